@@ -0,0 +1,139 @@
+#include "ArmorReader.h"
+
+#include <cctype>
+
+namespace OpenPGP {
+
+// Radix-64 characters decoded at a time
+static const std::size_t BUFFER_SIZE = 65536;
+
+static bool is_tail(const std::string & line){
+    return (line.compare(0, 13, "-----END PGP ") == 0);
+}
+
+ArmorReader::DecodeBuf::DecodeBuf(std::istream & in)
+    : std::streambuf(),
+      src(&in),
+      text(),
+      buf(),
+      crc(CRC24_INIT),
+      padded(false),
+      done(false),
+      found(false),
+      checksum(0)
+{
+    text.reserve(BUFFER_SIZE + 128);
+}
+
+void ArmorReader::DecodeBuf::fill(){
+    std::string line;
+    while (!done && (text.size() < BUFFER_SIZE)){
+        if (!std::getline(*src, line) || is_tail(line)){
+            done = true;
+            break;
+        }
+
+        std::string chars;
+        for(char const c : line){
+            if (!std::isspace(static_cast <unsigned char> (c))){
+                chars += c;
+            }
+        }
+
+        // 6.2. Forming ASCII Armor
+        //     ...
+        //     Then an Armor Checksum is
+        //     appended after the Armor Headers and the data, on a separate line.
+        //
+        // the checksum is '=' and 4 Radix-64 characters; a shorter line starting
+        // with '=' is padding wrapped onto its own line
+        if ((chars.size() == 5) && (chars[0] == '=')){
+            const std::string value = radix642ascii(chars.substr(1));
+            if (value.size() != 3){
+                throw std::runtime_error("Error: Bad ASCII Armor checksum.");
+            }
+            checksum = (static_cast <uint32_t> (static_cast <uint8_t> (value[0])) << 16) |
+                       (static_cast <uint32_t> (static_cast <uint8_t> (value[1])) <<  8) |
+                        static_cast <uint32_t> (static_cast <uint8_t> (value[2]));
+            found = true;
+            done = true;
+            skip_tail();
+            break;
+        }
+
+        text += chars;
+    }
+
+    // hold back a partial group unless nothing follows it
+    const std::size_t len = done?text.size():(text.size() & ~static_cast <std::size_t> (3));
+    if (!len){
+        buf.clear();
+        return;
+    }
+
+    if (padded){
+        throw std::runtime_error("Error: Misplaced Radix64 padding.");
+    }
+
+    buf = radix642ascii(text.data(), len);
+    padded = (text[len - 1] == '=');
+    text.erase(0, len);
+
+    crc = crc24_update(crc, buf.data(), buf.size());
+}
+
+void ArmorReader::DecodeBuf::skip_tail(){
+    std::string line;
+    while (std::getline(*src, line) && !is_tail(line));
+}
+
+ArmorReader::DecodeBuf::int_type ArmorReader::DecodeBuf::underflow(){
+    if (gptr() < egptr()){
+        return traits_type::to_int_type(*gptr());
+    }
+
+    do{
+        if (done && text.empty()){
+            return traits_type::eof();
+        }
+        fill();
+    } while (buf.empty());
+
+    setg(&buf[0], &buf[0], &buf[0] + buf.size());
+    return traits_type::to_int_type(*gptr());
+}
+
+bool ArmorReader::DecodeBuf::finished() const{
+    return done && text.empty() && (gptr() == egptr());
+}
+
+bool ArmorReader::DecodeBuf::has_checksum() const{
+    return found;
+}
+
+bool ArmorReader::DecodeBuf::checksum_matches() const{
+    return found && (crc == checksum);
+}
+
+ArmorReader::ArmorReader(std::istream & in)
+    : std::istream(nullptr),
+      decoder(in)
+{
+    rdbuf(&decoder);
+}
+
+ArmorReader::~ArmorReader(){}
+
+bool ArmorReader::finished() const{
+    return decoder.finished();
+}
+
+bool ArmorReader::has_checksum() const{
+    return decoder.has_checksum();
+}
+
+bool ArmorReader::checksum_matches() const{
+    return decoder.checksum_matches();
+}
+
+}
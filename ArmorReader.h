@@ -0,0 +1,101 @@
+/*
+ArmorReader.h
+Streaming ASCII Armor decoder with a running CRC-24
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_ARMOR_READER__
+#define __OPENPGP_ARMOR_READER__
+
+#include <cstdint>
+#include <istream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+#include "Misc/CRC-24.h"
+#include "Misc/radix64.h"
+
+namespace OpenPGP {
+
+    // Decodes the Radix-64 body of ASCII Armor as it is read. The input
+    // stream starts after the Armor Headers and the blank line following
+    // them; decoding stops at the checksum line or the Armor Tail, and
+    // the input is left after the Armor Tail. The checksum is calculated
+    // along the way, so only a few lines are held at a time:
+    //
+    //     ArmorReader armor(std::cin);
+    //     PacketReader reader(armor);
+    //     ...
+    //
+    // The checksum can be checked once everything has been read.
+    class ArmorReader : public std::istream {
+        private:
+            class DecodeBuf : public std::streambuf {
+                private:
+                    std::istream * src;
+                    std::string text;       // Radix-64 characters not yet decoded
+                    std::string buf;        // decoded octets
+                    uint32_t crc;           // running checksum of the decoded octets
+                    bool padded;            // the last decoded characters were padding
+                    bool done;              // the end of the body was found
+                    bool found;             // a checksum line was found
+                    uint32_t checksum;      // value of the checksum line
+
+                    // reads lines up to the next few thousand characters
+                    // and decodes the whole groups among them
+                    void fill();
+
+                    // reads the rest of the armor, up to and including the Armor Tail
+                    void skip_tail();
+
+                protected:
+                    int_type underflow();
+
+                public:
+                    DecodeBuf(std::istream & in);
+                    bool finished() const;
+                    bool has_checksum() const;
+                    bool checksum_matches() const;
+            };
+
+            DecodeBuf decoder;
+
+        public:
+            ArmorReader(std::istream & in);
+            ArmorReader(const ArmorReader & copy) = delete;
+            ArmorReader & operator=(const ArmorReader & copy) = delete;
+            ~ArmorReader();
+
+            // whether the whole body has been read
+            bool finished() const;
+
+            // whether the body ended with a checksum line
+            bool has_checksum() const;
+
+            // whether the checksum line matches the decoded data; only
+            // meaningful once finished() is true
+            bool checksum_matches() const;
+    };
+}
+
+#endif
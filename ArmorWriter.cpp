@@ -0,0 +1,114 @@
+#include "ArmorWriter.h"
+
+#include <algorithm>
+
+namespace OpenPGP {
+
+// octets encoded at a time; a whole number of 3 octet groups
+static const std::size_t BUFFER_SIZE = 3 * 16384;
+
+ArmorWriter::EncodeBuf::EncodeBuf(std::ostream & out, const std::size_t line_length)
+    : std::streambuf(),
+      dst(&out),
+      line_length(line_length),
+      column(0),
+      crc(CRC24_INIT),
+      closed(false),
+      buf(BUFFER_SIZE)
+{
+    if (!line_length || (line_length > 76)){
+        throw std::runtime_error("Error: ASCII Armor lines must be 1 to 76 characters long.");
+    }
+
+    setp(buf.data(), buf.data() + buf.size());
+}
+
+void ArmorWriter::EncodeBuf::encode(){
+    const std::size_t len = pptr() - pbase();
+    crc = crc24_update(crc, pbase(), len);
+
+    const std::string text = ascii2radix64(pbase(), len);
+    for(std::size_t i = 0; i < text.size();){
+        const std::size_t n = std::min(line_length - column, text.size() - i);
+        dst -> write(text.data() + i, n);
+        i += n;
+        column += n;
+        if (column == line_length){
+            dst -> put('\n');
+            column = 0;
+        }
+    }
+
+    setp(buf.data(), buf.data() + buf.size());
+}
+
+ArmorWriter::EncodeBuf::int_type ArmorWriter::EncodeBuf::overflow(int_type c){
+    if (closed){
+        return traits_type::eof();
+    }
+
+    if (traits_type::eq_int_type(c, traits_type::eof())){
+        return traits_type::not_eof(c);
+    }
+
+    encode();
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+std::streamsize ArmorWriter::EncodeBuf::xsputn(const char * s, std::streamsize n){
+    if (closed){
+        return 0;
+    }
+
+    const std::streamsize total = n;
+    while (n){
+        if (pptr() == epptr()){
+            encode();
+        }
+
+        const std::streamsize room = std::min <std::streamsize> (epptr() - pptr(), n);
+        std::copy(s, s + room, pptr());
+        pbump(room);
+        s += room;
+        n -= room;
+    }
+    return total;
+}
+
+void ArmorWriter::EncodeBuf::close(){
+    if (closed){
+        return;
+    }
+    closed = true;
+
+    encode();
+    if (column){
+        dst -> put('\n');
+    }
+
+    const char value[3] = {static_cast <char> (crc >> 16), static_cast <char> (crc >> 8), static_cast <char> (crc)};
+    *dst << "=" << ascii2radix64(value, sizeof(value)) << "\n";
+    setp(nullptr, nullptr);
+}
+
+ArmorWriter::ArmorWriter(std::ostream & out, const std::size_t line_length)
+    : std::ostream(nullptr),
+      encoder(out, line_length)
+{
+    rdbuf(&encoder);
+}
+
+ArmorWriter::~ArmorWriter(){
+    try{
+        close();
+    }
+    catch (...){}
+}
+
+void ArmorWriter::close(){
+    encoder.close();
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ArmorWriter.h
+Streaming ASCII Armor encoder with line wrapping and a running CRC-24
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_ARMOR_WRITER__
+#define __OPENPGP_ARMOR_WRITER__
+
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Misc/CRC-24.h"
+#include "Misc/radix64.h"
+
+namespace OpenPGP {
+
+    // Encodes whatever is written to it as the Radix-64 body of ASCII
+    // Armor, wrapped into lines of line_length characters, and keeps a
+    // running checksum. The Armor Header Line, Armor Headers and blank
+    // line are written to out before the body, and the Armor Tail after
+    // it:
+    //
+    //     out << "-----BEGIN PGP MESSAGE-----\n\n";
+    //     ArmorWriter armor(out);
+    //     armor << packets;
+    //     armor.close();
+    //     out << "-----END PGP MESSAGE-----\n";
+    //
+    // close() encodes the last group and writes the checksum line.
+    class ArmorWriter : public std::ostream {
+        private:
+            class EncodeBuf : public std::streambuf {
+                private:
+                    std::ostream * dst;
+                    std::size_t line_length;
+                    std::size_t column;     // characters already on the current line
+                    uint32_t crc;           // running checksum of the encoded octets
+                    bool closed;
+                    std::vector <char> buf; // octets not yet encoded; a whole number of groups
+
+                    // encodes and writes the buffered octets
+                    void encode();
+
+                protected:
+                    int_type overflow(int_type c);
+                    std::streamsize xsputn(const char * s, std::streamsize n);
+
+                public:
+                    EncodeBuf(std::ostream & out, const std::size_t line_length);
+                    void close();
+            };
+
+            EncodeBuf encoder;
+
+        public:
+            ArmorWriter(std::ostream & out, const std::size_t line_length = MAX_LINE_LENGTH);
+            ArmorWriter(const ArmorWriter & copy) = delete;
+            ArmorWriter & operator=(const ArmorWriter & copy) = delete;
+            ~ArmorWriter();
+
+            // writes the rest of the body and the checksum; nothing may be
+            // written afterwards
+            void close();
+    };
+}
+
+#endif
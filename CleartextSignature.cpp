@@ -141,6 +141,10 @@ void CleartextSignature::set_message(const std::string & data){
     message = data;
 }
 
+void CleartextSignature::set_message(std::string && data){
+    message = std::move(data);
+}
+
 void CleartextSignature::set_sig(const DetachedSignature & s){
     sig = s;
     sig.set_armored(PGP::Armored::YES);
@@ -208,20 +212,33 @@ std::string CleartextSignature::data_to_text() const{
 }
 
 std::string CleartextSignature::data_to_text(const std::string & text){
-    std::string out = "";
+    return data_to_text(ByteSlice::view(text.data(), text.size()));
+}
+
+std::string CleartextSignature::data_to_text(const ByteSlice & text){
+    std::string out;
+    out.reserve(text.size());
+
+    // lines are separated by newlines; a newline at the very end does not start another line
+    std::size_t start = 0;
+    while (start < text.size()){
+        const char * newline = static_cast <const char *> (std::memchr(text.data() + start, '\n', text.size() - start));
+        const std::size_t end = newline?(newline - text.data()):text.size();
 
-    std::stringstream s(text);
-    std::string line;
-    while (std::getline(s, line)){
         // remove trailing whitespace
-        std::string::size_type i = line.size();
-        while (i && ((line[i - 1] == ' ') || (line[i - 1] == '\t'))){
+        std::size_t i = end;
+        while ((i > start) && ((text[i - 1] == ' ') || (text[i - 1] == '\t'))){
             i--;
         }
-        out += line.substr(0, i) + "\n";
+
+        if (start){
+            out += "\n";
+        }
+        out.append(text.data() + start, i - start);
+        start = end + 1;
     }
 
-    return out.substr(0, out.size() - 1);
+    return out;
 }
 
 bool CleartextSignature::meaningful() const{
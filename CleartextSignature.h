@@ -26,6 +26,8 @@ THE SOFTWARE.
 #ifndef __OPENPGP_CLEARTEXT_SIGNATURE__
 #define __OPENPGP_CLEARTEXT_SIGNATURE__
 
+#include <cstring>
+
 #include "Misc/sigcalc.h"
 #include "PGP.h"
 #include "DetachedSignature.h"
@@ -93,12 +95,14 @@ namespace OpenPGP {
 
             void set_hash_armor_header(const PGP::Armor_Keys & keys);
             void set_message(const std::string & data);
+            void set_message(std::string && data);
             void set_sig(const DetachedSignature & s);
 
             static std::string dash_escape(const std::string & text);
             static std::string reverse_dash_escape(const std::string & text);
             std::string data_to_text() const;                            // remove trailing whitespace
             static std::string data_to_text(const std::string & text);   // remove trailing whitespace
+            static std::string data_to_text(const ByteSlice & text);     // remove trailing whitespace; text is read in place
 
             bool meaningful() const;
 
@@ -60,5 +60,97 @@ std::string decompress(const uint8_t alg, const std::string & src){
     return src; // 0: uncompressed
 }
 
+Compressor::Compressor(const uint8_t alg)
+    : alg(alg),
+      zs(),
+      bs(),
+      done(false)
+{
+    int ret = Z_OK;
+    switch (alg){
+        case ID::UNCOMPRESSED:
+            break;
+        case ID::ZIP:
+            ret = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, DEFLATE_WINDOWBITS, 8, Z_DEFAULT_STRATEGY);
+            break;
+        case ID::ZLIB:
+            ret = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, ZLIB_WINDOWBITS, 8, Z_DEFAULT_STRATEGY);
+            break;
+        case ID::BZIP2:
+            ret = (BZ2_bzCompressInit(&bs, bz2_BLOCKSIZE100K, bz2_VERBOSITY, bz2_WORKFACTOR) == BZ_OK)?Z_OK:Z_MEM_ERROR;
+            break;
+        default:
+            throw std::runtime_error("Error: Unknown or undefined compression algorithm value: " + std::to_string(alg));
+            break;
+    }
+
+    if (ret != Z_OK){
+        throw std::runtime_error("Error: Compression failed");
+    }
+}
+
+Compressor::~Compressor(){
+    if ((alg == ID::ZIP) || (alg == ID::ZLIB)){
+        deflateEnd(&zs);
+    }
+    else if (alg == ID::BZIP2){
+        BZ2_bzCompressEnd(&bs);
+    }
+}
+
+std::string Compressor::run(const char * data, const std::size_t length, const bool last){
+    if (done){
+        throw std::runtime_error("Error: Compressor has already finished.");
+    }
+    done = last;
+
+    if (alg == ID::UNCOMPRESSED){
+        return std::string(data, length);
+    }
+
+    std::string out;
+    char buf[ZLIB_CHUNK];
+    if (alg == ID::BZIP2){
+        bs.next_in = const_cast <char *> (data);
+        bs.avail_in = length;
+        int ret;
+        do {
+            bs.next_out = buf;
+            bs.avail_out = sizeof(buf);
+            ret = BZ2_bzCompress(&bs, last?BZ_FINISH:BZ_RUN);
+            if ((ret != BZ_RUN_OK) && (ret != BZ_FINISH_OK) && (ret != BZ_STREAM_END)){
+                throw std::runtime_error("Error: Compression failed");
+            }
+            out.append(buf, sizeof(buf) - bs.avail_out);
+        } while (last?(ret != BZ_STREAM_END):(bs.avail_in != 0));
+    }
+    else{
+        zs.next_in = reinterpret_cast <Bytef *> (const_cast <char *> (data));
+        zs.avail_in = length;
+        do {
+            zs.next_out = reinterpret_cast <Bytef *> (buf);
+            zs.avail_out = sizeof(buf);
+            if (deflate(&zs, last?Z_FINISH:Z_NO_FLUSH) == Z_STREAM_ERROR){
+                throw std::runtime_error("Error: Compression failed");
+            }
+            out.append(buf, sizeof(buf) - zs.avail_out);
+        } while (zs.avail_out == 0);
+    }
+
+    return out;
+}
+
+std::string Compressor::update(const std::string & data){
+    return update(data.data(), data.size());
+}
+
+std::string Compressor::update(const char * data, const std::size_t length){
+    return run(data, length, false);
+}
+
+std::string Compressor::finish(){
+    return run(nullptr, 0, true);
+}
+
 }
 }
@@ -83,6 +83,28 @@ namespace OpenPGP {
 
         std::string compress(const uint8_t alg, const std::string & data);
         std::string decompress(const uint8_t alg, const std::string & data);
+
+        // compresses data that arrives in pieces
+        // the concatenated output of update() and finish() decompresses to the concatenated input
+        class Compressor{
+            private:
+                uint8_t alg;
+                z_stream zs;
+                bz_stream bs;
+                bool done;
+
+                std::string run(const char * data, const std::size_t length, const bool last);
+
+            public:
+                Compressor(const uint8_t alg);
+                Compressor(const Compressor & copy) = delete;
+                Compressor & operator=(const Compressor & copy) = delete;
+                ~Compressor();
+
+                std::string update(const std::string & data);
+                std::string update(const char * data, const std::size_t length);
+                std::string finish();
+        };
     }
 }
 
@@ -34,5 +34,51 @@ std::string use(const uint8_t alg, const std::string & data){
     }
 }
 
+// octets given to update() at a time, so large inputs are never copied whole
+static const std::size_t PIECE = 65536;
+
+std::unique_ptr <MerkleDamgard> instance(const uint8_t alg){
+    std::unique_ptr <MerkleDamgard> h;
+    switch (alg){
+        case ID::MD5:
+            h.reset(new MD5());
+            break;
+        case ID::SHA1:
+            h.reset(new SHA1());
+            break;
+        case ID::RIPEMD160:
+            h.reset(new RIPEMD160());
+            break;
+        case ID::SHA256:
+            h.reset(new SHA256());
+            break;
+        case ID::SHA384:
+            h.reset(new SHA384());
+            break;
+        case ID::SHA512:
+            h.reset(new SHA512());
+            break;
+        case ID::SHA224:
+            h.reset(new SHA224());
+            break;
+        default:
+            throw std::runtime_error("Error: Hash value not defined or reserved.");
+            break;
+    }
+
+    return h;
+}
+
+std::string use(const uint8_t alg, const ByteChain & data){
+    std::unique_ptr <MerkleDamgard> h = instance(alg);
+    for(ByteSlice const & piece : data.get_pieces()){
+        for(std::size_t i = 0; i < piece.size(); i += PIECE){
+            h -> update(piece.data() + i, std::min(PIECE, piece.size() - i));
+        }
+    }
+
+    return h -> digest();
+}
+
+}
 }
-}
\ No newline at end of file
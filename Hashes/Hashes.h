@@ -27,8 +27,10 @@ THE SOFTWARE.
 #define HASHES_H
 
 #include <map>
+#include <memory>
 #include <stdexcept>
 
+#include "../common/ByteChain.h"
 #include "HashAlg.h"
 
 #include "MD5.h"
@@ -127,7 +129,13 @@ namespace OpenPGP {
             std::make_pair(ID::SHA224,      224),
         };
 
+        // new context for hashing data as it arrives
+        std::unique_ptr <MerkleDamgard> instance(const uint8_t alg);
+
         std::string use(const uint8_t alg, const std::string & data);
+
+        // hashes the pieces of data in order without joining them
+        std::string use(const uint8_t alg, const ByteChain & data);
     }
 }
 
@@ -6,4 +6,8 @@ MerkleDamgard::MerkleDamgard()
       clen(0)
 {}
 
-MerkleDamgard::~MerkleDamgard(){}
\ No newline at end of file
+MerkleDamgard::~MerkleDamgard(){}
+
+void MerkleDamgard::update(const char * data, const std::size_t length){
+    update(std::string(data, length));
+}
@@ -37,6 +37,7 @@ class MerkleDamgard : public HashAlg {
         MerkleDamgard();
         virtual ~MerkleDamgard();
         virtual void update(const std::string & str) = 0;
+        virtual void update(const char * data, const std::size_t length); // hashes octets in place where the algorithm allows it
         virtual std::size_t blocksize() const = 0;  // blocksize in bits
 };
 
@@ -1,11 +1,15 @@
 #include "SHA1.h"
 
-void SHA1::calc(const std::string & data, context & state) const {
-    for(unsigned int n = 0; n < (data.size() >> 6); n++){
-        std::string temp = data.substr(n << 6, 64);
+void SHA1::calc(const char * data, const std::size_t length, context & state) const {
+    for(std::size_t n = 0; n < (length >> 6); n++){
+        // big-endian words, read in place
+        const unsigned char * block = reinterpret_cast <const unsigned char *> (data) + (n << 6);
         uint32_t skey[80];
         for(uint8_t x = 0; x < 16; x++){
-            skey[x] = toint(temp.substr(x << 2, 4), 256);
+            skey[x] = (static_cast <uint32_t> (block[(x << 2)    ]) << 24) |
+                      (static_cast <uint32_t> (block[(x << 2) + 1]) << 16) |
+                      (static_cast <uint32_t> (block[(x << 2) + 2]) <<  8) |
+                       static_cast <uint32_t> (block[(x << 2) + 3]);
         }
         for(uint8_t x = 16; x < 80; x++){
             skey[x] = ROL((skey[x - 3] ^ skey[x - 8] ^ skey[x - 14] ^ skey[x - 16]), 1, 32);
@@ -56,21 +60,34 @@ SHA1::SHA1(const std::string & str) :
 }
 
 void SHA1::update(const std::string & str){
-    std::string data = stack + str;
-    stack.clear();
-    std::string::size_type size = ((data.size() >> 6) << 6);
-    if ( std::string::size_type rem = ( data.size() - size ) ){
-        stack = data.substr(size, rem);
+    update(str.data(), str.size());
+}
+
+void SHA1::update(const char * data, const std::size_t length){
+    std::size_t pos = 0;
+    if (!stack.empty()){
+        // top up the block left over from the last call
+        pos = std::min(length, static_cast <std::size_t> (64) - stack.size());
+        stack.append(data, pos);
+        if (stack.size() < 64){
+            return;
+        }
+        calc(stack.data(), stack.size(), ctx);
+        clen += stack.size();
     }
-    calc(data.substr(0, size), ctx);
+
+    // whole blocks are hashed straight from the input
+    const std::size_t size = ((length - pos) >> 6) << 6;
+    calc(data + pos, size, ctx);
     clen += size;
+    stack.assign(data + pos + size, length - pos - size);
 }
 
 std::string SHA1::hexdigest(){
     context tmp = ctx;
     uint16_t size = stack.size();
     std::string last = stack + "\x80" + std::string((((size & 63) > 55)?119:55) - (size & 63), 0) + unhexlify(makehex((clen+size) << 3, 16));
-    calc(last, tmp);
+    calc(last.data(), last.size(), tmp);
     return makehex(tmp.h0, 8) + makehex(tmp.h1, 8) + makehex(tmp.h2, 8) + makehex(tmp.h3, 8) + makehex(tmp.h4, 8);
 }
 
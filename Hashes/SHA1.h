@@ -49,12 +49,13 @@ class SHA1 : public MerkleDamgard {
 
         context ctx;
 
-        void calc(const std::string & data, context & state) const;
+        void calc(const char * data, const std::size_t length, context & state) const; // only whole blocks are used
 
     public:
         SHA1();
         SHA1(const std::string & str);
         void update(const std::string & str);
+        void update(const char * data, const std::size_t length);
         std::string hexdigest();
         std::size_t blocksize() const;
         std::size_t digestsize() const;
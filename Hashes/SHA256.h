@@ -51,13 +51,14 @@ class SHA256 : public MerkleDamgard {
 
         virtual void original_h();
 
-        void calc(const std::string & data, context & state) const;
+        void calc(const char * data, const std::size_t length, context & state) const; // only whole blocks are used
 
     public:
         SHA256();
         SHA256(const std::string & data);
 
-        void update(const std::string &str);
+        void update(const std::string & str);
+        void update(const char * data, const std::size_t length);
         virtual std::string hexdigest();
         virtual std::size_t blocksize() const;
         virtual std::size_t digestsize() const;
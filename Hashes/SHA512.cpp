@@ -27,12 +27,16 @@ void SHA512::original_h(){
     ctx.h7 = 0x5be0cd19137e2179ULL;
 }
 
-void SHA512::calc(const std::string & data, context & state) const {
-    for(unsigned int n = 0; n < (data.size() >> 7); n++){
-        std::string temp = data.substr(n << 7, 128);
+void SHA512::calc(const char * data, const std::size_t length, context & state) const {
+    for(std::size_t n = 0; n < (length >> 7); n++){
+        // big-endian words, read in place
+        const unsigned char * block = reinterpret_cast <const unsigned char *> (data) + (n << 7);
         uint64_t skey[80];
         for(uint8_t x = 0; x < 16; x++){
-            skey[x] = toint(temp.substr(x << 3, 8), 256);
+            skey[x] = 0;
+            for(uint8_t y = 0; y < 8; y++){
+                skey[x] = (skey[x] << 8) | block[(x << 3) + y];
+            }
         }
         for(uint8_t x = 16; x < 80; x++){
             skey[x] = s1(skey[x - 2]) + skey[x - 7] + s0(skey[x - 15]) + skey[x - 16];
@@ -67,22 +71,35 @@ SHA512::SHA512(const std::string & str) :
     update(str);
 }
 
-void SHA512::update(const std::string &str){
-    std::string data = stack + str;
-    stack.clear();
-    std::string::size_type size = ((data.size() >> 7) << 7);
-    if ( std::string::size_type rem = ( data.size() - size ) ){
-        stack = data.substr(size, rem);
+void SHA512::update(const std::string & str){
+    update(str.data(), str.size());
+}
+
+void SHA512::update(const char * data, const std::size_t length){
+    std::size_t pos = 0;
+    if (!stack.empty()){
+        // top up the block left over from the last call
+        pos = std::min(length, static_cast <std::size_t> (128) - stack.size());
+        stack.append(data, pos);
+        if (stack.size() < 128){
+            return;
+        }
+        calc(stack.data(), stack.size(), ctx);
+        clen += stack.size();
     }
-    calc(data.substr(0, size), ctx);
+
+    // whole blocks are hashed straight from the input
+    const std::size_t size = ((length - pos) >> 7) << 7;
+    calc(data + pos, size, ctx);
     clen += size;
+    stack.assign(data + pos + size, length - pos - size);
 }
 
 std::string SHA512::hexdigest(){
     context tmp = ctx;
     uint64_t size = stack.size();
     std::string last = stack + "\x80" + std::string((((size & 127) > 111)?239:111) - (size & 127), 0) + unhexlify(makehex((clen+size) << 3, 32));
-    calc(last, tmp);
+    calc(last.data(), last.size(), tmp);
     return makehex(tmp.h0, 16) + makehex(tmp.h1, 16) + makehex(tmp.h2, 16) + makehex(tmp.h3, 16) + makehex(tmp.h4, 16) + makehex(tmp.h5, 16) + makehex(tmp.h6, 16) + makehex(tmp.h7, 16);
 }
 
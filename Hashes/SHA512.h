@@ -50,12 +50,13 @@ class SHA512 : public MerkleDamgard {
 
         virtual void original_h();
 
-        void calc(const std::string & data, context & state) const;
+        void calc(const char * data, const std::size_t length, context & state) const; // only whole blocks are used
 
     public:
         SHA512();
         SHA512(const std::string & data);
         void update(const std::string & str);
+        void update(const char * data, const std::size_t length);
         virtual std::string hexdigest();
         virtual std::size_t blocksize() const;
         virtual std::size_t digestsize() const;
@@ -78,7 +78,7 @@ std::string Key::list_keys(const std::size_t indents, const std::size_t indent_s
                 out << "\n";
             }
 
-            out << indent << Public_Key_Type.at(p -> get_tag()) << "  " << std::setfill(' ') << std::setw(4) << std::to_string(bitsize(key -> get_mpi()[0]))
+            out << indent << Public_Key_Type.at(p -> get_tag()) << "  " << std::setfill(' ') << std::setw(4) << std::to_string(key -> get_mpi_bitsize(0))
                 << indent << PKA::SHORT.at(key -> get_pka()) << "/"
                 << indent << hexlify(key -> get_keyid().substr(4, 4)) << " "
                 << indent << show_date(key -> get_time());
@@ -193,6 +193,22 @@ Message::Message(std::istream & stream)
     }
 }
 
+Message::Message(const ByteSlice & data)
+    : PGP(data),
+      comp(nullptr)
+{
+    type = MESSAGE;
+
+    // throw if packet sequence is not meaningful
+    if (!meaningful()){
+        throw std::runtime_error("Error: Data does not form a meaningful PGP Message");
+    }
+
+    if (!decompress()){
+        throw std::runtime_error("Error: Failed to decompress data");
+    }
+}
+
 Message::~Message(){}
 
 std::string Message::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -215,6 +231,12 @@ std::string Message::raw(const Packet::Tag::Format header) const{
 }
 
 std::string Message::write(const PGP::Armored armor, const Packet::Tag::Format header) const{
+    std::ostringstream out;
+    write(out, armor, header);
+    return out.str();
+}
+
+void Message::write(std::ostream & out, const PGP::Armored armor, const Packet::Tag::Format header) const{
     std::string packet_string = raw(header);
 
     // put data into a Compressed Data Packet if compression is used
@@ -225,15 +247,21 @@ std::string Message::write(const PGP::Armored armor, const Packet::Tag::Format h
 
     if ((armor == Armored::NO)                   || // no armor
         ((armor == Armored::DEFAULT) && !armored)){ // or use stored value, and stored value is no
-        return packet_string;
+        out << packet_string;
+        return;
     }
 
-    std::string out = "-----BEGIN PGP MESSAGE-----\n";
+    out << "-----BEGIN PGP MESSAGE-----\n";
     for(Armor_Key const & key : keys){
-        out += key.first + ": " + key.second + "\n";
+        out << key.first << ": " << key.second << "\n";
     }
-    out += "\n";
-    return out + format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH) + "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) +  "\n-----END PGP MESSAGE-----\n";
+    out << "\n";
+
+    ArmorWriter body(out);
+    body << packet_string;
+    body.close();
+
+    out << "-----END PGP MESSAGE-----\n";
 }
 
 uint8_t Message::get_comp() const{
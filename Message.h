@@ -110,11 +110,13 @@ namespace OpenPGP {
             Message(const Message & copy);
             Message(const std::string & data);
             Message(std::istream & stream);
+            Message(const ByteSlice & data);            // binary packets keep slices of data
             ~Message();
 
             std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;   // display information; indents is used to tab the output if desired
             std::string raw(const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;               // write packets only; header is for writing default (0), old (1) or new (2) header formats
             std::string write(const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;
+            void write(std::ostream & out, const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;
 
             uint8_t get_comp() const;                                                                   // get compression algorithm
 
@@ -1,24 +1,134 @@
 #include "CRC-24.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC24_PCLMUL
+#include <immintrin.h>
+#endif
+
 namespace OpenPGP {
 
-// OpenPGP has an optional CRC24 checksum at the end of its Radix-64 encoded data
-uint32_t crc24(const std::string & str){
-    static const uint32_t INIT = 0xB704CE;
-    static const uint32_t POLY = 0x1864CFB;
-
-    uint32_t crc = INIT;
-    for(unsigned char const c : str){
-        crc ^= static_cast <uint32_t> (c) << 16;
-        for(uint8_t i = 0; i < 8; i++){
-            crc <<= 1;
-            if (crc & 0x1000000){
-                crc ^= POLY;
+// The checksum is kept in the top 24 bits of a 32 bit register, which
+// turns CRC-24 into a CRC-32 with the polynomial x^8 * CRC24_POLY. Tables
+// and folding constants are all in terms of that polynomial.
+static const uint32_t POLY32 = 0x864CFB00;  // x^32 is implied
+
+struct CRC24Tables{
+    uint32_t t[8][256];
+
+    CRC24Tables(){
+        for(uint32_t b = 0; b < 256; b++){
+            uint32_t crc = b << 24;
+            for(uint8_t i = 0; i < 8; i++){
+                crc = (crc << 1) ^ ((crc & 0x80000000)?POLY32:0);
             }
+            t[0][b] = crc;
         }
+
+        // t[k][b] is t[0][b] followed by k zero octets
+        for(uint8_t k = 1; k < 8; k++){
+            for(uint32_t b = 0; b < 256; b++){
+                t[k][b] = (t[k - 1][b] << 8) ^ t[0][t[k - 1][b] >> 24];
+            }
+        }
+    }
+};
+
+static const CRC24Tables & tables(){
+    static const CRC24Tables tables;
+    return tables;
+}
+
+// crc is the top aligned checksum
+static uint32_t slice8(uint32_t crc, const uint8_t * in, std::size_t len){
+    const uint32_t (* t)[256] = tables().t;
+
+    for(; len >= 8; in += 8, len -= 8){
+        crc ^= (static_cast <uint32_t> (in[0]) << 24) |
+               (static_cast <uint32_t> (in[1]) << 16) |
+               (static_cast <uint32_t> (in[2]) <<  8) |
+                static_cast <uint32_t> (in[3]);
+        crc = t[7][crc >> 24] ^ t[6][(crc >> 16) & 0xff] ^ t[5][(crc >> 8) & 0xff] ^ t[4][crc & 0xff] ^
+              t[3][in[4]]     ^ t[2][in[5]]             ^ t[1][in[6]]            ^ t[0][in[7]];
+    }
+
+    for(; len; in++, len--){
+        crc = (crc << 8) ^ t[0][(crc >> 24) ^ *in];
+    }
+
+    return crc;
+}
+
+#ifdef CRC24_PCLMUL
+// shorter inputs are not worth loading into vector registers
+static const std::size_t PCLMUL_MIN = 64;
+
+static bool has_pclmul(){
+    static const bool pclmul = [](){
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+    }();
+    return pclmul;
+}
+
+// x^n mod (x^32 + POLY32)
+static uint64_t xpow_mod(unsigned int n){
+    uint32_t r = 1;
+    while (n--){
+        r = (r << 1) ^ ((r & 0x80000000)?POLY32:0);
+    }
+    return r;
+}
+
+// Fold 16 octet blocks into a 128 bit remainder: a remainder R followed
+// by 128 more bits is congruent to R_hi * x^192 + R_lo * x^128, and both
+// products fit in 128 bits. The final remainder is reduced with the
+// tables. Returns the number of octets consumed, a multiple of 16.
+__attribute__((target("pclmul,ssse3")))
+static std::size_t fold_pclmul(uint32_t & crc, const uint8_t * in, const std::size_t len){
+    static const uint64_t K192 = xpow_mod(192);
+    static const uint64_t K128 = xpow_mod(128);
+
+    const __m128i k = _mm_set_epi64x(K192, K128);
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // the running checksum is added to the first 32 bits of the input
+    __m128i r = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast <const __m128i *> (in)), reverse);
+    r = _mm_xor_si128(r, _mm_set_epi32(crc, 0, 0, 0));
+
+    std::size_t i = 16;
+    for(; i + 16 <= len; i += 16){
+        const __m128i block = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i)), reverse);
+        r = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(r, k, 0x11),
+                                        _mm_clmulepi64_si128(r, k, 0x00)),
+                          block);
+    }
+
+    uint8_t rem[16];
+    _mm_storeu_si128(reinterpret_cast <__m128i *> (rem), _mm_shuffle_epi8(r, reverse));
+    crc = slice8(0, rem, sizeof(rem));
+
+    return i;
+}
+#endif
+
+uint32_t crc24_update(uint32_t crc, const void * data, const std::size_t len){
+    const uint8_t * in = static_cast <const uint8_t *> (data);
+    std::size_t i = 0;
+
+    crc <<= 8;
+
+    #ifdef CRC24_PCLMUL
+    if ((len >= PCLMUL_MIN) && has_pclmul()){
+        i = fold_pclmul(crc, in, len);
     }
+    #endif
 
-    return crc & 0xFFFFFF;
+    return slice8(crc, in + i, len - i) >> 8;
 }
 
-}
\ No newline at end of file
+// OpenPGP has an optional CRC24 checksum at the end of its Radix-64 encoded data
+uint32_t crc24(const std::string & str){
+    return crc24_update(CRC24_INIT, str.data(), str.size());
+}
+
+}
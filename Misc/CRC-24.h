@@ -26,6 +26,7 @@ THE SOFTWARE.
 #ifndef __CRC24__
 #define __CRC24__
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -50,6 +51,15 @@ namespace OpenPGP {
     //           }
     //           return crc & 0xFFFFFFL;
     //       }
+    const uint32_t CRC24_INIT = 0xB704CE;
+
+    // continue a checksum with len more octets; start with CRC24_INIT
+    //
+    // Octets are processed 8 at a time through tables (slicing-by-8). On
+    // x86 processors with PCLMULQDQ, detected at run time, long inputs are
+    // folded 16 octets at a time with carry-less multiplication instead.
+    uint32_t crc24_update(uint32_t crc, const void * data, const std::size_t len);
+
     uint32_t crc24(const std::string & str);
 }
 
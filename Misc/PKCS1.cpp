@@ -3,7 +3,6 @@
 namespace OpenPGP {
 
 std::string EME_PKCS1v1_5_ENCODE(const std::string & m, const unsigned int & k){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
     if (m.size() > (k - 11)){
         // "Error: EME-PKCS1 Message too long.\n";
         return "";
@@ -11,13 +10,10 @@ std::string EME_PKCS1v1_5_ENCODE(const std::string & m, const unsigned int & k){
 
     std::string EM = zero + "\x02";
     while (EM.size() < k - m.size() - 1){
-        unsigned char c = 0;
-        for(uint8_t x = 0; x < 8; x++){
-            c = (c << 1) | (RNG::BBS().rand(1) == "1");
-        }
-
-        if (c){ // non-zero octets only
-            EM += std::string(1, c);
+        for(char const c : RNG::bytes(k - m.size() - 1 - EM.size())){
+            if (c){ // non-zero octets only
+                EM += c;
+            }
         }
     }
 
@@ -0,0 +1,431 @@
+#include "argon2.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace OpenPGP {
+namespace Argon2 {
+
+static std::atomic <uint32_t> max_memory(DEFAULT_MAX_MEMORY);
+static std::atomic <uint32_t> max_lanes(DEFAULT_MAX_LANES);
+
+void set_limits(const uint32_t memory, const uint32_t lanes){
+    max_memory = memory;
+    max_lanes = lanes;
+}
+
+uint32_t get_max_memory(){
+    return max_memory;
+}
+
+uint32_t get_max_lanes(){
+    return max_lanes;
+}
+
+// memset called through a volatile pointer, so it is not optimized away
+static void * (* const volatile wipe_memset)(void *, int, std::size_t) = std::memset;
+
+static uint64_t rotr64(const uint64_t x, const unsigned int n){
+    return (x >> n) | (x << (64 - n));
+}
+
+static uint64_t load64(const uint8_t * in){
+    uint64_t out = 0;
+    for(unsigned int i = 8; i-- > 0;){
+        out = (out << 8) | in[i];
+    }
+    return out;
+}
+
+static void store64(uint8_t * out, uint64_t x){
+    for(unsigned int i = 0; i < 8; i++, x >>= 8){
+        out[i] = x;
+    }
+}
+
+static std::string le32(const uint32_t x){
+    const char out[4] = {static_cast <char> (x), static_cast <char> (x >> 8), static_cast <char> (x >> 16), static_cast <char> (x >> 24)};
+    return std::string(out, 4);
+}
+
+// RFC 7693 sec 2.6
+static const uint64_t BLAKE2B_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+// RFC 7693 sec 2.7
+static const uint8_t SIGMA[12][16] = {
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+    {11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4},
+    { 7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8},
+    { 9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13},
+    { 2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9},
+    {12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11},
+    {13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10},
+    { 6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5},
+    {10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0},
+    { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+    {14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3},
+};
+
+// RFC 7693 sec 3.1
+static void blake2b_mix(uint64_t v[16], const unsigned int a, const unsigned int b, const unsigned int c, const unsigned int d, const uint64_t x, const uint64_t y){
+    v[a] = v[a] + v[b] + x;
+    v[d] = rotr64(v[d] ^ v[a], 32);
+    v[c] = v[c] + v[d];
+    v[b] = rotr64(v[b] ^ v[c], 24);
+    v[a] = v[a] + v[b] + y;
+    v[d] = rotr64(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotr64(v[b] ^ v[c], 63);
+}
+
+// RFC 7693 sec 3.2; t is the number of octets so far
+static void blake2b_compress(uint64_t h[8], const uint8_t block[128], const uint64_t t, const bool last){
+    uint64_t v[16], m[16];
+    for(unsigned int i = 0; i < 8; i++){
+        v[i] = h[i];
+        v[i + 8] = BLAKE2B_IV[i];
+    }
+    v[12] ^= t;
+    if (last){
+        v[14] = ~v[14];
+    }
+
+    for(unsigned int i = 0; i < 16; i++){
+        m[i] = load64(block + (i << 3));
+    }
+
+    for(unsigned int r = 0; r < 12; r++){
+        const uint8_t * s = SIGMA[r];
+        blake2b_mix(v, 0, 4,  8, 12, m[s[ 0]], m[s[ 1]]);
+        blake2b_mix(v, 1, 5,  9, 13, m[s[ 2]], m[s[ 3]]);
+        blake2b_mix(v, 2, 6, 10, 14, m[s[ 4]], m[s[ 5]]);
+        blake2b_mix(v, 3, 7, 11, 15, m[s[ 6]], m[s[ 7]]);
+        blake2b_mix(v, 0, 5, 10, 15, m[s[ 8]], m[s[ 9]]);
+        blake2b_mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        blake2b_mix(v, 2, 7,  8, 13, m[s[12]], m[s[13]]);
+        blake2b_mix(v, 3, 4,  9, 14, m[s[14]], m[s[15]]);
+    }
+
+    for(unsigned int i = 0; i < 8; i++){
+        h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+std::string blake2b(const std::string & data, const std::size_t len){
+    if ((len < 1) || (len > 64)){
+        throw std::runtime_error("Error: BLAKE2b digests are 1 to 64 octets long.");
+    }
+
+    uint64_t h[8];
+    std::copy(BLAKE2B_IV, BLAKE2B_IV + 8, h);
+    h[0] ^= 0x01010000 ^ len;
+
+    // the last block is compressed differently, even when it is full or empty
+    const uint8_t * in = reinterpret_cast <const uint8_t *> (data.data());
+    std::size_t left = data.size();
+    uint64_t t = 0;
+    while (left > 128){
+        t += 128;
+        blake2b_compress(h, in, t, false);
+        in += 128;
+        left -= 128;
+    }
+
+    uint8_t block[128] = {};
+    std::memcpy(block, in, left);
+    t += left;
+    blake2b_compress(h, block, t, true);
+
+    uint8_t out[64];
+    for(unsigned int i = 0; i < 8; i++){
+        store64(out + (i << 3), h[i]);
+    }
+    return std::string(reinterpret_cast <char *> (out), len);
+}
+
+// variable length hash function H' (RFC 9106 sec 3.3)
+static std::string hash(const std::string & in, const uint32_t len){
+    if (len <= 64){
+        return blake2b(le32(len) + in, len);
+    }
+
+    const uint32_t r = ((len + 31) >> 5) - 2;
+    std::string v = blake2b(le32(len) + in, 64);
+    std::string out = v.substr(0, 32);
+    for(uint32_t i = 2; i <= r; i++){
+        v = blake2b(v, 64);
+        out += v.substr(0, 32);
+    }
+    out += blake2b(v, len - (r << 5));
+    return out;
+}
+
+static const std::size_t WORDS = BLOCK_SIZE >> 3;
+static const uint32_t SYNC_POINTS = 4;
+static const uint32_t ADDRESSES = WORDS;    // addresses per address block
+static const uint64_t ARGON2ID = 2;
+
+struct Block{
+    uint64_t v[WORDS];
+};
+
+// RFC 9106 sec 3.6
+static uint64_t blamka(const uint64_t x, const uint64_t y){
+    return x + y + 2 * (x & 0xffffffff) * (y & 0xffffffff);
+}
+
+static void gb(uint64_t & a, uint64_t & b, uint64_t & c, uint64_t & d){
+    a = blamka(a, b); d = rotr64(d ^ a, 32);
+    c = blamka(c, d); b = rotr64(b ^ c, 24);
+    a = blamka(a, b); d = rotr64(d ^ a, 16);
+    c = blamka(c, d); b = rotr64(b ^ c, 63);
+}
+
+// permutation P over the 16 words at the given positions of r
+static void permute(uint64_t * r, const std::size_t pos[16]){
+    gb(r[pos[0]], r[pos[4]], r[pos[ 8]], r[pos[12]]);
+    gb(r[pos[1]], r[pos[5]], r[pos[ 9]], r[pos[13]]);
+    gb(r[pos[2]], r[pos[6]], r[pos[10]], r[pos[14]]);
+    gb(r[pos[3]], r[pos[7]], r[pos[11]], r[pos[15]]);
+    gb(r[pos[0]], r[pos[5]], r[pos[10]], r[pos[15]]);
+    gb(r[pos[1]], r[pos[6]], r[pos[11]], r[pos[12]]);
+    gb(r[pos[2]], r[pos[7]], r[pos[ 8]], r[pos[13]]);
+    gb(r[pos[3]], r[pos[4]], r[pos[ 9]], r[pos[14]]);
+}
+
+// compression function G (RFC 9106 sec 3.5); from the second pass on,
+// the new block is xored into what was there before
+static void compress(const Block & x, const Block & y, Block & out, const bool with_xor){
+    Block r, tmp;
+    for(std::size_t i = 0; i < WORDS; i++){
+        r.v[i] = x.v[i] ^ y.v[i];
+    }
+    tmp = r;
+    if (with_xor){
+        for(std::size_t i = 0; i < WORDS; i++){
+            tmp.v[i] ^= out.v[i];
+        }
+    }
+
+    // rows of 8 16-octet registers, then columns
+    std::size_t pos[16];
+    for(std::size_t i = 0; i < 8; i++){
+        for(std::size_t j = 0; j < 16; j++){
+            pos[j] = (i << 4) + j;
+        }
+        permute(r.v, pos);
+    }
+    for(std::size_t i = 0; i < 8; i++){
+        for(std::size_t j = 0; j < 8; j++){
+            pos[ j << 1     ] = (i << 1) + (j << 4);
+            pos[(j << 1) + 1] = (i << 1) + (j << 4) + 1;
+        }
+        permute(r.v, pos);
+    }
+
+    for(std::size_t i = 0; i < WORDS; i++){
+        out.v[i] = tmp.v[i] ^ r.v[i];
+    }
+}
+
+struct Instance{
+    std::vector <Block> memory;
+    uint32_t passes;
+    uint32_t lanes;
+    uint32_t lane_length;
+    uint32_t segment_length;
+};
+
+// RFC 9106 sec 3.4.2: map J1 to a block in the reference area of J2's lane
+static uint32_t index_alpha(const Instance & inst, const uint32_t pass, const uint32_t slice, const uint32_t index, const uint64_t j1, const bool same_lane){
+    uint32_t area;
+    if (pass == 0){
+        if (slice == 0){
+            area = index - 1;
+        }
+        else if (same_lane){
+            area = slice * inst.segment_length + index - 1;
+        }
+        else{
+            area = slice * inst.segment_length - (index == 0);
+        }
+    }
+    else{
+        if (same_lane){
+            area = inst.lane_length - inst.segment_length + index - 1;
+        }
+        else{
+            area = inst.lane_length - inst.segment_length - (index == 0);
+        }
+    }
+
+    uint64_t relative = (j1 * j1) >> 32;
+    relative = area - 1 - ((area * relative) >> 32);
+
+    const uint32_t start = ((pass == 0) || (slice == SYNC_POINTS - 1))?0:((slice + 1) * inst.segment_length);
+    return (start + relative) % inst.lane_length;
+}
+
+static void fill_segment(Instance & inst, const uint32_t pass, const uint32_t lane, const uint32_t slice){
+    // Argon2id takes the first half of the first pass from Argon2i
+    const bool independent = (pass == 0) && (slice < (SYNC_POINTS >> 1));
+
+    Block zero = {}, input = {}, address = {};
+    input.v[0] = pass;
+    input.v[1] = lane;
+    input.v[2] = slice;
+    input.v[3] = inst.memory.size();
+    input.v[4] = inst.passes;
+    input.v[5] = ARGON2ID;
+
+    const auto next_addresses = [&](){
+        input.v[6]++;
+        compress(zero, input, address, false);
+        compress(zero, address, address, false);
+    };
+
+    // the first two blocks of every lane already exist
+    uint32_t start = 0;
+    if ((pass == 0) && (slice == 0)){
+        start = 2;
+        if (independent){
+            next_addresses();
+        }
+    }
+
+    std::size_t curr = lane * inst.lane_length + slice * inst.segment_length + start;
+    std::size_t prev = (curr % inst.lane_length)?(curr - 1):(curr + inst.lane_length - 1);
+    for(uint32_t i = start; i < inst.segment_length; i++, curr++, prev++){
+        if ((curr % inst.lane_length) == 1){
+            prev = curr - 1;
+        }
+
+        uint64_t rand;
+        if (independent){
+            if ((i % ADDRESSES) == 0){
+                next_addresses();
+            }
+            rand = address.v[i % ADDRESSES];
+        }
+        else{
+            rand = inst.memory[prev].v[0];
+        }
+
+        const uint32_t ref_lane = ((pass == 0) && (slice == 0))?lane:((rand >> 32) % inst.lanes);
+        const uint32_t ref_index = index_alpha(inst, pass, slice, i, rand & 0xffffffff, ref_lane == lane);
+        compress(inst.memory[prev], inst.memory[static_cast <std::size_t> (ref_lane) * inst.lane_length + ref_index], inst.memory[curr], pass != 0);
+    }
+}
+
+std::string argon2id(const std::string & password,
+                     const std::string & salt,
+                     const uint32_t passes,
+                     const uint32_t memory,
+                     const uint32_t lanes,
+                     const uint32_t tag_len,
+                     const std::string & secret,
+                     const std::string & associated,
+                     ThreadPool * pool){
+    if ((lanes < 1) || (lanes > 0xffffff)){
+        throw std::runtime_error("Error: Argon2 needs 1 to 16777215 lanes.");
+    }
+    if (lanes > max_lanes){
+        throw std::runtime_error("Error: Argon2 lane count " + std::to_string(lanes) + " is above the limit of " + std::to_string(max_lanes) + ".");
+    }
+    if (memory > max_memory){
+        throw std::runtime_error("Error: Argon2 memory of " + std::to_string(memory) + " KiB is above the limit of " + std::to_string(max_memory) + " KiB.");
+    }
+    if (passes < 1){
+        throw std::runtime_error("Error: Argon2 needs at least 1 pass.");
+    }
+    if (memory < (8 * lanes)){
+        throw std::runtime_error("Error: Argon2 needs at least 8 KiB of memory per lane.");
+    }
+    if (tag_len < 4){
+        throw std::runtime_error("Error: Argon2 tags are at least 4 octets long.");
+    }
+    if (salt.size() < 8){
+        throw std::runtime_error("Error: Argon2 salts are at least 8 octets long.");
+    }
+
+    // RFC 9106 sec 3.2
+    const std::string h0 = blake2b(le32(lanes) + le32(tag_len) + le32(memory) + le32(passes) + le32(VERSION) + le32(ARGON2ID) +
+                                   le32(password.size()) + password +
+                                   le32(salt.size()) + salt +
+                                   le32(secret.size()) + secret +
+                                   le32(associated.size()) + associated, 64);
+
+    Instance inst;
+    inst.passes = passes;
+    inst.lanes = lanes;
+    inst.segment_length = memory / (lanes * SYNC_POINTS);
+    inst.lane_length = inst.segment_length * SYNC_POINTS;
+    inst.memory.resize(static_cast <std::size_t> (inst.lane_length) * lanes);
+
+    for(uint32_t lane = 0; lane < lanes; lane++){
+        for(uint32_t j = 0; j < 2; j++){
+            const std::string first = hash(h0 + le32(j) + le32(lane), BLOCK_SIZE);
+            Block & block = inst.memory[static_cast <std::size_t> (lane) * inst.lane_length + j];
+            for(std::size_t i = 0; i < WORDS; i++){
+                block.v[i] = load64(reinterpret_cast <const uint8_t *> (first.data()) + (i << 3));
+            }
+        }
+    }
+
+    // lanes only refer to slices of other lanes that are already done,
+    // so each slice can be filled in parallel
+    std::unique_ptr <ThreadPool> own;
+    if ((lanes > 1) && !pool){
+        own.reset(new ThreadPool(std::min(lanes, std::max(std::thread::hardware_concurrency(), 1U))));
+        pool = own.get();
+    }
+
+    for(uint32_t pass = 0; pass < passes; pass++){
+        for(uint32_t slice = 0; slice < SYNC_POINTS; slice++){
+            if (lanes == 1){
+                fill_segment(inst, pass, 0, slice);
+                continue;
+            }
+
+            for(uint32_t lane = 0; lane < lanes; lane++){
+                pool -> submit([&inst, pass, lane, slice](){
+                    fill_segment(inst, pass, lane, slice);
+                });
+            }
+            pool -> wait();
+        }
+    }
+
+    // xor of the last block of every lane
+    Block last = inst.memory[inst.lane_length - 1];
+    for(uint32_t lane = 1; lane < lanes; lane++){
+        const Block & block = inst.memory[static_cast <std::size_t> (lane) * inst.lane_length + inst.lane_length - 1];
+        for(std::size_t i = 0; i < WORDS; i++){
+            last.v[i] ^= block.v[i];
+        }
+    }
+
+    std::string final(BLOCK_SIZE, 0);
+    for(std::size_t i = 0; i < WORDS; i++){
+        store64(reinterpret_cast <uint8_t *> (&final[0]) + (i << 3), last.v[i]);
+    }
+
+    const std::string tag = hash(final, tag_len);
+
+    wipe_memset(inst.memory.data(), 0, inst.memory.size() * sizeof(Block));
+    wipe_memset(&last, 0, sizeof(last));
+    wipe_memset(&final[0], 0, final.size());
+    return tag;
+}
+
+}
+}
@@ -0,0 +1,68 @@
+/*
+argon2.h
+Argon2id memory-hard password hashing - RFC 9106
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_ARGON2__
+#define __OPENPGP_ARGON2__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../common/ThreadPool.h"
+
+namespace OpenPGP {
+    namespace Argon2 {
+        const uint32_t VERSION    = 0x13;
+        const std::size_t BLOCK_SIZE = 1024;    // octets
+
+        // largest parameters argon2id accepts unless told otherwise; S2K
+        // parameters come from packets, so anything larger is refused
+        // before any memory is allocated or any thread is started
+        const uint32_t DEFAULT_MAX_MEMORY = 1U << 20;  // KiB (1 GiB)
+        const uint32_t DEFAULT_MAX_LANES  = 16;
+
+        void set_limits(const uint32_t max_memory, const uint32_t max_lanes);
+        uint32_t get_max_memory();
+        uint32_t get_max_lanes();
+
+        // unkeyed BLAKE2b (RFC 7693) with a digest of 1 to 64 octets
+        std::string blake2b(const std::string & data, const std::size_t len = 64);
+
+        // Argon2id with memory given in KiB; the lanes of each slice are
+        // filled in parallel on pool, or on a pool of up to one thread per
+        // lane that lives for this call if none is given
+        std::string argon2id(const std::string & password,
+                             const std::string & salt,
+                             const uint32_t passes,
+                             const uint32_t memory,
+                             const uint32_t lanes,
+                             const uint32_t tag_len,
+                             const std::string & secret = "",
+                             const std::string & associated = "",
+                             ThreadPool * pool = nullptr);
+    }
+}
+
+#endif
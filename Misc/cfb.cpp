@@ -101,6 +101,58 @@ std::string OpenPGP_CFB_encrypt(const SymAlg::Ptr & crypt, const uint8_t packet,
     return C;
 }
 
+OpenPGP_CFB_Encryptor::OpenPGP_CFB_Encryptor(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & prefix)
+    : crypt(crypt),
+      BS(crypt -> blocksize() >> 3),
+      FR(BS, 0),
+      FRE(crypt -> encrypt(FR)),
+      used(0),
+      pending()
+{
+    if (prefix.size() < (BS + 2)){
+        throw std::runtime_error("Error: Given prefix too short.");
+    }
+
+    if ((packet != Packet::SYMMETRICALLY_ENCRYPTED_DATA) &&
+        (packet != Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA)){
+        throw std::runtime_error("Error: Bad Packet Type");
+    }
+
+    // random data followed by the repeated 2 octets
+    const std::string repeated = prefix.substr(0, BS) + prefix.substr(BS - 2, 2);
+    encrypt(repeated.data(), repeated.size(), pending);
+
+    if (packet == Packet::SYMMETRICALLY_ENCRYPTED_DATA){
+        // resynchronization: FR is loaded with C[3] through C[BS+2]
+        FR = pending.substr(2, BS);
+        FRE = crypt -> encrypt(FR);
+        used = 0;
+    }
+}
+
+void OpenPGP_CFB_Encryptor::encrypt(const char * data, const std::size_t length, std::string & out){
+    out.reserve(out.size() + length);
+    for(std::size_t i = 0; i < length; i++){
+        FR[used] = data[i] ^ FRE[used];
+        out += FR[used];
+        if (++used == BS){
+            FRE = crypt -> encrypt(FR);
+            used = 0;
+        }
+    }
+}
+
+std::string OpenPGP_CFB_Encryptor::update(const std::string & data){
+    return update(data.data(), data.size());
+}
+
+std::string OpenPGP_CFB_Encryptor::update(const char * data, const std::size_t length){
+    std::string out;
+    out.swap(pending);
+    encrypt(data, length, out);
+    return out;
+}
+
 std::string OpenPGP_CFB_decrypt(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & data){
     const std::size_t BS = crypt -> blocksize() >> 3;
 
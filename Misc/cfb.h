@@ -40,6 +40,28 @@ namespace OpenPGP {
     // always returns prefix + 2 octets + cleartext
     std::string use_OpenPGP_CFB_decrypt(const uint8_t sym_alg, const uint8_t packet, const std::string & data, const std::string & key);
 
+    // OpenPGP CFB encryption of data that arrives in pieces
+    // produces the same ciphertext as OpenPGP_CFB_encrypt on the concatenated pieces
+    class OpenPGP_CFB_Encryptor{
+        private:
+            SymAlg::Ptr crypt;
+            std::size_t BS;
+            std::string FR;         // ciphertext of the current block
+            std::string FRE;        // encryption of the previous block
+            std::size_t used;       // octets of FRE already used
+            std::string pending;    // encrypted prefix, returned by the first update
+
+            // encrypts data into out, continuing the current block
+            void encrypt(const char * data, const std::size_t length, std::string & out);
+
+        public:
+            OpenPGP_CFB_Encryptor(const SymAlg::Ptr & crypt, const uint8_t packet, const std::string & prefix);
+
+            // returns the ciphertext of data (and of the prefix on the first call)
+            std::string update(const std::string & data);
+            std::string update(const char * data, const std::size_t length);
+    };
+
     // Standard CFB mode
     std::string normal_CFB_encrypt(const SymAlg::Ptr & crypt, const std::string & data, std::string IV);
     std::string normal_CFB_decrypt(const SymAlg::Ptr & crypt, const std::string & data, std::string IV);
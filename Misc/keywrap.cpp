@@ -0,0 +1,82 @@
+#include "keywrap.h"
+
+namespace OpenPGP {
+
+// default initial value (RFC 3394 sec 2.2.3.1)
+static const std::string IV(8, '\xa6');
+
+// A ^ t, where t is a 64 bit big endian counter
+static void xor_counter(std::string & a, uint64_t t){
+    for(std::size_t i = 8; i-- > 0; t >>= 8){
+        a[i] ^= static_cast <char> (t & 0xff);
+    }
+}
+
+std::string key_wrap(const SymAlg::Ptr & crypt, const std::string & data){
+    if (crypt -> blocksize() != 128){
+        throw std::runtime_error("Error: Key wrap requires a 128 bit block cipher.");
+    }
+
+    if ((data.size() < 16) || (data.size() & 7)){
+        throw std::runtime_error("Error: Key wrap input must be a multiple of 8 octets and at least 16 octets long.");
+    }
+
+    const std::size_t n = data.size() >> 3;
+    std::string a = IV;
+    std::string r = data;
+    for(std::size_t j = 0; j < 6; j++){
+        for(std::size_t i = 0; i < n; i++){
+            const std::string b = crypt -> encrypt(a + r.substr(i << 3, 8));
+            a = b.substr(0, 8);
+            xor_counter(a, n * j + i + 1);
+            r.replace(i << 3, 8, b, 8, 8);
+        }
+    }
+
+    return a + r;
+}
+
+std::string key_unwrap(const SymAlg::Ptr & crypt, const std::string & data){
+    if (crypt -> blocksize() != 128){
+        throw std::runtime_error("Error: Key wrap requires a 128 bit block cipher.");
+    }
+
+    if ((data.size() < 24) || (data.size() & 7)){
+        // "Error: Wrapped key has a bad length.\n";
+        return "";
+    }
+
+    const std::size_t n = (data.size() >> 3) - 1;
+    std::string a = data.substr(0, 8);
+    std::string r = data.substr(8);
+    for(std::size_t j = 6; j-- > 0;){
+        for(std::size_t i = n; i-- > 0;){
+            xor_counter(a, n * j + i + 1);
+            const std::string b = crypt -> decrypt(a + r.substr(i << 3, 8));
+            a = b.substr(0, 8);
+            r.replace(i << 3, 8, b, 8, 8);
+        }
+    }
+
+    // compare without exiting early
+    unsigned char diff = 0;
+    for(std::size_t i = 0; i < 8; i++){
+        diff |= static_cast <unsigned char> (a[i] ^ IV[i]);
+    }
+    if (diff){
+        // "Error: Key unwrap integrity check failed.\n";
+        return "";
+    }
+
+    return r;
+}
+
+std::string use_key_wrap(const uint8_t sym_alg, const std::string & data, const std::string & kek){
+    return key_wrap(Sym::setup(sym_alg, kek), data);
+}
+
+std::string use_key_unwrap(const uint8_t sym_alg, const std::string & data, const std::string & kek){
+    return key_unwrap(Sym::setup(sym_alg, kek), data);
+}
+
+}
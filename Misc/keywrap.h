@@ -0,0 +1,45 @@
+/*
+keywrap.h
+AES Key Wrap - RFC 3394
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_KEYWRAP__
+#define __OPENPGP_KEYWRAP__
+
+#include <stdexcept>
+
+#include "../Encryptions/Encryptions.h"
+
+namespace OpenPGP {
+    // wrap data (a multiple of 8 octets, at least 16) with a 128 bit block cipher
+    std::string key_wrap(const SymAlg::Ptr & crypt, const std::string & data);
+
+    // returns an empty string if the integrity check fails
+    std::string key_unwrap(const SymAlg::Ptr & crypt, const std::string & data);
+
+    // Helper functions
+    std::string use_key_wrap(const uint8_t sym_alg, const std::string & data, const std::string & kek);
+    std::string use_key_unwrap(const uint8_t sym_alg, const std::string & data, const std::string & kek);
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "mpi.h"
 
-#include "../RNG/BBS.h"
+#include <algorithm>
+
+#include "../RNG/Random.h"
 
 namespace OpenPGP {
 
@@ -17,7 +19,13 @@ MPI bintompi(const std::string & bin){
 }
 
 MPI rawtompi(const std::string & raw){
-    return hextompi(hexlify(raw));
+    return rawtompi(raw.data(), raw.size());
+}
+
+MPI rawtompi(const char * raw, const std::size_t len){
+    MPI out;
+    mpz_import(out.get_mpz_t(), len, 1, 1, 0, 0, raw);
+    return out;
 }
 
 std::string mpitohex(const MPI & a){
@@ -37,7 +45,10 @@ std::string mpitobin(const MPI & a){
 }
 
 std::string mpitoraw(const MPI & a){
-    return unhexlify(mpitohex(a));
+    // zero is still written as one octet
+    std::string out(rawsize(a), 0);
+    mpz_export(&out[0], nullptr, 1, 1, 0, 0, a.get_mpz_t());
+    return out;
 }
 
 unsigned long mpitoulong(const MPI & a){
@@ -45,7 +56,11 @@ unsigned long mpitoulong(const MPI & a){
 }
 
 std::size_t bitsize(const MPI &a){
-    return mpitobin(a).size();
+    return mpz_sizeinbase(a.get_mpz_t(), 2);
+}
+
+std::size_t rawsize(const MPI & a){
+    return (bitsize(a) + 7) >> 3;
 }
 
 bool knuth_prime_test(const MPI & a, int test){
@@ -74,6 +89,52 @@ MPI powm(const MPI &base, const MPI &exp, const MPI &mod){
     return ret;
 }
 
+MPI powm_public(const MPI &base, const MPI &exp, const MPI &mod){
+    MPI ret;
+    mpz_powm(ret.get_mpz_t(), base.get_mpz_t(), exp.get_mpz_t(), mod.get_mpz_t());
+    return ret;
+}
+
+// Shamir's trick: both exponents are scanned together, two bits
+// at a time, so the squarings are shared between the two powers
+MPI powm2_public(const MPI &base1, const MPI &exp1, const MPI &base2, const MPI &exp2, const MPI &mod){
+    // table[(i << 2) | j] = base1^i * base2^j
+    MPI a[4] = {1, base1 % mod, 0, 0};
+    MPI b[4] = {1, base2 % mod, 0, 0};
+    for(unsigned int i = 2; i < 4; i++){
+        a[i] = (a[i - 1] * a[1]) % mod;
+        b[i] = (b[i - 1] * b[1]) % mod;
+    }
+
+    MPI table[16];
+    for(unsigned int i = 0; i < 4; i++){
+        for(unsigned int j = 0; j < 4; j++){
+            table[(i << 2) | j] = (a[i] * b[j]) % mod;
+        }
+    }
+
+    std::size_t bits = std::max(bitsize(exp1), bitsize(exp2));
+    bits += bits & 1;
+
+    MPI ret = 1 % mod;
+    for(std::size_t k = bits; k > 0; k -= 2){
+        ret = (ret * ret) % mod;
+        ret = (ret * ret) % mod;
+
+        const unsigned int i = (mpz_tstbit(exp1.get_mpz_t(), k - 1) << 1) | mpz_tstbit(exp1.get_mpz_t(), k - 2);
+        const unsigned int j = (mpz_tstbit(exp2.get_mpz_t(), k - 1) << 1) | mpz_tstbit(exp2.get_mpz_t(), k - 2);
+        if (i | j){
+            ret = (ret * table[(i << 2) | j]) % mod;
+        }
+    }
+
+    if (ret < 0){
+        ret += mod;
+    }
+
+    return ret;
+}
+
 MPI invert(const MPI &a, const MPI &b){
     MPI ret;
     mpz_invert(ret.get_mpz_t(), a.get_mpz_t(), b.get_mpz_t());
@@ -81,40 +142,197 @@ MPI invert(const MPI &a, const MPI &b){
 }
 
 MPI random(unsigned int bits){
-    try{
-        return bintompi(RNG::BBS().rand(bits));
-    } catch (...) {
-        RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
-        return bintompi(RNG::BBS().rand(bits));
-    }
+    // whole octets are drawn, and the bits above the top one are cleared
+    MPI out = rawtompi(RNG::bytes((bits + 7) >> 3));
+    mpz_tdiv_r_2exp(out.get_mpz_t(), out.get_mpz_t(), bits);
+    return out;
 }
 
 // given some value, return the formatted mpi
 std::string write_MPI(const MPI & data){
-    const std::string out = mpitoraw(data);
-    return unhexlify(makehex(bitsize(data), 4)) + out;
+    ByteWriter out(MPI_size(data));
+    write_MPI(data, out);
+    return out.release();
+}
+
+void write_MPI(const MPI & data, ByteWriter & out){
+    out.put16(bitsize(data));
+    mpz_export(out.grow(rawsize(data)), nullptr, 1, 1, 0, 0, data.get_mpz_t());
+}
+
+std::size_t MPI_size(const MPI & data){
+    // 2 octet bit count followed by the value, which is at least 1 octet long
+    return 2 + rawsize(data);
 }
 
 // Read mpi from data, returning mpi value. The position will be updated to the octet after the end of the mpi value
 MPI read_MPI(const std::string & data, std::string::size_type & pos){
+    if ((pos + 2) > data.size()){
+        throw std::out_of_range("Error: MPI position out of range.");
+    }
+
     // get number of bits
-    uint16_t size = (static_cast <uint8_t> (data[pos]) << 8) |
-                     static_cast <uint8_t> (data[pos + 1]);
+    const uint16_t bits = (static_cast <uint8_t> (data[pos]) << 8) |
+                           static_cast <uint8_t> (data[pos + 1]);
     // update position
     pos += 2;
 
-    // pad to nearest 8 bits
-    while (size & 7){
-        size++;
-    }
+    // get number of octets, rounding up to the nearest 8 bits
+    const std::size_t size = (static_cast <std::size_t> (bits) + 7) >> 3;
 
-    // get number of octets
-    size >>= 3;
+    if ((pos + size) > data.size()){
+        throw std::out_of_range("Error: MPI value is shorter than its bit count.");
+    }
 
-    // turn to mpz_class
-    const MPI out = rawtompi(data.substr(pos, size));
+    // import straight from the buffer
+    const MPI out = rawtompi(data.data() + pos, size);
     pos += size;
     return out;
 }
 
-}
\ No newline at end of file
+MPISlices::MPISlices()
+    : raw(),
+      offsets(1, 0),
+      values(std::make_shared <const std::vector <MPI> > ())
+{}
+
+MPISlices::MPISlices(const std::vector <MPI> & m)
+    : raw(),
+      offsets(),
+      values(std::make_shared <const std::vector <MPI> > (m))
+{}
+
+MPISlices::MPISlices(const MPISlices & copy)
+    : raw(copy.raw),
+      offsets(copy.offsets),
+      values(std::atomic_load(&copy.values))
+{}
+
+MPISlices & MPISlices::operator=(const MPISlices & copy){
+    raw = copy.raw;
+    offsets = copy.offsets;
+    values = std::atomic_load(&copy.values);
+    return *this;
+}
+
+void MPISlices::read(const std::string & data, std::string::size_type & pos, const std::size_t count){
+    if (pos > data.size()){
+        throw std::out_of_range("Error: MPI position out of range.");
+    }
+
+    // only find where each MPI starts; the values are left alone
+    const std::string::size_type start = pos;
+    offsets.assign(1, 0);
+    for(std::size_t i = 0; i < count; i++){
+        if ((pos + 2) > data.size()){
+            throw std::out_of_range("Error: MPI position out of range.");
+        }
+        const uint16_t bits = (static_cast <uint8_t> (data[pos]) << 8) |
+                               static_cast <uint8_t> (data[pos + 1]);
+        pos += 2 + ((static_cast <std::size_t> (bits) + 7) >> 3);
+        if (pos > data.size()){
+            throw std::out_of_range("Error: MPI value is shorter than its bit count.");
+        }
+        offsets.push_back(pos - start);
+    }
+
+    raw = ByteSlice(data.substr(start, offsets.back()));
+    values = nullptr;
+}
+
+std::size_t MPISlices::size() const{
+    const std::shared_ptr <const std::vector <MPI> > current = std::atomic_load(&values);
+    return current?current -> size():(offsets.size() - 1);
+}
+
+bool MPISlices::empty() const{
+    return !size();
+}
+
+const std::vector <MPI> & MPISlices::get() const{
+    std::shared_ptr <const std::vector <MPI> > current = std::atomic_load(&values);
+    if (!current){
+        std::vector <MPI> out;
+        out.reserve(offsets.size() - 1);
+        for(std::size_t i = 0; i + 1 < offsets.size(); i++){
+            const std::size_t begin = std::min(offsets[i] + 2, offsets[i + 1]);
+            out.push_back(rawtompi(raw.data() + begin, offsets[i + 1] - begin));
+        }
+
+        // keep whichever conversion was stored first, so references
+        // handed out to other threads stay valid
+        std::shared_ptr <const std::vector <MPI> > built = std::make_shared <const std::vector <MPI> > (std::move(out));
+        if (std::atomic_compare_exchange_strong(&values, &current, built)){
+            current = built;
+        }
+    }
+    return *current;
+}
+
+const MPI & MPISlices::operator[](const std::size_t i) const{
+    return get()[i];
+}
+
+std::size_t MPISlices::bitsize(const std::size_t i) const{
+    const std::shared_ptr <const std::vector <MPI> > current = std::atomic_load(&values);
+    if (current){
+        return OpenPGP::bitsize((*current)[i]);
+    }
+
+    // leading zero octets are not counted
+    std::size_t begin = std::min(offsets[i] + 2, offsets[i + 1]);
+    while ((begin < offsets[i + 1]) && !raw[begin]){
+        begin++;
+    }
+    if (begin == offsets[i + 1]){
+        return 1;
+    }
+
+    std::size_t bits = (offsets[i + 1] - begin - 1) << 3;
+    for(uint8_t top = raw[begin]; top; top >>= 1){
+        bits++;
+    }
+    return bits;
+}
+
+std::string MPISlices::hex(const std::size_t i) const{
+    const std::shared_ptr <const std::vector <MPI> > current = std::atomic_load(&values);
+    if (current){
+        return mpitohex((*current)[i]);
+    }
+
+    std::size_t begin = std::min(offsets[i] + 2, offsets[i + 1]);
+    while ((begin < offsets[i + 1]) && !raw[begin]){
+        begin++;
+    }
+    if (begin == offsets[i + 1]){
+        return "00";
+    }
+    return hexlify(raw.substr(begin, offsets[i + 1] - begin).str());
+}
+
+std::size_t MPISlices::write_size() const{
+    if (!raw.empty()){
+        return raw.size();
+    }
+
+    std::size_t out = 0;
+    for(MPI const & m : get()){
+        out += MPI_size(m);
+    }
+    return out;
+}
+
+void MPISlices::write(ByteWriter & out) const{
+    // values that were read are written back exactly as they were
+    if (!raw.empty()){
+        out.put(raw);
+        return;
+    }
+
+    for(MPI const & m : get()){
+        write_MPI(m, out);
+    }
+}
+
+}
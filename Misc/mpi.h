@@ -27,15 +27,19 @@ THE SOFTWARE.
 #define __MPI__
 
 #include <cstddef>
+#include <memory>
+#include <vector>
 
 #include <gmpxx.h>
 
+#include "../common/ByteWriter.h"
 #include "../common/includes.h"
 
 namespace OpenPGP {
     typedef mpz_class MPI;
 
     MPI rawtompi(const std::string & raw);
+    MPI rawtompi(const char * raw, const std::size_t len);                   // big-endian octets
     MPI hextompi(const std::string & hex);
     MPI dectompi(const std::string & dec);
     MPI bintompi(const std::string & bin);
@@ -48,6 +52,7 @@ namespace OpenPGP {
     unsigned long mpitoulong(const MPI & a);
 
     std::size_t bitsize(const MPI & a);
+    std::size_t rawsize(const MPI & a);                                      // octets mpitoraw will produce
 
     bool knuth_prime_test(const MPI & a, int test);
 
@@ -55,13 +60,51 @@ namespace OpenPGP {
     MPI mpigcd(const MPI & a, const MPI & b);
     MPI nextprime(const MPI & a);
     MPI powm(const MPI & base, const MPI & exp, const MPI & mod);
+    MPI powm_public(const MPI & base, const MPI & exp, const MPI & mod);     // not constant time; only for public values, such as when verifying
+    MPI powm2_public(const MPI & base1, const MPI & exp1, const MPI & base2, const MPI & exp2, const MPI & mod); // base1^exp1 * base2^exp2 mod m; not constant time
     MPI invert(const MPI & a, const MPI & b);
 
     MPI random(unsigned int bits);
 
     std::string write_MPI(const MPI & data);                                 // given some value, return the formatted mpi
+    void write_MPI(const MPI & data, ByteWriter & out);                      // append the formatted mpi to out
+    std::size_t MPI_size(const MPI & data);                                  // number of octets write_MPI will produce
     MPI read_MPI(const std::string & data, std::string::size_type & pos);    // remove mpi from data, returning mpi value. the rest of the data will be returned through pass-by-reference
 
+    // MPIs as they were read from a packet, bit counts included. The octets
+    // are kept as one slice, and the numbers are only built the first time
+    // they are asked for. Listing keys, calculating key IDs, and writing
+    // packets back out never need them.
+    class MPISlices{
+        private:
+            ByteSlice raw;                                                  // formatted MPIs, back to back
+            std::vector <std::size_t> offsets;                              // start of each MPI in raw, followed by the end
+            mutable std::shared_ptr <const std::vector <MPI> > values;      // set once; read and written atomically
+
+        public:
+            MPISlices();
+            MPISlices(const std::vector <MPI> & m);
+            MPISlices(const MPISlices & copy);
+            MPISlices & operator=(const MPISlices & copy);
+
+            // read count MPIs starting at pos; pos is moved past them
+            void read(const std::string & data, std::string::size_type & pos, const std::size_t count);
+
+            std::size_t size() const;
+            bool empty() const;
+
+            // the values, converted on first use
+            const std::vector <MPI> & get() const;
+            const MPI & operator[](const std::size_t i) const;
+
+            // read from the octets without converting them
+            std::size_t bitsize(const std::size_t i) const;
+            std::string hex(const std::size_t i) const;                     // same as mpitohex
+
+            std::size_t write_size() const;                                 // number of octets write will produce
+            void write(ByteWriter & out) const;
+    };
+
 }
 
 #endif
@@ -1,9 +1,12 @@
-MISC_OBJECTS=cfb.o      \
+MISC_OBJECTS=argon2.o   \
+             cfb.o      \
              CRC-24.o   \
+             keywrap.o  \
              mpi.o      \
              pgptime.o  \
              PKCS1.o    \
              radix64.o  \
              s2k.o      \
+             s2kcache.o \
              sigcalc.o  \
              sigtypes.o
@@ -1,78 +1,277 @@
 #include "radix64.h"
 
+#include <cstdint>
+#include <memory>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RADIX64_AVX2
+#include <immintrin.h>
+#endif
+
 namespace OpenPGP {
 
-std::string ascii2radix64(std::string str, const unsigned char char62, const unsigned char char63){
-    std::string out = "", bin = "", pad = "";
-    while (str.size() % 3){
-        str += zero;
-        pad += "=";
-    }
+// decoding table values that are not sextets
+static const uint8_t INVALID = 0xff;
+static const uint8_t SPACE   = 0xfe;
+static const uint8_t PAD     = 0xfd;
+
+struct Radix64Tables{
+    char encode[64];
+    uint8_t decode[256];
 
-    for(char const c : str){
-        bin += makebin(c, 8);
+    Radix64Tables(const unsigned char char62, const unsigned char char63){
+        const char * alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+        for(unsigned int i = 0; i < 62; i++){
+            encode[i] = alphabet[i];
+        }
+        encode[62] = char62;
+        encode[63] = char63;
+
+        for(unsigned int i = 0; i < 256; i++){
+            decode[i] = INVALID;
+        }
+        for(unsigned int c : {' ', '\t', '\r', '\n', '\v', '\f'}){
+            decode[c] = SPACE;
+        }
+        decode[static_cast <unsigned char> ('=')] = PAD;
+        for(unsigned int i = 0; i < 64; i++){
+            decode[static_cast <unsigned char> (encode[i])] = i;
+        }
     }
+};
 
-    std::string::size_type x = 0;
-    while (x < bin.size()){
-        out += ("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789" + std::string(1, char62) + std::string(1, char63))[toint(bin.substr(x, 6), 2)];
-        x += 6;
+// the default alphabet's tables are only built once
+static const Radix64Tables & tables(const unsigned char char62, const unsigned char char63, std::unique_ptr <Radix64Tables> & custom){
+    static const Radix64Tables standard('+', '/');
+    if ((char62 == '+') && (char63 == '/')){
+        return standard;
     }
 
-    if (pad.size() == 2){                       // string length % 3 == 1
-        out = out.substr(0, out.size() - 2);
+    custom.reset(new Radix64Tables(char62, char63));
+    return *custom;
+}
+
+#ifdef RADIX64_AVX2
+static bool has_avx2(){
+    static const bool avx2 = [](){
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }();
+    return avx2;
+}
+
+// W. Mula and D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions". Each 128 bit lane turns 12 octets into 16 characters.
+__attribute__((target("avx2")))
+static std::size_t encode_avx2(const uint8_t * in, const std::size_t len, char * out, const unsigned char char62, const unsigned char char63){
+    // octets b, a, c, b of every group, so each 16 bit half holds two sextets
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    // what to add to a sextet to get its character, indexed as below
+    const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, char62 - 62, char63 - 63, 'A', 0, 0,
+                                             'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, char62 - 62, char63 - 63, 'A', 0, 0);
+
+    std::size_t i = 0;
+    for(; (i + 28) <= len; i += 24, out += 32){
+        const __m256i octets = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i))),
+                                                       _mm_loadu_si128(reinterpret_cast <const __m128i *> (in + i + 12)), 1);
+
+        // split every 3 octets into 4 sextets, one per octet
+        const __m256i in_order = _mm256_shuffle_epi8(octets, shuffle);
+        const __m256i t0 = _mm256_and_si256(in_order, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in_order, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i sextets = _mm256_or_si256(t1, t3);
+
+        // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+        __m256i index = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+        index = _mm256_or_si256(index, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+
+        _mm256_storeu_si256(reinterpret_cast <__m256i *> (out), _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, index)));
     }
 
-    if (pad.size() == 1){                       // string length % 3 == 2
-        out = out.substr(0, out.size() - 1);
+    return i;
+}
+
+// decodes blocks of 32 characters of the default alphabet until one holds
+// anything else; returns the number of characters decoded
+__attribute__((target("avx2")))
+static std::size_t decode_avx2(const uint8_t * in, const std::size_t len, uint8_t * out){
+    // a character is invalid when the bits picked by its nibbles overlap
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+                                            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+
+    // what to add to a character to get its sextet, by high nibble ('/' uses 1)
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+
+    // the 3 octets of each 32 bit word, then the first 6 words
+    const __m256i order = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                           2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i words = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+    const __m256i store = _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+
+    std::size_t i = 0;
+    for(; (i + 32) <= len; i += 32, out += 24){
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast <const __m256i *> (in + i));
+        const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask_2f);
+        const __m256i lo_nibbles = _mm256_and_si256(chars, mask_2f);
+        const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        if (!_mm256_testz_si256(lo, hi)){
+            break;
+        }
+
+        const __m256i eq_2f = _mm256_cmpeq_epi8(chars, mask_2f);
+        const __m256i sextets = _mm256_add_epi8(chars, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+
+        // join pairs of sextets, then pairs of pairs, into 24 bit values
+        const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        const __m256i joined = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i octets = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(joined, order), words);
+        _mm256_maskstore_epi32(reinterpret_cast <int *> (out), store, octets);
     }
 
-    return out + pad;
+    return i;
 }
+#endif
 
-std::string radix642ascii(std::string str, const unsigned char char62, const unsigned char char63){
-    if (str.size() & 3){
-        throw std::runtime_error("Error: Input string length is not a multiple of 4.");
+std::string ascii2radix64(const std::string & str, const unsigned char char62, const unsigned char char63){
+    return ascii2radix64(str.data(), str.size(), char62, char63);
+}
+
+std::string ascii2radix64(const char * data, const std::size_t len, const unsigned char char62, const unsigned char char63){
+    std::unique_ptr <Radix64Tables> custom;
+    const char * table = tables(char62, char63, custom).encode;
+
+    const uint8_t * in = reinterpret_cast <const uint8_t *> (data);
+    std::string out(((len + 2) / 3) << 2, 0);
+    char * o = &out[0];
+
+    std::size_t i = 0;
+    #ifdef RADIX64_AVX2
+    if (has_avx2()){
+        i = encode_avx2(in, len, o, char62, char63);
+        o += (i / 3) << 2;
     }
+    #endif
 
-    std::string bin = "";
+    for(; (i + 3) <= len; i += 3){
+        const uint32_t group = (static_cast <uint32_t> (in[i]) << 16) | (static_cast <uint32_t> (in[i + 1]) << 8) | in[i + 2];
+        *o++ = table[ group >> 18];
+        *o++ = table[(group >> 12) & 63];
+        *o++ = table[(group >>  6) & 63];
+        *o++ = table[ group        & 63];
+    }
 
-    // count padding
-    uint8_t unpad = 0;
-    while (str[str.size() - 1] == '='){
-        unpad++;
-        str = str.substr(0, str.size() - 1);
+    // 1 or 2 octets left are padded with zero bits and '='
+    if (i < len){
+        const uint32_t group = (static_cast <uint32_t> (in[i]) << 16) | (((i + 1) < len)?(static_cast <uint32_t> (in[i + 1]) << 8):0);
+        *o++ = table[ group >> 18];
+        *o++ = table[(group >> 12) & 63];
+        *o++ = ((i + 1) < len)?table[(group >> 6) & 63]:'=';
+        *o++ = '=';
     }
 
-    for(unsigned char c : str){
-        if (('A' <= c) && (c <= 'Z')){
-            bin += makebin(c - 'A', 6);
-        }
-        else if (('a' <= c) && (c <= 'z')){
-            bin += makebin(c - 'G', 6);
-        }
-        else if (('0' <= c) && (c <= '9')){
-            bin += makebin(c + 4, 6);
+    return out;
+}
+
+std::string radix642ascii(const std::string & str, const unsigned char char62, const unsigned char char63){
+    return radix642ascii(str.data(), str.size(), char62, char63);
+}
+
+std::string radix642ascii(const char * data, const std::size_t len, const unsigned char char62, const unsigned char char63){
+    std::unique_ptr <Radix64Tables> custom;
+    const uint8_t * table = tables(char62, char63, custom).decode;
+
+    const uint8_t * in = reinterpret_cast <const uint8_t *> (data);
+    std::string out(((len >> 2) + 1) * 3, 0);
+    uint8_t * o = reinterpret_cast <uint8_t *> (&out[0]);
+
+    uint32_t group = 0;     // sextets of the current group
+    unsigned int have = 0;  // number of sextets in group
+    unsigned int pad = 0;   // number of '=' seen
+    std::size_t i = 0;
+    while (i < len){
+        // between groups, as many whole groups as possible at once
+        if (!have && !pad){
+            #ifdef RADIX64_AVX2
+            if (!custom && has_avx2()){
+                const std::size_t done = decode_avx2(in + i, len - i, o);
+                i += done;
+                o += (done >> 2) * 3;
+            }
+            #endif
+
+            for(; (i + 4) <= len; i += 4){
+                const uint8_t a = table[in[i]], b = table[in[i + 1]], c = table[in[i + 2]], d = table[in[i + 3]];
+                if ((a | b | c | d) & 0xc0){
+                    break;
+                }
+                *o++ = (a << 2) | (b >> 4);
+                *o++ = (b << 4) | (c >> 2);
+                *o++ = (c << 6) | d;
+            }
+
+            if (i == len){
+                break;
+            }
         }
-        else if (c == char62){
-            bin += "111110";
+
+        // one character at a time around white space and padding
+        const unsigned char c = in[i++];
+        const uint8_t value = table[c];
+        if (value == SPACE){
+            continue;
         }
-        else if (c == char63){
-            bin += "111111";
+
+        if (value == PAD){
+            if ((have < 2) || ((have + ++pad) > 4)){
+                throw std::runtime_error("Error: Misplaced Radix64 padding.");
+            }
+            continue;
         }
-        else{
+
+        if ((value == INVALID) || pad){
             throw std::runtime_error("Error: Invalid Radix64 character found: " + std::string(1, c));
         }
+
+        group = (group << 6) | value;
+        if (++have == 4){
+            *o++ = group >> 16;
+            *o++ = group >> 8;
+            *o++ = group;
+            group = 0;
+            have = 0;
+        }
     }
 
-    bin += std::string(unpad * 6, '0');
+    if (pad){
+        if ((have + pad) != 4){
+            throw std::runtime_error("Error: Input string length is not a multiple of 4.");
+        }
 
-    str = "";
-    for(unsigned int x = 0; x < bin.size(); x += 8){
-        str += std::string(1, static_cast <unsigned char> (toint(bin.substr(x, 8), 2)));
+        // the padding bits are dropped
+        group >>= (have == 2)?4:2;
+        if (have == 3){
+            *o++ = group >> 8;
+        }
+        *o++ = group;
+    }
+    else if (have){
+        throw std::runtime_error("Error: Input string length is not a multiple of 4.");
     }
 
-    return str.substr(0, str.size() - unpad);   // remove padding when returning
+    out.resize(o - reinterpret_cast <uint8_t *> (&out[0]));
+    return out;
 }
 
-}
\ No newline at end of file
+}
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #ifndef __RADIX64__
 #define __RADIX64__
 
+#include <cstddef>
 #include <stdexcept>
 #include <string>
 
@@ -94,7 +95,11 @@ namespace OpenPGP {
     //       pad characters (=) are added to the output.
     const unsigned int MAX_LINE_LENGTH = 64;
 
-    std::string ascii2radix64(std::string str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    // encoding works on whole 3 octet groups through a table; with the
+    // default alphabet, 24 octets at a time are encoded with AVX2 when the
+    // processor has it
+    std::string ascii2radix64(const std::string & str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    std::string ascii2radix64(const char * data, const std::size_t len, const unsigned char char62 = '+', const unsigned char char63 = '/');
 
     // 6.4.  Decoding Radix-64
     //
@@ -110,7 +115,12 @@ namespace OpenPGP {
     //    such assurance is possible, however, when the number of octets
     //    transmitted was a multiple of three and no "=" characters are
     //    present.
-    std::string radix642ascii(std::string str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    //
+    // White space, including line breaks, is skipped. With the default
+    // alphabet, 32 characters at a time are decoded with AVX2 when the
+    // processor has it.
+    std::string radix642ascii(const std::string & str, const unsigned char char62 = '+', const unsigned char char63 = '/');
+    std::string radix642ascii(const char * data, const std::size_t len, const unsigned char char62 = '+', const unsigned char char63 = '/');
 
 }
 
@@ -1,5 +1,14 @@
 #include "s2k.h"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "argon2.h"
+
 namespace OpenPGP {
 namespace S2K {
 
@@ -14,6 +23,12 @@ S2K::S2K(uint8_t t)
 
 S2K::~S2K(){}
 
+std::string S2K::raw() const{
+    ByteWriter out(serialized_size());
+    write(out);
+    return out.release();
+}
+
 std::string S2K::write() const{
     return raw();
 }
@@ -57,8 +72,13 @@ std::string S2K0::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + tab + "Hash: " + Hash::NAME.at(hash) + " (hash " + std::to_string(hash) + ")";
 }
 
-std::string S2K0::raw() const{
-    return "\x00" + std::string(1, hash);
+std::size_t S2K0::serialized_size() const{
+    return 2;
+}
+
+void S2K0::write(ByteWriter & out) const{
+    out.put8(0);
+    out.put8(hash);
 }
 
 std::string S2K0::run(const std::string & pass, unsigned int sym_key_len) const{
@@ -100,8 +120,14 @@ std::string S2K1::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + tab + "Salt: " + hexlify(salt);
 }
 
-std::string S2K1::raw() const{
-    return "\x01" + std::string(1, hash) + salt;
+std::size_t S2K1::serialized_size() const{
+    return 2 + salt.size();
+}
+
+void S2K1::write(ByteWriter & out) const{
+    out.put8(1);
+    out.put8(hash);
+    out.put(salt);
 }
 
 std::string S2K1::run(const std::string & pass, unsigned int sym_key_len) const{
@@ -129,10 +155,63 @@ S2K::Ptr S2K1::clone() const{
     return std::make_shared <S2K1> (*this);
 }
 
+const std::size_t S2K3::CHUNK;
+const uint8_t S2K3::DEFAULT_COUNT;
+
 uint32_t S2K3::coded_count(const uint8_t c){
     return (16 + (c & 15)) << ((c >> 4) + S2K3::EXPBIAS);
 }
 
+uint8_t S2K3::calibrate(const uint8_t hash, const std::chrono::milliseconds & target, const unsigned int sym_key_len){
+    typedef std::tuple <uint8_t, std::chrono::milliseconds::rep, unsigned int> Args;
+    static std::mutex mutex;
+    static std::map <Args, uint8_t> calibrated;
+
+    const Args args(hash, target.count(), sym_key_len);
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        std::map <Args, uint8_t>::const_iterator it = calibrated.find(args);
+        if (it != calibrated.end()){
+            return it -> second;
+        }
+    }
+
+    // double the count until a run takes long enough to time reliably;
+    // the timing lock is not held, so other calibrations can go ahead
+    const std::chrono::duration <double> enough = std::min(std::chrono::duration <double> (target) / 4, std::chrono::duration <double> (0.025));
+    const std::string pass(16, 'p');
+    S2K3 s2k;
+    s2k.set_hash(hash);
+    s2k.set_salt(std::string(8, 's'));
+
+    uint8_t c = DEFAULT_COUNT;
+    std::chrono::duration <double> elapsed;
+    while (true){
+        s2k.set_count(c);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        s2k.run(pass, sym_key_len);
+        elapsed = std::chrono::steady_clock::now() - start;
+
+        if ((elapsed >= enough) || (c >= 0xf0)){
+            break;
+        }
+        c += 0x10;
+    }
+
+    // pick the count closest to what the measured rate allows,
+    // but never less than the default
+    const double wanted = coded_count(c) * (std::chrono::duration <double> (target) / std::max(elapsed, std::chrono::duration <double> (1e-9)));
+    uint8_t best = DEFAULT_COUNT;
+    for(unsigned int i = DEFAULT_COUNT + 1; i < 256; i++){
+        if (std::abs(coded_count(i) - wanted) < std::abs(coded_count(best) - wanted)){
+            best = i;
+        }
+    }
+
+    std::lock_guard <std::mutex> lock(mutex);
+    return calibrated.insert(std::make_pair(args, best)).first -> second;
+}
+
 S2K3::S2K3()
     : S2K1(ID::ITERATED_AND_SALTED_S2K),
       count()
@@ -157,22 +236,55 @@ std::string S2K3::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + tab + "Coded Count: " + std::to_string(S2K3::coded_count(count)) + " (count " + std::to_string(count) + ")";
 }
 
-std::string S2K3::raw() const{
-    return "\x03" + std::string(1, hash) + salt + unhexlify(makehex(count, 2));
+std::size_t S2K3::serialized_size() const{
+    return 3 + salt.size();
+}
+
+void S2K3::write(ByteWriter & out) const{
+    out.put8(3);
+    out.put8(hash);
+    out.put(salt);
+    out.put8(count);
 }
 
 std::string S2K3::run(const std::string & pass, unsigned int sym_key_len) const{
-    // get string to hash
-    std::string to_hash = "";
-    while (to_hash.size() < S2K3::coded_count(count)){// coded count is count of octets, not iterations
-        to_hash += salt + pass;
+    const std::string unit = salt + pass;
+    if (unit.empty()){
+        return S2K0::run(pass, sym_key_len);
     }
-    to_hash = to_hash.substr(0, S2K3::coded_count(count));
-    // hash string
+
+    // coded count is count of octets, not iterations; salt + pass is hashed at least once
+    const std::size_t total = std::max(static_cast <std::size_t> (S2K3::coded_count(count)), unit.size());
+
+    // one context per output block, preloaded with 0, 1, 2, ... zero octets
+    const std::size_t digest_len = Hash::LENGTH.at(hash) >> 3;
+    std::vector <std::unique_ptr <MerkleDamgard> > contexts;
+    for(std::size_t i = 0; (i * digest_len) < sym_key_len; i++){
+        contexts.push_back(Hash::instance(hash));
+        contexts.back() -> update(std::string(i, 0));
+    }
+
+    // salt + pass repeated as many whole times as fit in a chunk, so the
+    // repetition carries on across chunks; every context is given each
+    // chunk while it is still in cache
+    std::string chunk;
+    chunk.reserve(std::max(CHUNK, unit.size()));
+    do {
+        chunk += unit;
+    } while ((chunk.size() + unit.size()) <= CHUNK);
+
+    for(std::size_t done = 0; done < total; done += chunk.size()){
+        if ((total - done) < chunk.size()){
+            chunk.resize(total - done);
+        }
+        for(std::unique_ptr <MerkleDamgard> & context : contexts){
+            context -> update(chunk);
+        }
+    }
+
     std::string out = "";
-    unsigned int context = 0;
-    while (out.size() < sym_key_len){
-        out += Hash::use(hash, std::string(context++, 0) + to_hash);
+    for(std::unique_ptr <MerkleDamgard> & context : contexts){
+        out += context -> digest();
     }
     return out.substr(0, sym_key_len);
 }
@@ -189,5 +301,102 @@ S2K::Ptr S2K3::clone() const{
     return std::make_shared <S2K3> (*this);
 }
 
+const std::size_t S2K4::SALT_SIZE;
+
+S2K4::S2K4()
+    : S2K(ID::ARGON2),
+      salt(),
+      passes(3),
+      parallelism(4),
+      memory(16)
+{}
+
+S2K4::~S2K4(){}
+
+void S2K4::read(const std::string & data, std::string::size_type & pos){
+    type        = data[pos];
+    salt        = data.substr(pos + 1, SALT_SIZE);
+    passes      = data[pos + 17];
+    parallelism = data[pos + 18];
+    memory      = data[pos + 19];
+    pos += 20;
+}
+
+std::string S2K4::show(const std::size_t indents, const std::size_t indent_size) const{
+    const std::string indent(indents * indent_size, ' ');
+    const std::string tab(indent_size, ' ');
+    return indent + tab + show_title() + "\n" +
+           indent + tab + tab + "Salt: " + hexlify(salt) + "\n" +
+           indent + tab + tab + "Passes: " + std::to_string(passes) + "\n" +
+           indent + tab + tab + "Parallelism: " + std::to_string(parallelism) + "\n" +
+           indent + tab + tab + "Memory: " + std::to_string(1ULL << memory) + " KiB (encoded " + std::to_string(memory) + ")";
+}
+
+std::size_t S2K4::serialized_size() const{
+    return 4 + salt.size();
+}
+
+void S2K4::write(ByteWriter & out) const{
+    out.put8(4);
+    out.put(salt);
+    out.put8(passes);
+    out.put8(parallelism);
+    out.put8(memory);
+}
+
+std::string S2K4::run(const std::string & pass, unsigned int sym_key_len) const{
+    // at least 8 KiB per lane
+    unsigned int min_memory = 3;
+    while ((1U << (min_memory - 3)) < parallelism){
+        min_memory++;
+    }
+
+    if (!passes || !parallelism || (memory < min_memory) || (memory > 31)){
+        throw std::runtime_error("Error: Bad Argon2 parameters.");
+    }
+
+    return Argon2::argon2id(pass, salt, passes, 1U << memory, parallelism, sym_key_len);
+}
+
+std::string S2K4::get_salt() const{
+    return salt;
+}
+
+uint8_t S2K4::get_passes() const{
+    return passes;
+}
+
+uint8_t S2K4::get_parallelism() const{
+    return parallelism;
+}
+
+uint8_t S2K4::get_memory() const{
+    return memory;
+}
+
+void S2K4::set_salt(const std::string & s){
+    if (s.size() != SALT_SIZE){
+        throw std::runtime_error("Error: Argon2 salt length must be " + std::to_string(SALT_SIZE) + " octets.");
+    }
+
+    salt = s;
+}
+
+void S2K4::set_passes(const uint8_t t){
+    passes = t;
+}
+
+void S2K4::set_parallelism(const uint8_t p){
+    parallelism = p;
+}
+
+void S2K4::set_memory(const uint8_t m){
+    memory = m;
+}
+
+S2K::Ptr S2K4::clone() const{
+    return std::make_shared <S2K4> (*this);
+}
+
 }
 }
\ No newline at end of file
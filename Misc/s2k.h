@@ -26,11 +26,13 @@ THE SOFTWARE.
 #ifndef __S2K__
 #define __S2K__
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <string>
 
 #include "../Hashes/Hashes.h"
+#include "../common/ByteWriter.h"
 
 namespace OpenPGP {
     namespace S2K {
@@ -61,6 +63,7 @@ namespace OpenPGP {
             const uint8_t SIMPLE_S2K              = 0;
             const uint8_t SALTED_S2K              = 1;
             const uint8_t ITERATED_AND_SALTED_S2K = 3;
+            const uint8_t ARGON2                  = 4;
         }
 
         const std::map <uint8_t, std::string> NAME = {
@@ -68,6 +71,7 @@ namespace OpenPGP {
                     std::make_pair(ID::SALTED_S2K,              "Salted S2K"),
                     std::make_pair(2,                           "Reserved value"),
                     std::make_pair(ID::ITERATED_AND_SALTED_S2K, "Iterated and Salted S2K"),
+                    std::make_pair(ID::ARGON2,                  "Argon2"),
                     std::make_pair(100,                         "Private/Experimental S2K"),
                     std::make_pair(101,                         "Private/Experimental S2K"),
                     std::make_pair(102,                         "Private/Experimental S2K"),
@@ -96,7 +100,9 @@ namespace OpenPGP {
                 virtual ~S2K();
                 virtual void read(const std::string & data, std::string::size_type & pos) = 0;
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const = 0;
-                virtual std::string raw() const = 0;
+                virtual std::size_t serialized_size() const = 0;    // number of octets write will produce
+                virtual void write(ByteWriter & out) const = 0;
+                std::string raw() const;
                 std::string write() const;
                 virtual std::string run(const std::string & pass, unsigned int sym_key_len) const = 0;
 
@@ -149,7 +155,9 @@ namespace OpenPGP {
                 virtual ~S2K0();
                 virtual void read(const std::string & data, std::string::size_type & pos);
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                virtual std::string raw() const;
+                virtual std::size_t serialized_size() const;
+                virtual void write(ByteWriter & out) const;
+                using S2K::write;
                 virtual std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 S2K::Ptr clone() const;
@@ -181,7 +189,9 @@ namespace OpenPGP {
                 virtual ~S2K1();
                 virtual void read(const std::string & data, std::string::size_type & pos);
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                virtual std::string raw() const;
+                virtual std::size_t serialized_size() const;
+                virtual void write(ByteWriter & out) const;
+                using S2K::write;
                 virtual std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 std::string get_salt() const;
@@ -230,7 +240,7 @@ namespace OpenPGP {
          class S2K3 : public S2K1 {
             private:
                 static const uint32_t EXPBIAS = 6;
-                static uint32_t coded_count(const uint8_t c);
+                static const std::size_t CHUNK = 65536;     // octets hashed at a time
 
             private:
                 uint8_t count;
@@ -238,11 +248,24 @@ namespace OpenPGP {
             public:
                 typedef std::shared_ptr <S2K3> Ptr;
 
+                static const uint8_t DEFAULT_COUNT = 96;    // 65536 octets
+
+                // number of octets hashed for a coded count
+                static uint32_t coded_count(const uint8_t c);
+
+                // coded count whose run takes closest to target on this
+                // machine, for keys of sym_key_len octets; measured once
+                // per process for each set of arguments and never below
+                // DEFAULT_COUNT
+                static uint8_t calibrate(const uint8_t hash, const std::chrono::milliseconds & target, const unsigned int sym_key_len = 32);
+
                 S2K3();
                 ~S2K3();
                 void read(const std::string & data, std::string::size_type & pos);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write(ByteWriter & out) const;
+                using S2K::write;
                 std::string run(const std::string & pass, unsigned int sym_key_len) const;
 
                 uint8_t get_count() const;
@@ -252,6 +275,72 @@ namespace OpenPGP {
                 S2K::Ptr clone() const;
         };
 
+        // RFC 9580 3.7.1.4. Argon2
+        //
+        //    This S2K method hashes the passphrase using Argon2, as specified in
+        //    [RFC9106]. This provides memory hardness, further protecting the
+        //    passphrase against brute-force attacks.
+        //
+        //        Octet  0:     0x04
+        //        Octets 1-16:  16-octet salt value
+        //        Octet  17:    one-octet number of passes t
+        //        Octet  18:    one-octet degree of parallelism p
+        //        Octet  19:    one-octet encoded_m, specifying the exponent of
+        //                      the memory size
+        //
+        //    The salt SHOULD be unique for each password.
+        //
+        //    The number of passes t and the degree of parallelism p MUST be
+        //    non-zero.
+        //
+        //    The memory size m is 2**encoded_m kibibytes of memory, and the
+        //    encoded_m value MUST be greater than or equal to 3 + ceil(log2(p))
+        //    and less than 32.
+        //
+        //    The Argon2 parameters should be set as follows: Argon2id, version
+        //    0x13, no secret key and no associated data. The output length is
+        //    the length of the key to derive.
+        //
+        //    There is no AEAD in this implementation, so unlike RFC 9580, Argon2
+        //    is accepted wherever an S2K specifier is.
+
+        class S2K4 : public S2K {
+            public:
+                static const std::size_t SALT_SIZE = 16;   // octets
+
+            private:
+                std::string salt;
+                uint8_t passes;
+                uint8_t parallelism;                        // lanes, filled in parallel
+                uint8_t memory;                             // 2^memory KiB
+
+            public:
+                typedef std::shared_ptr <S2K4> Ptr;
+
+                // 3 passes over 64 MiB in 4 lanes
+                S2K4();
+                ~S2K4();
+                void read(const std::string & data, std::string::size_type & pos);
+                std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
+                std::size_t serialized_size() const;
+                void write(ByteWriter & out) const;
+                using S2K::write;
+                // refuses parameters above the Argon2 limits (see Argon2::set_limits)
+                std::string run(const std::string & pass, unsigned int sym_key_len) const;
+
+                std::string get_salt() const;
+                uint8_t get_passes() const;
+                uint8_t get_parallelism() const;
+                uint8_t get_memory() const;
+
+                void set_salt(const std::string & s);
+                void set_passes(const uint8_t t);
+                void set_parallelism(const uint8_t p);
+                void set_memory(const uint8_t m);
+
+                S2K::Ptr clone() const;
+        };
+
         // 3.7.2. String-to-Key Usage
         //
         //    Implementations SHOULD use salted or iterated-and-salted S2K
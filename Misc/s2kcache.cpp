@@ -0,0 +1,194 @@
+#include "s2kcache.h"
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../Hashes/Hashes.h"
+#include "../RNG/Random.h"
+
+namespace OpenPGP {
+namespace S2K {
+namespace Cache {
+
+// memset called through a volatile pointer, so it is not optimized away
+static void * (* const volatile wipe_memset)(void *, int, std::size_t) = std::memset;
+
+// Octets in pages of their own, so unlocking them does not unlock
+// anything else. Locking is best effort: without the privilege to
+// lock memory, the octets are still wiped when released.
+class Locked{
+    private:
+        uint8_t * data;
+        std::size_t len;
+        std::size_t mapped;
+
+    public:
+        Locked(const std::string & str)
+            : data(nullptr),
+              len(str.size()),
+              mapped(0)
+        {
+            const std::size_t page = sysconf(_SC_PAGESIZE);
+            mapped = ((len + page) / page) * page;
+
+            void * mem = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mem == MAP_FAILED){
+                throw std::bad_alloc();
+            }
+            data = static_cast <uint8_t *> (mem);
+
+            mlock(data, mapped);
+            #ifdef MADV_DONTDUMP
+            madvise(data, mapped, MADV_DONTDUMP);   // keep out of core dumps
+            #endif
+
+            std::memcpy(data, str.data(), len);
+        }
+
+        Locked(const Locked & copy) = delete;
+
+        ~Locked(){
+            wipe_memset(data, 0, mapped);
+            munlock(data, mapped);
+            munmap(data, mapped);
+        }
+
+        std::string str() const{
+            return std::string(reinterpret_cast <const char *> (data), len);
+        }
+
+        Locked & operator=(const Locked & copy) = delete;
+};
+
+struct Entry{
+    std::unique_ptr <Locked> key;
+    std::chrono::steady_clock::time_point expires;
+};
+
+// fingerprint -> (S2K parameters + passphrase digest -> derived key)
+typedef std::map <std::string, std::map <std::string, Entry> > Entries;
+
+static std::mutex mutex;
+static Entries entries;
+static std::chrono::seconds lifetime(0);
+static bool on = false;
+static std::unique_ptr <Locked> secret;     // keys the passphrase digests
+
+// remove expired entries; the mutex is held
+static void expire(){
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for(Entries::iterator key = entries.begin(); key != entries.end();){
+        for(std::map <std::string, Entry>::iterator it = key -> second.begin(); it != key -> second.end();){
+            if (it -> second.expires <= now){
+                it = key -> second.erase(it);
+            }
+            else{
+                ++it;
+            }
+        }
+
+        if (key -> second.empty()){
+            key = entries.erase(key);
+        }
+        else{
+            ++key;
+        }
+    }
+}
+
+// S2K parameters followed by the keyed passphrase digest; the mutex is held
+static std::string id(const std::string & params, const std::string & passphrase){
+    if (!secret){
+        secret.reset(new Locked(RNG::bytes(32)));
+    }
+
+    std::unique_ptr <MerkleDamgard> h = Hash::instance(Hash::ID::SHA256);
+    h -> update(secret -> str());
+    h -> update(passphrase);
+    return params + h -> digest();
+}
+
+void enable(const std::chrono::seconds & ttl){
+    std::lock_guard <std::mutex> lock(mutex);
+    lifetime = ttl;
+    on = true;
+    expire();
+}
+
+void disable(){
+    std::lock_guard <std::mutex> lock(mutex);
+    on = false;
+    entries.clear();
+    secret.reset();
+}
+
+bool enabled(){
+    std::lock_guard <std::mutex> lock(mutex);
+    return on;
+}
+
+bool get(const std::string & fingerprint, const std::string & params, const std::string & passphrase, std::string & key){
+    std::lock_guard <std::mutex> lock(mutex);
+    if (!on){
+        return false;
+    }
+
+    expire();
+
+    Entries::const_iterator entry = entries.find(fingerprint);
+    if (entry == entries.end()){
+        return false;
+    }
+
+    std::map <std::string, Entry>::const_iterator it = entry -> second.find(id(params, passphrase));
+    if (it == entry -> second.end()){
+        return false;
+    }
+
+    key = it -> second.key -> str();
+    return true;
+}
+
+void put(const std::string & fingerprint, const std::string & params, const std::string & passphrase, const std::string & key){
+    std::lock_guard <std::mutex> lock(mutex);
+    if (!on){
+        return;
+    }
+
+    expire();
+
+    Entry & entry = entries[fingerprint][id(params, passphrase)];
+    entry.key.reset(new Locked(key));
+    entry.expires = std::chrono::steady_clock::now() + lifetime;
+}
+
+void evict(const std::string & fingerprint){
+    std::lock_guard <std::mutex> lock(mutex);
+    entries.erase(fingerprint);
+}
+
+void clear(){
+    std::lock_guard <std::mutex> lock(mutex);
+    entries.clear();
+}
+
+std::size_t size(){
+    std::lock_guard <std::mutex> lock(mutex);
+    expire();
+
+    std::size_t count = 0;
+    for(Entries::value_type const & entry : entries){
+        count += entry.second.size();
+    }
+    return count;
+}
+
+}
+}
+}
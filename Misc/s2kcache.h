@@ -0,0 +1,67 @@
+/*
+s2kcache.h
+Opt-in cache of keys derived by String-to-Key specifiers
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __S2K_CACHE__
+#define __S2K_CACHE__
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace OpenPGP {
+    namespace S2K {
+        // Keys derived from passphrases, remembered so that a secret key
+        // used over and over only pays for its S2K once. The cache is off
+        // until enabled. Entries are looked up by key fingerprint, the
+        // S2K parameters and a digest of the passphrase keyed with a
+        // per-process secret, so the passphrase itself is never stored.
+        // Derived keys are kept in locked memory that is wiped when an
+        // entry expires, is evicted or the cache is disabled.
+        namespace Cache {
+            // start caching; entries are dropped ttl after they were added
+            void enable(const std::chrono::seconds & ttl);
+
+            // stop caching and wipe every entry
+            void disable();
+
+            bool enabled();
+
+            // returns false if nothing unexpired is cached
+            bool get(const std::string & fingerprint, const std::string & params, const std::string & passphrase, std::string & key);
+
+            // does nothing while the cache is disabled
+            void put(const std::string & fingerprint, const std::string & params, const std::string & passphrase, const std::string & key);
+
+            // wipe the entries of one key, or of all keys
+            void evict(const std::string & fingerprint);
+            void clear();
+
+            // number of unexpired entries
+            std::size_t size();
+        }
+    }
+}
+
+#endif
@@ -3,16 +3,20 @@
 namespace OpenPGP {
 
 std::string addtrailer(const std::string & data, const Packet::Tag2::Ptr & sig){
+    return data + trailer(sig);
+}
+
+std::string trailer(const Packet::Tag2::Ptr & sig){
     if (!sig){
         throw std::runtime_error("Error: No signature packet");
     }
 
-    const std::string trailer = sig -> get_up_to_hashed();
+    const std::string hashed = sig -> get_up_to_hashed();
     if (sig -> get_version() == 3){
-        return data + trailer.substr(1, trailer.size() - 1); // remove version from trailer
+        return hashed.substr(1, hashed.size() - 1); // remove version from trailer
     }
     else if (sig -> get_version() == 4){
-        return data + trailer + "\x04\xff" + unhexlify(makehex(trailer.size(), 8));
+        return hashed + "\x04\xff" + unhexlify(makehex(hashed.size(), 8));
     }
     else{
         throw std::runtime_error("Error: addtrailer for version " + std::to_string(sig -> get_version()) + " not defined.");
@@ -58,6 +62,10 @@ const std::string & binary_to_canonical(const std::string & data){
     return data;
 }
 
+const ByteChain & binary_to_canonical(const ByteChain & data){
+    return data;
+}
+
 std::string to_sign_00(const std::string & data, const Packet::Tag2::Ptr & tag2){
     if (!tag2){
         throw std::runtime_error("Error: No signature packet");
@@ -66,6 +74,16 @@ std::string to_sign_00(const std::string & data, const Packet::Tag2::Ptr & tag2)
     return Hash::use(tag2 -> get_hash(), addtrailer(data, tag2));
 }
 
+std::string to_sign_00(const ByteChain & data, const Packet::Tag2::Ptr & tag2){
+    if (!tag2){
+        throw std::runtime_error("Error: No signature packet");
+    }
+
+    ByteChain hashed = data;
+    hashed.append(ByteSlice(trailer(tag2)));
+    return Hash::use(tag2 -> get_hash(), hashed);
+}
+
 std::string text_to_canonical(const std::string & data){
     // convert line endings to <CR><LF>
     if (!data.size()){
@@ -58,6 +58,9 @@ namespace OpenPGP {
     //    at the end of the Signature packet.
     std::string addtrailer(const std::string & data, const Packet::Tag2::Ptr & sig);
 
+    // the octets addtrailer appends to the data
+    std::string trailer(const Packet::Tag2::Ptr & sig);
+
     // Signature over a Packet::Key
     //
     //    When a signature is made over a Packet::Key, the hash data starts with the
@@ -98,7 +101,9 @@ namespace OpenPGP {
     //    For binary document signatures (type 0x00), the document data is
     //    hashed directly.
     const std::string & binary_to_canonical(const std::string & data);
+    const ByteChain & binary_to_canonical(const ByteChain & data);
     std::string to_sign_00(const std::string & data, const Packet::Tag2::Ptr & tag2);
+    std::string to_sign_00(const ByteChain & data, const Packet::Tag2::Ptr & tag2);   // data is hashed in place
 
     // 0x01: Signature of a canonical text document.
     //    This means the signer owns it, created it, or certifies that it
@@ -37,4 +37,7 @@ THE SOFTWARE.
 #include "generatekey.h"                // generate OpenPGP keys
 #include "revoke.h"                     // revoke OpenPGP keys
 #include "sign.h"                       // sign stuff
-#include "verify.h"                     // verify signatures
\ No newline at end of file
+#include "verify.h"                     // verify signatures
+
+// Input
+#include "common/MappedFile.h"          // memory mapped files
\ No newline at end of file
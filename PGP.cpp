@@ -11,6 +11,35 @@ const PGP::Type_t PGP::MESSAGE_PART_X    = 5; // Used for multi-part messages, w
 const PGP::Type_t PGP::SIGNATURE         = 6; // Used for detached signatures, OpenPGP/MIME signatures, and cleartext signatures. Note that PGP 2.x uses BEGIN PGP MESSAGE for detached signatures.
 const PGP::Type_t PGP::SIGNED_MESSAGE    = 7; // Used for cleartext signatures; header not really part of RFC 4880.
 
+PGP::SliceBuf::SliceBuf(const ByteSlice & data)
+    : std::streambuf()
+{
+    // the get area is never written to
+    char * begin = const_cast <char *> (data.data());
+    setg(begin, begin, begin + data.size());
+}
+
+PGP::SliceBuf::pos_type PGP::SliceBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which){
+    off_type pos = off;
+    if (dir == std::ios_base::cur){
+        pos += gptr() - eback();
+    }
+    else if (dir == std::ios_base::end){
+        pos += egptr() - eback();
+    }
+
+    if (!(which & std::ios_base::in) || (pos < 0) || (pos > (egptr() - eback()))){
+        return pos_type(off_type(-1));
+    }
+
+    setg(eback(), eback() + pos, egptr());
+    return pos_type(pos);
+}
+
+PGP::SliceBuf::pos_type PGP::SliceBuf::seekpos(pos_type pos, std::ios_base::openmode which){
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
 const std::string PGP::ASCII_Armor_Header[] = {
    "",                  // Unknown type
    "MESSAGE",           // Used for signed, encrypted, or compressed files.
@@ -44,171 +73,126 @@ unsigned int PGP::partialBodyLen(uint8_t first_octet) const{
     return 1 << (first_octet & 0x1f);
 }
 
-uint8_t PGP::read_packet_header(const std::string & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const{
+// binary data starts with a packet tag, which never looks like text
+static bool is_binary(const int ctb){
+    return ((ctb != std::char_traits <char>::eof()) &&
+            (ctb & 0x80) &&
+            Packet::NAME.count((ctb & 0x40)?(ctb & 63):((ctb >> 2) & 15)));
+}
+
+// big endian value of the n octets of data starting at pos
+static std::size_t read_length(const ByteSlice & data, const std::string::size_type pos, const uint8_t n){
+    if ((pos + n) > data.size()){
+        throw std::runtime_error("Error: Not enough data to read packet length.");
+    }
+
+    std::size_t out = 0;
+    for(uint8_t i = 0; i < n; i++){
+        out = (out << 8) | static_cast <uint8_t> (data[pos + i]);
+    }
+    return out;
+}
+
+uint8_t PGP::read_packet_header(const ByteSlice & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const{
     uint8_t ctb = data[pos];                                        // Name "ctb" came from Version 2 [RFC 1991]
     format = ctb & 0x40;                                            // get packet length type (OLD = false; NEW = true)
     length = 0;
     tag = 0;                                                        // default value (error)
+    partial = 0;
 
-    if (!partial){                                                  // if partial continue packets have not been found
-        if (!(ctb & 0x80)){
-           throw std::runtime_error("Error: First bit of packet header MUST be 1.");
-        }
+    if (!(ctb & 0x80)){
+       throw std::runtime_error("Error: First bit of packet header MUST be 1.");
+    }
 
-        if (!format){                                               // Old length type RFC4880 sec 4.2.1
-            tag = (ctb >> 2) & 15;                                  // get tag value
-            if ((ctb & 3) == 0){                                    // 0 - The packet has a one-octet length. The header is 2 octets long.
-                length = static_cast <uint8_t> (data[pos + 1]);
-                pos += 2;
-            }
-            else if ((ctb & 3) == 1){                               // 1 - The packet has a two-octet length. The header is 3 octets long.
-                length = toint(data.substr(pos + 1, 2), 256);
-                pos += 3;
-            }
-            else if ((ctb & 3) == 2){                               // 2 - The packet has a four-octet length. The header is 5 octets long.
-                length = toint(data.substr(pos + 2, 4), 256);
-                pos += 6;
-            }
-            else if ((ctb & 3) == 3){                               // The packet is of indeterminate length. The header is 1 octet long, and the implementation must determine how long the packet is.
-                partial = 1;                                        // set to partial start
-                length = data.size() - pos - 1;                     // header is one octet long
-                pos += 1;
-            }
+    if (!format){                                                   // Old length type RFC4880 sec 4.2.1
+        tag = (ctb >> 2) & 15;                                      // get tag value
+        if ((ctb & 3) == 0){                                        // 0 - The packet has a one-octet length. The header is 2 octets long.
+            length = read_length(data, pos + 1, 1);
+            pos += 2;
         }
-        else{                                                       // New length type RFC4880 sec 4.2.2
-            tag = ctb & 63;                                         // get tag value
-            const uint8_t first_octet = static_cast <unsigned char> (data[pos + 1]);
-            if (first_octet < 192){                                 // 0 - 191; A one-octet Body Length header encodes packet lengths of up to 191 octets.
-                length = first_octet;
-                pos += 2;
-            }
-            else if ((192 <= first_octet) & (first_octet < 223)){   // 192 - 8383; A two-octet Body Length header encodes packet lengths of 192 to 8383 octets.
-                length = toint(data.substr(pos + 1, 2), 256) - (192 << 8) + 192;
-                pos += 3;
-            }
-            else if (first_octet == 255){                           // 8384 - 4294967295; A five-octet Body Length header encodes packet lengths of up to 4,294,967,295 (0xFFFFFFFF) octets in length.
-                length = toint(data.substr(pos + 2, 4), 256);
-                pos += 6;
-            }
-            else if (224 <= first_octet){                           // unknown; When the length of the packet body is not known in advance by the issuer, Partial Body Length headers encode a packet of indeterminate length, effectively making it a stream.
-                partial = 1;                                        // set to partial start
-                length = partialBodyLen(first_octet);
-                pos += 1;
-            }
+        else if ((ctb & 3) == 1){                                   // 1 - The packet has a two-octet length. The header is 3 octets long.
+            length = read_length(data, pos + 1, 2);
+            pos += 3;
         }
-    }
-    else{ // partial continue
-        partial = 2;                                                // set to partial continue
-        tag = 254;                                                  // set to partial body tag
-
-        if (!format){                                               // Old length type RFC4880 sec 4.2.1
-            length = data.size() - pos - 1;                         // header is one octet long
+        else if ((ctb & 3) == 2){                                   // 2 - The packet has a four-octet length. The header is 5 octets long.
+            length = read_length(data, pos + 1, 4);
+            pos += 5;
         }
-        else{                                                       // New length type RFC4880 sec 4.2.2
-            length = partialBodyLen(data[pos + 1]);
+        else if ((ctb & 3) == 3){                                   // The packet is of indeterminate length. The header is 1 octet long, and the implementation must determine how long the packet is.
+            partial = 1;
+            length = data.size() - pos - 1;                         // header is one octet long
+            pos += 1;
         }
-
-        pos += 1;                                                   // header is one octet long
+    }
+    else{                                                           // New length type RFC4880 sec 4.2.2
+        tag = ctb & 63;                                             // get tag value
+        pos += 1;
+        length = read_body_length(data, pos, partial);
     }
 
     return tag;
 }
 
-Packet::Tag::Ptr PGP::read_packet_raw(const bool format, const uint8_t tag, uint8_t & partial, const std::string & data, std::string::size_type & pos, const std::string::size_type & length) const{
-    Packet::Tag::Ptr out;
-    if (partial > 1){
-        out = std::make_shared <Packet::Partial> ();
+std::size_t PGP::read_body_length(const ByteSlice & data, std::string::size_type & pos, uint8_t & partial) const{
+    const uint8_t first_octet = read_length(data, pos, 1);
+    std::size_t length = 0;
+    partial = 0;
+    if (first_octet < 192){                                         // 0 - 191; A one-octet Body Length header encodes packet lengths of up to 191 octets.
+        length = first_octet;
+        pos += 1;
     }
-    else{
-        if (tag == Packet::RESERVED){
-            throw std::runtime_error("Error: Tag number MUST NOT be 0.");
-        }
-        else if (tag == Packet::PUBLIC_KEY_ENCRYPTED_SESSION_KEY){
-            out = std::make_shared <Packet::Tag1> ();
-        }
-        else if (tag == Packet::SIGNATURE){
-            out = std::make_shared <Packet::Tag2> ();
-        }
-        else if (tag == Packet::SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY){
-            out = std::make_shared <Packet::Tag3> ();
-        }
-        else if (tag == Packet::ONE_PASS_SIGNATURE){
-            out = std::make_shared <Packet::Tag4> ();
-        }
-        else if (tag == Packet::SECRET_KEY){
-            out = std::make_shared <Packet::Tag5> ();
-        }
-        else if (tag == Packet::PUBLIC_KEY){
-            out = std::make_shared <Packet::Tag6> ();
-        }
-        else if (tag == Packet::SECRET_SUBKEY){
-            out = std::make_shared <Packet::Tag7> ();
-        }
-        else if (tag == Packet::COMPRESSED_DATA){
-            out = std::make_shared <Packet::Tag8> ();
-        }
-        else if (tag == Packet::SYMMETRICALLY_ENCRYPTED_DATA){
-            out = std::make_shared <Packet::Tag9> ();
-        }
-        else if (tag == Packet::MARKER_PACKET){
-            out = std::make_shared <Packet::Tag10> ();
-        }
-        else if (tag == Packet::LITERAL_DATA){
-            out = std::make_shared <Packet::Tag11> ();
-        }
-        else if (tag == Packet::TRUST){
-            out = std::make_shared <Packet::Tag12> ();
-        }
-        else if (tag == Packet::USER_ID){
-            out = std::make_shared <Packet::Tag13> ();
-        }
-        else if (tag == Packet::PUBLIC_SUBKEY){
-            out = std::make_shared <Packet::Tag14> ();
-        }
-        else if (tag == Packet::USER_ATTRIBUTE){
-            out = std::make_shared <Packet::Tag17> ();
-        }
-        else if (tag == Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA){
-            out = std::make_shared <Packet::Tag18> ();
-        }
-        else if (tag == Packet::MODIFICATION_DETECTION_CODE){
-            out = std::make_shared <Packet::Tag19> ();
-        }
-        else if (tag == 60){
-            out = std::make_shared <Packet::Tag60> ();
-        }
-        else if (tag == 61){
-            out = std::make_shared <Packet::Tag61> ();
-        }
-        else if (tag == 62){
-            out = std::make_shared <Packet::Tag62> ();
-        }
-        else if (tag == 63){
-            out = std::make_shared <Packet::Tag63> ();
+    else if (first_octet < 224){                                    // 192 - 8383; A two-octet Body Length header encodes packet lengths of 192 to 8383 octets.
+        length = read_length(data, pos, 2) - (192 << 8) + 192;
+        pos += 2;
+    }
+    else if (first_octet == 255){                                   // 8384 - 4294967295; A five-octet Body Length header encodes packet lengths of up to 4,294,967,295 (0xFFFFFFFF) octets in length.
+        length = read_length(data, pos + 1, 4);
+        pos += 5;
+    }
+    else{                                                           // unknown; When the length of the packet body is not known in advance by the issuer, Partial Body Length headers encode a packet of indeterminate length, effectively making it a stream.
+        partial = 1;
+        length = partialBodyLen(first_octet);
+        pos += 1;
+    }
+    return length;
+}
+
+ByteChain PGP::read_packet_body(const ByteSlice & data, std::string::size_type & pos, std::string::size_type length, const bool format, const uint8_t partial) const{
+    ByteChain body;
+    bool more = format && partial;                                  // only new format lengths have more chunks
+    while (true){
+        if ((pos + length) > data.size()){
+            throw std::runtime_error("Error: Not enough data to read packet body.");
         }
-        else{
-            throw std::runtime_error("Error: Tag not defined: " + std::to_string(tag) + ".");
+
+        body.append(data.substr(pos, length));                      // no copy; the packet shares data
+        pos += length;
+
+        if (!more){
+            break;
         }
+
+        uint8_t next = 0;
+        length = read_body_length(data, pos, next);                 // each chunk has its own length; the last one is not partial
+        more = next;
     }
+    return body;
+}
+
+Packet::Tag::Ptr PGP::read_packet_raw(const bool format, const uint8_t tag, const uint8_t partial, const ByteChain & body) const{
+    Packet::Tag::Ptr out = Packet::create(tag);
 
     // fill in data
     out -> set_tag(tag);
     out -> set_format(format);
     out -> set_partial(partial);
-    out -> set_size(length);
-    out -> read(data.substr(pos, length));
-
-    // update position to end of packet
-    pos += length;
-
-    if (partial){
-        partial = 2;
-    }
+    out -> set_size(body.size());
+    out -> read(body);
 
     return out;
 }
 
-Packet::Tag::Ptr PGP::read_packet(const std::string & data, std::string::size_type & pos, uint8_t & partial) const{
+Packet::Tag::Ptr PGP::read_packet(const ByteSlice & data, std::string::size_type & pos) const{
     if (pos >= data.size()){
         return nullptr;
     }
@@ -216,10 +200,11 @@ Packet::Tag::Ptr PGP::read_packet(const std::string & data, std::string::size_ty
     // set in read_packet_header, used in read_packet_raw
     bool format;
     uint8_t tag = 0;
+    uint8_t partial = 0;
     std::string::size_type length;
 
     read_packet_header(data, pos, length, tag, format, partial);    // pos is moved past header
-    return read_packet_raw(format, tag, partial, data, pos, length);
+    return read_packet_raw(format, tag, partial, read_packet_body(data, pos, length, format, partial));
 }
 
 std::string PGP::format_string(std::string data, uint8_t line_length) const{
@@ -256,14 +241,51 @@ PGP::PGP(std::istream & stream)
     read(stream);
 }
 
+PGP::PGP(const ByteSlice & data)
+    : PGP()
+{
+    read(data);
+}
+
 PGP::~PGP(){}
 
 void PGP::read(const std::string & data){
+    if (data.size() && is_binary(static_cast <uint8_t> (data[0]))){
+        read_raw(data);
+
+        armored = false;
+        type = UNKNOWN;
+        return;
+    }
+
     std::stringstream s(data);
     read(s);
 }
 
+void PGP::read(const ByteSlice & data){
+    if (data.size() && is_binary(static_cast <uint8_t> (data[0]))){
+        read_raw(data);
+
+        armored = false;
+        type = UNKNOWN;
+        return;
+    }
+
+    SliceBuf buf(data);
+    std::istream stream(&buf);
+    read(stream);
+}
+
 void PGP::read(std::istream & stream){
+    // binary data can be parsed as it is read instead of searching it for armor
+    if (is_binary(stream.peek())){
+        read_raw(stream);
+
+        armored = false;
+        type = UNKNOWN;
+        return;
+    }
+
     // find armor header
     //
     // 6.2. Forming ASCII Armor
@@ -327,57 +349,57 @@ void PGP::read(std::istream & stream){
             keys.push_back(Armor_Key(key, value));
         }
 
-        // read up to tail
-        std::string body;
-        while (std::getline(stream, line) && (line.substr(0, 13) != "-----END PGP ")){
-            body += line;
-        }
+        // decode up to tail, parsing packets as they are decoded
+        ArmorReader body(stream);
+        PacketReader reader(body);
+        read_raw(reader);
 
         // check for a checksum
-        if (body[body.size() - 5] == '='){
-            uint32_t checksum = toint(radix642ascii(body.substr(body.size() - 4, 4)), 256);
-            body = radix642ascii(body.substr(0, body.size() - 5));
-            // check if the checksum is correct
-            if (crc24(body) != checksum){
-                std::cerr << "Warning: Given checksum does not match calculated value." << std::endl;
-            }
-        }
-        else{
-            body = radix642ascii(body);
+        if (!body.has_checksum()){
             std::cerr << "Warning: No checksum found." << std::endl;
         }
-
-        // parse data
-        read_raw(body);
+        // check if the checksum is correct
+        else if (!body.checksum_matches()){
+            std::cerr << "Warning: Given checksum does not match calculated value." << std::endl;
+        }
 
         armored = true;
     }
 }
 
 void PGP::read_raw(const std::string & data){
+    read_raw(ByteSlice(data));
+}
+
+void PGP::read_raw(const ByteSlice & data){
     packets.clear();
 
     // read each packet
-    uint8_t partial = 0;
     std::string::size_type pos = 0;
     while (pos < data.size()){
-        Packet::Tag::Ptr packet = read_packet(data, pos, partial);
+        Packet::Tag::Ptr packet = read_packet(data, pos);
         if (packet){
             packets.push_back(packet);
         }
     }
 
-    if (packets.size()){
-        if (partial){                         // last packet must have been a partial packet
-            packets.back() -> set_partial(3); // set last partial packet to partial end
-        }
-    }
-
     armored = false;                          // assume data was not armored, since it was submitted through this function
 }
 
 void PGP::read_raw(std::istream & stream){
-    read_raw(std::string(std::istreambuf_iterator <char> (stream), {}));
+    PacketReader reader(stream);
+    read_raw(reader);
+}
+
+void PGP::read_raw(PacketReader & reader){
+    packets.clear();
+
+    // read each packet
+    while (Packet::Tag::Ptr packet = reader.read_packet()){
+        packets.push_back(packet);
+    }
+
+    armored = false;                          // assume data was not armored, since it was submitted through this function
 }
 
 std::string PGP::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -389,27 +411,46 @@ std::string PGP::show(const std::size_t indents, const std::size_t indent_size)
 }
 
 std::string PGP::raw(const Packet::Tag::Format header) const{
-    std::string out = "";
+    std::size_t length = 0;
     for(Packet::Tag::Ptr const & p : packets){
-        out += p -> write(header);
+        length += p -> write_size(header);
     }
-    return out;
+
+    ByteWriter out(length);
+    for(Packet::Tag::Ptr const & p : packets){
+        p -> write(out, header);
+    }
+    return out.release();
 }
 
 std::string PGP::write(const PGP::Armored armor, const Packet::Tag::Format header) const{
-    const std::string packet_string = raw(header);  // raw PGP data = binary, no ASCII headers
+    std::ostringstream out;
+    write(out, armor, header);
+    return out.str();
+}
 
+void PGP::write(std::ostream & out, const PGP::Armored armor, const Packet::Tag::Format header) const{
     if ((armor == Armored::NO)                   || // no armor
         ((armor == Armored::DEFAULT) && !armored)){ // or use stored value, and stored value is no
-        return packet_string;
+        for(Packet::Tag::Ptr const & p : packets){
+            out << p -> write(header);
+        }
+        return;
     }
 
-    std::string out = "-----BEGIN PGP " + ASCII_Armor_Header[type] + "-----\n";
+    out << "-----BEGIN PGP " << ASCII_Armor_Header[type] << "-----\n";
     for(Armor_Key const & key : keys){
-        out += key.first + ": " + key.second + "\n";
+        out << key.first << ": " << key.second << "\n";
+    }
+    out << "\n";
+
+    ArmorWriter body(out);
+    for(Packet::Tag::Ptr const & p : packets){
+        body << p -> write(header);
     }
+    body.close();
 
-    return out + "\n" + format_string(ascii2radix64(packet_string), MAX_LINE_LENGTH) + "=" + ascii2radix64(unhexlify(makehex(crc24(packet_string), 6))) +  "\n-----END PGP " + ASCII_Armor_Header[type] + "-----\n";
+    out << "-----END PGP " << ASCII_Armor_Header[type] << "-----\n";
 }
 
 bool PGP::get_armored() const{
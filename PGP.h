@@ -27,8 +27,10 @@ THE SOFTWARE.
 #define __OPENPGP_BASE__
 
 #include <memory>
+#include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
 #include <vector>
 #include <utility>
@@ -37,6 +39,9 @@ THE SOFTWARE.
 #include "Misc/radix64.h"
 #include "Packets/packets.h"
 #include "common/includes.h"
+#include "ArmorReader.h"
+#include "ArmorWriter.h"
+#include "PacketReader.h"
 
 namespace OpenPGP {
     class PGP {
@@ -65,6 +70,17 @@ namespace OpenPGP {
             typedef std::vector <Armor_Key> Armor_Keys;
             typedef std::vector <Packet::Tag::Ptr> Packets;
 
+        private:
+            // reads a ByteSlice in place
+            class SliceBuf : public std::streambuf {
+                protected:
+                    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in);
+                    pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in);
+
+                public:
+                    SliceBuf(const ByteSlice & data);
+            };
+
         protected:
             bool armored;                                   // default true
             Type_t type;                                    // what type of key is this
@@ -76,14 +92,20 @@ namespace OpenPGP {
 
             // figures out where packet data starts and updates pos arguments
             // length, tag, format and partial arguments also filled
-            uint8_t read_packet_header(const std::string & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const;
+            // partial is set to 1 if length is the first partial body length or an indeterminate length
+            uint8_t read_packet_header(const ByteSlice & data, std::string::size_type & pos, std::string::size_type & length, uint8_t & tag, bool & format, uint8_t & partial) const;
+
+            // reads a new format body length at pos and moves pos past it
+            std::size_t read_body_length(const ByteSlice & data, std::string::size_type & pos, uint8_t & partial) const;
+
+            // collects a packet body starting at pos; partial bodies are chained, not copied
+            ByteChain read_packet_body(const ByteSlice & data, std::string::size_type & pos, std::string::size_type length, const bool format, const uint8_t partial) const;
 
             // parses raw packet data
-            Packet::Tag::Ptr read_packet_raw(const bool format, const uint8_t tag, uint8_t & partial, const std::string & data, std::string::size_type & pos, const std::string::size_type & length) const;
+            Packet::Tag::Ptr read_packet_raw(const bool format, const uint8_t tag, const uint8_t partial, const ByteChain & body) const;
 
-            // parse packet with header; wrapper for read_packet_header and read_packet_raw
-            // partial should be initialized with 0
-            Packet::Tag::Ptr read_packet(const std::string & data, std::string::size_type & pos, uint8_t & partial) const;
+            // parse packet with header; wrapper for read_packet_header, read_packet_body and read_packet_raw
+            Packet::Tag::Ptr read_packet(const ByteSlice & data, std::string::size_type & pos) const;
 
             // modifies output string so each line is no longer than MAX_LINE_SIZE long
             std::string format_string(std::string data, uint8_t line_length = MAX_LINE_LENGTH) const;
@@ -95,19 +117,24 @@ namespace OpenPGP {
             PGP(const PGP & copy);                          // clone another PGP instance
             PGP(const std::string & data);
             PGP(std::istream & stream);
+            PGP(const ByteSlice & data);
             ~PGP();
 
             // Read ASCII Header + Base64 data
             void read(const std::string & data);
             void read(std::istream & stream);
+            void read(const ByteSlice & data);              // binary data is kept as slices of data; armor is read in place
 
             // Read Binary data
             void read_raw(const std::string & data);
+            void read_raw(const ByteSlice & data);          // packets keep slices of data instead of copies
             void read_raw(std::istream & stream);
+            void read_raw(PacketReader & reader);           // reads packets one at a time; partial bodies are chained
 
             virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;   // display information; indents is used to tab the output if desired
             virtual std::string raw(const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;               // write packets only; header is for writing default (0), old (1) or new (2) header formats
             virtual std::string write(const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const;
+            virtual void write(std::ostream & out, const Armored armor = DEFAULT, const Packet::Tag::Format header = Packet::Tag::Format::DEFAULT) const; // one packet in memory at a time
 
             // Accessors
             bool get_armored()              const;
@@ -4,27 +4,24 @@ namespace OpenPGP {
 namespace PKA {
 namespace DSA {
 
-Values new_public(const uint32_t & L, const uint32_t & N){
+Values new_public(const uint32_t & L, const uint32_t & N, ThreadPool * pool){
 //    L = 1024, N = 160
 //    L = 2048, N = 224
 //    L = 2048, N = 256
 //    L = 3072, N = 256
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
-
     // random prime q
-    MPI q = bintompi("1" + RNG::BBS().rand(N - 1));
-    q = nextprime(q);
-    while (bitsize(q) > N){
-        q = bintompi("1" + RNG::BBS().rand(N - 1));
-        q = nextprime(q);
-    }
+    const MPI q = Prime::random(N, pool);
 
     // random prime p = kq + 1
-    MPI p = bintompi("1" + RNG::BBS().rand(L - 1));                   // pick random starting point
-    p = ((p - 1) / q) * q + 1;                                        // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
-    while (!knuth_prime_test(p, 25)){
-        p += q;
-    }
+    MPI p;
+    do {
+        p = random(L - 1) | (MPI(1) << (L - 1));                      // pick random starting point
+        p = ((p - 1) / q) * q + 1;                                    // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
+        if ((p & 1) == 0){                                            // only odd k give even p, so skip them
+            p += q;
+        }
+        p = Prime::next(p, q << 1, pool);
+    } while (bitsize(p) > L);
 
     // generator g with order q
     MPI g = 1, h = 1;
@@ -38,15 +35,13 @@ Values new_public(const uint32_t & L, const uint32_t & N){
 }
 
 Values keygen(Values & pub){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
-
     MPI x = 0;
     std::string test = "testing testing 123"; // a string to test the key with, just in case the key doesn't work for some reason
     unsigned int bits = bitsize(pub[1]) - 1;
     while (true){
         // 0 < x < q
         while ((x == 0) || (pub[1] <= x)){
-            x = bintompi(RNG::BBS().rand(bits));
+            x = random(bits);
         }
 
         // y = g^x mod p
@@ -72,7 +67,15 @@ Values keygen(Values & pub){
 }
 
 Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
+    return sign(data, pri, pub, ModExpContext::Ptr(), k);
+}
+
+Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k){
+    return sign(data, pri, pub, ModExpContext::Ptr(), k);
+}
+
+Values sign(const MPI & data, const Values & pri, const Values & pub, const ModExpContext::Ptr & context, MPI k){
+    const bool fixed = usable(context, pub[0], {pub[2], pub[3]});
 
     bool set_k = (k == 0);
 
@@ -80,12 +83,12 @@ Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k){
     while ((r == 0) || (s == 0)){
         // 0 < k < q
         if ( set_k ) {
-            k = bintompi(RNG::BBS().rand(bitsize(pub[1])));
+            k = random(bitsize(pub[1]));
             k %= pub[1];
         }
 
         // r = (g^k mod p) mod q
-        r = powm(pub[2], k, pub[0]);
+        r = fixed?context -> powm(0, k):powm(pub[2], k, pub[0]);
         r %= pub[1];
 
         // if r == 0, don't bother calculating s
@@ -102,12 +105,11 @@ Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k){
     return {r, s};
 }
 
-Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k){
-    MPI m(hexlify(data), 16);
-    return sign(rawtompi(data), pri, pub, k);
+Values sign(const std::string & data, const Values & pri, const Values & pub, const ModExpContext::Ptr & context, MPI k){
+    return sign(rawtompi(data), pri, pub, context, k);
 }
 
-bool verify(const MPI & data, const Values & sig, const Values & pub){
+bool verify(const MPI & data, const Values & sig, const Values & pub, const ModExpContext::Ptr & context){
     // 0 < r < q or 0 < s < q
     if (!((0 < sig[0]) && (sig[0] < pub[1])) & !((0 < sig[0]) && (sig[1] < pub[1]))){
         return false;
@@ -122,16 +124,20 @@ bool verify(const MPI & data, const Values & sig, const Values & pub){
     MPI u2 = (sig[0] * w) % pub[1];
 
     // v = ((g ^ u1 * y ^ u2) mod p) mod q
-    MPI g, y;
-    g = powm(pub[2], u1, pub[0]);
-    y = powm(pub[3], u2, pub[0]);
+    MPI v;
+    if (usable(context, pub[0], {pub[2], pub[3]})){
+        v = context -> powm2_public(u1, u2);
+    }
+    else{
+        v = powm2_public(pub[2], u1, pub[3], u2, pub[0]);
+    }
 
     // check v == r
-    return ((((g * y) % pub[0]) % pub[1]) == sig[0]);
+    return ((v % pub[1]) == sig[0]);
 }
 
-bool verify(const std::string & data, const Values & sig, const Values & pub){
-    return verify(rawtompi(data), sig, pub);
+bool verify(const std::string & data, const Values & sig, const Values & pub, const ModExpContext::Ptr & context){
+    return verify(rawtompi(data), sig, pub, context);
 }
 
 }
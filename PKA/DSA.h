@@ -30,24 +30,29 @@ THE SOFTWARE.
 #include "../common/includes.h"
 #include "../Misc/mpi.h"
 #include "../Misc/pgptime.h"
+#include "ModExp.h"
 #include "PKA.h"
+#include "Prime.h"
 
 namespace OpenPGP {
     namespace PKA {
         namespace DSA{
             // Generate new set of parameters
-            Values new_public(const uint32_t & L = 2048, const uint32_t & N = 256);
+            Values new_public(const uint32_t & L = 2048, const uint32_t & N = 256, ThreadPool * pool = nullptr);
 
             // Generate new keypair with parameters
             Values keygen(Values & pub);
 
             // Sign hash of data
+            // context is the exponentiation context of pub (see modexp_context), or nullptr
             Values sign(const MPI & data, const Values & pri, const Values & pub, MPI k = 0);
             Values sign(const std::string & data, const Values & pri, const Values & pub, MPI k = 0);
+            Values sign(const MPI & data, const Values & pri, const Values & pub, const ModExpContext::Ptr & context, MPI k = 0);
+            Values sign(const std::string & data, const Values & pri, const Values & pub, const ModExpContext::Ptr & context, MPI k = 0);
 
             // Verify signature on hash
-            bool verify(const MPI & data, const Values & sig, const Values & pub);
-            bool verify(const std::string & data, const Values & sig, const Values & pub);
+            bool verify(const MPI & data, const Values & sig, const Values & pub, const ModExpContext::Ptr & context = nullptr);
+            bool verify(const std::string & data, const Values & sig, const Values & pub, const ModExpContext::Ptr & context = nullptr);
         }
     }
 }
@@ -0,0 +1,714 @@
+#include "ECC.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <gmpxx.h>
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECC {
+
+typedef unsigned __int128 uint128_t;
+
+// arithmetic mod an odd prime of N limbs, in Montgomery form
+template <std::size_t N>
+class Field {
+    public:
+        typedef std::array <uint64_t, N> Elem;
+
+    private:
+        Elem p;
+        uint64_t n0;    // -p^-1 mod 2^64
+        Elem r2;        // R^2 mod p
+        Elem r;         // R mod p, ie 1 in Montgomery form
+
+        // t - p if t >= p, where t is N limbs plus a carry
+        Elem reduce(const uint64_t * t, const uint64_t carry) const{
+            Elem d;
+            uint64_t borrow = 0;
+            for(std::size_t j = 0; j < N; j++){
+                const uint128_t s = static_cast <uint128_t> (t[j]) - p[j] - borrow;
+                d[j] = static_cast <uint64_t> (s);
+                borrow = static_cast <uint64_t> (s >> 64) & 1;
+            }
+
+            // keep t only when the subtraction underflowed
+            const uint64_t mask = -(borrow & ~carry & 1);
+            Elem out;
+            for(std::size_t j = 0; j < N; j++){
+                out[j] = (t[j] & mask) | (d[j] & ~mask);
+            }
+            return out;
+        }
+
+    public:
+        static Elem limbs(const mpz_class & value){
+            Elem out = {};
+            mpz_export(out.data(), nullptr, -1, sizeof(uint64_t), 0, 0, value.get_mpz_t());
+            return out;
+        }
+
+        Field(const mpz_class & prime)
+            : p(limbs(prime)),
+              n0(),
+              r2(),
+              r()
+        {
+            // Newton's iteration doubles the correct bits every step
+            uint64_t inv = 1;
+            for(unsigned int i = 0; i < 6; i++){
+                inv *= 2 - p[0] * inv;
+            }
+            n0 = -inv;
+
+            const mpz_class R = mpz_class(1) << (64 * N);
+            r = limbs(R % prime);
+            r2 = limbs((R * R) % prime);
+        }
+
+        // a * b / R mod p (CIOS)
+        Elem mul(const Elem & a, const Elem & b) const{
+            uint64_t t[N + 2] = {};
+            for(std::size_t i = 0; i < N; i++){
+                uint64_t c = 0;
+                for(std::size_t j = 0; j < N; j++){
+                    const uint128_t s = static_cast <uint128_t> (a[j]) * b[i] + t[j] + c;
+                    t[j] = static_cast <uint64_t> (s);
+                    c = static_cast <uint64_t> (s >> 64);
+                }
+                uint128_t s = static_cast <uint128_t> (t[N]) + c;
+                t[N] = static_cast <uint64_t> (s);
+                t[N + 1] = static_cast <uint64_t> (s >> 64);
+
+                const uint64_t m = t[0] * n0;
+                s = static_cast <uint128_t> (m) * p[0] + t[0];
+                c = static_cast <uint64_t> (s >> 64);
+                for(std::size_t j = 1; j < N; j++){
+                    s = static_cast <uint128_t> (m) * p[j] + t[j] + c;
+                    t[j - 1] = static_cast <uint64_t> (s);
+                    c = static_cast <uint64_t> (s >> 64);
+                }
+                s = static_cast <uint128_t> (t[N]) + c;
+                t[N - 1] = static_cast <uint64_t> (s);
+                t[N] = t[N + 1] + static_cast <uint64_t> (s >> 64);
+            }
+            return reduce(t, t[N]);
+        }
+
+        Elem sq(const Elem & a) const{
+            return mul(a, a);
+        }
+
+        Elem add(const Elem & a, const Elem & b) const{
+            uint64_t t[N];
+            uint64_t carry = 0;
+            for(std::size_t j = 0; j < N; j++){
+                const uint128_t s = static_cast <uint128_t> (a[j]) + b[j] + carry;
+                t[j] = static_cast <uint64_t> (s);
+                carry = static_cast <uint64_t> (s >> 64);
+            }
+            return reduce(t, carry);
+        }
+
+        Elem sub(const Elem & a, const Elem & b) const{
+            Elem d;
+            uint64_t borrow = 0;
+            for(std::size_t j = 0; j < N; j++){
+                const uint128_t s = static_cast <uint128_t> (a[j]) - b[j] - borrow;
+                d[j] = static_cast <uint64_t> (s);
+                borrow = static_cast <uint64_t> (s >> 64) & 1;
+            }
+
+            // add p back if the result went negative
+            const uint64_t mask = -borrow;
+            uint64_t carry = 0;
+            for(std::size_t j = 0; j < N; j++){
+                const uint128_t s = static_cast <uint128_t> (d[j]) + (p[j] & mask) + carry;
+                d[j] = static_cast <uint64_t> (s);
+                carry = static_cast <uint64_t> (s >> 64);
+            }
+            return d;
+        }
+
+        Elem to_mont(const Elem & a) const{
+            return mul(a, r2);
+        }
+
+        Elem from_mont(const Elem & a) const{
+            Elem one = {};
+            one[0] = 1;
+            return mul(a, one);
+        }
+
+        Elem one() const{
+            return r;
+        }
+
+        // a mod p, for a < 2p
+        Elem normalize(const Elem & a) const{
+            return reduce(a.data(), 0);
+        }
+
+        // a^(p - 2); the exponent is public
+        Elem invert(const Elem & a) const{
+            Elem e = p;
+            e[0] -= 2;
+
+            Elem out = r;
+            for(std::size_t i = N; i-- > 0;){
+                for(int bit = 63; bit >= 0; bit--){
+                    out = sq(out);
+                    if ((e[i] >> bit) & 1){
+                        out = mul(out, a);
+                    }
+                }
+            }
+            return out;
+        }
+
+        // a < p, for values that are not in Montgomery form
+        bool is_reduced(const Elem & a) const{
+            for(std::size_t i = N; i-- > 0;){
+                if (a[i] != p[i]){
+                    return a[i] < p[i];
+                }
+            }
+            return false;
+        }
+
+        static bool equal(const Elem & a, const Elem & b){
+            uint64_t diff = 0;
+            for(std::size_t j = 0; j < N; j++){
+                diff |= a[j] ^ b[j];
+            }
+            return !diff;
+        }
+
+        static bool is_zero(const Elem & a){
+            return equal(a, Elem());
+        }
+
+        // a = b ? c : a, in constant time
+        static void cmov(Elem & a, const Elem & c, const uint64_t b){
+            const uint64_t mask = -b;
+            for(std::size_t j = 0; j < N; j++){
+                a[j] ^= mask & (a[j] ^ c[j]);
+            }
+        }
+
+        static Elem frombytes(const std::string & s){
+            Elem out = {};
+            for(std::size_t i = 0; i < N * 8; i++){
+                out[i >> 3] |= static_cast <uint64_t> (static_cast <unsigned char> (s[N * 8 - 1 - i])) << ((i & 7) << 3);
+            }
+            return out;
+        }
+
+        static std::string tobytes(const Elem & a){
+            std::string out(N * 8, 0);
+            for(std::size_t i = 0; i < N * 8; i++){
+                out[N * 8 - 1 - i] = static_cast <char> (a[i >> 3] >> ((i & 7) << 3));
+            }
+            return out;
+        }
+};
+
+template <std::size_t N>
+class Curve {
+    public:
+        typedef typename Field <N>::Elem Elem;
+
+        // projective: x = X / Z, y = Y / Z; the identity is (0 : 1 : 0)
+        struct Point {
+            Elem X, Y, Z;
+        };
+
+    private:
+        Field <N> fp;
+        Field <N> fn;   // scalars mod the group order
+        Elem b;         // Montgomery form
+        Point g;
+        mpz_class n;
+
+        // TABLE[i * 16 + j] = j * 16^i * G
+        mutable std::vector <Point> table;
+        mutable std::once_flag built;
+
+        // odd multiples G, 3G, ..., 127G for verification
+        mutable std::vector <Point> odd_g;
+        mutable std::once_flag built_odd_g;
+
+        static const unsigned int WNAF_G = 8;   // window for G, whose multiples are computed once
+        static const unsigned int WNAF_P = 5;   // window for other points
+
+    public:
+        Curve(const std::string & p, const std::string & b, const std::string & gx, const std::string & gy, const std::string & n)
+            : fp(mpz_class(p, 16)),
+              fn(mpz_class(n, 16)),
+              b(fp.to_mont(Field <N>::limbs(mpz_class(b, 16)))),
+              g({fp.to_mont(Field <N>::limbs(mpz_class(gx, 16))), fp.to_mont(Field <N>::limbs(mpz_class(gy, 16))), fp.one()}),
+              n(n, 16),
+              table(),
+              built(),
+              odd_g(),
+              built_odd_g()
+        {}
+
+        Point identity() const{
+            return {Elem(), fp.one(), Elem()};
+        }
+
+        // Renes, Costello and Batina 2015, algorithm 4 (a = -3)
+        // complete: also correct for doubling and the identity
+        Point add(const Point & p, const Point & q) const{
+            Elem t0 = fp.mul(p.X, q.X);
+            Elem t1 = fp.mul(p.Y, q.Y);
+            Elem t2 = fp.mul(p.Z, q.Z);
+            Elem t3 = fp.add(p.X, p.Y);
+            Elem t4 = fp.add(q.X, q.Y);
+            t3 = fp.mul(t3, t4);
+            t4 = fp.add(t0, t1);
+            t3 = fp.sub(t3, t4);
+            t4 = fp.add(p.Y, p.Z);
+            Elem x3 = fp.add(q.Y, q.Z);
+            t4 = fp.mul(t4, x3);
+            x3 = fp.add(t1, t2);
+            t4 = fp.sub(t4, x3);
+            x3 = fp.add(p.X, p.Z);
+            Elem y3 = fp.add(q.X, q.Z);
+            x3 = fp.mul(x3, y3);
+            y3 = fp.add(t0, t2);
+            y3 = fp.sub(x3, y3);
+            Elem z3 = fp.mul(b, t2);
+            x3 = fp.sub(y3, z3);
+            z3 = fp.add(x3, x3);
+            x3 = fp.add(x3, z3);
+            z3 = fp.sub(t1, x3);
+            x3 = fp.add(t1, x3);
+            y3 = fp.mul(b, y3);
+            t1 = fp.add(t2, t2);
+            t2 = fp.add(t1, t2);
+            y3 = fp.sub(y3, t2);
+            y3 = fp.sub(y3, t0);
+            t1 = fp.add(y3, y3);
+            y3 = fp.add(t1, y3);
+            t1 = fp.add(t0, t0);
+            t0 = fp.add(t1, t0);
+            t0 = fp.sub(t0, t2);
+            t1 = fp.mul(t4, y3);
+            t2 = fp.mul(t0, y3);
+            y3 = fp.mul(x3, z3);
+            y3 = fp.add(y3, t2);
+            x3 = fp.mul(t3, x3);
+            x3 = fp.sub(x3, t1);
+            z3 = fp.mul(t4, z3);
+            t1 = fp.mul(t3, t0);
+            z3 = fp.add(z3, t1);
+            return {x3, y3, z3};
+        }
+
+        // Renes, Costello and Batina 2015, algorithm 6 (a = -3)
+        Point dbl(const Point & p) const{
+            Elem t0 = fp.sq(p.X);
+            Elem t1 = fp.sq(p.Y);
+            Elem t2 = fp.sq(p.Z);
+            Elem t3 = fp.mul(p.X, p.Y);
+            t3 = fp.add(t3, t3);
+            Elem z3 = fp.mul(p.X, p.Z);
+            z3 = fp.add(z3, z3);
+            Elem y3 = fp.mul(b, t2);
+            y3 = fp.sub(y3, z3);
+            Elem x3 = fp.add(y3, y3);
+            y3 = fp.add(x3, y3);
+            x3 = fp.sub(t1, y3);
+            y3 = fp.add(t1, y3);
+            y3 = fp.mul(x3, y3);
+            x3 = fp.mul(x3, t3);
+            t3 = fp.add(t2, t2);
+            t2 = fp.add(t2, t3);
+            z3 = fp.mul(b, z3);
+            z3 = fp.sub(z3, t2);
+            z3 = fp.sub(z3, t0);
+            t3 = fp.add(z3, z3);
+            z3 = fp.add(z3, t3);
+            t3 = fp.add(t0, t0);
+            t0 = fp.add(t3, t0);
+            t0 = fp.sub(t0, t2);
+            t0 = fp.mul(t0, z3);
+            y3 = fp.add(y3, t0);
+            t0 = fp.mul(p.Y, p.Z);
+            t0 = fp.add(t0, t0);
+            z3 = fp.mul(t0, z3);
+            x3 = fp.sub(x3, z3);
+            z3 = fp.mul(t0, t1);
+            z3 = fp.add(z3, z3);
+            z3 = fp.add(z3, z3);
+            return {x3, y3, z3};
+        }
+
+        Point neg(const Point & p) const{
+            return {p.X, fp.sub(Elem(), p.Y), p.Z};
+        }
+
+        static void cmov(Point & p, const Point & q, const uint64_t b){
+            Field <N>::cmov(p.X, q.X, b);
+            Field <N>::cmov(p.Y, q.Y, b);
+            Field <N>::cmov(p.Z, q.Z, b);
+        }
+
+        // constant time lookup of table[index]
+        static Point select(const Point * table, const unsigned int index){
+            Point out = table[0];
+            for(unsigned int j = 1; j < 16; j++){
+                cmov(out, table[j], static_cast <uint64_t> (j == index));
+            }
+            return out;
+        }
+
+        // 4 bit digit i of a big endian scalar
+        static unsigned int nibble(const std::string & s, const std::size_t i){
+            return (static_cast <unsigned char> (s[N * 8 - 1 - (i >> 1)]) >> ((i & 1) << 2)) & 15;
+        }
+
+        // [k]P in constant time, with a fixed 4 bit window
+        Point mul(const std::string & k, const Point & p) const{
+            Point multiples[16];
+            multiples[0] = identity();
+            for(unsigned int j = 1; j < 16; j++){
+                multiples[j] = add(multiples[j - 1], p);
+            }
+
+            Point out = identity();
+            for(std::size_t i = N * 16; i-- > 0;){
+                for(unsigned int d = 0; d < 4; d++){
+                    out = dbl(out);
+                }
+                out = add(out, select(multiples, nibble(k, i)));
+            }
+            return out;
+        }
+
+        // [k]G in constant time, from a table of multiples of G
+        Point mul_base(const std::string & k) const{
+            std::call_once(built, [this](){
+                table.resize(N * 16 * 16);
+                Point base = g;
+                for(std::size_t i = 0; i < N * 16; i++){
+                    table[i * 16] = identity();
+                    for(unsigned int j = 1; j < 16; j++){
+                        table[i * 16 + j] = add(table[i * 16 + j - 1], base);
+                    }
+                    base = add(table[i * 16 + 15], base);
+                }
+            });
+
+            Point out = identity();
+            for(std::size_t i = 0; i < N * 16; i++){
+                out = add(out, select(&table[i * 16], nibble(k, i)));
+            }
+            return out;
+        }
+
+        // width w non-adjacent form, least significant digit first
+        static std::vector <int> wnaf(const std::string & k, const unsigned int w){
+            mpz_class value;
+            mpz_import(value.get_mpz_t(), k.size(), 1, 1, 0, 0, k.data());
+
+            std::vector <int> out;
+            while (value > 0){
+                int digit = 0;
+                if (mpz_odd_p(value.get_mpz_t())){
+                    digit = static_cast <int> (mpz_fdiv_ui(value.get_mpz_t(), 1UL << w));
+                    if (digit >= (1 << (w - 1))){
+                        digit -= (1 << w);
+                    }
+                    value -= digit;
+                }
+                out.push_back(digit);
+                value >>= 1;
+            }
+            return out;
+        }
+
+        // P, 3P, 5P, ...
+        std::vector <Point> odd_multiples(const Point & p, const unsigned int w) const{
+            std::vector <Point> out(1 << (w - 2));
+            out[0] = p;
+            const Point twice = dbl(p);
+            for(std::size_t i = 1; i < out.size(); i++){
+                out[i] = add(out[i - 1], twice);
+            }
+            return out;
+        }
+
+        // [u1]G + [u2]Q with interleaved wNAF (Shamir's trick)
+        // variable time, so only for public values
+        Point mul_double_vartime(const std::string & u1, const std::string & u2, const Point & q) const{
+            std::call_once(built_odd_g, [this](){
+                odd_g = odd_multiples(g, WNAF_G);
+            });
+            const std::vector <Point> odd_q = odd_multiples(q, WNAF_P);
+
+            const std::vector <int> n1 = wnaf(u1, WNAF_G);
+            const std::vector <int> n2 = wnaf(u2, WNAF_P);
+
+            Point out = identity();
+            for(std::size_t i = std::max(n1.size(), n2.size()); i-- > 0;){
+                out = dbl(out);
+                if ((i < n1.size()) && n1[i]){
+                    const Point & m = odd_g[std::abs(n1[i]) >> 1];
+                    out = add(out, (n1[i] > 0)?m:neg(m));
+                }
+                if ((i < n2.size()) && n2[i]){
+                    const Point & m = odd_q[std::abs(n2[i]) >> 1];
+                    out = add(out, (n2[i] > 0)?m:neg(m));
+                }
+            }
+            return out;
+        }
+
+        // scalar as exactly N * 8 octets, or an empty string if it is not in [1, n - 1]
+        std::string scalar(const std::string & k) const{
+            if (!k.size() || (k.size() > N * 8)){
+                return "";
+            }
+
+            const std::string out = std::string(N * 8 - k.size(), 0) + k;
+            mpz_class value;
+            mpz_import(value.get_mpz_t(), out.size(), 1, 1, 0, 0, out.data());
+            if ((value == 0) || (value >= n)){
+                return "";
+            }
+            return out;
+        }
+
+        std::string order() const{
+            return Field <N>::tobytes(Field <N>::limbs(n));
+        }
+
+        // leftmost N * 64 bits of a digest, reduced mod n (FIPS 186-4 sec 6.4)
+        Elem digest_scalar(const std::string & digest) const{
+            std::string e = digest.substr(0, N * 8);
+            e = std::string(N * 8 - e.size(), 0) + e;
+            return fn.normalize(Field <N>::frombytes(e));
+        }
+
+        // 0x04 || x || y; empty for the identity
+        std::string encode(const Point & p) const{
+            if (Field <N>::is_zero(p.Z)){
+                return "";
+            }
+            const Elem zinv = fp.invert(p.Z);
+            return "\x04" + Field <N>::tobytes(fp.from_mont(fp.mul(p.X, zinv))) + Field <N>::tobytes(fp.from_mont(fp.mul(p.Y, zinv)));
+        }
+
+        bool decode(const std::string & s, Point & p) const{
+            if ((s.size() != (1 + 2 * N * 8)) || (s[0] != 0x04)){
+                return false;
+            }
+
+            const Elem x = Field <N>::frombytes(s.substr(1, N * 8));
+            const Elem y = Field <N>::frombytes(s.substr(1 + N * 8, N * 8));
+            if (!fp.is_reduced(x) || !fp.is_reduced(y)){
+                return false;
+            }
+
+            p = {fp.to_mont(x), fp.to_mont(y), fp.one()};
+
+            // y^2 = x^3 - 3x + b
+            const Elem lhs = fp.sq(p.Y);
+            const Elem x3 = fp.mul(fp.sq(p.X), p.X);
+            const Elem rhs = fp.add(fp.sub(x3, fp.add(fp.add(p.X, p.X), p.X)), b);
+            return Field <N>::equal(lhs, rhs);
+        }
+
+        std::string public_key(const std::string & secret) const{
+            const std::string k = scalar(secret);
+            if (!k.size()){
+                // "Error: Secret scalar out of range.\n";
+                return "";
+            }
+            return encode(mul_base(k));
+        }
+
+        std::string shared_secret(const std::string & secret, const std::string & pub) const{
+            const std::string k = scalar(secret);
+            Point p;
+            if (!k.size() || !decode(pub, p)){
+                return "";
+            }
+
+            const std::string out = encode(mul(k, p));
+            if (!out.size()){
+                return "";
+            }
+            return out.substr(1, N * 8);
+        }
+
+        // FIPS 186-4 sec 6.4
+        std::string sign(const std::string & digest, const std::string & secret, const std::string & nonce) const{
+            const std::string d = scalar(secret);
+            const std::string k = scalar(nonce);
+            if (!d.size() || !k.size()){
+                return "";
+            }
+
+            // r = x(kG) mod n
+            const Point kg = mul_base(k);
+            const Elem x = fp.from_mont(fp.mul(kg.X, fp.invert(kg.Z)));
+            const Elem r = fn.normalize(x);
+            if (Field <N>::is_zero(r)){
+                return "";
+            }
+
+            // s = k^-1 (e + r d) mod n
+            const Elem e = digest_scalar(digest);
+            const Elem rd = fn.mul(fn.to_mont(r), fn.to_mont(Field <N>::frombytes(d)));
+            const Elem kinv = fn.invert(fn.to_mont(Field <N>::frombytes(k)));
+            const Elem s = fn.from_mont(fn.mul(kinv, fn.add(fn.to_mont(e), rd)));
+            if (Field <N>::is_zero(s)){
+                return "";
+            }
+
+            return Field <N>::tobytes(r) + Field <N>::tobytes(s);
+        }
+
+        bool verify(const std::string & digest, const std::string & signature, const std::string & pub) const{
+            Point q;
+            if ((signature.size() != (2 * N * 8)) || !decode(pub, q)){
+                return false;
+            }
+
+            const std::string r = scalar(signature.substr(0, N * 8));
+            const std::string s = scalar(signature.substr(N * 8, N * 8));
+            if (!r.size() || !s.size()){
+                return false;
+            }
+
+            // u1 = e / s, u2 = r / s
+            const Elem w = fn.invert(fn.to_mont(Field <N>::frombytes(s)));
+            const Elem u1 = fn.from_mont(fn.mul(fn.to_mont(digest_scalar(digest)), w));
+            const Elem u2 = fn.from_mont(fn.mul(fn.to_mont(Field <N>::frombytes(r)), w));
+
+            const Point rp = mul_double_vartime(Field <N>::tobytes(u1), Field <N>::tobytes(u2), q);
+            if (Field <N>::is_zero(rp.Z)){
+                return false;
+            }
+
+            const Elem x = fp.from_mont(fp.mul(rp.X, fp.invert(rp.Z)));
+            return Field <N>::equal(fn.normalize(x), Field <N>::frombytes(r));
+        }
+};
+
+static const Curve <4> & P256(){
+    static const Curve <4> curve("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff",
+                                 "5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b",
+                                 "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296",
+                                 "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5",
+                                 "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551");
+    return curve;
+}
+
+static const Curve <6> & P384(){
+    static const Curve <6> curve("fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffff",
+                                 "b3312fa7e23ee7e4988e056be3f82d19181d9c6efe8141120314088f5013875ac656398d8a2ed19d2a85c8edd3ec2aef",
+                                 "aa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a385502f25dbf55296c3a545e3872760ab7",
+                                 "3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c00a60b1ce1d7e819d7a431d7c90ea0e5f",
+                                 "ffffffffffffffffffffffffffffffffffffffffffffffffc7634d81f4372ddf581a0db248b0a77aecec196accc52973");
+    return curve;
+}
+
+std::size_t size(const uint8_t curve){
+    switch (curve){
+        case ID::P256:
+            return 32;
+        case ID::P384:
+            return 48;
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown curve: " + std::to_string(curve));
+}
+
+uint8_t curve_of(const std::string & point){
+    for(uint8_t const curve : {ID::P256, ID::P384}){
+        if (point.size() == (1 + 2 * size(curve))){
+            return curve;
+        }
+    }
+    return 0;
+}
+
+std::string order(const uint8_t curve){
+    switch (curve){
+        case ID::P256:
+            return P256().order();
+        case ID::P384:
+            return P384().order();
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown curve: " + std::to_string(curve));
+}
+
+std::string public_key(const uint8_t curve, const std::string & secret){
+    switch (curve){
+        case ID::P256:
+            return P256().public_key(secret);
+        case ID::P384:
+            return P384().public_key(secret);
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown curve: " + std::to_string(curve));
+}
+
+std::string shared_secret(const uint8_t curve, const std::string & secret, const std::string & pub){
+    switch (curve){
+        case ID::P256:
+            return P256().shared_secret(secret, pub);
+        case ID::P384:
+            return P384().shared_secret(secret, pub);
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown curve: " + std::to_string(curve));
+}
+
+std::string sign(const uint8_t curve, const std::string & digest, const std::string & secret, const std::string & k){
+    switch (curve){
+        case ID::P256:
+            return P256().sign(digest, secret, k);
+        case ID::P384:
+            return P384().sign(digest, secret, k);
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown curve: " + std::to_string(curve));
+}
+
+bool verify(const uint8_t curve, const std::string & digest, const std::string & signature, const std::string & pub){
+    switch (curve){
+        case ID::P256:
+            return P256().verify(digest, signature, pub);
+        case ID::P384:
+            return P384().verify(digest, signature, pub);
+        default:
+            break;
+    }
+
+    throw std::runtime_error("Error: Unknown curve: " + std::to_string(curve));
+}
+
+}
+}
+}
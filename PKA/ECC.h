@@ -0,0 +1,78 @@
+/*
+ECC.h
+Short Weierstrass curves NIST P-256 and P-384
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECC__
+#define __ECC__
+
+#include <cstdint>
+#include <string>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECC {
+            // Short Weierstrass curves y^2 = x^3 - 3x + b over prime fields
+            //
+            // Field elements are held in 64 bit limbs in Montgomery form, and
+            // points in projective coordinates using the complete formulas of
+            // Renes, Costello and Batina, so there are no special cases to
+            // branch on. Scalar multiplications by secret values run in
+            // constant time.
+            //
+            // Scalars are big endian octet strings. Points are encoded
+            // uncompressed: 0x04 || x || y.
+
+            namespace ID {
+                const uint8_t P256 = 1;
+                const uint8_t P384 = 2;
+            }
+
+            // octets in a coordinate or scalar
+            std::size_t size(const uint8_t curve);
+
+            // curve of an encoded point, judging by its length; 0 if none match
+            uint8_t curve_of(const std::string & point);
+
+            // group order n
+            std::string order(const uint8_t curve);
+
+            // derive the public point of a secret scalar
+            // returns an empty string if the scalar is not in [1, n - 1]
+            std::string public_key(const uint8_t curve, const std::string & secret);
+
+            // x coordinate of secret * pub
+            // returns an empty string if pub is not a point on the curve
+            std::string shared_secret(const uint8_t curve, const std::string & secret, const std::string & pub);
+
+            // ECDSA signature r || s of a digest with nonce k (FIPS 186-4 sec 6.4)
+            // returns an empty string if the secret or k is not in [1, n - 1]
+            std::string sign(const uint8_t curve, const std::string & digest, const std::string & secret, const std::string & k);
+
+            // verification uses wNAF and Shamir's trick, in variable time
+            bool verify(const uint8_t curve, const std::string & digest, const std::string & signature, const std::string & pub);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "ECDH.h"
+
+#include <algorithm>
+
+#include "PKAs.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECDH {
+
+static bool is_25519(const std::string & curve){
+    return curve == unhexlify(CURVE_OID::CURVE_255);
+}
+
+static bool is_p256(const std::string & curve){
+    return curve == unhexlify(CURVE_OID::NIST_256);
+}
+
+bool supported(const std::string & curve){
+    return is_25519(curve) || is_p256(curve);
+}
+
+static std::string reversed(const std::string & s){
+    return std::string(s.rbegin(), s.rend());
+}
+
+// MPIs drop leading zeros
+static std::string fixed(const MPI & m, const std::size_t size){
+    const std::string raw = mpitoraw(m);
+    if (raw.size() > size){
+        return "";
+    }
+    return std::string(size - raw.size(), 0) + raw;
+}
+
+// native encodings of a point MPI and a secret scalar MPI
+static std::string point(const std::string & curve, const MPI & m){
+    const std::string raw = mpitoraw(m);
+    if (is_25519(curve)){
+        if ((raw.size() != (X25519::KEY_SIZE + 1)) || (raw[0] != 0x40)){
+            return "";
+        }
+        return raw.substr(1);
+    }
+    return raw;
+}
+
+static std::string scalar(const std::string & curve, const MPI & m){
+    if (is_25519(curve)){
+        return reversed(fixed(m, X25519::KEY_SIZE));
+    }
+    return fixed(m, ECC::size(ECC::ID::P256));
+}
+
+// shared secret of a native secret scalar and point
+static std::string shared(const std::string & curve, const std::string & secret, const std::string & pub){
+    if (!secret.size() || !pub.size()){
+        return "";
+    }
+    if (is_25519(curve)){
+        return X25519::shared_secret(secret, pub);
+    }
+    return ECC::shared_secret(ECC::ID::P256, secret, pub);
+}
+
+// RFC 6637 sec 7 and 8
+static std::string kek(const std::string & z, const KDF & kdf){
+    const std::string param = std::string(1, kdf.curve.size()) + kdf.curve +
+                              std::string(1, 18) + "\x03\x01" +   // ECDH public key algorithm ID
+                              std::string(1, kdf.hash) + std::string(1, kdf.alg) +
+                              "Anonymous Sender    " + kdf.fingerprint;
+    return Hash::use(kdf.hash, std::string("\x00\x00\x00\x01", 4) + z + param).substr(0, Sym::KEY_LENGTH.at(kdf.alg) >> 3);
+}
+
+Values keygen(Values & pub, const std::string & curve){
+    if (is_25519(curve)){
+        std::string secret = RNG::bytes(X25519::KEY_SIZE);
+        secret[0]  &= 248;
+        secret[31] &= 127;
+        secret[31] |= 64;
+        pub = {rawtompi("\x40" + X25519::public_key(secret))};
+        return {rawtompi(reversed(secret))};
+    }
+    else if (is_p256(curve)){
+        std::string secret, point;
+        do {
+            secret = RNG::bytes(ECC::size(ECC::ID::P256));
+            point = ECC::public_key(ECC::ID::P256, secret);
+        } while (!point.size());
+        pub = {rawtompi(point)};
+        return {rawtompi(secret)};
+    }
+
+    // "Error: Unsupported ECDH curve.\n";
+    return {};
+}
+
+Values encrypt(const std::string & m, const Values & pub, const KDF & kdf, std::string & wrapped){
+    if (!supported(kdf.curve) || !pub.size()){
+        // "Error: Unsupported ECDH curve.\n";
+        return {};
+    }
+
+    // ephemeral key
+    Values ephemeral;
+    const std::string secret = scalar(kdf.curve, keygen(ephemeral, kdf.curve)[0]);
+    const std::string z = shared(kdf.curve, secret, point(kdf.curve, pub[0]));
+    if (!z.size()){
+        // "Error: Bad ECDH public key.\n";
+        return {};
+    }
+
+    // PKCS5 padding to a multiple of 8 octets
+    const std::size_t pad = 8 - (m.size() & 7);
+    wrapped = use_key_wrap(kdf.alg, m + std::string(pad, static_cast <char> (pad)), kek(z, kdf));
+
+    return ephemeral;
+}
+
+std::string decrypt(const Values & ephemeral, const std::string & wrapped, const Values & pri, const KDF & kdf){
+    if (!supported(kdf.curve) || !ephemeral.size() || !pri.size()){
+        // "Error: Unsupported ECDH curve.\n";
+        return "";
+    }
+
+    const std::string z = shared(kdf.curve, scalar(kdf.curve, pri[0]), point(kdf.curve, ephemeral[0]));
+    if (!z.size()){
+        // "Error: Bad ECDH ephemeral key.\n";
+        return "";
+    }
+
+    const std::string m = use_key_unwrap(kdf.alg, wrapped, kek(z, kdf));
+    if (!m.size()){
+        return "";
+    }
+
+    // remove PKCS5 padding
+    const unsigned char pad = m.back();
+    if (!pad || (pad > 8) || (pad > m.size()) || (m.find_first_not_of(static_cast <char> (pad), m.size() - pad) != std::string::npos)){
+        // "Error: Bad ECDH session key padding.\n";
+        return "";
+    }
+
+    return m.substr(0, m.size() - pad);
+}
+
+}
+}
+}
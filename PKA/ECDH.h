@@ -0,0 +1,74 @@
+/*
+ECDH.h
+Elliptic Curve Diffie-Hellman key agreement (RFC 6637)
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDH__
+#define __ECDH__
+
+#include "../Encryptions/Encryptions.h"
+#include "../Hashes/Hashes.h"
+#include "../RNG/RNGs.h"
+#include "../common/includes.h"
+#include "../Misc/keywrap.h"
+#include "../Misc/mpi.h"
+#include "../Misc/pgptime.h"
+#include "ECC.h"
+#include "PKA.h"
+#include "X25519.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDH {
+            // RFC 6637 ECDH on Curve25519 and NIST P-256
+            //
+            //     public:     MPI of the point (0x40 || u for Curve25519,
+            //                 0x04 || x || y for P-256)
+            //     private:    MPI of the scalar (reversed octets for Curve25519)
+            //     encrypted:  MPI of the ephemeral point + wrapped session key
+
+            // recipient key fields that go into the KDF (RFC 6637 sec 8)
+            struct KDF {
+                std::string curve;          // binary OID
+                uint8_t hash;
+                uint8_t alg;                // key wrap algorithm
+                std::string fingerprint;    // of the recipient key
+            };
+
+            // whether the curve (binary OID) is supported
+            bool supported(const std::string & curve);
+
+            // Generate new keypair on the curve (binary OID)
+            Values keygen(Values & pub, const std::string & curve);
+
+            // Encrypt m (symmetric algorithm || session key || checksum)
+            // returns the ephemeral point; the wrapped key is returned through wrapped
+            Values encrypt(const std::string & m, const Values & pub, const KDF & kdf, std::string & wrapped);
+
+            // returns m, or an empty string on failure
+            std::string decrypt(const Values & ephemeral, const std::string & wrapped, const Values & pri, const KDF & kdf);
+        }
+    }
+}
+
+#endif
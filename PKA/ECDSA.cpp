@@ -0,0 +1,131 @@
+#include "ECDSA.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace ECDSA {
+
+// MPIs drop leading zeros
+static std::string fixed(const MPI & m, const std::size_t size){
+    const std::string raw = mpitoraw(m);
+    if (raw.size() > size){
+        return "";
+    }
+    return std::string(size - raw.size(), 0) + raw;
+}
+
+// RFC 2104
+static std::string hmac(const uint8_t hash, const std::string & key, const std::string & data){
+    const std::size_t block = (Hash::LENGTH.at(hash) > 256)?128:64;
+    std::string k = (key.size() > block)?Hash::use(hash, key):key;
+    k += std::string(block - k.size(), 0);
+
+    std::string ipad(block, 0x36), opad(block, 0x5c);
+    for(std::size_t i = 0; i < block; i++){
+        ipad[i] ^= k[i];
+        opad[i] ^= k[i];
+    }
+    return Hash::use(hash, opad + Hash::use(hash, ipad + data));
+}
+
+std::string nonce(const uint8_t curve, const uint8_t hash, const std::string & secret, const std::string & digest){
+    // the orders of the supported curves fill all of their bits,
+    // so bits2int only has to truncate to the size of n
+    const std::string order = ECC::order(curve);
+    const std::size_t size = order.size();
+    const MPI n = rawtompi(order);
+
+    // bits2octets(digest)
+    std::string h1 = digest.substr(0, size);
+    h1 = std::string(size - h1.size(), 0) + h1;
+    MPI z = rawtompi(h1);
+    if (z >= n){
+        z -= n;
+    }
+    h1 = fixed(z, size);
+
+    const std::string x = std::string(size - secret.size(), 0) + secret;
+
+    const std::size_t hlen = Hash::LENGTH.at(hash) >> 3;
+    std::string V(hlen, 0x01);
+    std::string K(hlen, 0x00);
+    K = hmac(hash, K, V + std::string(1, 0x00) + x + h1);
+    V = hmac(hash, K, V);
+    K = hmac(hash, K, V + std::string(1, 0x01) + x + h1);
+    V = hmac(hash, K, V);
+
+    while (true){
+        std::string T;
+        while (T.size() < size){
+            V = hmac(hash, K, V);
+            T += V;
+        }
+        T = T.substr(0, size);
+
+        const MPI k = rawtompi(T);
+        if ((k > 0) && (k < n)){
+            return T;
+        }
+
+        K = hmac(hash, K, V + std::string(1, 0x00));
+        V = hmac(hash, K, V);
+    }
+}
+
+Values keygen(Values & pub, const uint8_t curve){
+    std::string secret, point;
+    do {
+        secret = RNG::bytes(ECC::size(curve));
+        point = ECC::public_key(curve, secret);
+    } while (!point.size());
+
+    pub = {rawtompi(point)};
+    return {rawtompi(secret)};
+}
+
+Values sign(const std::string & data, const Values & pri, const Values & pub, const uint8_t hash){
+    if (!pri.size() || !pub.size()){
+        // "Error: No ECDSA key.\n";
+        return {};
+    }
+
+    const uint8_t curve = ECC::curve_of(mpitoraw(pub[0]));
+    if (!curve){
+        // "Error: Unsupported ECDSA curve.\n";
+        return {};
+    }
+
+    const std::size_t size = ECC::size(curve);
+    const std::string secret = fixed(pri[0], size);
+    const std::string sig = ECC::sign(curve, data, secret, nonce(curve, hash, secret, data));
+    if (!sig.size()){
+        // "Error: ECDSA signing failed.\n";
+        return {};
+    }
+
+    return {rawtompi(sig.substr(0, size)), rawtompi(sig.substr(size, size))};
+}
+
+bool verify(const std::string & data, const Values & sig, const Values & pub){
+    if ((sig.size() < 2) || !pub.size()){
+        return false;
+    }
+
+    const std::string point = mpitoraw(pub[0]);
+    const uint8_t curve = ECC::curve_of(point);
+    if (!curve){
+        return false;
+    }
+
+    const std::size_t size = ECC::size(curve);
+    const std::string r = fixed(sig[0], size);
+    const std::string s = fixed(sig[1], size);
+    if (!r.size() || !s.size()){
+        return false;
+    }
+
+    return ECC::verify(curve, data, r + s, point);
+}
+
+}
+}
+}
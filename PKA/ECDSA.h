@@ -0,0 +1,64 @@
+/*
+ECDSA.h
+Elliptic Curve Digital Signature Algorithm
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ECDSA__
+#define __ECDSA__
+
+#include "../Hashes/Hashes.h"
+#include "../RNG/RNGs.h"
+#include "../common/includes.h"
+#include "../Misc/mpi.h"
+#include "../Misc/pgptime.h"
+#include "ECC.h"
+#include "PKA.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace ECDSA {
+            // ECDSA on NIST P-256 and P-384 (RFC 6637)
+            //
+            //     public:     MPI of 0x04 || x || y; the curve follows from its length
+            //     private:    MPI of the secret scalar
+            //     signature:  MPIs of r and s
+            //
+            // Nonces are derived deterministically from the key and
+            // digest (RFC 6979), so signing needs no random numbers.
+
+            // Generate new keypair on the curve (ECC::ID)
+            Values keygen(Values & pub, const uint8_t curve);
+
+            // Sign hash of data; hash is the algorithm that produced it
+            Values sign(const std::string & data, const Values & pri, const Values & pub, const uint8_t hash);
+
+            // Verify signature on hash
+            bool verify(const std::string & data, const Values & sig, const Values & pub);
+
+            // RFC 6979 sec 3.2 nonce for a secret scalar and digest
+            std::string nonce(const uint8_t curve, const uint8_t hash, const std::string & secret, const std::string & digest);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,354 @@
+#include "Ed25519.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+
+#include <gmp.h>
+
+#include "../Hashes/SHA512.h"
+#include "Field25519.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace Ed25519 {
+
+using namespace Field25519;
+
+// curve constant d = -121665 / 121666
+static const Fe & D(){
+    static const Fe d = fe_mul(fe_neg(fe(121665)), fe_invert(fe(121666)));
+    return d;
+}
+
+static const Fe & D2(){
+    static const Fe d2 = fe_add(D(), D());
+    return d2;
+}
+
+// 2^((p - 1) / 4)
+static const Fe & SQRTM1(){
+    static const Fe s = fe_mul(fe_sq(fe_pow22523(fe(2))), fe(2));
+    return s;
+}
+
+// point in extended coordinates: x = X / Z, y = Y / Z, x * y = T / Z
+struct Ge {
+    Fe X, Y, Z, T;
+};
+
+static Ge ge_identity(){
+    return {fe(0), fe(1), fe(1), fe(0)};
+}
+
+// unified addition (add-2008-hwcd-3); also correct for doubling and the identity
+static Ge ge_add(const Ge & p, const Ge & q){
+    const Fe a = fe_mul(fe_sub(p.Y, p.X), fe_sub(q.Y, q.X));
+    const Fe b = fe_mul(fe_add(p.Y, p.X), fe_add(q.Y, q.X));
+    const Fe c = fe_mul(fe_mul(p.T, D2()), q.T);
+    Fe d = fe_mul(p.Z, q.Z);
+    d = fe_add(d, d);
+    const Fe e = fe_sub(b, a);
+    const Fe f = fe_sub(d, c);
+    const Fe g = fe_add(d, c);
+    const Fe h = fe_add(b, a);
+    return {fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+// dbl-2008-hwcd with a = -1
+static Ge ge_double(const Ge & p){
+    const Fe a = fe_sq(p.X);
+    const Fe b = fe_sq(p.Y);
+    Fe c = fe_sq(p.Z);
+    c = fe_add(c, c);
+    const Fe e = fe_sub(fe_sq(fe_add(p.X, p.Y)), fe_add(a, b));
+    const Fe g = fe_sub(b, a);
+    const Fe f = fe_sub(g, c);
+    const Fe h = fe_neg(fe_add(a, b));
+    return {fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+static Ge ge_neg(const Ge & p){
+    return {fe_neg(p.X), p.Y, p.Z, fe_neg(p.T)};
+}
+
+static void ge_cmov(Ge & p, const Ge & q, const uint64_t b){
+    fe_cmov(p.X, q.X, b);
+    fe_cmov(p.Y, q.Y, b);
+    fe_cmov(p.Z, q.Z, b);
+    fe_cmov(p.T, q.T, b);
+}
+
+static std::string ge_tobytes(const Ge & p){
+    const Fe zinv = fe_invert(p.Z);
+    std::string out = fe_tobytes(fe_mul(p.Y, zinv));
+    out[31] ^= fe_isnegative(fe_mul(p.X, zinv)) << 7;
+    return out;
+}
+
+// RFC 8032 sec 5.1.3
+static bool ge_frombytes(const std::string & s, Ge & p){
+    if (s.size() != 32){
+        return false;
+    }
+
+    const Fe y = fe_frombytes(s);
+    const bool sign = static_cast <unsigned char> (s[31]) >> 7;
+
+    // y must be canonical
+    std::string canonical = s;
+    canonical[31] &= 0x7f;
+    if (fe_tobytes(y) != canonical){
+        return false;
+    }
+
+    const Fe y2 = fe_sq(y);
+    const Fe u = fe_sub(y2, fe(1));
+    const Fe v = fe_add(fe_mul(D(), y2), fe(1));
+
+    // x = u v^3 (u v^7)^((p - 5) / 8)
+    const Fe v3 = fe_mul(fe_sq(v), v);
+    const Fe v7 = fe_mul(fe_sq(v3), v);
+    Fe x = fe_mul(fe_mul(u, v3), fe_pow22523(fe_mul(u, v7)));
+
+    const Fe vx2 = fe_mul(v, fe_sq(x));
+    if (!fe_iszero(fe_sub(vx2, u))){
+        if (!fe_iszero(fe_add(vx2, u))){
+            return false;
+        }
+        x = fe_mul(x, SQRTM1());
+    }
+
+    if (fe_isnegative(x) != sign){
+        if (fe_iszero(x)){
+            return false;
+        }
+        x = fe_neg(x);
+    }
+
+    p = {x, y, fe(1), fe_mul(x, y)};
+    return true;
+}
+
+// 4 bit digit i of a little endian scalar
+static unsigned int nibble(const std::string & s, const unsigned int i){
+    return (static_cast <unsigned char> (s[i >> 1]) >> ((i & 1) << 2)) & 15;
+}
+
+// TABLE[i][j] = j * 16^i * B
+typedef Ge BaseTable[64][16];
+
+static const BaseTable & base_table(){
+    static BaseTable table;
+    static std::once_flag built;
+    std::call_once(built, [](){
+        Ge base;
+        // y = 4/5 with positive x
+        ge_frombytes(std::string(1, 0x58) + std::string(31, 0x66), base);
+        for(unsigned int i = 0; i < 64; i++){
+            table[i][0] = ge_identity();
+            for(unsigned int j = 1; j < 16; j++){
+                table[i][j] = ge_add(table[i][j - 1], base);
+            }
+            base = ge_add(table[i][15], base);
+        }
+    });
+    return table;
+}
+
+// [s]B in constant time
+static Ge ge_scalarmult_base(const std::string & s){
+    const BaseTable & table = base_table();
+    Ge out = ge_identity();
+    for(unsigned int i = 0; i < 64; i++){
+        const unsigned int n = nibble(s, i);
+        Ge entry = ge_identity();
+        for(unsigned int j = 1; j < 16; j++){
+            ge_cmov(entry, table[i][j], static_cast <uint64_t> (j == n));
+        }
+        out = ge_add(out, entry);
+    }
+    return out;
+}
+
+// sum of [scalars[i]]points[i]; variable time, for public values only
+static Ge ge_multiscalarmult_vartime(const std::vector <Ge> & points, const std::vector <std::string> & scalars){
+    std::vector <Ge> tables(points.size() * 16);
+    for(std::size_t i = 0; i < points.size(); i++){
+        Ge * table = &tables[i * 16];
+        table[0] = ge_identity();
+        for(unsigned int j = 1; j < 16; j++){
+            table[j] = ge_add(table[j - 1], points[i]);
+        }
+    }
+
+    Ge out = ge_identity();
+    for(unsigned int n = 64; n-- > 0;){
+        out = ge_double(ge_double(ge_double(ge_double(out))));
+        for(std::size_t i = 0; i < points.size(); i++){
+            const unsigned int d = nibble(scalars[i], n);
+            if (d){
+                out = ge_add(out, tables[i * 16 + d]);
+            }
+        }
+    }
+    return out;
+}
+
+// [8]P == O
+static bool ge_is_small_order(Ge p){
+    p = ge_double(ge_double(ge_double(p)));
+    return fe_iszero(p.X) && fe_iszero(fe_sub(p.Y, p.Z));
+}
+
+// scalars mod L = 2^252 + 27742317777372353535851937790883648493
+// reduced with GMP's side channel silent mpn_sec functions
+static const mp_limb_t L[4] = {0x5812631a5cf5d3edULL, 0x14def9dea2f79cd6ULL, 0, 0x1000000000000000ULL};
+
+static void to_limbs(const std::string & s, mp_limb_t * out, const std::size_t n){
+    std::fill(out, out + n, 0);
+    for(std::size_t i = 0; i < s.size(); i++){
+        out[i >> 3] |= static_cast <mp_limb_t> (static_cast <unsigned char> (s[i])) << ((i & 7) << 3);
+    }
+}
+
+static std::string from_limbs(const mp_limb_t * in){
+    std::string out(32, 0);
+    for(std::size_t i = 0; i < 32; i++){
+        out[i] = static_cast <char> (in[i >> 3] >> ((i & 7) << 3));
+    }
+    return out;
+}
+
+// 64 octet little endian value mod L
+static std::string sc_reduce(const std::string & s){
+    mp_limb_t n[8];
+    to_limbs(s, n, 8);
+    std::vector <mp_limb_t> scratch(mpn_sec_div_r_itch(8, 4));
+    mpn_sec_div_r(n, 8, L, 4, scratch.data());
+    return from_limbs(n);
+}
+
+// (a * b + c) mod L
+static std::string sc_muladd(const std::string & a, const std::string & b, const std::string & c){
+    mp_limb_t x[4], y[4], z[4], n[8];
+    to_limbs(a, x, 4);
+    to_limbs(b, y, 4);
+    to_limbs(c, z, 4);
+
+    std::vector <mp_limb_t> scratch(std::max(std::max(mpn_sec_mul_itch(4, 4), mpn_sec_div_r_itch(8, 4)), mpn_sec_add_1_itch(4)));
+    mpn_sec_mul(n, x, 4, y, 4, scratch.data());
+    const mp_limb_t carry = mpn_add_n(n, n, z, 4);
+    mpn_sec_add_1(n + 4, n + 4, 4, carry, scratch.data());
+    mpn_sec_div_r(n, 8, L, 4, scratch.data());
+    return from_limbs(n);
+}
+
+// s < L
+static bool sc_is_canonical(const std::string & s){
+    mp_limb_t n[4];
+    to_limbs(s, n, 4);
+    return mpn_cmp(n, L, 4) < 0;
+}
+
+static std::string sha512(const std::string & data){
+    return SHA512(data).digest();
+}
+
+std::string public_key(const std::string & seed){
+    if (seed.size() != KEY_SIZE){
+        throw std::runtime_error("Error: Ed25519 private key must be 32 octets.");
+    }
+
+    std::string a = sha512(seed).substr(0, 32);
+    a[0]  &= 248;
+    a[31] &= 127;
+    a[31] |= 64;
+    return ge_tobytes(ge_scalarmult_base(a));
+}
+
+std::string sign(const std::string & message, const std::string & seed, const std::string & pub){
+    if (seed.size() != KEY_SIZE){
+        throw std::runtime_error("Error: Ed25519 private key must be 32 octets.");
+    }
+
+    const std::string h = sha512(seed);
+    std::string a = h.substr(0, 32);
+    a[0]  &= 248;
+    a[31] &= 127;
+    a[31] |= 64;
+
+    // A is always derived from a: signing one seed under two different A values
+    // reuses r with different k, which reveals a
+    const std::string A = ge_tobytes(ge_scalarmult_base(a));
+    if (pub.size() && (pub != A)){
+        throw std::runtime_error("Error: Ed25519 public key does not match the private key.");
+    }
+    const std::string r = sc_reduce(sha512(h.substr(32, 32) + message));
+    const std::string R = ge_tobytes(ge_scalarmult_base(r));
+    const std::string k = sc_reduce(sha512(R + A + message));
+    return R + sc_muladd(k, a, r);
+}
+
+bool verify(const std::string & message, const std::string & signature, const std::string & pub){
+    return verify(std::vector <Signed> (1, {message, signature, pub}));
+}
+
+bool verify(const std::vector <Signed> & batch){
+    if (batch.empty()){
+        return true;
+    }
+
+    // [8]([sum z_i S_i]B - sum [z_i]R_i - sum [z_i k_i]A_i) == O,
+    // with z_i = 1 for a single signature
+    //
+    // z_i are 128 bit values derived from a hash of the whole batch,
+    // so they cannot be known before the signatures are chosen
+    std::string transcript;
+    if (batch.size() > 1){
+        for(Signed const & s : batch){
+            transcript += s.signature + s.pub + sha512(s.message);
+        }
+        transcript = sha512(transcript);
+    }
+
+    std::vector <Ge> points;
+    std::vector <std::string> scalars;
+    std::string sum(32, 0);
+    for(std::size_t i = 0; i < batch.size(); i++){
+        const Signed & s = batch[i];
+        if ((s.signature.size() != SIGNATURE_SIZE) || (s.pub.size() != KEY_SIZE)){
+            return false;
+        }
+
+        const std::string R = s.signature.substr(0, 32);
+        const std::string S = s.signature.substr(32, 32);
+        Ge r, a;
+        if (!sc_is_canonical(S) || !ge_frombytes(R, r) || !ge_frombytes(s.pub, a)){
+            return false;
+        }
+
+        std::string z(32, 0);
+        if (batch.size() > 1){
+            z.replace(0, 16, sha512(transcript + std::to_string(i)).substr(0, 16));
+        }
+        else{
+            z[0] = 1;
+        }
+
+        const std::string k = sc_reduce(sha512(R + s.pub + s.message));
+        sum = sc_muladd(z, S, sum);
+
+        points.push_back(ge_neg(r));
+        scalars.push_back(z);
+        points.push_back(ge_neg(a));
+        scalars.push_back(sc_muladd(z, k, std::string(32, 0)));
+    }
+
+    return ge_is_small_order(ge_add(ge_scalarmult_base(sum), ge_multiscalarmult_vartime(points, scalars)));
+}
+
+}
+}
+}
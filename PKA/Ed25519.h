@@ -0,0 +1,73 @@
+/*
+Ed25519.h
+Ed25519 signatures (RFC 8032)
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __ED25519__
+#define __ED25519__
+
+#include <string>
+#include <vector>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace Ed25519 {
+            // Field elements mod 2^255 - 19 are held in five 51 bit
+            // limbs. Everything that touches secret values (key
+            // generation and signing) runs in constant time;
+            // verification only handles public values and uses
+            // faster variable time code.
+            //
+            // All values are octet strings in the RFC 8032 encodings:
+            //     seed (private key)    32 octets
+            //     public key            32 octets
+            //     signature             64 octets (R || S)
+
+            const std::size_t KEY_SIZE       = 32;
+            const std::size_t SIGNATURE_SIZE = 64;
+
+            // derive the public key of a private key
+            std::string public_key(const std::string & seed);
+
+            // sign a message; the public key is derived from the seed, and a
+            // non-empty pub that does not match it is rejected
+            std::string sign(const std::string & message, const std::string & seed, const std::string & pub);
+
+            // verify one signature
+            bool verify(const std::string & message, const std::string & signature, const std::string & pub);
+
+            // one signature of a batch
+            struct Signed {
+                std::string message;
+                std::string signature;
+                std::string pub;
+            };
+
+            // verify many signatures with a single multi-scalar multiplication
+            // returns true only if all of the signatures are valid
+            bool verify(const std::vector <Signed> & batch);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+#include "EdDSA.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace EdDSA {
+
+// MPIs drop leading zeros
+static std::string fixed(const MPI & m){
+    const std::string raw = mpitoraw(m);
+    if (raw.size() > Ed25519::KEY_SIZE){
+        return "";
+    }
+    return std::string(Ed25519::KEY_SIZE - raw.size(), 0) + raw;
+}
+
+static std::string public_key(const Values & pub){
+    if (pub.size() < 1){
+        return "";
+    }
+
+    const std::string point = mpitoraw(pub[0]);
+    if ((point.size() != (Ed25519::KEY_SIZE + 1)) || (point[0] != 0x40)){
+        // "Error: EdDSA public key is not in native format.\n";
+        return "";
+    }
+
+    return point.substr(1);
+}
+
+Values keygen(Values & pub){
+    const std::string seed = RNG::bytes(Ed25519::KEY_SIZE);
+    pub = {rawtompi("\x40" + Ed25519::public_key(seed))};
+    return {rawtompi(seed)};
+}
+
+Values sign(const std::string & data, const Values & pri, const Values & pub){
+    if (!pri.size()){
+        // "Error: No EdDSA private key.\n";
+        return {};
+    }
+
+    const std::string sig = Ed25519::sign(data, fixed(pri[0]), public_key(pub));
+
+    // the native encodings of R and S are stored as MPIs without reordering
+    return {rawtompi(sig.substr(0, 32)), rawtompi(sig.substr(32, 32))};
+}
+
+bool verify(const std::string & data, const Values & sig, const Values & pub){
+    if (sig.size() < 2){
+        return false;
+    }
+
+    const std::string key = public_key(pub);
+    const std::string r = fixed(sig[0]);
+    const std::string s = fixed(sig[1]);
+    if (!key.size() || !r.size() || !s.size()){
+        return false;
+    }
+
+    return Ed25519::verify(data, r + s, key);
+}
+
+}
+}
+}
@@ -4,25 +4,20 @@ namespace OpenPGP {
 namespace PKA {
 namespace ElGamal {
 
-Values keygen(unsigned int bits){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
-
-    bits /= 5;
+Values keygen(unsigned int bits, ThreadPool * pool){
     // random prime q - only used for key generation
-    MPI q = bintompi(RNG::BBS().rand(bits));
-    q = nextprime(q);
-    while (bitsize(q) > bits){
-        q = bintompi(RNG::BBS().rand(bits));
-        q = nextprime(q);
-    }
-    bits *= 5;
+    const MPI q = Prime::random(bits / 5, pool);
 
     // random prime p = kq + 1
-    MPI p = bintompi("1" + RNG::BBS().rand(bits - 1));                // pick random starting point
-    p = ((p - 1) / q) * q + 1;                                        // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
-    while (!knuth_prime_test(p, 25)){
-        p += q;
-    }
+    MPI p;
+    do {
+        p = random(bits - 1) | (MPI(1) << (bits - 1));                // pick random starting point
+        p = ((p - 1) / q) * q + 1;                                    // set starting point to value such that p = kq + 1 for some k, while maintaining bitsize
+        if ((p & 1) == 0){                                            // only odd k give even p, so skip them
+            p += q;
+        }
+        p = Prime::next(p, q << 1, pool);
+    } while (bitsize(p) > bits);
 
     // generator g with order p
     MPI g = 1;
@@ -35,7 +30,7 @@ Values keygen(unsigned int bits){
     // 0 < x < p
     MPI x = 0;
     while ((x == 0) || (p <= x)){
-        x = bintompi(RNG::BBS().rand(bits));
+        x = random(bits);
     }
 
     // y = g^x mod p
@@ -45,18 +40,23 @@ Values keygen(unsigned int bits){
     return {p, g, y, x};
 }
 
-Values encrypt(const MPI & data, const Values & pub){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
-    MPI k = bintompi(RNG::BBS().rand(bitsize(pub[0])));
+Values encrypt(const MPI & data, const Values & pub, const ModExpContext::Ptr & context){
+    MPI k = random(bitsize(pub[0]));
     k %= pub[0];
     MPI r, s;
-    r = powm(pub[1], k, pub[0]);
-    s = powm(pub[2], k, pub[0]);
+    if (usable(context, pub[0], {pub[1], pub[2]})){
+        r = context -> powm(0, k);
+        s = context -> powm(1, k);
+    }
+    else{
+        r = powm(pub[1], k, pub[0]);
+        s = powm(pub[2], k, pub[0]);
+    }
     return {r, (data * s) % pub[0]};
 }
 
-Values encrypt(const std::string & data, const Values & pub){
-    return encrypt(rawtompi(data), pub);
+Values encrypt(const std::string & data, const Values & pub, const ModExpContext::Ptr & context){
+    return encrypt(rawtompi(data), pub, context);
 }
 
 std::string decrypt(const Values & c, const Values & pri, const Values & pub){
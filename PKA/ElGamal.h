@@ -30,17 +30,20 @@ THE SOFTWARE.
 #include "../common/includes.h"
 #include "../Misc/mpi.h"
 #include "../Misc/pgptime.h"
+#include "ModExp.h"
 #include "PKA.h"
+#include "Prime.h"
 
 namespace OpenPGP {
     namespace PKA {
         namespace ElGamal {
             // Generate ElGamal key values
-            Values keygen(unsigned int bits = 2048);
+            Values keygen(unsigned int bits = 2048, ThreadPool * pool = nullptr);
 
             // Encrypt data
-            Values encrypt(const MPI & data, const PKA::Values & pub);
-            Values encrypt(const std::string & data, const PKA::Values & pub);
+            // context is the exponentiation context of pub (see modexp_context), or nullptr
+            Values encrypt(const MPI & data, const PKA::Values & pub, const ModExpContext::Ptr & context = nullptr);
+            Values encrypt(const std::string & data, const PKA::Values & pub, const ModExpContext::Ptr & context = nullptr);
 
             // Decrypt data
             std::string decrypt(const PKA::Values & c, const PKA::Values & pri, const PKA::Values & pub);
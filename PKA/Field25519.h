@@ -0,0 +1,220 @@
+/*
+Field25519.h
+Arithmetic modulo 2^255 - 19 in radix 2^51
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __FIELD25519__
+#define __FIELD25519__
+
+#include <cstdint>
+#include <string>
+
+// arithmetic in GF(2^255 - 19), shared by Ed25519 and X25519
+// only meant to be included by their source files
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace Field25519 {
+            typedef unsigned __int128 uint128_t;
+
+            const uint64_t MASK51 = (static_cast <uint64_t> (1) << 51) - 1;
+
+            // element of GF(2^255 - 19): sum of v[i] * 2^(51 * i)
+            // every operation returns limbs of at most 51 bits plus a small carry
+            struct Fe {
+                uint64_t v[5];
+            };
+
+            inline Fe fe(const uint64_t x){
+                return {{x, 0, 0, 0, 0}};
+            }
+
+            inline Fe fe_carry(Fe r){
+                uint64_t c;
+                c = r.v[0] >> 51; r.v[0] &= MASK51; r.v[1] += c;
+                c = r.v[1] >> 51; r.v[1] &= MASK51; r.v[2] += c;
+                c = r.v[2] >> 51; r.v[2] &= MASK51; r.v[3] += c;
+                c = r.v[3] >> 51; r.v[3] &= MASK51; r.v[4] += c;
+                c = r.v[4] >> 51; r.v[4] &= MASK51; r.v[0] += c * 19;
+                return r;
+            }
+
+            inline Fe fe_add(const Fe & a, const Fe & b){
+                Fe r;
+                for(unsigned int i = 0; i < 5; i++){
+                    r.v[i] = a.v[i] + b.v[i];
+                }
+                return fe_carry(r);
+            }
+
+            // a - b computed as a + 2p - b so that no limb goes negative
+            inline Fe fe_sub(const Fe & a, const Fe & b){
+                Fe r;
+                r.v[0] = (a.v[0] + 0xfffffffffffdaULL) - b.v[0];
+                for(unsigned int i = 1; i < 5; i++){
+                    r.v[i] = (a.v[i] + 0xffffffffffffeULL) - b.v[i];
+                }
+                return fe_carry(r);
+            }
+
+            inline Fe fe_neg(const Fe & a){
+                return fe_sub(fe(0), a);
+            }
+
+            inline Fe fe_mul(const Fe & a, const Fe & b){
+                const uint64_t b1 = b.v[1] * 19, b2 = b.v[2] * 19, b3 = b.v[3] * 19, b4 = b.v[4] * 19;
+
+                uint128_t t0 = (uint128_t) a.v[0] * b.v[0] + (uint128_t) a.v[1] * b4     + (uint128_t) a.v[2] * b3     + (uint128_t) a.v[3] * b2     + (uint128_t) a.v[4] * b1;
+                uint128_t t1 = (uint128_t) a.v[0] * b.v[1] + (uint128_t) a.v[1] * b.v[0] + (uint128_t) a.v[2] * b4     + (uint128_t) a.v[3] * b3     + (uint128_t) a.v[4] * b2;
+                uint128_t t2 = (uint128_t) a.v[0] * b.v[2] + (uint128_t) a.v[1] * b.v[1] + (uint128_t) a.v[2] * b.v[0] + (uint128_t) a.v[3] * b4     + (uint128_t) a.v[4] * b3;
+                uint128_t t3 = (uint128_t) a.v[0] * b.v[3] + (uint128_t) a.v[1] * b.v[2] + (uint128_t) a.v[2] * b.v[1] + (uint128_t) a.v[3] * b.v[0] + (uint128_t) a.v[4] * b4;
+                uint128_t t4 = (uint128_t) a.v[0] * b.v[4] + (uint128_t) a.v[1] * b.v[3] + (uint128_t) a.v[2] * b.v[2] + (uint128_t) a.v[3] * b.v[1] + (uint128_t) a.v[4] * b.v[0];
+
+                Fe r;
+                t1 += static_cast <uint64_t> (t0 >> 51); r.v[0] = static_cast <uint64_t> (t0) & MASK51;
+                t2 += static_cast <uint64_t> (t1 >> 51); r.v[1] = static_cast <uint64_t> (t1) & MASK51;
+                t3 += static_cast <uint64_t> (t2 >> 51); r.v[2] = static_cast <uint64_t> (t2) & MASK51;
+                t4 += static_cast <uint64_t> (t3 >> 51); r.v[3] = static_cast <uint64_t> (t3) & MASK51;
+                r.v[0] += static_cast <uint64_t> (t4 >> 51) * 19; r.v[4] = static_cast <uint64_t> (t4) & MASK51;
+                r.v[1] += r.v[0] >> 51; r.v[0] &= MASK51;
+                return r;
+            }
+
+            inline Fe fe_sq(const Fe & a){
+                return fe_mul(a, a);
+            }
+
+            inline Fe fe_sqn(Fe a, unsigned int n){
+                while (n--){
+                    a = fe_sq(a);
+                }
+                return a;
+            }
+
+            // r = b ? g : f, in constant time
+            inline void fe_cmov(Fe & f, const Fe & g, const uint64_t b){
+                const uint64_t mask = -b;
+                for(unsigned int i = 0; i < 5; i++){
+                    f.v[i] ^= mask & (f.v[i] ^ g.v[i]);
+                }
+            }
+
+            // swap f and g if b is set, in constant time
+            inline void fe_cswap(Fe & f, Fe & g, const uint64_t b){
+                const uint64_t mask = -b;
+                for(unsigned int i = 0; i < 5; i++){
+                    const uint64_t x = mask & (f.v[i] ^ g.v[i]);
+                    f.v[i] ^= x;
+                    g.v[i] ^= x;
+                }
+            }
+
+            // canonical little endian encoding
+            inline std::string fe_tobytes(const Fe & a){
+                Fe t = fe_carry(fe_carry(a));
+
+                // add 19 and see if the result reaches 2^255, ie t >= p
+                uint64_t q = (t.v[0] + 19) >> 51;
+                q = (t.v[1] + q) >> 51;
+                q = (t.v[2] + q) >> 51;
+                q = (t.v[3] + q) >> 51;
+                q = (t.v[4] + q) >> 51;
+
+                t.v[0] += 19 * q;
+                t.v[1] += t.v[0] >> 51; t.v[0] &= MASK51;
+                t.v[2] += t.v[1] >> 51; t.v[1] &= MASK51;
+                t.v[3] += t.v[2] >> 51; t.v[2] &= MASK51;
+                t.v[4] += t.v[3] >> 51; t.v[3] &= MASK51;
+                t.v[4] &= MASK51;
+
+                const uint64_t w[4] = {
+                    t.v[0]         | (t.v[1] << 51),
+                    (t.v[1] >> 13) | (t.v[2] << 38),
+                    (t.v[2] >> 26) | (t.v[3] << 25),
+                    (t.v[3] >> 39) | (t.v[4] << 12),
+                };
+
+                std::string out(32, 0);
+                for(unsigned int i = 0; i < 32; i++){
+                    out[i] = static_cast <char> (w[i >> 3] >> ((i & 7) << 3));
+                }
+                return out;
+            }
+
+            // the top bit is ignored
+            inline Fe fe_frombytes(const std::string & s){
+                uint64_t w[4] = {0, 0, 0, 0};
+                for(unsigned int i = 0; i < 32; i++){
+                    w[i >> 3] |= static_cast <uint64_t> (static_cast <unsigned char> (s[i])) << ((i & 7) << 3);
+                }
+
+                return {{
+                    w[0] & MASK51,
+                    ((w[0] >> 51) | (w[1] << 13)) & MASK51,
+                    ((w[1] >> 38) | (w[2] << 26)) & MASK51,
+                    ((w[2] >> 25) | (w[3] << 39)) & MASK51,
+                    (w[3] >> 12) & MASK51,
+                }};
+            }
+
+            inline bool fe_iszero(const Fe & a){
+                return fe_tobytes(a) == std::string(32, 0);
+            }
+
+            inline bool fe_isnegative(const Fe & a){
+                return fe_tobytes(a)[0] & 1;
+            }
+
+            // z^(2^250 - 1), and z^11 through z11
+            inline Fe fe_pow_2_250_1(const Fe & z, Fe & z11){
+                const Fe z2 = fe_sq(z);
+                const Fe z9 = fe_mul(fe_sqn(z2, 2), z);
+                z11 = fe_mul(z9, z2);
+                const Fe z_5_0   = fe_mul(fe_sq(z11), z9);
+                const Fe z_10_0  = fe_mul(fe_sqn(z_5_0, 5), z_5_0);
+                const Fe z_20_0  = fe_mul(fe_sqn(z_10_0, 10), z_10_0);
+                const Fe z_40_0  = fe_mul(fe_sqn(z_20_0, 20), z_20_0);
+                const Fe z_50_0  = fe_mul(fe_sqn(z_40_0, 10), z_10_0);
+                const Fe z_100_0 = fe_mul(fe_sqn(z_50_0, 50), z_50_0);
+                const Fe z_200_0 = fe_mul(fe_sqn(z_100_0, 100), z_100_0);
+                return fe_mul(fe_sqn(z_200_0, 50), z_50_0);
+            }
+
+            // z^(p - 2) = z^-1
+            inline Fe fe_invert(const Fe & z){
+                Fe z11;
+                const Fe t = fe_pow_2_250_1(z, z11);
+                return fe_mul(fe_sqn(t, 5), z11);
+            }
+
+            // z^((p - 5) / 8)
+            inline Fe fe_pow22523(const Fe & z){
+                Fe z11;
+                const Fe t = fe_pow_2_250_1(z, z11);
+                return fe_mul(fe_sqn(t, 2), z);
+            }
+        }
+    }
+}
+
+#endif
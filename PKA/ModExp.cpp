@@ -0,0 +1,242 @@
+#include "ModExp.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace OpenPGP {
+namespace PKA {
+
+// copy a value into exactly n limbs
+static void to_limbs(const MPI & value, mp_limb_t * out, const std::size_t n){
+    const mpz_srcptr z = value.get_mpz_t();
+    for(std::size_t i = 0; i < n; i++){
+        out[i] = mpz_getlimbn(z, i);
+    }
+}
+
+FixedBase::FixedBase(const MPI & base, const MPI & mod, const std::size_t bits, const unsigned int window)
+    : base(base),
+      mod(mod),
+      bits(bits),
+      window(window),
+      limbs(mpz_size(mod.get_mpz_t())),
+      modulus(limbs),
+      table()
+{
+    if ((mod <= 1) || !window || (window > 8)){
+        throw std::runtime_error("Error: Bad fixed base parameters.");
+    }
+
+    to_limbs(mod, modulus.data(), limbs);
+
+    const std::size_t windows = (bits + window - 1) / window;
+    const std::size_t entries = 1 << window;
+    table.resize(windows * entries * limbs);
+
+    // the base is public, so the table is built with ordinary arithmetic
+    MPI power = base % mod;                                 // base^(2^(w * i))
+    if (power < 0){
+        power += mod;
+    }
+
+    mp_limb_t * entry = table.data();
+    for(std::size_t i = 0; i < windows; i++){
+        MPI value = 1;
+        for(std::size_t j = 0; j < entries; j++){
+            to_limbs(value, entry, limbs);
+            entry += limbs;
+            value = (value * power) % mod;
+        }
+        power = value;
+    }
+}
+
+std::size_t FixedBase::get_bits() const{
+    return bits;
+}
+
+bool FixedBase::fits(const MPI & exp) const{
+    return (exp >= 0) && ((exp >> static_cast <mp_bitcnt_t> (bits)) == 0);
+}
+
+MPI FixedBase::powm(const MPI & exp) const{
+    // every exponent is processed at the full table width so that
+    // the time taken does not depend on the length of exp
+    if (!fits(exp)){
+        throw std::runtime_error("Error: Exponent does not fit into the fixed base table.");
+    }
+
+    const std::size_t windows = (bits + window - 1) / window;
+    if (!windows){
+        return MPI(1) % mod;
+    }
+
+    const std::size_t entries = 1 << window;
+    const std::size_t mask = entries - 1;
+    const std::size_t entry_limbs = entries * limbs;
+
+    // the exponent with one spare limb so that digits never read past the end
+    std::vector <mp_limb_t> e((bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS + 1);
+    to_limbs(exp, e.data(), e.size());
+
+    auto digit = [&](const std::size_t i){
+        const std::size_t offset = i * window;
+        const std::size_t limb = offset / GMP_NUMB_BITS;
+        const std::size_t shift = offset % GMP_NUMB_BITS;
+        mp_limb_t d = e[limb] >> shift;
+        if (shift + window > GMP_NUMB_BITS){
+            d |= e[limb + 1] << (GMP_NUMB_BITS - shift);
+        }
+        return static_cast <mp_size_t> (d & mask);
+    };
+
+    std::vector <mp_limb_t> acc(limbs), entry(limbs), product(2 * limbs);
+    std::vector <mp_limb_t> scratch(std::max(mpn_sec_mul_itch(limbs, limbs), mpn_sec_div_r_itch(2 * limbs, limbs)));
+
+    // every window costs the same whatever its digit is
+    mpn_sec_tabselect(acc.data(), table.data(), limbs, entries, digit(0));
+    for(std::size_t i = 1; i < windows; i++){
+        mpn_sec_tabselect(entry.data(), table.data() + i * entry_limbs, limbs, entries, digit(i));
+        mpn_sec_mul(product.data(), acc.data(), limbs, entry.data(), limbs, scratch.data());
+        mpn_sec_div_r(product.data(), 2 * limbs, modulus.data(), limbs, scratch.data());
+        std::copy(product.begin(), product.begin() + limbs, acc.begin());
+    }
+
+    MPI out;
+    mpz_ptr z = out.get_mpz_t();
+    std::copy(acc.begin(), acc.end(), mpz_limbs_write(z, limbs));
+    mpz_limbs_finish(z, limbs);
+    return out;
+}
+
+ModExpContext::ModExpContext(const MPI & mod, const Values & bases, const std::size_t bits)
+    : mod(mod),
+      bases(),
+      crt()
+{
+    for(MPI const & base : bases){
+        std::shared_ptr <Base> b = std::make_shared <Base> ();
+        b -> base = base;
+        b -> bits = bits;
+        b -> uses = 0;
+        b -> ready = false;
+        this -> bases.push_back(b);
+    }
+}
+
+const MPI & ModExpContext::get_mod() const{
+    return mod;
+}
+
+std::size_t ModExpContext::get_base_count() const{
+    return bases.size();
+}
+
+const MPI & ModExpContext::get_base(const std::size_t index) const{
+    return bases.at(index) -> base;
+}
+
+bool ModExpContext::count_use(const std::size_t index) const{
+    Base & b = *bases.at(index);
+    if (b.ready.load(std::memory_order_acquire)){
+        return true;
+    }
+
+    // one-off uses are cheaper without a table
+    if (b.uses.fetch_add(1, std::memory_order_relaxed) < BUILD_AFTER){
+        return false;
+    }
+
+    std::call_once(b.built, [&](){
+        b.table = std::make_shared <FixedBase> (b.base, mod, b.bits);
+        b.ready.store(true, std::memory_order_release);
+    });
+
+    return true;
+}
+
+MPI ModExpContext::powm(const std::size_t index, const MPI & exp, const bool secret) const{
+    const Base & b = *bases.at(index);
+    if (!count_use(index) || (!secret && !b.table -> fits(exp))){
+        return secret?OpenPGP::powm(b.base, exp, mod):powm_public(b.base, exp, mod);
+    }
+
+    return b.table -> powm(exp);
+}
+
+MPI ModExpContext::powm2_public(const MPI & exp0, const MPI & exp1) const{
+    // both uses are counted, even when the first table is not ready
+    const bool table0 = count_use(0);
+    const bool table1 = count_use(1);
+    if (!(table0 && table1 && bases[0] -> table -> fits(exp0) && bases[1] -> table -> fits(exp1))){
+        return OpenPGP::powm2_public(bases[0] -> base, exp0, bases[1] -> base, exp1, mod);
+    }
+
+    return (bases[0] -> table -> powm(exp0) * bases[1] -> table -> powm(exp1)) % mod;
+}
+
+bool ModExpContext::has_table(const std::size_t index) const{
+    return bases.at(index) -> ready.load(std::memory_order_acquire);
+}
+
+bool ModExpContext::set_crt(const Values & pri){
+    if ((pri.size() < 4) || (pri[1] <= 1) || (pri[2] <= 1) || ((pri[1] * pri[2]) != mod)){
+        return false;
+    }
+
+    std::shared_ptr <CRT> values = std::make_shared <CRT> ();
+    values -> d = pri[0];
+    values -> p = pri[1];
+    values -> q = pri[2];
+    values -> dp = pri[0] % (pri[1] - 1);
+    values -> dq = pri[0] % (pri[2] - 1);
+    values -> u = pri[3];
+    crt = values;
+
+    return true;
+}
+
+bool ModExpContext::has_crt() const{
+    return static_cast <bool> (crt);
+}
+
+bool ModExpContext::has_crt(const Values & pri) const{
+    return crt && (pri.size() >= 4) &&
+           (crt -> d == pri[0]) && (crt -> p == pri[1]) &&
+           (crt -> q == pri[2]) && (crt -> u == pri[3]);
+}
+
+MPI ModExpContext::powm_crt(const MPI & data) const{
+    if (!crt){
+        throw std::runtime_error("Error: No private values in exponentiation context.");
+    }
+
+    // half size exponentiations
+    const MPI m1 = OpenPGP::powm(data % crt -> p, crt -> dp, crt -> p);
+    const MPI m2 = OpenPGP::powm(data % crt -> q, crt -> dq, crt -> q);
+
+    // Garner's recombination
+    MPI h = ((m2 - m1) * crt -> u) % crt -> q;
+    if (h < 0){
+        h += crt -> q;
+    }
+
+    return m1 + (h * crt -> p);
+}
+
+bool usable(const ModExpContext::Ptr & context, const MPI & mod, const Values & bases){
+    if (!context || (context -> get_mod() != mod) || (context -> get_base_count() != bases.size())){
+        return false;
+    }
+
+    for(std::size_t i = 0; i < bases.size(); i++){
+        if (context -> get_base(i) != bases[i]){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+}
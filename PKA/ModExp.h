@@ -0,0 +1,148 @@
+/*
+ModExp.h
+Precomputed values for repeated modular exponentiation
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __MODEXP__
+#define __MODEXP__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gmp.h>
+
+#include "../Misc/mpi.h"
+#include "PKA.h"
+
+namespace OpenPGP {
+    namespace PKA {
+
+        // Powers of one base for exponents of at most a fixed number of bits
+        //
+        // The exponent is cut into windows of w bits, and the table
+        // holds base^(j * 2^(w * i)) mod m for every window i and
+        // every digit j. An exponentiation is then one modular
+        // multiplication per window and no squarings. Entries are
+        // selected and multiplied in constant time, so the exponent
+        // may be secret.
+        class FixedBase {
+            private:
+                MPI base;
+                MPI mod;
+                std::size_t bits;
+                unsigned int window;
+                mp_size_t limbs;                    // limbs in the modulus
+                std::vector <mp_limb_t> modulus;
+                std::vector <mp_limb_t> table;      // windows * 2^window entries of limbs each
+
+            public:
+                typedef std::shared_ptr <FixedBase> Ptr;
+
+                FixedBase(const MPI & base, const MPI & mod, const std::size_t bits, const unsigned int window = 4);
+
+                std::size_t get_bits() const;
+
+                // whether 0 <= exp < 2^bits
+                bool fits(const MPI & exp) const;
+
+                // base^exp mod m; throws if exp does not fit into the table
+                MPI powm(const MPI & exp) const;
+        };
+
+        // Values that only depend on a key, kept so that repeated
+        // operations with the key do not compute them again
+        //
+        //    - fixed bases (such as the DSA and ELGAMAL g and y),
+        //      whose tables are built once a base has been used
+        //      often enough to pay for them
+        //    - RSA private values in Chinese Remainder Theorem form
+        //
+        // A context may be shared between threads once its private
+        // values have been set.
+        class ModExpContext {
+            private:
+                struct Base {
+                    MPI base;
+                    std::size_t bits;
+                    std::atomic <unsigned int> uses;
+                    std::atomic <bool> ready;
+                    std::once_flag built;
+                    FixedBase::Ptr table;
+                };
+
+                struct CRT {
+                    MPI d;          // private exponent
+                    MPI p, q;       // primes
+                    MPI dp, dq;     // d mod (p - 1), d mod (q - 1)
+                    MPI u;          // p^-1 mod q
+                };
+
+                MPI mod;
+                std::vector <std::shared_ptr <Base> > bases;
+                std::shared_ptr <const CRT> crt;
+
+                // counts a use of bases[index] and builds its table once the base
+                // has been used often enough; returns whether the table is ready
+                bool count_use(const std::size_t index) const;
+
+            public:
+                typedef std::shared_ptr <ModExpContext> Ptr;
+
+                // a table costs about as much as this many plain exponentiations
+                static const unsigned int BUILD_AFTER = 3;
+
+                // bases are fixed bases for exponents of up to bits bits
+                explicit ModExpContext(const MPI & mod, const Values & bases = {}, const std::size_t bits = 0);
+
+                const MPI & get_mod() const;
+                std::size_t get_base_count() const;
+                const MPI & get_base(const std::size_t index) const;
+
+                // bases[index]^exp mod m
+                // exp may only be public if secret is false; secret
+                // exponents must fit into the bits given to the constructor
+                MPI powm(const std::size_t index, const MPI & exp, const bool secret = true) const;
+                bool has_table(const std::size_t index) const;
+
+                // bases[0]^exp0 * bases[1]^exp1 mod m for public exponents
+                // uses Shamir's trick until the tables of both bases are built
+                MPI powm2_public(const MPI & exp0, const MPI & exp1) const;
+
+                // RSA private values {d, p, q, u}; returns false if they do not belong to the modulus
+                bool set_crt(const Values & pri);
+                bool has_crt() const;
+                bool has_crt(const Values & pri) const;     // whether the private values set are pri
+
+                // data^d mod m using the private values
+                MPI powm_crt(const MPI & data) const;
+        };
+
+        // whether context is set up for the modulus mod and exactly the given fixed bases
+        bool usable(const ModExpContext::Ptr & context, const MPI & mod, const Values & bases);
+    }
+}
+
+#endif
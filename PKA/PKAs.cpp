@@ -50,6 +50,15 @@ Params generate_params(const uint8_t pka, const std::size_t bits){
 
             params.push_back((bits == 1024)?160:256);
             break;
+        #ifdef GPG_COMPATIBLE
+        case ID::ECDH:
+        case ID::EdDSA:
+            break;
+        case ID::ECDSA:
+            // bits is half of the key size, as with RSA
+            params = {((bits << 1) > 256)?ECC::ID::P384:ECC::ID::P256};
+            break;
+        #endif
         default:
             // "Error: Undefined or reserved PKA number: " + std::to_string(pka) + "\n";
             return {};
@@ -59,7 +68,7 @@ Params generate_params(const uint8_t pka, const std::size_t bits){
     return params;
 }
 
-uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub){
+uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub, ThreadPool * pool){
     if (!params.size()){
         // "Error: No PKA key generation configuration provided.\n";
         return 0;
@@ -69,7 +78,7 @@ uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri,
         case ID::RSA_ENCRYPT_OR_SIGN:
         case ID::RSA_ENCRYPT_ONLY:
         case ID::RSA_SIGN_ONLY:
-            pub = RSA::keygen(params[0]);                // n, e, d, p, q, u
+            pub = RSA::keygen(params[0], pool);          // n, e, d, p, q, u
             if (!pub.size()){
                 // "Error: Bad RSA key generation values.\n";
                 return 0;
@@ -81,14 +90,25 @@ uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri,
             pub.pop_back();                              // d
             break;
         case ID::ELGAMAL:
-            pub = ElGamal::keygen(params[0]);            // p, g, y, x
+            pub = ElGamal::keygen(params[0], pool);      // p, g, y, x
             pri = {pub[3]};                              // x
             pub.pop_back();                              // x
             break;
         case ID::DSA:
-            pub = DSA::new_public(params[0], params[1]); // p, q, g
+            pub = DSA::new_public(params[0], params[1], pool); // p, q, g
             pri = DSA::keygen(pub);                      // x
             break;
+        #ifdef GPG_COMPATIBLE
+        case ID::ECDH:
+            pri = ECDH::keygen(pub, unhexlify(CURVE_OID::CURVE_255)); // Curve25519 point, secret
+            break;
+        case ID::ECDSA:
+            pri = ECDSA::keygen(pub, params[0]);         // point, secret
+            break;
+        case ID::EdDSA:
+            pri = EdDSA::keygen(pub);                    // seed
+            break;
+        #endif
         default:
             // "Error: Undefined or reserved PKA number: " + std::to_string(pka) + "\n";
             return 0;
@@ -98,5 +118,76 @@ uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri,
     return pka;
 }
 
+std::size_t generate_keypairs(const uint8_t pka, const Params & params, const std::size_t count, std::vector <Values> & pri, std::vector <Values> & pub, ThreadPool & pool){
+    pri.assign(count, Values());
+    pub.assign(count, Values());
+
+    // each keypair is generated by one worker; the prime searches are not split again
+    // jobs must not throw, so the first exception is passed on once every job is done
+    std::vector <uint8_t> ok(count, 0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    for(std::size_t i = 0; i < count; i++){
+        pool.submit([&, i](){
+            try {
+                ok[i] = generate_keypair(pka, params, pri[i], pub[i]);
+            }
+            catch (...) {
+                std::lock_guard <std::mutex> lock(error_mutex);
+                if (!error){
+                    error = std::current_exception();
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    if (error){
+        std::rethrow_exception(error);
+    }
+
+    // move failed keypairs out
+    std::size_t generated = 0;
+    for(std::size_t i = 0; i < count; i++){
+        if (ok[i]){
+            if (generated != i){
+                pri[generated] = std::move(pri[i]);
+                pub[generated] = std::move(pub[i]);
+            }
+            generated++;
+        }
+    }
+    pri.resize(generated);
+    pub.resize(generated);
+
+    return generated;
+}
+
+ModExpContext::Ptr modexp_context(const uint8_t pka, const Values & pub){
+    switch (pka){
+        case ID::RSA_ENCRYPT_OR_SIGN:
+        case ID::RSA_ENCRYPT_ONLY:
+        case ID::RSA_SIGN_ONLY:
+            if (pub.size() >= 2){
+                return std::make_shared <ModExpContext> (pub[0]);
+            }
+            break;
+        case ID::ELGAMAL:
+            if (pub.size() >= 3){
+                return std::make_shared <ModExpContext> (pub[0], Values({pub[1], pub[2]}), bitsize(pub[0]));
+            }
+            break;
+        case ID::DSA:
+            if (pub.size() >= 4){
+                return std::make_shared <ModExpContext> (pub[0], Values({pub[2], pub[3]}), bitsize(pub[1]));
+            }
+            break;
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
 }
 }
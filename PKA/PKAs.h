@@ -26,13 +26,20 @@ THE SOFTWARE.
 #ifndef __PKAS__
 #define __PKAS__
 
+#include <exception>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 
 #include "PKA.h"
 
 #include "DSA.h"
+#include "ECDH.h"
+#include "ECDSA.h"
+#include "EdDSA.h"
 #include "ElGamal.h"
+#include "ModExp.h"
+#include "Prime.h"
 #include "RSA.h"
 
 namespace OpenPGP {
@@ -96,7 +103,6 @@ namespace OpenPGP {
         };
 
 
-        #ifdef GPG_COMPATIBLE
         namespace CURVE_OID {
             const std::string NIST_256          = "2A8648CE3D030107";
             const std::string NIST_384          = "2B81040022";
@@ -107,6 +113,7 @@ namespace OpenPGP {
             const std::string CURVE_255         = "2B060104019755010501";
         }
 
+        #ifdef GPG_COMPATIBLE
         const std::map <std::string, std::string> CURVE_OID_STRING = {
             std::make_pair(CURVE_OID::NIST_256,         "1.2.840.10045.3.1.7"),
             std::make_pair(CURVE_OID::NIST_384,         "1.3.132.0.34"),
@@ -171,13 +178,31 @@ namespace OpenPGP {
         /*
             params:
                 DSA = {L, N}
+                ECDSA = {ECC::ID}
                 ELGAMAL = {bits}
                 RSA = {bits}
 
             pub and pri are destination containers
+
+            the prime searches of DSA, ELGAMAL, and RSA run on pool, if given
         */
         Params generate_params(const uint8_t pka, const std::size_t bits);
-        uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub);
+        uint8_t generate_keypair(const uint8_t pka, const Params & params, Values & pri, Values & pub, ThreadPool * pool = nullptr);
+
+        // generate count independent keypairs, one per job on pool
+        // returns the number of keypairs that were generated; the first
+        // exception thrown by a job is rethrown after all of them finish
+        std::size_t generate_keypairs(const uint8_t pka, const Params & params, const std::size_t count, std::vector <Values> & pri, std::vector <Values> & pub, ThreadPool & pool);
+
+        /*
+            exponentiation context of a public key:
+                DSA = modulus p, fixed bases {g, y} for exponents mod q
+                ELGAMAL = modulus p, fixed bases {g, y}
+                RSA = modulus n
+
+            returns nullptr for other algorithms
+        */
+        ModExpContext::Ptr modexp_context(const uint8_t pka, const Values & pub);
     }
 }
 
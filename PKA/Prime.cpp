@@ -0,0 +1,182 @@
+#include "Prime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#include "../RNG/RNGs.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace Prime {
+
+const std::vector <unsigned long> & small_primes(){
+    static const std::vector <unsigned long> primes = [](){
+        const unsigned long limit = 1 << 14;
+        std::vector <bool> composite(limit, false);
+        std::vector <unsigned long> out;
+        for(unsigned long i = 3; i < limit; i += 2){
+            if (!composite[i]){
+                out.push_back(i);
+                for(unsigned long j = i * i; j < limit; j += i << 1){
+                    composite[j] = true;
+                }
+            }
+        }
+        return out;
+    }();
+    return primes;
+}
+
+// a^-1 mod m for 0 < a < m, m prime
+static unsigned long invert_small(unsigned long a, const unsigned long m){
+    long t = 0, new_t = 1;
+    unsigned long r = m;
+    while (a){
+        const unsigned long q = r / a;
+        const long tmp_t = t - static_cast <long> (q) * new_t;
+        t = new_t;
+        new_t = tmp_t;
+        const unsigned long tmp_r = r - q * a;
+        r = a;
+        a = tmp_r;
+    }
+    return (t < 0)?(t + m):t;
+}
+
+// one window of one search
+struct Search {
+    MPI start;
+    std::vector <std::size_t> survivors;        // offsets (in steps) left after sieving
+    std::atomic <std::size_t> next;             // next survivor to test
+    std::atomic <std::size_t> found;            // first survivor found to be prime
+
+    Search()
+        : start(), survivors(), next(0), found(std::numeric_limits <std::size_t>::max())
+    {}
+};
+
+static void sieve(Search & search, const MPI & step){
+    std::vector <bool> composite(WINDOW, false);
+
+    // small values could be crossed out as multiples of themselves
+    const std::vector <unsigned long> & primes = small_primes();
+    if (search.start > primes.back()){
+        for(unsigned long const p : primes){
+            const unsigned long r = mpz_fdiv_ui(search.start.get_mpz_t(), p);
+            const unsigned long t = mpz_fdiv_ui(step.get_mpz_t(), p);
+            if (!t){
+                // every candidate has the same remainder
+                if (!r){
+                    std::fill(composite.begin(), composite.end(), true);
+                }
+                continue;
+            }
+
+            // start + i * step = 0 (mod p)
+            const unsigned long first = ((p - r) % p) * invert_small(t, p) % p;
+            for(std::size_t i = first; i < WINDOW; i += p){
+                composite[i] = true;
+            }
+        }
+    }
+
+    search.survivors.clear();
+    for(std::size_t i = 0; i < WINDOW; i++){
+        if (!composite[i]){
+            search.survivors.push_back(i);
+        }
+    }
+    search.next = 0;
+    search.found = std::numeric_limits <std::size_t>::max();
+}
+
+// test survivors until one is prime or none are left; survivors are handed
+// out in order, so once every worker is done, found is the smallest prime
+static void test(Search & search, const MPI & step){
+    MPI candidate;
+    std::size_t i;
+    while (((i = search.next++) < search.survivors.size()) && (i < search.found)){
+        candidate = search.start + step * static_cast <unsigned long> (search.survivors[i]);
+        if (mpz_probab_prime_p(candidate.get_mpz_t(), ROUNDS)){
+            std::size_t found = search.found;
+            while ((i < found) && !search.found.compare_exchange_weak(found, i));
+            return;
+        }
+    }
+}
+
+MPI next(const MPI & start, const MPI & step, ThreadPool * pool){
+    return next(std::vector <MPI> ({start}), step, pool)[0];
+}
+
+std::vector <MPI> next(const std::vector <MPI> & starts, const MPI & step, ThreadPool * pool){
+    if (step <= 0){
+        throw std::runtime_error("Error: Prime search step must be positive.");
+    }
+
+    std::vector <MPI> out(starts.size(), 0);
+    std::vector <Search> searches(starts.size());
+    std::vector <Search *> remaining;
+    for(std::size_t i = 0; i < starts.size(); i++){
+        searches[i].start = starts[i];
+        remaining.push_back(&searches[i]);
+    }
+
+    while (remaining.size()){
+        for(Search * search : remaining){
+            sieve(*search, step);
+        }
+
+        // every worker starts on a different search, then helps with the others
+        const std::size_t workers = pool?pool -> size():1;
+        for(std::size_t w = 0; w < workers; w++){
+            auto job = [&remaining, &step, w](){
+                for(std::size_t s = 0; s < remaining.size(); s++){
+                    test(*remaining[(w + s) % remaining.size()], step);
+                }
+            };
+
+            if (pool){
+                pool -> submit(job);
+            }
+            else{
+                job();
+            }
+        }
+        if (pool){
+            pool -> wait();
+        }
+
+        // searches without a prime move on to the next window
+        std::vector <Search *> left;
+        for(Search * search : remaining){
+            if (search -> found < search -> survivors.size()){
+                out[search - searches.data()] = search -> start + step * static_cast <unsigned long> (search -> survivors[search -> found]);
+            }
+            else{
+                search -> start += step * static_cast <unsigned long> (WINDOW);
+                left.push_back(search);
+            }
+        }
+        remaining.swap(left);
+    }
+
+    return out;
+}
+
+MPI random(const unsigned int bits, ThreadPool * pool){
+    if (bits < 2){
+        throw std::runtime_error("Error: A prime needs at least 2 bits.");
+    }
+
+    MPI p;
+    do {
+        p = next(OpenPGP::random(bits - 1) | (MPI(1) << (bits - 1)) | 1, 2, pool);
+    } while (bitsize(p) > bits);
+    return p;
+}
+
+}
+}
+}
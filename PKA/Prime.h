@@ -0,0 +1,68 @@
+/*
+Prime.h
+Probable prime generation for key generation
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __PRIME__
+#define __PRIME__
+
+#include <cstddef>
+#include <vector>
+
+#include "../common/ThreadPool.h"
+#include "../Misc/mpi.h"
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace Prime {
+            // Candidates are checked in windows of this many values.
+            // Multiples of the small primes are crossed out first, and
+            // only the rest are given to Miller-Rabin.
+            const std::size_t WINDOW = 8192;
+
+            // Miller-Rabin rounds
+            const int ROUNDS = 25;
+
+            // odd primes used for sieving
+            const std::vector <unsigned long> & small_primes();
+
+            // First probable prime of the form start + k * step, k >= 0.
+            // step has to be even and start odd. The Miller-Rabin tests of
+            // a window run on pool, if one is given. Workers stop once a
+            // prime has been found, but the result is always the first
+            // prime, so it does not depend on the number of threads.
+            // This waits on pool, so it must not be called from one of
+            // pool's own jobs.
+            MPI next(const MPI & start, const MPI & step = 2, ThreadPool * pool = nullptr);
+
+            // next() for several starting points at once, searched at the
+            // same time (the p and q of an RSA key)
+            std::vector <MPI> next(const std::vector <MPI> & starts, const MPI & step = 2, ThreadPool * pool = nullptr);
+
+            // probable prime of exactly bits bits
+            MPI random(const unsigned int bits, ThreadPool * pool = nullptr);
+        }
+    }
+}
+
+#endif
@@ -4,9 +4,7 @@ namespace OpenPGP {
 namespace PKA {
 namespace RSA {
 
-Values keygen(const uint32_t & bits){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
-
+Values keygen(const uint32_t & bits, ThreadPool * pool){
     MPI p = 3;
     MPI q = 3;
 
@@ -21,8 +19,10 @@ Values keygen(const uint32_t & bits){
 
     MPI n;
     while (true){
-        p = nextprime(bintompi("1" + RNG::BBS().rand(bits - 1)));
-        q = nextprime(bintompi("1" + RNG::BBS().rand(bits - 1)));
+        const MPI top = MPI(1) << (bits - 1);
+        const std::vector <MPI> pq = Prime::next({random(bits - 1) | top | 1, random(bits - 1) | top | 1}, 2, pool);
+        p = pq[0];
+        q = pq[1];
         n = p * q;
 
         const std::size_t nbits = bitsize(n);
@@ -33,8 +33,9 @@ Values keygen(const uint32_t & bits){
     #else
     // don't check bitsize
     while (p == q){
-        p = nextprime(bintompi(RNG::BBS().rand(bits)));
-        q = nextprime(bintompi(RNG::BBS().rand(bits)));
+        const std::vector <MPI> pq = Prime::next({random(bits) | 1, random(bits) | 1}, 2, pool);
+        p = pq[0];
+        q = pq[1];
     }
     const MPI n = p * q;
     #endif
@@ -46,7 +47,7 @@ Values keygen(const uint32_t & bits){
 
     const MPI tot = (p - 1) * (q - 1);
 
-    MPI e = bintompi(RNG::BBS().rand(bits));
+    MPI e = random(bits);
     e += ((e & 1) == 0);
     while (mpigcd(tot, e) != 1){
         e += 2;
@@ -64,20 +65,47 @@ MPI encrypt(const std::string & data, const Values & pub){
     return powm(rawtompi(data), pub[1], pub[0]);
 }
 
-MPI decrypt(const MPI & data, const Values & pri, const Values & pub){
-    return powm(data, pri[0], pub[0]);
+MPI decrypt(const MPI & data, const Values & pri, const Values & pub, const bool check){
+    const ModExpContext::Ptr context = std::make_shared <ModExpContext> (pub[0]);
+
+    // only the private exponent is available
+    if (!context -> set_crt(pri)){
+        return powm(data, pri[0], pub[0]);
+    }
+
+    return decrypt(data, context, pub, check);
+}
+
+MPI decrypt(const MPI & data, const ModExpContext::Ptr & context, const Values & pub, const bool check){
+    if (!context){
+        throw std::runtime_error("Error: No RSA exponentiation context given.");
+    }
+
+    const MPI out = context -> powm_crt(data);
+
+    if (check && (powm(out, pub[1], pub[0]) != (data % pub[0]))){
+        throw std::runtime_error("Error: RSA private key operation failed verification.");
+    }
+
+    return out;
+}
+
+MPI sign(const MPI & data, const Values & pri, const Values & pub, const bool check){
+    return decrypt(data, pri, pub, check);
 }
 
-MPI sign(const MPI & data, const Values & pri, const Values & pub){
-    return decrypt(data, pri, pub);
+MPI sign(const std::string & data, const Values & pri, const Values & pub, const bool check){
+    return decrypt(rawtompi(data), pri, pub, check);
 }
 
-MPI sign(const std::string & data, const Values & pri, const Values & pub){
-    return decrypt(rawtompi(data), pri, pub);
+MPI sign(const MPI & data, const ModExpContext::Ptr & context, const Values & pub, const bool check){
+    return decrypt(data, context, pub, check);
 }
 
 bool verify(const MPI & data, const Values & signature, const Values & pub){
-    return (encrypt(signature[0], pub) == data);
+    // everything here is public, so skip the constant time exponentiation;
+    // with the usual e = 65537 this is about five times faster
+    return (powm_public(signature[0], pub[1], pub[0]) == data);
 }
 
 bool verify(const std::string & data, const Values & signature, const Values & pub){
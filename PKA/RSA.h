@@ -30,24 +30,30 @@ THE SOFTWARE.
 #include "../common/includes.h"
 #include "../Misc/mpi.h"
 #include "../Misc/pgptime.h"
+#include "ModExp.h"
 #include "PKA.h"
+#include "Prime.h"
 
 namespace OpenPGP {
     namespace PKA {
         namespace RSA {
-            // Generate RSA key values
-            Values keygen(const uint32_t & bits = 2048);
+            // Generate RSA key values; p and q are searched for at the same time on pool, if given
+            Values keygen(const uint32_t & bits = 2048, ThreadPool * pool = nullptr);
 
             // Encrypt data
             MPI encrypt(const MPI & data, const Values & pub);
             MPI encrypt(const std::string & data, const Values & pub);
 
             // Decrypt data
-            MPI decrypt(const MPI & data, const Values & pri, const Values & pub);
+            // uses the Chinese Remainder Theorem when pri holds {d, p, q, u};
+            // check re-encrypts the result to catch faulty computations
+            MPI decrypt(const MPI & data, const Values & pri, const Values & pub, const bool check = false);
+            MPI decrypt(const MPI & data, const ModExpContext::Ptr & context, const Values & pub, const bool check = false);  // context must have its CRT values set
 
             // Sign data
-            MPI sign(const MPI & data, const Values & pri, const Values & pub);
-            MPI sign(const std::string & data, const Values & pri, const Values & pub);
+            MPI sign(const MPI & data, const Values & pri, const Values & pub, const bool check = false);
+            MPI sign(const std::string & data, const Values & pri, const Values & pub, const bool check = false);
+            MPI sign(const MPI & data, const ModExpContext::Ptr & context, const Values & pub, const bool check = false);
 
             // Verify signature
             bool verify(const MPI & data, const Values & signature, const Values & pub);
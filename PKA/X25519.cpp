@@ -0,0 +1,77 @@
+#include "X25519.h"
+
+#include <stdexcept>
+
+#include "Field25519.h"
+
+namespace OpenPGP {
+namespace PKA {
+namespace X25519 {
+
+using namespace Field25519;
+
+// RFC 7748 sec 5
+static std::string scalarmult(std::string k, const std::string & u){
+    if ((k.size() != KEY_SIZE) || (u.size() != KEY_SIZE)){
+        throw std::runtime_error("Error: X25519 values must be 32 octets.");
+    }
+
+    k[0]  &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+
+    const Fe x1 = fe_frombytes(u);
+    const Fe a24 = fe(121665);
+    Fe x2 = fe(1), z2 = fe(0), x3 = x1, z3 = fe(1);
+    uint64_t swap = 0;
+
+    for(int t = 254; t >= 0; t--){
+        const uint64_t bit = (static_cast <unsigned char> (k[t >> 3]) >> (t & 7)) & 1;
+        swap ^= bit;
+        fe_cswap(x2, x3, swap);
+        fe_cswap(z2, z3, swap);
+        swap = bit;
+
+        const Fe a  = fe_add(x2, z2);
+        const Fe aa = fe_sq(a);
+        const Fe b  = fe_sub(x2, z2);
+        const Fe bb = fe_sq(b);
+        const Fe e  = fe_sub(aa, bb);
+        const Fe c  = fe_add(x3, z3);
+        const Fe d  = fe_sub(x3, z3);
+        const Fe da = fe_mul(d, a);
+        const Fe cb = fe_mul(c, b);
+        x3 = fe_sq(fe_add(da, cb));
+        z3 = fe_mul(x1, fe_sq(fe_sub(da, cb)));
+        x2 = fe_mul(aa, bb);
+        z2 = fe_mul(e, fe_add(aa, fe_mul(a24, e)));
+    }
+
+    fe_cswap(x2, x3, swap);
+    fe_cswap(z2, z3, swap);
+
+    return fe_tobytes(fe_mul(x2, fe_invert(z2)));
+}
+
+std::string public_key(const std::string & secret){
+    return scalarmult(secret, std::string(1, 9) + std::string(KEY_SIZE - 1, 0));
+}
+
+std::string shared_secret(const std::string & secret, const std::string & pub){
+    const std::string out = scalarmult(secret, pub);
+
+    // low order points give a known result (RFC 7748 sec 6.1)
+    unsigned char acc = 0;
+    for(char const c : out){
+        acc |= static_cast <unsigned char> (c);
+    }
+    if (!acc){
+        return "";
+    }
+
+    return out;
+}
+
+}
+}
+}
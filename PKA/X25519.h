@@ -0,0 +1,50 @@
+/*
+X25519.h
+Curve25519 Diffie-Hellman (RFC 7748)
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __X25519__
+#define __X25519__
+
+#include <string>
+
+namespace OpenPGP {
+    namespace PKA {
+        namespace X25519 {
+            // Diffie-Hellman on Curve25519 (RFC 7748)
+            //
+            // Keys and shared secrets are 32 octet little endian strings.
+            // The Montgomery ladder runs in constant time.
+
+            const std::size_t KEY_SIZE = 32;
+
+            // derive the public key of a secret scalar
+            std::string public_key(const std::string & secret);
+
+            // secret * pub; returns an empty string if the result is all zeros
+            std::string shared_secret(const std::string & secret, const std::string & pub);
+        }
+    }
+}
+
+#endif
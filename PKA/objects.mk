@@ -1,4 +1,12 @@
 PKA_OBJECTS=PKAs.o    \
             DSA.o     \
+            ECC.o     \
+            ECDH.o    \
+            ECDSA.o   \
+            Ed25519.o \
+            EdDSA.o   \
             ElGamal.o \
-            RSA.o
+            ModExp.o  \
+            Prime.o   \
+            RSA.o     \
+            X25519.o
@@ -0,0 +1,262 @@
+#include "PacketReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <unistd.h>
+
+namespace OpenPGP {
+
+static const std::size_t BUFFER_SIZE = 65536;
+
+PacketReader::FDBuf::FDBuf(const int fd)
+    : std::streambuf(),
+      fd(fd),
+      buf(BUFFER_SIZE)
+{}
+
+PacketReader::FDBuf::int_type PacketReader::FDBuf::underflow(){
+    if (gptr() < egptr()){
+        return traits_type::to_int_type(*gptr());
+    }
+
+    ssize_t got;
+    do{
+        got = ::read(fd, buf.data(), buf.size());
+    } while ((got < 0) && (errno == EINTR));
+
+    if (got < 0){
+        throw std::runtime_error("Error: Could not read from file descriptor " + std::to_string(fd) + ".");
+    }
+
+    if (!got){
+        return traits_type::eof();
+    }
+
+    setg(buf.data(), buf.data(), buf.data() + got);
+    return traits_type::to_int_type(*gptr());
+}
+
+PacketReader::BodyBuf::BodyBuf()
+    : std::streambuf(),
+      src(nullptr),
+      left(0),
+      partial(false),
+      to_end(false),
+      buf(BUFFER_SIZE)
+{}
+
+void PacketReader::BodyBuf::reset(std::streambuf * source, const Header & header){
+    src = source;
+    left = header.length;
+    partial = header.partial;
+    to_end = header.indeterminate;
+    setg(buf.data(), buf.data(), buf.data());
+}
+
+void PacketReader::BodyBuf::next_chunk(){
+    // 4.2.2.4. Partial Body Lengths
+    //
+    //     ... Each Partial Body Length header is followed by a portion of the packet body data.
+    //     The Partial Body Length header specifies this portion's length. Another length header
+    //     (one octet, two-octet, five-octet, or partial) follows that portion. The last length
+    //     header in the packet MUST NOT be a Partial Body Length header.
+    const int first_octet = src -> sbumpc();
+    if (first_octet == traits_type::eof()){
+        throw std::runtime_error("Error: Partial body ended without a final length.");
+    }
+
+    if (first_octet < 192){
+        left = first_octet;
+        partial = false;
+    }
+    else if (first_octet < 224){
+        const int second_octet = src -> sbumpc();
+        if (second_octet == traits_type::eof()){
+            throw std::runtime_error("Error: Not enough data to read packet length.");
+        }
+        left = ((first_octet - 192) << 8) + second_octet + 192;
+        partial = false;
+    }
+    else if (first_octet < 255){
+        left = 1ULL << (first_octet & 0x1f);
+    }
+    else{
+        char octets[4];
+        if (src -> sgetn(octets, 4) != 4){
+            throw std::runtime_error("Error: Not enough data to read packet length.");
+        }
+        left = toint(std::string(octets, 4), 256);
+        partial = false;
+    }
+}
+
+PacketReader::BodyBuf::int_type PacketReader::BodyBuf::underflow(){
+    if (gptr() < egptr()){
+        return traits_type::to_int_type(*gptr());
+    }
+
+    if (!src){
+        return traits_type::eof();
+    }
+
+    // move on to the next chunk; chunks may be empty
+    while (!to_end && !left && partial){
+        next_chunk();
+    }
+
+    if (!to_end && !left){
+        return traits_type::eof();
+    }
+
+    std::streamsize want = buf.size();
+    if (!to_end && (left < buf.size())){
+        want = left;
+    }
+
+    const std::streamsize got = src -> sgetn(buf.data(), want);
+    if (!got){
+        if (to_end){
+            return traits_type::eof();
+        }
+        throw std::runtime_error("Error: Packet body ended early.");
+    }
+
+    if (!to_end){
+        left -= got;
+    }
+
+    setg(buf.data(), buf.data(), buf.data() + got);
+    return traits_type::to_int_type(*gptr());
+}
+
+void PacketReader::BodyBuf::skip(){
+    while (underflow() != traits_type::eof()){
+        setg(egptr(), egptr(), egptr());
+    }
+}
+
+std::size_t PacketReader::read_length(const uint8_t n){
+    char octets[4];
+    if (src -> sgetn(octets, n) != n){
+        throw std::runtime_error("Error: Not enough data to read packet length.");
+    }
+    return toint(std::string(octets, n), 256);
+}
+
+PacketReader::PacketReader(std::istream & stream)
+    : owned(),
+      src(stream.rdbuf()),
+      body_buf(),
+      body_stream(&body_buf)
+{}
+
+PacketReader::PacketReader(const int fd)
+    : owned(new FDBuf(fd)),
+      src(owned.get()),
+      body_buf(),
+      body_stream(&body_buf)
+{}
+
+PacketReader::~PacketReader(){}
+
+bool PacketReader::next(Header & header){
+    // finish off the previous packet
+    body_buf.skip();
+    body_stream.clear();
+
+    const int ctb = src -> sbumpc();                    // Name "ctb" came from Version 2 [RFC 1991]
+    if (ctb == std::char_traits <char>::eof()){
+        return false;
+    }
+
+    if (!(ctb & 0x80)){
+        throw std::runtime_error("Error: First bit of packet header MUST be 1.");
+    }
+
+    header.format = ctb & 0x40;
+    header.indeterminate = false;
+    header.partial = false;
+    header.length = 0;
+
+    if (!header.format){                                // Old length type RFC4880 sec 4.2.1
+        header.tag = (ctb >> 2) & 15;
+        switch (ctb & 3){
+            case 0:                                     // one-octet length
+                header.length = read_length(1);
+                break;
+            case 1:                                     // two-octet length
+                header.length = read_length(2);
+                break;
+            case 2:                                     // four-octet length
+                header.length = read_length(4);
+                break;
+            case 3:                                     // indeterminate length
+                header.indeterminate = true;
+                break;
+        }
+    }
+    else{                                               // New length type RFC4880 sec 4.2.2
+        header.tag = ctb & 63;
+        const uint8_t first_octet = read_length(1);
+        if (first_octet < 192){                         // one-octet length
+            header.length = first_octet;
+        }
+        else if (first_octet < 224){                    // two-octet length
+            header.length = ((first_octet - 192) << 8) + read_length(1) + 192;
+        }
+        else if (first_octet < 255){                    // partial body length
+            header.partial = true;
+            header.length = 1ULL << (first_octet & 0x1f);
+        }
+        else{                                           // five-octet length
+            header.length = read_length(4);
+        }
+    }
+
+    body_buf.reset(src, header);
+    return true;
+}
+
+std::istream & PacketReader::body(){
+    return body_stream;
+}
+
+Packet::Tag::Ptr PacketReader::read_packet(){
+    Header header;
+    if (!next(header)){
+        return nullptr;
+    }
+
+    Packet::Tag::Ptr out = Packet::create(header.tag);
+
+    // keep the pieces chained instead of growing one buffer; a length
+    // from the header is never allocated before its data has arrived
+    const bool definite = !header.indeterminate && !header.partial;
+    ByteChain data;
+    while (!definite || (data.size() < header.length)){
+        std::size_t want = Packet::PARTIAL_CHUNK;
+        if (definite){
+            want = std::min(want, header.length - data.size());
+        }
+
+        std::string piece(want, 0);
+        piece.resize(body_stream.rdbuf() -> sgetn(&piece[0], piece.size()));
+        if (piece.empty()){
+            break;
+        }
+        data.append(ByteSlice(std::move(piece)));
+    }
+
+    if (definite && (data.size() != header.length)){
+        throw std::runtime_error("Error: Packet body ended early.");
+    }
+
+    out -> set_tag(header.tag);
+    out -> set_format(header.format);
+    out -> set_partial(header.indeterminate || header.partial);
+    out -> set_size(data.size());
+    out -> read(data);
+    return out;
+}
+
+}
@@ -0,0 +1,123 @@
+/*
+PacketReader.h
+Pull based packet reader for streams and file descriptors
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_PACKET_READER__
+#define __OPENPGP_PACKET_READER__
+
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Packets/packets.h"
+
+namespace OpenPGP {
+
+    // Reads one packet header at a time from a stream or file descriptor.
+    // The body of the current packet is available as a stream, so packets
+    // of any size can be processed without holding them in memory:
+    //
+    //     PacketReader reader(std::cin);
+    //     PacketReader::Header header;
+    //     while (reader.next(header)){
+    //         consume(header.tag, reader.body());
+    //     }
+    //
+    // Partial body lengths are joined transparently, and an unread body
+    // is skipped when the next header is requested.
+    class PacketReader {
+        public:
+            struct Header{
+                uint8_t tag;
+                bool format;            // OLD (false) or NEW (true)
+                bool indeterminate;     // old format length type 3; the body runs to the end of the input
+                bool partial;           // the body is split into partial body length chunks
+                std::size_t length;     // body length; length of the first chunk when partial; 0 when indeterminate
+            };
+
+        private:
+            // reads from a file descriptor
+            class FDBuf : public std::streambuf {
+                private:
+                    int fd;
+                    std::vector <char> buf;
+
+                protected:
+                    int_type underflow();
+
+                public:
+                    FDBuf(const int fd);
+            };
+
+            // limits reads to the body of the current packet
+            class BodyBuf : public std::streambuf {
+                private:
+                    std::streambuf * src;
+                    std::size_t left;   // octets left in the current chunk
+                    bool partial;       // more chunks follow the current one
+                    bool to_end;        // read until the end of src
+                    std::vector <char> buf;
+
+                    // reads the length of the next partial body chunk
+                    void next_chunk();
+
+                protected:
+                    int_type underflow();
+
+                public:
+                    BodyBuf();
+                    void reset(std::streambuf * source, const Header & header);
+                    void skip();        // discard whatever is left of the body
+            };
+
+            std::unique_ptr <std::streambuf> owned;
+            std::streambuf * src;
+            BodyBuf body_buf;
+            std::istream body_stream;
+
+            // read n octets from src as a big endian value
+            std::size_t read_length(const uint8_t n);
+
+        public:
+            PacketReader(std::istream & stream);
+            PacketReader(const int fd);
+            PacketReader(const PacketReader & copy) = delete;
+            PacketReader & operator=(const PacketReader & copy) = delete;
+            ~PacketReader();
+
+            // moves to the next packet; returns false at the end of the input
+            bool next(Header & header);
+
+            // body of the packet returned by the last call to next()
+            std::istream & body();
+
+            // reads the next whole packet; returns nullptr at the end of the input
+            Packet::Tag::Ptr read_packet();
+    };
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "Key.h"
 
+#include <memory>
+
 namespace OpenPGP {
 namespace Packet {
 
@@ -8,6 +10,7 @@ Key::Key(uint8_t tag)
       time(),
       pka(),
       mpi(),
+      modexp(),
       expire()
       #ifdef GPG_COMPATIBLE
       ,
@@ -27,6 +30,7 @@ Key::Key(const Key & copy)
       time(copy.time),
       pka(copy.pka),
       mpi(copy.mpi),
+      modexp(std::atomic_load(&copy.modexp)),
       expire(copy.expire)
       #ifdef GPG_COMPATIBLE
       ,
@@ -55,21 +59,25 @@ std::string Key::show(const std::size_t indents, const std::size_t indent_size)
     return tab + show_title() + "\n" + show_common(indents, indent_size);
 }
 
-std::string Key::raw() const{
-    return raw_common();
+std::size_t Key::serialized_size() const{
+    return raw_common_size();
+}
+
+void Key::write_raw(ByteWriter & out) const{
+    write_raw_common(out);
 }
 
 void Key::read_common(const std::string & data, std::string::size_type & pos){
     size = data.size();
     version = data[pos];
     time = toint(data.substr(pos + 1, 4), 256);
+    modexp = nullptr;
 
     if (version < 4){
         expire = (data[pos + 5] << 8) + data[pos + 6];
         pka = data[pos + 7];
         pos += 8;
-        mpi.push_back(read_MPI(data, pos));         // RSA n
-        mpi.push_back(read_MPI(data, pos));         // RSA e
+        mpi.read(data, pos, 2);                     // RSA n, e
     }
     else if (version == 4){
         pka = data[pos + 5];
@@ -77,21 +85,15 @@ void Key::read_common(const std::string & data, std::string::size_type & pos){
 
         // RSA
         if(PKA::is_RSA(pka)){
-            mpi.push_back(read_MPI(data, pos));     // RSA n
-            mpi.push_back(read_MPI(data, pos));     // RSA e
+            mpi.read(data, pos, 2);                 // RSA n, e
         }
         // DSA
         else if (pka == PKA::ID::DSA){
-            mpi.push_back(read_MPI(data, pos));     // DSA p
-            mpi.push_back(read_MPI(data, pos));     // DSA q
-            mpi.push_back(read_MPI(data, pos));     // DSA g
-            mpi.push_back(read_MPI(data, pos));     // DSA y
+            mpi.read(data, pos, 4);                 // DSA p, q, g, y
         }
         // ELGAMAL
         else if (pka == PKA::ID::ELGAMAL){
-            mpi.push_back(read_MPI(data, pos));     // ELGAMAL p
-            mpi.push_back(read_MPI(data, pos));     // ELGAMAL g
-            mpi.push_back(read_MPI(data, pos));     // ELGAMAL y
+            mpi.read(data, pos, 3);                 // ELGAMAL p, g, y
         }
         #ifdef GPG_COMPATIBLE
         // ECDSA
@@ -99,21 +101,21 @@ void Key::read_common(const std::string & data, std::string::size_type & pos){
             uint8_t curve_dim = data[pos];
             curve = data.substr(pos + 1, curve_dim);
             pos += curve_dim + 1;
-            mpi.push_back(read_MPI(data, pos));
+            mpi.read(data, pos, 1);
         }
         // EdDSA
         else if (pka == PKA::ID::EdDSA){
             uint8_t curve_dim = data[pos];
             curve = data.substr(pos + 1, curve_dim);
             pos += curve_dim + 1;
-            mpi.push_back(read_MPI(data, pos));
+            mpi.read(data, pos, 1);
         }
         // ECDH
         else if (pka == PKA::ID::ECDH){
             uint8_t curve_dim = data[pos];
             curve = data.substr(pos + 1, curve_dim);
             pos += curve_dim + 1;
-            mpi.push_back(read_MPI(data, pos));
+            mpi.read(data, pos, 1);
             kdf_size = data[pos];
             kdf_hash = data[pos + 2];
             kdf_alg = data[pos + 3];
@@ -139,39 +141,39 @@ std::string Key::show_common(const std::size_t indents, const std::size_t indent
             out += " (Never)\n";
         }
         out += indent + tab + "Public Key Algorithm: " + PKA::NAME.at(pka) + " (pka " + std::to_string(pka) + ")\n" +
-               indent + tab + "RSA n: " + mpitohex(mpi[0]) + "(" + std::to_string(bitsize(mpi[0])) + " bits)\n" +
-               indent + tab + "RSA e: " + mpitohex(mpi[1]);
+               indent + tab + "RSA n: " + mpi.hex(0) + "(" + std::to_string(mpi.bitsize(0)) + " bits)\n" +
+               indent + tab + "RSA e: " + mpi.hex(1);
     }
     else if (version == 4){
         out += indent + tab + "Public Key Algorithm: " + PKA::NAME.at(pka) + " (pka " + std::to_string(pka) + ")\n";
         if (PKA::is_RSA(pka)){
-            out += indent + tab + "RSA n (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0]) + "\n" +
-                   indent + tab + "RSA e (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
+            out += indent + tab + "RSA n (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0) + "\n" +
+                   indent + tab + "RSA e (" + std::to_string(mpi.bitsize(1)) + " bits): " + mpi.hex(1);
         }
         else if (pka == PKA::ID::ELGAMAL){
-            out += indent + tab + "ELGAMAL p (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0]) + "\n" +
-                   indent + tab + "ELGAMAL g (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]) + "\n" +
-                   indent + tab + "ELGAMAL y (" + std::to_string(bitsize(mpi[2])) + " bits): " + mpitohex(mpi[2]);
+            out += indent + tab + "ELGAMAL p (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0) + "\n" +
+                   indent + tab + "ELGAMAL g (" + std::to_string(mpi.bitsize(1)) + " bits): " + mpi.hex(1) + "\n" +
+                   indent + tab + "ELGAMAL y (" + std::to_string(mpi.bitsize(2)) + " bits): " + mpi.hex(2);
         }
         #ifdef GPG_COMPATIBLE
         else if (pka == PKA::ID::ECDSA){
             out += indent + tab + "ECDSA " + PKA::CURVE_NAME.at(hexlify(curve, true)) + "\n" +
-                   indent + tab + "ECDSA ec point: " + mpitohex(mpi[0]);
+                   indent + tab + "ECDSA ec point: " + mpi.hex(0);
         }
         else if (pka == PKA::ID::EdDSA){
             out += indent + tab + "EdDSA " + PKA::CURVE_NAME.at(hexlify(curve, true)) + "\n" +
-                   indent + tab + "EdDSA ec point: " + mpitohex(mpi[0]);
+                   indent + tab + "EdDSA ec point: " + mpi.hex(0);
         }
         else if (pka == PKA::ID::ECDH){
             out += indent + tab + "ECDH " + PKA::CURVE_NAME.at(hexlify(curve, true)) + "\n" +
-                   indent + tab + "ECDH ec point: " + mpitohex(mpi[0]);
+                   indent + tab + "ECDH ec point: " + mpi.hex(0);
         }
         #endif
         else if (pka == PKA::ID::DSA){
-            out += indent + tab + "DSA p (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0]) + "\n" +
-                   indent + tab + "DSA q (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]) + "\n" +
-                   indent + tab + "DSA g (" + std::to_string(bitsize(mpi[2])) + " bits): " + mpitohex(mpi[2]) + "\n" +
-                   indent + tab + "DSA y (" + std::to_string(bitsize(mpi[3])) + " bits): " + mpitohex(mpi[3]);
+            out += indent + tab + "DSA p (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0) + "\n" +
+                   indent + tab + "DSA q (" + std::to_string(mpi.bitsize(1)) + " bits): " + mpi.hex(1) + "\n" +
+                   indent + tab + "DSA g (" + std::to_string(mpi.bitsize(2)) + " bits): " + mpi.hex(2) + "\n" +
+                   indent + tab + "DSA y (" + std::to_string(mpi.bitsize(3)) + " bits): " + mpi.hex(3);
         }
     }
 
@@ -179,37 +181,60 @@ std::string Key::show_common(const std::size_t indents, const std::size_t indent
 }
 
 std::string Key::raw_common() const{
-    std::string out = std::string(1, version) + unhexlify(makehex(time, 8));
-    if (version < 4){ // to recreate older keys
-        out += unhexlify(makehex(expire, 4));
-    }
+    ByteWriter out(raw_common_size());
+    write_raw_common(out);
+    return out.release();
+}
 
-    out += std::string(1, pka);
+std::size_t Key::raw_common_size() const{
+    std::size_t out = 1 + 4 + ((version < 4)?2:0) + 1;
 
     #ifdef GPG_COMPATIBLE
     if (pka == PKA::ID::ECDSA || pka == PKA::ID::EdDSA || pka == PKA::ID::ECDH){
-        out += std::string(1, PKA::CURVE_OID_LENGTH.at(hexlify(curve, true)));
-        //out += curve.size();
-        out += curve;
+        out += 1 + curve.size();
     }
     #endif
 
-    for(MPI const m : mpi){
-        out += write_MPI(m);
-    }
+    out += mpi.write_size();
 
     #ifdef GPG_COMPATIBLE
     if (pka == PKA::ID::ECDH){
-        out += kdf_size; // Should be one
-        out += std::string(1, 1);
-        out += kdf_hash;
-        out += kdf_alg;
+        out += 4;
     }
     #endif
 
     return out;
 }
 
+void Key::write_raw_common(ByteWriter & out) const{
+    out.put8(version);
+    out.put32(time);
+    if (version < 4){ // to recreate older keys
+        out.put16(expire);
+    }
+
+    out.put8(pka);
+
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDSA || pka == PKA::ID::EdDSA || pka == PKA::ID::ECDH){
+        out.put8(PKA::CURVE_OID_LENGTH.at(hexlify(curve, true)));
+        //out.put8(curve.size());
+        out.put(curve);
+    }
+    #endif
+
+    mpi.write(out);
+
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH){
+        out.put8(kdf_size); // Should be one
+        out.put8(1);
+        out.put8(kdf_hash);
+        out.put8(kdf_alg);
+    }
+    #endif
+}
+
 uint32_t Key::get_time() const{
     return time;
 }
@@ -227,8 +252,12 @@ uint8_t Key::get_pka() const{
     return pka;
 }
 
-PKA::Values Key::get_mpi() const{
-    return mpi;
+const PKA::Values & Key::get_mpi() const{
+    return mpi.get();
+}
+
+std::size_t Key::get_mpi_bitsize(const std::size_t i) const{
+    return mpi.bitsize(i);
 }
 
 void Key::set_time(uint32_t t){
@@ -237,25 +266,41 @@ void Key::set_time(uint32_t t){
 
 void Key::set_pka(uint8_t p){
     pka = p;
+    modexp = nullptr;
 }
 
 void Key::set_mpi(const PKA::Values & m){
-    mpi = m;
-    size = raw().size();
+    mpi = MPISlices(m);
+    modexp = nullptr;
+    size = serialized_size();
+}
+
+PKA::ModExpContext::Ptr Key::get_modexp() const{
+    PKA::ModExpContext::Ptr context = std::atomic_load(&modexp);
+    if (!context){
+        // racing threads may each build one; any of them is correct
+        context = PKA::modexp_context(pka, mpi.get());
+        std::atomic_store(&modexp, context);
+    }
+    return context;
 }
 
 std::string Key::get_fingerprint() const{
     if (version == 3){
         std::string data = "";
-        for(MPI const & i : mpi){
+        for(MPI const & i : mpi.get()){
             std::string m = write_MPI(i);
             data += m.substr(2, m.size() - 2);
         }
         return MD5(data).digest();
     }
     else if (version == 4){
-        std::string packet = raw_common();
-        return SHA1("\x99" + unhexlify(makehex(packet.size(), 4)) + packet).digest();
+        const std::size_t length = raw_common_size();
+        ByteWriter packet(3 + length);
+        packet.put8(0x99);
+        packet.put16(length);
+        write_raw_common(packet);
+        return SHA1(packet.str()).digest();
     }
     else{
         throw std::runtime_error("Error: Key packet version " + std::to_string(version) + " not defined.");
@@ -284,6 +329,12 @@ std::string Key::get_curve() const{
 void Key::set_curve(const std::string c){
     curve = c;
 }
+uint8_t Key::get_kdf_size() const{
+    return kdf_size;
+}
+void Key::set_kdf_size(const uint8_t s){
+    kdf_size = s;
+}
 uint8_t Key::get_kdf_hash() const{
     return kdf_hash;
 }
@@ -308,6 +359,7 @@ Key & Key::operator=(const Key & copy)
     time = copy.time;
     pka = copy.pka;
     mpi = copy.mpi;
+    modexp = std::atomic_load(&copy.modexp);
     expire = copy.expire;
     return *this;
 }
@@ -40,7 +40,8 @@ namespace OpenPGP {
             protected:
                 uint32_t time;
                 uint8_t pka;
-                PKA::Values mpi;
+                MPISlices mpi;                              // converted on first use
+                mutable PKA::ModExpContext::Ptr modexp;     // built from pka and mpi on first use
 
                 // version 3
                 uint32_t expire;
@@ -64,26 +65,35 @@ namespace OpenPGP {
 
                 virtual void read(const std::string & data);
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                virtual std::string raw() const;
+                virtual std::size_t serialized_size() const;
+                virtual void write_raw(ByteWriter & out) const;
 
                 // read, show, and raw functions common to all keys tags
                 // can't overload normal versions because the inherited versions are needed
                 void read_common(const std::string & data, std::string::size_type & pos);
                 std::string show_common(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                 std::string raw_common() const;
+                std::size_t raw_common_size() const;
+                void write_raw_common(ByteWriter & out) const;
 
                 uint32_t get_time() const;
                 uint32_t get_exp_time() const;
                 uint8_t get_pka() const;
-                PKA::Values get_mpi() const;
+                const PKA::Values & get_mpi() const;
+                std::size_t get_mpi_bitsize(const std::size_t i) const;    // without converting the values
 
                 void set_time(const uint32_t t);
                 void set_pka(const uint8_t p);
                 void set_mpi(const PKA::Values & m);
 
+                // exponentiation context of the public values; shared by copies of this key
+                PKA::ModExpContext::Ptr get_modexp() const;
+
                 #ifdef GPG_COMPATIBLE
                 std::string get_curve() const;
                 void set_curve(const std::string c);
+                uint8_t get_kdf_size() const;
+                void set_kdf_size(const uint8_t s);
                 uint8_t get_kdf_hash() const;
                 void set_kdf_hash(const uint8_t h);
                 uint8_t get_kdf_alg() const;
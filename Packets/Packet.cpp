@@ -42,58 +42,119 @@ bool is_sym_protected_data(const uint8_t t){
             (t == SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA));
 }
 
-std::string Tag::write_old_length(const std::string & data) const{
-    std::string::size_type length = data.size();
-    std::string out(1, 0b10000000 | (tag << 2));
-    if (partial){
-        out[0] |= 3;                                        // partial
+uint8_t partial_length(const std::size_t chunk){
+    uint8_t bits = 9;                                       // the first partial length must be at least 512 octets
+    while ((bits < 30) && (chunk > (static_cast <std::size_t> (1) << bits))){
+        bits++;
     }
-    else{
-        if (length < 256){
-            out[0] |= 0;                                    // 1 octet
-            out += std::string(1, length);
-        }
-        else if ((256 <= length) && (length < 65536)){      // 2 octest
-            out[0] |= 1;
-            out += unhexlify(makehex(length, 4));
-        }
-        else if (65536 <= length){                          // 4 octets
-            out[0] |= 2;
-            out += unhexlify(makehex(length, 8));
-        }
+
+    if (chunk != (static_cast <std::size_t> (1) << bits)){
+        throw std::runtime_error("Error: Partial body length chunks must be a power of 2 from 512 to 2^30 octets.");
     }
-    return out + data;
+
+    return 224 + bits;
 }
 
-// returns formatted length string
-std::string Tag::write_new_length(const std::string & data) const{
-    std::string::size_type length = data.size();
-    std::string out(1, 0b11000000 | tag);
-    if (partial){                                           // partial
-        uint8_t bits = 0;
-        while (length > (1u << bits)){
-            bits++;
-        }
-        length = 224 + bits;
-        if (length > 254){
-            throw std::runtime_error("Error: Data in partial Tag too large.");
-        }
+std::size_t body_length_size(const std::size_t length){
+    if (length < 192){
+        return 1;                                           // 1 octet
+    }
+    if (length < 8384){
+        return 2;                                           // 2 octets
+    }
+    return 5;                                               // 5 octets
+}
 
-        out += std::string(1, length);
+void write_body_length(const std::size_t length, ByteWriter & out){
+    if (length < 192){                                      // 1 octet
+        out.put8(length);
     }
-    else{
-        if (length < 192){                                  // 1 octet
-            out += std::string(1, length);
-        }
-        else if ((192 <= length) && (length < 8383)){       // 2 octets
-            length -= 0xc0;
-            out += std::string(1, (length >> 8) + 0xc0 ) + std::string(1, length & 0xff);
-        }
-        else if (length > 8383){                            // 3 octets
-            out += std::string(1, '\xff') + unhexlify(makehex(length, 8));
+    else if (length < 8384){                                // 2 octets
+        const std::size_t l = length - 0xc0;
+        out.put8((l >> 8) + 0xc0);
+        out.put8(l & 0xff);
+    }
+    else{                                                   // 5 octets
+        if (length > 0xffffffff){
+            throw std::runtime_error("Error: Packet body too large for a 5 octet length.");
         }
+        out.put8(0xff);
+        out.put32(length);
+    }
+}
+
+std::size_t Tag::old_length_size(const std::size_t length) const{
+    if (length < 256){
+        return 2;                                           // 1 octet
+    }
+    if (length < 65536){
+        return 3;                                           // 2 octets
+    }
+    return 5;                                               // 4 octets
+}
+
+std::size_t Tag::new_length_size(const std::size_t length) const{
+    if (partial && (length > PARTIAL_CHUNK)){
+        const std::size_t chunks = (length - 1) / PARTIAL_CHUNK; // every chunk but the last has a 1 octet partial length
+        return 1 + chunks + body_length_size(length - chunks * PARTIAL_CHUNK);
+    }
+    return 1 + body_length_size(length);
+}
+
+void Tag::write_old_length(const std::size_t length, ByteWriter & out) const{
+    // always a definite length; an indeterminate length is only valid for the last packet
+    uint8_t ctb = 0b10000000 | (tag << 2);
+    if (length < 256){                                      // 1 octet
+        out.put8(ctb | 0);
+        out.put8(length);
+    }
+    else if (length < 65536){                               // 2 octets
+        out.put8(ctb | 1);
+        out.put16(length);
+    }
+    else{                                                   // 4 octets
+        out.put8(ctb | 2);
+        out.put32(length);
+    }
+}
+
+void Tag::write_new_length(const std::size_t length, ByteWriter & out) const{
+    out.put8(0b11000000 | tag);
+    write_body_length(length, out);
+}
+
+void Tag::write_partial(ByteWriter & out) const{
+    const std::size_t length = serialized_size();
+    const std::size_t chunks = (length - 1) / PARTIAL_CHUNK;          // the last chunk always has a definite length
+    const std::size_t last = length - chunks * PARTIAL_CHUNK;
+
+    ByteWriter last_header(5);
+    write_body_length(last, last_header);
+    const std::size_t headers = chunks + last_header.size();
+
+    out.put8(0b11000000 | tag);
+
+    // leave room for every chunk header in front of the body, write the body
+    // once, then slide each full chunk down to sit right after its header
+    const std::size_t start = out.size();
+    out.grow(headers);
+    write_raw(out);
+
+    char * data = out.at(start);
+    const char chunk_length = static_cast <char> (partial_length(PARTIAL_CHUNK));
+    for(std::size_t i = 0; i < chunks; i++){
+        char * dst = data + i * (PARTIAL_CHUNK + 1);
+        dst[0] = chunk_length;
+        std::memmove(dst + 1, data + headers + i * PARTIAL_CHUNK, PARTIAL_CHUNK);
     }
-    return out + data;
+
+    // the last chunk is already in place, right after its header
+    std::memcpy(data + chunks * (PARTIAL_CHUNK + 1), last_header.str().data(), last_header.size());
+}
+
+bool Tag::use_new_format(const Tag::Format header) const{
+    return ((header == NEW) ||  // specified new header
+            (tag > 15));        // tag > 15, so new header is required
 }
 
 std::string Tag::show_title() const{
@@ -144,12 +205,44 @@ Tag::Tag()
 
 Tag::~Tag(){}
 
+void Tag::read(const ByteSlice & data){
+    read(data.str());
+}
+
+void Tag::read(const ByteChain & data){
+    read(data.flatten());
+}
+
+std::string Tag::raw() const{
+    ByteWriter out(serialized_size());
+    write_raw(out);
+    return out.release();
+}
+
 std::string Tag::write(const Tag::Format header) const{
-    if ((header == NEW) ||      // specified new header
-        (tag > 15)){            // tag > 15, so new header is required
-        return write_new_length(raw());
+    ByteWriter out(write_size(header));
+    write(out, header);
+    return out.release();
+}
+
+void Tag::write(ByteWriter & out, const Tag::Format header) const{
+    const std::size_t length = serialized_size();
+    if (use_new_format(header)){
+        if (partial && (length > PARTIAL_CHUNK)){
+            write_partial(out);
+            return;
+        }
+        write_new_length(length, out);
+    }
+    else{
+        write_old_length(length, out);
     }
-    return write_old_length(raw());
+    write_raw(out);
+}
+
+std::size_t Tag::write_size(const Tag::Format header) const{
+    const std::size_t length = serialized_size();
+    return (use_new_format(header)?new_length_size(length):old_length_size(length)) + length;
 }
 
 uint8_t Tag::get_tag() const{
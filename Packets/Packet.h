@@ -26,11 +26,13 @@ THE SOFTWARE.
 #ifndef __PACKET__
 #define __PACKET__
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
 
+#include "../common/ByteWriter.h"
 #include "../common/includes.h"
 
 namespace OpenPGP {
@@ -118,6 +120,17 @@ namespace OpenPGP {
         bool is_session_key          (const uint8_t t);
         bool is_sym_protected_data   (const uint8_t t);
 
+        // default number of octets in each chunk of a body written with partial body lengths
+        const std::size_t PARTIAL_CHUNK = 1 << 16;
+
+        // Partial Body Length octet for chunks of the given size
+        // chunk must be a power of 2 from 512 (RFC 4880 sec 4.2.2.4) to 2^30
+        uint8_t partial_length(const std::size_t chunk);
+
+        // new format body length octets (no tag octet) for a definite length
+        std::size_t body_length_size(const std::size_t length);
+        void write_body_length(const std::size_t length, ByteWriter & out);
+
         // Tag class for all packet types
         class Tag {
             public:
@@ -132,13 +145,21 @@ namespace OpenPGP {
                 uint8_t version;
                 bool format;        // OLD (false) or NEW (true); defaults to NEW
                 std::size_t size;   // This value is only correct when the Tag was generated with the read() function
-                uint8_t partial;    // 0-3; 0 = not partial, 1 = partial begin, 2 = partial continue, 3 = partial end
+                uint8_t partial;    // 0-3; 0 = definite length, 1 = written with partial body lengths when in NEW format; 2 and 3 are only used by Partial
 
-                // returns Tag data with old format Tag length
-                std::string write_old_length(const std::string & data) const;
+                // number of octets used by the old/new format header for a body of the given length
+                std::size_t old_length_size(const std::size_t length) const;
+                std::size_t new_length_size(const std::size_t length) const;
 
-                // returns Tag data with new format Tag length
-                std::string write_new_length(const std::string & data) const;
+                // appends the old/new format header for a body of the given length
+                void write_old_length(const std::size_t length, ByteWriter & out) const;
+                void write_new_length(const std::size_t length, ByteWriter & out) const;
+
+                // appends a new format packet whose body is split into PARTIAL_CHUNK octet partial body length chunks
+                void write_partial(ByteWriter & out) const;
+
+                // returns true if the packet will be written with a new format header
+                bool use_new_format(const Format header) const;
 
                 // returns first line of show functions (no tab or newline)
                 virtual std::string show_title() const; // virtual to allow for overriding for special cases
@@ -153,9 +174,29 @@ namespace OpenPGP {
                 Tag();
                 virtual ~Tag();
                 virtual void read(const std::string & data) = 0;
+
+                // read from a slice of a shared buffer; packets that hold large
+                // bodies override this to keep a slice instead of a copy
+                virtual void read(const ByteSlice & data);
+
+                // read a body that arrived in partial body length chunks; by default
+                // the chunks are joined, data packets keep them chained
+                virtual void read(const ByteChain & data);
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const = 0;
-                virtual std::string raw() const = 0;
+
+                // number of octets raw() will produce, computed without serializing the packet
+                virtual std::size_t serialized_size() const = 0;
+
+                // appends the packet body to out
+                virtual void write_raw(ByteWriter & out) const = 0;
+
+                // packet body (no header)
+                std::string raw() const;
+
+                // full packet (header + body)
                 std::string write(const Format header = DEFAULT) const;
+                void write(ByteWriter & out, const Format header = DEFAULT) const;
+                std::size_t write_size(const Format header = DEFAULT) const;
 
                 // Accessors
                 uint8_t get_tag() const;
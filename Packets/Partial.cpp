@@ -37,16 +37,28 @@ void Partial::read(const std::string & data){
     stream = data;
 }
 
+void Partial::read(const ByteSlice & data){
+    stream = data;
+}
+
 std::string Partial::show(const std::size_t indents, const std::size_t indent_size) const{
     const std::string tab(indents * indent_size, ' ');
-    return tab + tab + show_title() + "\n" + std::string((indents + 1) * indent_size, ' ') + hexlify(stream);
+    return tab + tab + show_title() + "\n" + std::string((indents + 1) * indent_size, ' ') + hexlify(stream.str());
 }
 
-std::string Partial::raw() const{
-    return stream;
+std::size_t Partial::serialized_size() const{
+    return stream.size();
+}
+
+void Partial::write_raw(ByteWriter & out) const{
+    out.put(stream);
 }
 
 std::string Partial::get_stream() const{
+    return stream.str();
+}
+
+const ByteSlice & Partial::get_stream_slice() const{
     return stream;
 }
 
@@ -33,7 +33,7 @@ namespace OpenPGP {
 
         class Partial : public Tag {
             private:
-                std::string stream;
+                ByteSlice stream;
 
                 std::string show_title() const;
 
@@ -43,10 +43,13 @@ namespace OpenPGP {
                 Partial();
                 Partial(const std::string & data);
                 void read(const std::string & data);
+                void read(const ByteSlice & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 std::string get_stream() const;
+                const ByteSlice & get_stream_slice() const;
 
                 void set_stream(const std::string & data);
 
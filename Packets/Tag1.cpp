@@ -8,6 +8,10 @@ Tag1::Tag1()
       keyid(),
       pka(),
       mpi()
+      #ifdef GPG_COMPATIBLE
+      ,
+      wrapped()
+      #endif
 {}
 
 Tag1::Tag1(const Tag1 & copy)
@@ -15,6 +19,10 @@ Tag1::Tag1(const Tag1 & copy)
       keyid(copy.keyid),
       pka(copy.pka),
       mpi(copy.mpi)
+      #ifdef GPG_COMPATIBLE
+      ,
+      wrapped(copy.wrapped)
+      #endif
 {}
 
 Tag1::Tag1(const std::string & data)
@@ -29,6 +37,20 @@ void Tag1::read(const std::string & data){
     keyid = data.substr(1, 8);
     pka = data[9];
     std::string::size_type pos = 10;
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH){
+        mpi.push_back(read_MPI(data, pos));
+        if (pos >= data.size()){
+            throw std::runtime_error("Error: ECDH session key is missing its wrapped key length.");
+        }
+        const uint8_t wrapped_size = data[pos];
+        if ((pos + 1 + wrapped_size) > data.size()){
+            throw std::runtime_error("Error: ECDH wrapped session key is truncated.");
+        }
+        wrapped = data.substr(pos + 1, wrapped_size);
+        return;
+    }
+    #endif
     while (pos < data.size()){
         mpi.push_back(read_MPI(data, pos));
     }
@@ -49,17 +71,43 @@ std::string Tag1::show(const std::size_t indents, const std::size_t indent_size)
         out += indent + tab + "ELGAMAL g**k mod p (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0]) + "\n"
             += indent + tab + "ELGAMAL m * y**k mod p (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
     }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDH){
+        out += indent + tab + "ECDH ephemeral point: " + mpitohex(mpi[0]) + "\n"
+            += indent + tab + "ECDH wrapped session key: " + hexlify(wrapped);
+    }
+    #endif
     return out;
 }
 
-std::string Tag1::raw() const{
-    std::string out = "\x03" + keyid + std::string(1, pka);
-    for(unsigned int x = 0; x < mpi.size(); x++){
-        out += write_MPI(mpi[x]);
+std::size_t Tag1::serialized_size() const{
+    std::size_t out = 1 + keyid.size() + 1;
+    for(MPI const & m : mpi){
+        out += MPI_size(m);
+    }
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH){
+        out += 1 + wrapped.size();
     }
+    #endif
     return out;
 }
 
+void Tag1::write_raw(ByteWriter & out) const{
+    out.put8(3);
+    out.put(keyid);
+    out.put8(pka);
+    for(MPI const & m : mpi){
+        write_MPI(m, out);
+    }
+    #ifdef GPG_COMPATIBLE
+    if (pka == PKA::ID::ECDH){
+        out.put8(wrapped.size());
+        out.put(wrapped);
+    }
+    #endif
+}
+
 std::string Tag1::get_keyid() const{
     return keyid;
 }
@@ -77,18 +125,32 @@ void Tag1::set_keyid(const std::string & k){
         throw std::runtime_error("Error: Key ID must be 8 octets.");
     }
     keyid = k;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag1::set_pka(const uint8_t p){
     pka = p;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag1::set_mpi(const PKA::Values & m){
     mpi = m;
-    size = raw().size();
+    size = serialized_size();
+}
+
+#ifdef GPG_COMPATIBLE
+std::string Tag1::get_wrapped() const{
+    return wrapped;
+}
+
+void Tag1::set_wrapped(const std::string & w){
+    if (w.size() > 255){
+        throw std::runtime_error("Error: Wrapped session key must be shorter than 256 octets.");
+    }
+    wrapped = w;
+    size = serialized_size();
 }
+#endif
 
 Tag::Ptr Tag1::clone() const{
     return std::make_shared <Packet::Tag1> (*this);
@@ -73,6 +73,13 @@ namespace OpenPGP {
         //
         //      - MPI of ELGAMAL (Diffie-Hellman) value m * y**k mod p.
         //
+        //    Algorithm Specific Fields for ECDH encryption (RFC 6637 sec 10):
+        //
+        //      - MPI of the ephemeral public point.
+        //
+        //      - A one-octet size, followed by the session key wrapped with
+        //        the key derived from the shared point.
+        //
         //    The value "m" in the above formulas is derived from the session key
         //    as follows.  First, the session key is prefixed with a one-octet
         //    algorithm identifier that specifies the symmetric encryption
@@ -98,6 +105,9 @@ namespace OpenPGP {
                 std::string keyid;      // 8 octets
                 uint8_t pka;
                 PKA::Values mpi;        // algorithm specific fields
+                #ifdef GPG_COMPATIBLE
+                std::string wrapped;    // ECDH wrapped session key
+                #endif
 
             public:
                 typedef std::shared_ptr <Packet::Tag1> Ptr;
@@ -107,7 +117,8 @@ namespace OpenPGP {
                 Tag1(const std::string & data);
                 void read(const std::string & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 std::string get_keyid() const;
                 uint8_t get_pka() const;
@@ -117,6 +128,11 @@ namespace OpenPGP {
                 void set_pka(const uint8_t p);
                 void set_mpi(const PKA::Values & m);
 
+                #ifdef GPG_COMPATIBLE
+                std::string get_wrapped() const;
+                void set_wrapped(const std::string & w);
+                #endif
+
                 Tag::Ptr clone() const;
         };
     }
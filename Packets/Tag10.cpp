@@ -33,8 +33,12 @@ std::string Tag10::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "PGP";
 }
 
-std::string Tag10::raw() const{
-    return "PGP";
+std::size_t Tag10::serialized_size() const{
+    return 3;
+}
+
+void Tag10::write_raw(ByteWriter & out) const{
+    out.put("PGP", 3);
 }
 
 std::string Tag10::get_pgp() const{
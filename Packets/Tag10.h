@@ -60,7 +60,8 @@ namespace OpenPGP {
                 Tag10(const std::string & data);
                 void read(const std::string & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 std::string get_pgp() const;
 
@@ -26,17 +26,26 @@ Tag11::Tag11(const std::string & data)
 }
 
 void Tag11::read(const std::string & data){
+    read(ByteSlice(data));
+}
+
+void Tag11::read(const ByteSlice & data){
+    read(ByteChain(data));
+}
+
+void Tag11::read(const ByteChain & data){
     size        = data.size();
-    format      = data[0];
-    uint8_t len = data[1];
-    filename    = data.substr(2, len);
+    const std::string header = data.substr(0, 2).str();
+    format      = header[0];
+    uint8_t len = header[1];
+    filename    = data.substr(2, len).str();
 
     if (filename == "_CONSOLE"){
         std::cerr << "Warning: Special name \"_CONSOLE\" used. Message is considered to be \"for your eyes only\"." << std::endl;
     }
 
-    time    = toint(data.substr(2 + len, 4), 256);
-    literal = data.substr(len + 6, data.size() - len - 6);
+    time    = toint(data.substr(2 + len, 4).str(), 256);
+    literal = data.substr(len + 6);
 }
 
 std::string Tag11::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -48,11 +57,19 @@ std::string Tag11::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Data (" + std::to_string(1 + filename.size() + 4 + literal.size()) + " octets):\n" +
            indent + tab + tab + "Filename: " + filename + "\n" +
            indent + tab + tab + "Creation Date: " + show_time(time) + "\n" +
-           indent + tab + tab + "Data: " + literal;
+           indent + tab + tab + "Data: " + literal.str();
+}
+
+std::size_t Tag11::serialized_size() const{
+    return 1 + 1 + filename.size() + 4 + literal.size();
 }
 
-std::string Tag11::raw() const{
-    return std::string(1, format) + std::string(1, filename.size()) + filename + unhexlify(makehex(time, 8)) + literal;
+void Tag11::write_raw(ByteWriter & out) const{
+    out.put8(format);
+    out.put8(filename.size());
+    out.put(filename);
+    out.put32(time);
+    out.put(literal);
 }
 
 uint8_t Tag11::get_format() const{
@@ -71,7 +88,11 @@ std::string Tag11::get_literal() const{
     if (filename == "_CONSOLE"){
         std::cerr << "Warning: Special name \"_CONSOLE\22 used. Message is considered to be \"for your eyes only\"." << std::endl;
     }
-    return literal;
+    return literal.str();
+}
+
+const ByteSlice & Tag11::get_literal_slice() const{
+    return literal.flatten();
 }
 
 std::string Tag11::out(const bool writefile){
@@ -95,32 +116,39 @@ std::string Tag11::out(const bool writefile){
         if (!f){
             throw std::runtime_error("Error: Failed to open file to write literal data.");
         }
-        f << literal;
+        for(ByteSlice const & piece : literal.get_pieces()){
+            f.write(piece.data(), piece.size());
+        }
     }
     else{
-        return literal;
+        return literal.str();
     }
     return "Data written to file '" + filename + "'.";
 }
 
 void Tag11::set_format(const uint8_t f){
     format = f;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag11::set_filename(const std::string & f){
     filename = f;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag11::set_time(const uint32_t t){
     time = t;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag11::set_literal(const std::string & l){
     literal = l;
-    size = raw().size();
+    size = serialized_size();
+}
+
+void Tag11::set_literal(const ByteChain & l){
+    literal = l;
+    size = serialized_size();
 }
 
 Tag::Ptr Tag11::clone() const{
@@ -96,7 +96,7 @@ namespace OpenPGP {
                 uint8_t format;
                 std::string filename;
                 uint32_t time;
-                std::string literal;    // source data; no line ending conversion
+                ByteChain literal;      // source data; no line ending conversion
 
             public:
                 typedef std::shared_ptr <Packet::Tag11> Ptr;
@@ -105,19 +105,24 @@ namespace OpenPGP {
                 Tag11(const Tag11 & copy);
                 Tag11(const std::string & data);
                 void read(const std::string & data);
+                void read(const ByteSlice & data);
+                void read(const ByteChain & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 uint8_t get_format() const;
                 std::string get_filename() const;
                 uint32_t get_time() const;
                 std::string get_literal() const;
+                const ByteSlice & get_literal_slice() const;
                 std::string out(const bool writefile = true); // send data to
 
                 void set_format(const uint8_t f);
                 void set_filename(const std::string & f);
                 void set_time(const uint32_t t);
                 void set_literal(const std::string & l);
+                void set_literal(const ByteChain & l);      // no copy; the packet shares l
 
                 Tag::Ptr clone() const;
         };
@@ -31,8 +31,12 @@ std::string Tag12::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Data (" + std::to_string(trust.size()) + " octets): " + trust;
 }
 
-std::string Tag12::raw() const{
-    return trust;
+std::size_t Tag12::serialized_size() const{
+    return trust.size();
+}
+
+void Tag12::write_raw(ByteWriter & out) const{
+    out.put(trust);
 }
 
 std::string Tag12::get_trust() const{
@@ -41,7 +45,7 @@ std::string Tag12::get_trust() const{
 
 void Tag12::set_trust(const std::string & t){
     trust = t;
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag12::clone() const{
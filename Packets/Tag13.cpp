@@ -31,8 +31,12 @@ std::string Tag13::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "User ID: " + contents;
 }
 
-std::string Tag13::raw() const{
-    return contents;
+std::size_t Tag13::serialized_size() const{
+    return contents.size();
+}
+
+void Tag13::write_raw(ByteWriter & out) const{
+    out.put(contents);
 }
 
 std::string Tag13::get_contents() const{
@@ -41,7 +45,7 @@ std::string Tag13::get_contents() const{
 
 void Tag13::set_contents(const std::string & c){
     contents = c;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag13::set_contents(const std::string & name, const std::string & comment, const std::string & email){
@@ -55,7 +59,7 @@ void Tag13::set_contents(const std::string & name, const std::string & comment,
         contents += "<" + email + ">";
     }
 
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag13::clone() const{
@@ -85,14 +85,20 @@ std::string Tag17::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Tag17::raw() const{
-    std::string out = "";
+std::size_t Tag17::serialized_size() const{
+    std::size_t out = 0;
     for(Subpacket::Tag17::Sub::Ptr const & a : attributes){
-        out += a -> write();
+        out += a -> write_size();
     }
     return out;
 }
 
+void Tag17::write_raw(ByteWriter & out) const{
+    for(Subpacket::Tag17::Sub::Ptr const & a : attributes){
+        a -> write(out);
+    }
+}
+
 Tag17::Attributes Tag17::get_attributes() const{
     return attributes;
 }
@@ -110,7 +116,7 @@ void Tag17::set_attributes(const Tag17::Attributes & a){
     for(Subpacket::Tag17::Sub::Ptr const & s : a){
         attributes.push_back(s -> clone());
     }
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag17::clone() const{
@@ -20,9 +20,17 @@ Tag18::Tag18(const std::string & data)
 }
 
 void Tag18::read(const std::string & data){
+    read(ByteSlice(data));
+}
+
+void Tag18::read(const ByteSlice & data){
+    read(ByteChain(data));
+}
+
+void Tag18::read(const ByteChain & data){
     size = data.size();
-    version = data[0];
-    protected_data = data.substr(1, data.size() - 1);
+    version = data.substr(0, 1).str()[0];
+    protected_data = data.substr(1);
 }
 
 std::string Tag18::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -30,20 +38,34 @@ std::string Tag18::show(const std::size_t indents, const std::size_t indent_size
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" +
            indent + tab + "Version: " + std::to_string(version) + "\n" +
-           indent + tab + "Encrypted Data (" + std::to_string(protected_data.size()) + " octets): " + hexlify(protected_data);
+           indent + tab + "Encrypted Data (" + std::to_string(protected_data.size()) + " octets): " + hexlify(protected_data.str());
+}
+
+std::size_t Tag18::serialized_size() const{
+    return 1 + protected_data.size();
 }
 
-std::string Tag18::raw() const{
-    return std::string(1, version) + protected_data;
+void Tag18::write_raw(ByteWriter & out) const{
+    out.put8(version);
+    out.put(protected_data);
 }
 
 std::string Tag18::get_protected_data() const{
-    return protected_data;
+    return protected_data.str();
+}
+
+const ByteSlice & Tag18::get_protected_data_slice() const{
+    return protected_data.flatten();
 }
 
 void Tag18::set_protected_data(const std::string & p){
     protected_data = p;
-    size = raw().size();
+    size = serialized_size();
+}
+
+void Tag18::set_protected_data(const ByteChain & p){
+    protected_data = p;
+    size = serialized_size();
 }
 
 Tag::Ptr Tag18::clone() const{
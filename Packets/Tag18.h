@@ -131,7 +131,7 @@ namespace OpenPGP {
 
         class Tag18 : public Tag {
             private:
-                std::string protected_data;
+                ByteChain protected_data;
 
             public:
                 typedef std::shared_ptr <Packet::Tag18> Ptr;
@@ -140,12 +140,17 @@ namespace OpenPGP {
                 Tag18(const Tag18 & copy);
                 Tag18(const std::string & data);
                 void read(const std::string & data);
+                void read(const ByteSlice & data);
+                void read(const ByteChain & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 std::string get_protected_data() const;
+                const ByteSlice & get_protected_data_slice() const;
 
                 void set_protected_data(const std::string & p);
+                void set_protected_data(const ByteChain & p);   // no copy; the packet shares p
 
                 Tag::Ptr clone() const;
         };
@@ -33,8 +33,12 @@ std::string Tag19::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "SHA - 1 Hash of previous packet: " + hash;
 }
 
-std::string Tag19::raw() const{
-    return hash;
+std::size_t Tag19::serialized_size() const{
+    return hash.size();
+}
+
+void Tag19::write_raw(ByteWriter & out) const{
+    out.put(hash);
 }
 
 std::string Tag19::get_hash() const{
@@ -43,7 +47,7 @@ std::string Tag19::get_hash() const{
 
 void Tag19::set_hash(const std::string & h){
     hash = h;
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag19::clone() const{
@@ -182,17 +182,15 @@ void Tag2::read(const std::string & data){
         std::string::size_type pos = 19;
 
         if (PKA::is_RSA(pka)){
-            mpi.push_back(read_MPI(data, pos)); // RSA m**d mod n
+            mpi.read(data, pos, 1);             // RSA m**d mod n
         }
         #ifdef GPG_COMPATIBLE
         else if(pka == PKA::ID::DSA || pka == PKA::ID::ECDSA){
-            mpi.push_back(read_MPI(data, pos)); // r
-            mpi.push_back(read_MPI(data, pos)); // s
+            mpi.read(data, pos, 2);             // r, s
         }
         #else
         else if (pka == PKA::ID::DSA){
-            mpi.push_back(read_MPI(data, pos)); // DSA r
-            mpi.push_back(read_MPI(data, pos)); // DSA s
+            mpi.read(data, pos, 2);             // DSA r, s
         }
         #endif
         else{
@@ -217,18 +215,18 @@ void Tag2::read(const std::string & data){
 
 //        if (PKA::is_RSA(PKA))
         std::string::size_type pos = hashed_size + 6 + 2 + unhashed_size + 2;
-        mpi.push_back(read_MPI(data, pos));         // RSA m**d mod n
         #ifdef GPG_COMPATIBLE
         if(pka == PKA::ID::DSA || pka == PKA::ID::ECDSA || pka == PKA::ID::EdDSA){
-            // mpi.push_back(read_MPI(data, pos)); // r
-            mpi.push_back(read_MPI(data, pos)); // s
+            mpi.read(data, pos, 2);                 // r, s
         }
         #else
         if (pka == PKA::ID::DSA){
-            // mpi.push_back(read_MPI(data, pos)); // DSA r
-            mpi.push_back(read_MPI(data, pos)); // DSA s
+            mpi.read(data, pos, 2);                 // DSA r, s
         }
         #endif
+        else{
+            mpi.read(data, pos, 1);                 // RSA m**d mod n
+        }
     }
     else{
         throw std::runtime_error("Error: Tag2 Unknown version: " + std::to_string(static_cast <unsigned int> (version)));
@@ -299,48 +297,78 @@ std::string Tag2::show(const std::size_t indents, const std::size_t indent_size)
     out += "\n" + indent + tab + "Hash Left 16 Bits: " + hexlify(left16);
 
     if (PKA::is_RSA(pka)){
-        out += "\n" + indent + tab + "RSA m**d mod n (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0]);
+        out += "\n" + indent + tab + "RSA m**d mod n (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0);
     }
     #ifdef GPG_COMPATIBLE
     else if (pka == PKA::ID::ECDSA){
-        out += "\n" + indent + tab + "ECDSA r (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0])
-            += "\n" + indent + tab + "ECDSA s (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
+        out += "\n" + indent + tab + "ECDSA r (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0)
+            += "\n" + indent + tab + "ECDSA s (" + std::to_string(mpi.bitsize(1)) + " bits): " + mpi.hex(1);
     }
     else if (pka == PKA::ID::EdDSA){
-        out += "\n" + indent + tab + "EdDSA r (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0])
-            += "\n" + indent + tab + "EdDSA s (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
+        out += "\n" + indent + tab + "EdDSA r (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0)
+            += "\n" + indent + tab + "EdDSA s (" + std::to_string(mpi.bitsize(1)) + " bits): " + mpi.hex(1);
     }
     #endif
     else if (pka == PKA::ID::DSA){
-        out += "\n" + indent + tab + "DSA r (" + std::to_string(bitsize(mpi[0])) + " bits): " + mpitohex(mpi[0])
-            += "\n" + indent + tab + "DSA s (" + std::to_string(bitsize(mpi[1])) + " bits): " + mpitohex(mpi[1]);
+        out += "\n" + indent + tab + "DSA r (" + std::to_string(mpi.bitsize(0)) + " bits): " + mpi.hex(0)
+            += "\n" + indent + tab + "DSA s (" + std::to_string(mpi.bitsize(1)) + " bits): " + mpi.hex(1);
     }
 
     return out;
 }
 
-std::string Tag2::raw() const{
-    std::string out(1, version);
-    if (version < 4){// to recreate older keys
-        out += "\x05" + std::string(1, type) + unhexlify(makehex(time, 8)) + keyid + std::string(1, pka) + std::string(1, hash) + left16;
+// appends subpackets preceded by their 2 octet total length
+static void write_subpackets(const Tag2::Subpackets & subpackets, ByteWriter & out){
+    const std::size_t pos = out.size();
+    out.put16(0);
+    for(Subpacket::Tag2::Sub::Ptr const & s : subpackets){
+        s -> write(out);
     }
-    if (version == 4){
-        std::string hashed_str = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets){
-            hashed_str += s -> write();
-        }
-        std::string unhashed_str = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : unhashed_subpackets){
-            unhashed_str += s -> write();
-        }
-        out += std::string(1, type) + std::string(1, pka) + std::string(1, hash) + unhexlify(makehex(hashed_str.size(), 4)) + hashed_str + unhexlify(makehex(unhashed_str.size(), 4)) + unhashed_str + left16;
+    out.patch16(pos, out.size() - pos - 2);
+}
+
+static std::size_t subpackets_size(const Tag2::Subpackets & subpackets){
+    std::size_t out = 2;
+    for(Subpacket::Tag2::Sub::Ptr const & s : subpackets){
+        out += s -> write_size();
+    }
+    return out;
+}
+
+std::size_t Tag2::serialized_size() const{
+    std::size_t out = 1;
+    if (version < 4){
+        out += 1 + 1 + 4 + keyid.size() + 1 + 1 + left16.size();
     }
-    for(MPI const & i : mpi){
-        out += write_MPI(i);
+    if (version == 4){
+        out += 3 + subpackets_size(hashed_subpackets) + subpackets_size(unhashed_subpackets) + left16.size();
     }
+    out += mpi.write_size();
     return out;
 }
 
+void Tag2::write_raw(ByteWriter & out) const{
+    out.put8(version);
+    if (version < 4){// to recreate older keys
+        out.put8(5);
+        out.put8(type);
+        out.put32(time);
+        out.put(keyid);
+        out.put8(pka);
+        out.put8(hash);
+        out.put(left16);
+    }
+    if (version == 4){
+        out.put8(type);
+        out.put8(pka);
+        out.put8(hash);
+        write_subpackets(hashed_subpackets, out);
+        write_subpackets(unhashed_subpackets, out);
+        out.put(left16);
+    }
+    mpi.write(out);
+}
+
 uint8_t Tag2::get_type() const{
     return type;
 }
@@ -357,8 +385,8 @@ std::string Tag2::get_left16() const{
     return left16;
 }
 
-PKA::Values Tag2::get_mpi() const{
-    return mpi;
+const PKA::Values & Tag2::get_mpi() const{
+    return mpi.get();
 }
 
 std::array <uint32_t, 3> Tag2::get_times() const{
@@ -464,14 +492,20 @@ Tag2::Subpackets Tag2::get_unhashed_subpackets_clone() const{
 
 std::string Tag2::get_up_to_hashed() const{
     if (version == 3){
-        return "\x03" + std::string(1, type) + unhexlify(makehex(time, 8));
+        ByteWriter out(6);
+        out.put8(3);
+        out.put8(type);
+        out.put32(time);
+        return out.release();
     }
     else if (version == 4){
-        std::string hashed = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets){
-            hashed += s -> write();
-        }
-        return "\x04" + std::string(1, type) + std::string(1, pka) + std::string(1, hash) + unhexlify(makehex(hashed.size(), 4)) + hashed;
+        ByteWriter out(4 + subpackets_size(hashed_subpackets));
+        out.put8(4);
+        out.put8(type);
+        out.put8(pka);
+        out.put8(hash);
+        write_subpackets(hashed_subpackets, out);
+        return out.release();
     }
     else{
         throw std::runtime_error("Error: Signature packet version " + std::to_string(version) + " not defined.");
@@ -480,46 +514,52 @@ std::string Tag2::get_up_to_hashed() const{
 }
 
 std::string Tag2::get_without_unhashed() const{
-    std::string out(1, version);
+    ByteWriter out(serialized_size());
+    out.put8(version);
     if (version < 4){// to recreate older keys
-        out += "\x05" + std::string(1, type) + unhexlify(makehex(time, 8)) + keyid + std::string(1, pka) + std::string(1, hash) + left16;
+        out.put8(5);
+        out.put8(type);
+        out.put32(time);
+        out.put(keyid);
+        out.put8(pka);
+        out.put8(hash);
+        out.put(left16);
     }
     if (version == 4){
-        std::string hashed_str = "";
-        for(Subpacket::Tag2::Sub::Ptr const & s : hashed_subpackets){
-            hashed_str += s -> write();
-        }
-        out += std::string(1, type) + std::string(1, pka) + std::string(1, hash) + unhexlify(makehex(hashed_str.size(), 4)) + hashed_str + zero + zero + left16;
-    }
-    for(MPI const & i : mpi){
-        out += write_MPI(i);
+        out.put8(type);
+        out.put8(pka);
+        out.put8(hash);
+        write_subpackets(hashed_subpackets, out);
+        out.put16(0);
+        out.put(left16);
     }
-    return out;
+    mpi.write(out);
+    return out.release();
 }
 
 void Tag2::set_type(const uint8_t t){
     type = t;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_pka(const uint8_t p){
     pka = p;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_hash(const uint8_t h){
     hash = h;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_left16(const std::string & l){
     left16 = l;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_mpi(const PKA::Values & m){
-    mpi = m;
-    size = raw().size();
+    mpi = MPISlices(m);
+    size = serialized_size();
 }
 
 void Tag2::set_time(const uint32_t t){
@@ -542,7 +582,7 @@ void Tag2::set_time(const uint32_t t){
             hashed_subpackets[i] = sub2;
         }
     }
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_keyid(const std::string & k){
@@ -569,7 +609,7 @@ void Tag2::set_keyid(const std::string & k){
             unhashed_subpackets[i] = sub16;
         }
     }
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_hashed_subpackets(const Tag2::Subpackets & h){
@@ -577,7 +617,7 @@ void Tag2::set_hashed_subpackets(const Tag2::Subpackets & h){
     for(Subpacket::Tag2::Sub::Ptr const & s : h){
         hashed_subpackets.push_back(s -> clone());
     }
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag2::set_unhashed_subpackets(const Tag2::Subpackets & u){
@@ -585,7 +625,7 @@ void Tag2::set_unhashed_subpackets(const Tag2::Subpackets & u){
     for(Subpacket::Tag2::Sub::Ptr const & s : u){
         unhashed_subpackets.push_back(s -> clone());
     }
-    size = raw().size();
+    size = serialized_size();
 }
 
 std::string Tag2::find_subpacket(const uint8_t sub) const{
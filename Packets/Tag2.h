@@ -69,7 +69,7 @@ namespace OpenPGP {
                 uint8_t type;
                 uint8_t pka;
                 uint8_t hash;
-                PKA::Values mpi;
+                MPISlices mpi;                  // converted on first use
                 std::string left16;        // 2 octets
 
                 // version 3 stuff
@@ -95,13 +95,14 @@ namespace OpenPGP {
                 ~Tag2();
                 void read(const std::string & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw()                               const;
+                std::size_t serialized_size()                   const;
+                void write_raw(ByteWriter & out)                const;
 
                 uint8_t get_type()                              const;
                 uint8_t get_pka()                               const;
                 uint8_t get_hash()                              const;
                 std::string get_left16()                        const;      // whatever is stored, not calculated
-                PKA::Values get_mpi()                           const;
+                const PKA::Values & get_mpi()                   const;
 
                 // special functions: works differently depending on version
                 std::array <uint32_t, 3> get_times()            const;      // signature creation/expiration time and key expiration time; creation time should always exist; expirations times are 0 for version 3 signatures
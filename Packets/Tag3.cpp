@@ -42,6 +42,9 @@ void Tag3::read(const std::string & data){
     else if (data[2] == S2K::ID::ITERATED_AND_SALTED_S2K){
         s2k = std::make_shared <S2K::S2K3> ();
     }
+    else if (data[2] == S2K::ID::ARGON2){
+        s2k = std::make_shared <S2K::S2K4> ();
+    }
     else{
         throw std::runtime_error("Unknown S2K ID encountered: " + std::to_string(data[0]));
     }
@@ -68,8 +71,19 @@ std::string Tag3::show(const std::size_t indents, const std::size_t indent_size)
     return out;
 }
 
-std::string Tag3::raw() const{
-    return std::string(1, version) + std::string(1, sym) + (s2k?s2k -> write():"") + (esk?*esk:"");
+std::size_t Tag3::serialized_size() const{
+    return 2 + (s2k?s2k -> serialized_size():0) + (esk?esk -> size():0);
+}
+
+void Tag3::write_raw(ByteWriter & out) const{
+    out.put8(version);
+    out.put8(sym);
+    if (s2k){
+        s2k -> write(out);
+    }
+    if (esk){
+        out.put(*esk);
+    }
 }
 
 uint8_t Tag3::get_sym() const{
@@ -105,7 +119,7 @@ std::string Tag3::get_session_key(const std::string & pass) const{
 
 void Tag3::set_sym(const uint8_t s){
     sym = s;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag3::set_s2k(const S2K::S2K::Ptr & s){
@@ -114,12 +128,13 @@ void Tag3::set_s2k(const S2K::S2K::Ptr & s){
     }
 
     if ((s -> get_type() != S2K::ID::SALTED_S2K)             &&
-        (s -> get_type() != S2K::ID::ITERATED_AND_SALTED_S2K)){
+        (s -> get_type() != S2K::ID::ITERATED_AND_SALTED_S2K) &&
+        (s -> get_type() != S2K::ID::ARGON2)){
         throw std::runtime_error("Error: S2K must have a salt value.");
     }
 
     s2k = s -> clone();
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag3::set_esk(std::string * s){
@@ -130,7 +145,7 @@ void Tag3::set_esk(std::string * s){
 
 void Tag3::set_esk(const std::string & s){
     esk = std::make_shared <std::string> (s);
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag3::set_session_key(const std::string & pass, const std::string & sk){
@@ -139,7 +154,7 @@ void Tag3::set_session_key(const std::string & pass, const std::string & sk){
     if (s2k && (sk.size() > 1)){
         esk = std::make_shared <std::string> (use_normal_CFB_encrypt(sym, sk, s2k -> run(pass, Sym::KEY_LENGTH.at(sym) >> 3), std::string(Sym::BLOCK_LENGTH.at(sym) >> 3, 0)));
     }
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag3::clone() const{
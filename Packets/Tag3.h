@@ -99,7 +99,8 @@ namespace OpenPGP {
                 ~Tag3();
                 void read(const std::string & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 uint8_t get_sym() const;
                 S2K::S2K::Ptr get_s2k() const;
@@ -51,8 +51,17 @@ std::string Tag4::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Nested: " + std::to_string(nested);
     }
 
-std::string Tag4::raw() const{
-    return "\x03" + std::string(1, type) + std::string(1, hash) + std::string(1, pka) + keyid + std::string(1, nested);
+std::size_t Tag4::serialized_size() const{
+    return 4 + keyid.size() + 1;
+}
+
+void Tag4::write_raw(ByteWriter & out) const{
+    out.put8(3);
+    out.put8(type);
+    out.put8(hash);
+    out.put8(pka);
+    out.put(keyid);
+    out.put8(nested);
 }
 
 uint8_t Tag4::get_type() const{
@@ -77,17 +86,17 @@ uint8_t Tag4::get_nested() const{
 
 void Tag4::set_type(const uint8_t t){
     type = t;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag4::set_hash(const uint8_t h){
     hash = h;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag4::set_pka(const uint8_t p){
     pka = p;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag4::set_keyid(const std::string & k){
@@ -95,12 +104,12 @@ void Tag4::set_keyid(const std::string & k){
         throw std::runtime_error("Error: Key ID must be 8 octets.");
     }
     keyid = k;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag4::set_nested(const uint8_t n){
     nested = n;
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag4::clone() const{
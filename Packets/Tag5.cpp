@@ -9,7 +9,8 @@ Tag5::Tag5(uint8_t tag)
       sym(0),
       s2k(),
       IV(),
-      secret()
+      secret(),
+      secret_modexp()
 {}
 
 Tag5::Tag5()
@@ -22,7 +23,8 @@ Tag5::Tag5(const Tag5 & copy)
       sym(copy.sym),
       s2k(copy.s2k),
       IV(copy.IV),
-      secret(copy.secret)
+      secret(copy.secret),
+      secret_modexp(std::atomic_load(&copy.secret_modexp))
 {}
 
 Tag5::Tag5(const std::string & data)
@@ -45,6 +47,9 @@ void Tag5::read_s2k(const std::string & data, std::string::size_type & pos){
     else if (data[pos] == S2K::ID::ITERATED_AND_SALTED_S2K){
         s2k = std::make_shared <S2K::S2K3> ();
     }
+    else if (data[pos] == S2K::ID::ARGON2){
+        s2k = std::make_shared <S2K::S2K4> ();
+    }
     else{
         throw std::runtime_error("Error: Bad S2K ID encountered: " + std::to_string(data[0]));
     }
@@ -185,6 +190,7 @@ void Tag5::read(const std::string & data){
 
     // plaintex or encrypted data
     secret = data.substr(pos, data.size() - pos);
+    secret_modexp = nullptr;
 }
 
 std::string Tag5::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -195,28 +201,35 @@ std::string Tag5::show(const std::size_t indents, const std::size_t indent_size)
            show_private(indents, indent_size);
 }
 
-std::string Tag5::raw() const{
-    std::string out = raw_common() +            // public data
-                      std::string(1, s2k_con);  // S2K usage octet
+std::size_t Tag5::serialized_size() const{
+    std::size_t out = raw_common_size() + 1;
     if ((s2k_con == 254) || (s2k_con == 255)){
-        if (!s2k){
-            throw std::runtime_error("Error: S2K has not been set.");
-        }
-        out += std::string(1, sym);             // one octet symmetric key encryption algorithm
+        out += 1 + (s2k?s2k -> serialized_size():0);
     }
 
+    if (s2k_con){
+        out += IV.size();
+    }
+
+    return out + secret.size();
+}
+
+void Tag5::write_raw(ByteWriter & out) const{
+    write_raw_common(out);                      // public data
+    out.put8(s2k_con);                          // S2K usage octet
     if ((s2k_con == 254) || (s2k_con == 255)){
         if (!s2k){
             throw std::runtime_error("Error: S2K has not been set.");
         }
-        out += s2k -> write();                  // S2K specifier
+        out.put8(sym);                          // one octet symmetric key encryption algorithm
+        s2k -> write(out);                      // S2K specifier
     }
 
     if (s2k_con){
-        out += IV;                              // IV
+        out.put(IV);                            // IV
     }
 
-    return out + secret;
+    out.put(secret);
 }
 
 uint8_t Tag5::get_s2k_con() const{
@@ -255,26 +268,12 @@ Tag6::Ptr Tag5::get_public_ptr() const{
 
 void Tag5::set_s2k_con(const uint8_t c){
     s2k_con = c;
-    size = raw_common().size() + 1;
-    if (s2k){
-        size += s2k -> write().size();
-    }
-    if (s2k_con){
-        size += IV.size();
-    }
-    size += secret.size();
+    size = serialized_size();
 }
 
 void Tag5::set_sym(const uint8_t s){
     sym = s;
-    size = raw_common().size() + 1;
-    if (s2k){
-        size += s2k -> write().size();
-    }
-    if (s2k_con){
-        size += IV.size();
-    }
-    size += secret.size();
+    size = serialized_size();
 }
 
 void Tag5::set_s2k(const S2K::S2K::Ptr & s){
@@ -287,39 +286,22 @@ void Tag5::set_s2k(const S2K::S2K::Ptr & s){
     else if (s -> get_type() == S2K::ID::ITERATED_AND_SALTED_S2K){
         s2k = std::make_shared <S2K::S2K3> ();
     }
-    s2k = s -> clone();
-    size = raw_common().size() + 1;
-    if (s2k){
-        size += s2k -> write().size();
-    }
-    if (s2k_con){
-        size += IV.size();
+    else if (s -> get_type() == S2K::ID::ARGON2){
+        s2k = std::make_shared <S2K::S2K4> ();
     }
-    size += secret.size();
+    s2k = s -> clone();
+    size = serialized_size();
 }
 
 void Tag5::set_IV(const std::string & iv){
     IV = iv;
-    size = raw_common().size() + 1;
-    if (s2k){
-        size += s2k -> write().size();
-    }
-    if (s2k_con){
-        size += IV.size();
-    }
-    size += secret.size();
+    size = serialized_size();
 }
 
 void Tag5::set_secret(const std::string & s){
     secret = s;
-    size = raw_common().size() + 1;
-    if (s2k){
-        size += s2k -> write().size();
-    }
-    if (s2k_con){
-        size += IV.size();
-    }
-    size += secret.size();
+    secret_modexp = nullptr;
+    size = serialized_size();
 }
 
 std::string Tag5::calculate_key(const std::string & passphrase) const {
@@ -344,6 +326,7 @@ std::string Tag5::calculate_key(const std::string & passphrase) const {
 
 const std::string & Tag5::encrypt_secret_keys(const std::string & passphrase, const PKA::Values & keys){
     secret = "";
+    secret_modexp = nullptr;
 
     // convert keys into string
     for(MPI const & mpi : keys){
@@ -352,7 +335,7 @@ const std::string & Tag5::encrypt_secret_keys(const std::string & passphrase, co
 
     // calculate checksum
     if(s2k_con == 254){
-        secret += Hash::use(s2k -> get_hash(), secret); // SHA1
+        secret += Hash::use(Hash::ID::SHA1, secret);
     }
     else{
         uint16_t sum = 0;
@@ -377,10 +360,22 @@ const std::string & Tag5::encrypt_secret_keys(const std::string & passphrase, co
 PKA::Values Tag5::decrypt_secret_keys(const std::string & passphrase) const {
     std::string keys;
 
+    // keys derived by an S2K specifier may already be in the cache
+    const bool cacheable = s2k && ((s2k_con == 254) || (s2k_con == 255)) && S2K::Cache::enabled();
+    std::string fingerprint, params, key;
+    bool cached = false;
+    if (cacheable){
+        fingerprint = get_fingerprint();
+        params = std::string(1, sym) + s2k -> write();
+        cached = S2K::Cache::get(fingerprint, params, passphrase, key);
+    }
+
     // S2k != 0 -> secret keys are encrypted
     if (s2k_con){
         // calculate key to decrypt
-        const std::string key = calculate_key(passphrase);
+        if (!cached){
+            key = calculate_key(passphrase);
+        }
 
         // decrypt
         keys = use_normal_CFB_decrypt(sym, secret, key, IV);
@@ -412,6 +407,11 @@ PKA::Values Tag5::decrypt_secret_keys(const std::string & passphrase) const {
         throw std::runtime_error("Error: Secret key checksum and calculated checksum do not match.");
     }
 
+    // only keys that were shown to be right are remembered
+    if (cacheable && !cached){
+        S2K::Cache::put(fingerprint, params, passphrase, key);
+    }
+
     // extract MPI values
     PKA::Values out;
     std::string::size_type pos = 0;
@@ -422,6 +422,31 @@ PKA::Values Tag5::decrypt_secret_keys(const std::string & passphrase) const {
     return out;
 }
 
+PKA::ModExpContext::Ptr Tag5::get_secret_modexp(const PKA::Values & pri) const{
+    const PKA::ModExpContext::Ptr pub = get_modexp();
+    if (!pub || !PKA::is_RSA(pka)){
+        return pub;
+    }
+
+    PKA::ModExpContext::Ptr context = std::atomic_load(&secret_modexp);
+    if (context && (context -> get_mod() == pub -> get_mod()) && context -> has_crt(pri)){
+        return context;
+    }
+
+    context = std::make_shared <PKA::ModExpContext> (*pub);
+    if (!context -> set_crt(pri)){
+        // "Error: RSA private values do not match the public key.\n";
+        return nullptr;
+    }
+
+    std::atomic_store(&secret_modexp, context);
+    return context;
+}
+
+PKA::ModExpContext::Ptr Tag5::get_secret_modexp(const std::string & passphrase) const{
+    return get_secret_modexp(decrypt_secret_keys(passphrase));
+}
+
 Tag::Ptr Tag5::clone() const{
     Ptr out = std::make_shared <Packet::Tag5> (*this);
     out -> s2k = s2k?s2k -> clone():nullptr;
@@ -435,6 +460,7 @@ Tag5 & Tag5::operator=(const Tag5 & copy){
     s2k = copy.s2k?copy.s2k -> clone():nullptr;
     IV = copy.IV;
     secret = copy.secret;
+    secret_modexp = std::atomic_load(&copy.secret_modexp);
     return *this;
 }
 
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "../Misc/cfb.h"
 #include "../Misc/mpi.h"
 #include "../Misc/s2k.h"
+#include "../Misc/s2kcache.h"
 #include "Tag6.h"
 
 namespace OpenPGP {
@@ -140,6 +141,7 @@ namespace OpenPGP {
                 S2K::S2K::Ptr s2k;
                 std::string IV;
                 std::string secret;
+                mutable PKA::ModExpContext::Ptr secret_modexp;  // last context built by get_secret_modexp
 
                 void read_s2k(const std::string & data, std::string::size_type & pos);
                 std::string show_private(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
@@ -155,7 +157,8 @@ namespace OpenPGP {
                 virtual ~Tag5();
                 void read(const std::string & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 uint8_t get_s2k_con() const;
                 uint8_t get_sym() const;
@@ -179,9 +182,15 @@ namespace OpenPGP {
                 // encrypt and set the secret keys
                 const std::string & encrypt_secret_keys(const std::string & passphrase, const PKA::Values & keys);
 
-                // decrypt the secret keys
+                // decrypt the secret keys; the derived key is looked up in
+                // and added to S2K::Cache while the cache is enabled
                 PKA::Values decrypt_secret_keys(const std::string & passphrase) const;
 
+                // exponentiation context holding the decrypted private values as well
+                // the context is cached and handed out again for the same private values
+                PKA::ModExpContext::Ptr get_secret_modexp(const PKA::Values & pri) const;
+                PKA::ModExpContext::Ptr get_secret_modexp(const std::string & passphrase) const;
+
                 Tag::Ptr clone() const;
                 Tag5 & operator=(const Tag5 & copy);
         };
@@ -21,18 +21,30 @@ void Tag60::read(const std::string & data){
     stream = data;
 }
 
+void Tag60::read(const ByteSlice & data){
+    stream = data;
+}
+
 std::string Tag60::show(const std::size_t indents, const std::size_t indent_size) const{
     const std::string indent(indents * indent_size, ' ');
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" +
-           indent + tab + hexlify(stream);
+           indent + tab + hexlify(stream.str());
 }
 
-std::string Tag60::raw() const{
-    return stream;
+std::size_t Tag60::serialized_size() const{
+    return stream.size();
+}
+
+void Tag60::write_raw(ByteWriter & out) const{
+    out.put(stream);
 }
 
 std::string Tag60::get_stream() const{
+    return stream.str();
+}
+
+const ByteSlice & Tag60::get_stream_slice() const{
     return stream;
 }
 
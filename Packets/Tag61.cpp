@@ -21,18 +21,30 @@ void Tag61::read(const std::string & data){
     stream = data;
 }
 
+void Tag61::read(const ByteSlice & data){
+    stream = data;
+}
+
 std::string Tag61::show(const std::size_t indents, const std::size_t indent_size) const{
     const std::string indent(indents * indent_size, ' ');
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" + 
-           indent + tab + hexlify(stream);
+           indent + tab + hexlify(stream.str());
 }
 
-std::string Tag61::raw() const{
-    return stream;
+std::size_t Tag61::serialized_size() const{
+    return stream.size();
+}
+
+void Tag61::write_raw(ByteWriter & out) const{
+    out.put(stream);
 }
 
 std::string Tag61::get_stream() const{
+    return stream.str();
+}
+
+const ByteSlice & Tag61::get_stream_slice() const{
     return stream;
 }
 
@@ -33,7 +33,7 @@ namespace OpenPGP {
 
         class Tag62 : public Tag {
             private:
-                std::string stream;
+                ByteSlice stream;
 
             public:
                 typedef std::shared_ptr <Packet::Tag62> Ptr;
@@ -42,10 +42,13 @@ namespace OpenPGP {
                 Tag62(const Tag62 & copy);
                 Tag62(const std::string & data);
                 void read(const std::string & data);
+                void read(const ByteSlice & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 std::string get_stream() const;
+                const ByteSlice & get_stream_slice() const;
 
                 void set_stream(const std::string & data);
 
@@ -21,18 +21,30 @@ void Tag63::read(const std::string & data){
     stream = data;
 }
 
+void Tag63::read(const ByteSlice & data){
+    stream = data;
+}
+
 std::string Tag63::show(const std::size_t indents, const std::size_t indent_size) const{
     const std::string indent(indents * indent_size, ' ');
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" + 
-           indent + tab + hexlify(stream);
+           indent + tab + hexlify(stream.str());
 }
 
-std::string Tag63::raw() const{
-    return stream;
+std::size_t Tag63::serialized_size() const{
+    return stream.size();
+}
+
+void Tag63::write_raw(ByteWriter & out) const{
+    out.put(stream);
 }
 
 std::string Tag63::get_stream() const{
+    return stream.str();
+}
+
+const ByteSlice & Tag63::get_stream_slice() const{
     return stream;
 }
 
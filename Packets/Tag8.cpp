@@ -54,9 +54,17 @@ Tag8::Tag8(const std::string & data)
 }
 
 void Tag8::read(const std::string & data){
+    read(ByteSlice(data));
+}
+
+void Tag8::read(const ByteSlice & data){
+    read(ByteChain(data));
+}
+
+void Tag8::read(const ByteChain & data){
     size = data.size();
-    comp = data[0];
-    compressed_data = data.substr(1, size - 1);
+    comp = data.substr(0, 1).str()[0];
+    compressed_data = data.substr(1);
 }
 
 std::string Tag8::show(const std::size_t indents, const std::size_t indent_size) const{
@@ -64,7 +72,7 @@ std::string Tag8::show(const std::size_t indents, const std::size_t indent_size)
     const std::string tab(indent_size, ' ');
     const decltype(Compression::NAME)::const_iterator comp_it = Compression::NAME.find(comp);
     Message decompressed;
-    decompressed.read_raw(get_data()); // do this in case decompressed data contains headers
+    decompressed.read_raw(ByteSlice(get_data())); // do this in case decompressed data contains headers
 
     return indent + show_title() + "\n" +
            indent + tab + "Compression Algorithm: " + ((comp_it == Compression::NAME.end())?"Unknown":(comp_it -> second)) + " (compress " + std::to_string(comp) + ")\n" +
@@ -72,8 +80,13 @@ std::string Tag8::show(const std::size_t indents, const std::size_t indent_size)
            decompressed.show(indents + 2, indent_size);
 }
 
-std::string Tag8::raw() const{
-    return std::string(1, comp) + compressed_data;
+std::size_t Tag8::serialized_size() const{
+    return 1 + compressed_data.size();
+}
+
+void Tag8::write_raw(ByteWriter & out) const{
+    out.put8(comp);
+    out.put(compressed_data);
 }
 
 uint8_t Tag8::get_comp() const{
@@ -81,11 +94,15 @@ uint8_t Tag8::get_comp() const{
 }
 
 std::string Tag8::get_compressed_data() const{
-    return compressed_data;
+    return compressed_data.str();
+}
+
+const ByteSlice & Tag8::get_compressed_data_slice() const{
+    return compressed_data.flatten();
 }
 
 std::string Tag8::get_data() const{
-    return decompress(compressed_data);
+    return decompress(compressed_data.str());
 }
 
 void Tag8::set_comp(const uint8_t alg){
@@ -94,17 +111,17 @@ void Tag8::set_comp(const uint8_t alg){
     comp = alg;                         // set new compression algorithm
     set_data(data);                     // compress data with new algorithm
     comp = alg;
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag8::set_data(const std::string & data){
     compressed_data = compress(data);
-    size = raw().size();
+    size = serialized_size();
 }
 
 void Tag8::set_compressed_data(const std::string & data){
     compressed_data = data;
-    size = raw().size();
+    size = serialized_size();
 }
 
 Tag::Ptr Tag8::clone() const{
@@ -63,7 +63,7 @@ namespace OpenPGP {
         class Tag8 : public Tag {
             private:
                 uint8_t comp;
-                std::string compressed_data;
+                ByteChain compressed_data;
 
                 // call external functions to do compression and decompression
                 std::string compress(const std::string & data) const;
@@ -78,12 +78,16 @@ namespace OpenPGP {
                 Tag8(const Tag8 & copy);
                 Tag8(const std::string & data);
                 void read(const std::string & data);
+                void read(const ByteSlice & data);
+                void read(const ByteChain & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 uint8_t get_comp() const;
                 std::string get_data() const;                           // get uncompressed data
                 std::string get_compressed_data() const;                // get compressed data
+                const ByteSlice & get_compressed_data_slice() const;    // get compressed data without copying
 
                 void set_comp(const uint8_t alg);
                 void set_data(const std::string & data);                // set uncompressed data
@@ -20,6 +20,14 @@ Tag9::Tag9(const std::string & data)
 }
 
 void Tag9::read(const std::string & data){
+    read(ByteSlice(data));
+}
+
+void Tag9::read(const ByteSlice & data){
+    read(ByteChain(data));
+}
+
+void Tag9::read(const ByteChain & data){
     size = data.size();
     encrypted_data = data;
 }
@@ -28,20 +36,33 @@ std::string Tag9::show(const std::size_t indents, const std::size_t indent_size)
     const std::string indent(indents * indent_size, ' ');
     const std::string tab(indent_size, ' ');
     return indent + show_title() + "\n" +
-           indent + tab + "Encrypted Data (" + std::to_string(encrypted_data.size()) + " octets): " + hexlify(encrypted_data);
+           indent + tab + "Encrypted Data (" + std::to_string(encrypted_data.size()) + " octets): " + hexlify(encrypted_data.str());
+}
+
+std::size_t Tag9::serialized_size() const{
+    return encrypted_data.size();
 }
 
-std::string Tag9::raw() const{
-    return encrypted_data;
+void Tag9::write_raw(ByteWriter & out) const{
+    out.put(encrypted_data);
 }
 
 std::string Tag9::get_encrypted_data() const{
-    return encrypted_data;
+    return encrypted_data.str();
+}
+
+const ByteSlice & Tag9::get_encrypted_data_slice() const{
+    return encrypted_data.flatten();
 }
 
 void Tag9::set_encrypted_data(const std::string & e){
     encrypted_data = e;
-    size = raw().size();
+    size = serialized_size();
+}
+
+void Tag9::set_encrypted_data(const ByteChain & e){
+    encrypted_data = e;
+    size = serialized_size();
 }
 
 Tag::Ptr Tag9::clone() const{
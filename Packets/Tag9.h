@@ -76,7 +76,7 @@ namespace OpenPGP {
 
         class Tag9 : public Tag {
             private:
-                std::string encrypted_data;
+                ByteChain encrypted_data;
 
             public:
                 typedef std::shared_ptr <Packet::Tag9> Ptr;
@@ -85,14 +85,19 @@ namespace OpenPGP {
                 Tag9(const Tag9 & copy);
                 Tag9(const std::string & data);
                 void read(const std::string & data);
+                void read(const ByteSlice & data);
+                void read(const ByteChain & data);
                 std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                std::string raw() const;
+                std::size_t serialized_size() const;
+                void write_raw(ByteWriter & out) const;
 
                 Tag::Ptr clone() const;
 
                 std::string get_encrypted_data() const;
+                const ByteSlice & get_encrypted_data_slice() const;
 
                 void set_encrypted_data(const std::string & e);
+                void set_encrypted_data(const ByteChain & e);   // no copy; the packet shares e
         };
     }
 }
@@ -0,0 +1,81 @@
+#include "packets.h"
+
+namespace OpenPGP {
+namespace Packet {
+
+Tag::Ptr create(const uint8_t tag){
+    Tag::Ptr out;
+    if (tag == RESERVED){
+        throw std::runtime_error("Error: Tag number MUST NOT be 0.");
+    }
+    else if (tag == PUBLIC_KEY_ENCRYPTED_SESSION_KEY){
+        out = std::make_shared <Tag1> ();
+    }
+    else if (tag == SIGNATURE){
+        out = std::make_shared <Tag2> ();
+    }
+    else if (tag == SYMMETRIC_KEY_ENCRYPTED_SESSION_KEY){
+        out = std::make_shared <Tag3> ();
+    }
+    else if (tag == ONE_PASS_SIGNATURE){
+        out = std::make_shared <Tag4> ();
+    }
+    else if (tag == SECRET_KEY){
+        out = std::make_shared <Tag5> ();
+    }
+    else if (tag == PUBLIC_KEY){
+        out = std::make_shared <Tag6> ();
+    }
+    else if (tag == SECRET_SUBKEY){
+        out = std::make_shared <Tag7> ();
+    }
+    else if (tag == COMPRESSED_DATA){
+        out = std::make_shared <Tag8> ();
+    }
+    else if (tag == SYMMETRICALLY_ENCRYPTED_DATA){
+        out = std::make_shared <Tag9> ();
+    }
+    else if (tag == MARKER_PACKET){
+        out = std::make_shared <Tag10> ();
+    }
+    else if (tag == LITERAL_DATA){
+        out = std::make_shared <Tag11> ();
+    }
+    else if (tag == TRUST){
+        out = std::make_shared <Tag12> ();
+    }
+    else if (tag == USER_ID){
+        out = std::make_shared <Tag13> ();
+    }
+    else if (tag == PUBLIC_SUBKEY){
+        out = std::make_shared <Tag14> ();
+    }
+    else if (tag == USER_ATTRIBUTE){
+        out = std::make_shared <Tag17> ();
+    }
+    else if (tag == SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA){
+        out = std::make_shared <Tag18> ();
+    }
+    else if (tag == MODIFICATION_DETECTION_CODE){
+        out = std::make_shared <Tag19> ();
+    }
+    else if (tag == 60){
+        out = std::make_shared <Tag60> ();
+    }
+    else if (tag == 61){
+        out = std::make_shared <Tag61> ();
+    }
+    else if (tag == 62){
+        out = std::make_shared <Tag62> ();
+    }
+    else if (tag == 63){
+        out = std::make_shared <Tag63> ();
+    }
+    else{
+        throw std::runtime_error("Error: Tag not defined: " + std::to_string(tag) + ".");
+    }
+    return out;
+}
+
+}
+}
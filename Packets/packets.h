@@ -55,4 +55,12 @@ THE SOFTWARE.
 #include "Tag62.h"  // Private or Experimental Values
 #include "Tag63.h"  // Private or Experimental Values
 
+namespace OpenPGP {
+    namespace Packet {
+
+        // returns an empty packet object for the given tag number
+        Tag::Ptr create(const uint8_t tag);
+    }
+}
+
 #endif
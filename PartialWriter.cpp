@@ -0,0 +1,107 @@
+#include "PartialWriter.h"
+
+#include <algorithm>
+
+namespace OpenPGP {
+
+PartialWriter::ChunkBuf::ChunkBuf(std::ostream & out, const uint8_t tag, const std::size_t chunk)
+    : std::streambuf(),
+      dst(&out),
+      tag(tag),
+      chunk_length(Packet::partial_length(chunk)),
+      started(false),
+      closed(false),
+      buf(chunk)
+{
+    setp(buf.data(), buf.data() + buf.size());
+}
+
+void PartialWriter::ChunkBuf::write_chunk(){
+    if (!started){
+        dst -> put(0b11000000 | tag);
+        started = true;
+    }
+
+    dst -> put(chunk_length);
+    dst -> write(buf.data(), buf.size());
+    setp(buf.data(), buf.data() + buf.size());
+}
+
+PartialWriter::ChunkBuf::int_type PartialWriter::ChunkBuf::overflow(int_type c){
+    if (closed){
+        return traits_type::eof();
+    }
+
+    if (traits_type::eq_int_type(c, traits_type::eof())){
+        return traits_type::not_eof(c);
+    }
+
+    // the buffer is full and more data follows, so it is not the last chunk
+    write_chunk();
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+}
+
+std::streamsize PartialWriter::ChunkBuf::xsputn(const char * s, std::streamsize n){
+    if (closed){
+        return 0;
+    }
+
+    const std::streamsize total = n;
+    while (n){
+        if (pptr() == epptr()){
+            write_chunk();
+        }
+
+        const std::streamsize room = std::min <std::streamsize> (epptr() - pptr(), n);
+        std::copy(s, s + room, pptr());
+        pbump(room);
+        s += room;
+        n -= room;
+    }
+    return total;
+}
+
+void PartialWriter::ChunkBuf::close(){
+    if (closed){
+        return;
+    }
+    closed = true;
+
+    const std::size_t length = pptr() - pbase();
+
+    ByteWriter header(6);
+    if (!started){
+        header.put8(0b11000000 | tag);
+    }
+    Packet::write_body_length(length, header);
+
+    dst -> write(header.str().data(), header.size());
+    dst -> write(pbase(), length);
+    setp(nullptr, nullptr);
+}
+
+bool PartialWriter::ChunkBuf::is_closed() const{
+    return closed;
+}
+
+PartialWriter::PartialWriter(std::ostream & out, const uint8_t tag, const std::size_t chunk)
+    : std::ostream(nullptr),
+      chunks(out, tag, chunk)
+{
+    rdbuf(&chunks);
+}
+
+PartialWriter::~PartialWriter(){
+    try{
+        close();
+    }
+    catch (...){}
+}
+
+void PartialWriter::close(){
+    chunks.close();
+}
+
+}
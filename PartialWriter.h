@@ -0,0 +1,87 @@
+/*
+PartialWriter.h
+Streaming packet writer using partial body lengths
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __OPENPGP_PARTIAL_WRITER__
+#define __OPENPGP_PARTIAL_WRITER__
+
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Packets/packets.h"
+
+namespace OpenPGP {
+
+    // Writes the body of one new format packet whose length is not known
+    // in advance. Whatever is written to the PartialWriter is sent to out
+    // in chunks of the given size, each with a Partial Body Length header
+    // (RFC 4880 sec 4.2.2.4), so output starts before the input ends:
+    //
+    //     PartialWriter literal(std::cout, Packet::LITERAL_DATA);
+    //     literal << header << data;
+    //     literal.close();
+    //
+    // close() writes the last chunk with a definite length. A body that
+    // never fills a chunk is written as an ordinary packet.
+    class PartialWriter : public std::ostream {
+        private:
+            class ChunkBuf : public std::streambuf {
+                private:
+                    std::ostream * dst;
+                    uint8_t tag;
+                    uint8_t chunk_length;   // Partial Body Length octet
+                    bool started;           // the tag octet has been written
+                    bool closed;
+                    std::vector <char> buf;
+
+                    // sends the full buffer as a partial chunk
+                    void write_chunk();
+
+                protected:
+                    int_type overflow(int_type c);
+                    std::streamsize xsputn(const char * s, std::streamsize n);
+
+                public:
+                    ChunkBuf(std::ostream & out, const uint8_t tag, const std::size_t chunk);
+                    void close();
+                    bool is_closed() const;
+            };
+
+            ChunkBuf chunks;
+
+        public:
+            PartialWriter(std::ostream & out, const uint8_t tag, const std::size_t chunk = Packet::PARTIAL_CHUNK);
+            PartialWriter(const PartialWriter & copy) = delete;
+            PartialWriter & operator=(const PartialWriter & copy) = delete;
+            ~PartialWriter();
+
+            // writes the rest of the body; nothing may be written afterwards
+            void close();
+    };
+}
+
+#endif
@@ -1,8 +1,13 @@
 #include "BBS.h"
 
+#include <mutex>
+
 namespace OpenPGP {
 namespace RNG {
 
+// the state is shared by every instance, so only one thread may use it at a time
+static std::mutex bbs_mutex;
+
 bool BBS::seeded = false;
 
 MPI BBS::state = 0;
@@ -12,6 +17,7 @@ MPI BBS::m = 0;
 const MPI BBS::two = 2;
 
 void BBS::init(const MPI & seed, const unsigned int & bits, MPI p, MPI q){
+    std::lock_guard <std::mutex> lock(bbs_mutex);
     if (!seeded){
         /*
         p and q should be:
@@ -68,6 +74,7 @@ bool BBS::parity(const std::string & par) const{
 BBS::BBS(...)
     : par()
 {
+    std::lock_guard <std::mutex> lock(bbs_mutex);
     if (!seeded){
         throw std::runtime_error("Error: BBS must be seeded first.");
     }
@@ -81,6 +88,7 @@ BBS::BBS(const MPI & SEED, const unsigned int & bits, MPI p, MPI q)
 
 std::string BBS::rand(const unsigned int & bits, const std::string & par){
     // returns string because SIZE might be larger than 64 bits
+    std::lock_guard <std::mutex> lock(bbs_mutex);
     std::string out(bits, '0');
     for(char & c : out){
         r_number();
@@ -0,0 +1,203 @@
+#include "ChaCha20.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#include <pthread.h>
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+
+namespace OpenPGP {
+namespace RNG {
+
+const std::size_t ChaCha20::KEY_SIZE;
+const std::size_t ChaCha20::BLOCK_SIZE;
+const std::size_t ChaCha20::BLOCKS;
+const std::size_t ChaCha20::RESEED_INTERVAL;
+
+// memset called through a volatile pointer, so it is not optimized away
+static void * (* const volatile wipe_memset)(void *, int, std::size_t) = std::memset;
+
+static void wipe(void * data, const std::size_t len){
+    wipe_memset(data, 0, len);
+}
+
+// bumped in the child after every fork, so generators notice without a system call
+static std::atomic <unsigned long> forks(0);
+
+static void forked(){
+    forks++;
+}
+
+static unsigned long fork_count(){
+    static std::once_flag registered;
+    std::call_once(registered, [](){ pthread_atfork(nullptr, nullptr, forked); });
+    return forks;
+}
+
+static uint32_t rotl(const uint32_t x, const unsigned int n){
+    return (x << n) | (x >> (32 - n));
+}
+
+static void quarter_round(uint32_t & a, uint32_t & b, uint32_t & c, uint32_t & d){
+    a += b; d ^= a; d = rotl(d, 16);
+    c += d; b ^= c; b = rotl(b, 12);
+    a += b; d ^= a; d = rotl(d, 8);
+    c += d; b ^= c; b = rotl(b, 7);
+}
+
+void ChaCha20::block(const uint32_t key[8], const uint32_t counter, const uint32_t nonce[3], uint8_t out[BLOCK_SIZE]){
+    const uint32_t state[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,     // "expand 32-byte k"
+        key[0], key[1], key[2], key[3],
+        key[4], key[5], key[6], key[7],
+        counter, nonce[0], nonce[1], nonce[2],
+    };
+
+    uint32_t x[16];
+    std::copy(state, state + 16, x);
+    for(unsigned int i = 0; i < 10; i++){
+        quarter_round(x[0], x[4], x[ 8], x[12]);
+        quarter_round(x[1], x[5], x[ 9], x[13]);
+        quarter_round(x[2], x[6], x[10], x[14]);
+        quarter_round(x[3], x[7], x[11], x[15]);
+        quarter_round(x[0], x[5], x[10], x[15]);
+        quarter_round(x[1], x[6], x[11], x[12]);
+        quarter_round(x[2], x[7], x[ 8], x[13]);
+        quarter_round(x[3], x[4], x[ 9], x[14]);
+    }
+
+    // little-endian words
+    for(unsigned int i = 0; i < 16; i++){
+        const uint32_t w = x[i] + state[i];
+        out[(i << 2)    ] = w;
+        out[(i << 2) + 1] = w >> 8;
+        out[(i << 2) + 2] = w >> 16;
+        out[(i << 2) + 3] = w >> 24;
+    }
+
+    wipe(x, sizeof(x));
+}
+
+void ChaCha20::system_random(uint8_t * out, std::size_t len){
+    #ifdef __linux__
+    while (len){
+        const ssize_t got = getrandom(out, len, 0);
+        if (got < 0){
+            if (errno == EINTR){
+                continue;
+            }
+            break;                                              // old kernel; use the device instead
+        }
+        out += got;
+        len -= got;
+    }
+    #endif
+
+    if (len){
+        std::ifstream urandom("/dev/urandom", std::ios::binary);
+        if (!urandom.read(reinterpret_cast <char *> (out), len)){
+            throw std::runtime_error("Error: Could not get random data from the operating system.");
+        }
+    }
+}
+
+void ChaCha20::rekey(const uint8_t * seed){
+    for(unsigned int i = 0; i < 8; i++){
+        key[i] ^= static_cast <uint32_t> (seed[(i << 2)    ])        |
+                  (static_cast <uint32_t> (seed[(i << 2) + 1]) << 8)  |
+                  (static_cast <uint32_t> (seed[(i << 2) + 2]) << 16) |
+                  (static_cast <uint32_t> (seed[(i << 2) + 3]) << 24);
+    }
+}
+
+void ChaCha20::refill(){
+    if (reseeding && (generated >= RESEED_INTERVAL)){
+        reseed();
+    }
+
+    const uint32_t nonce[3] = {0, 0, 0};
+    for(uint32_t i = 0; i < BLOCKS; i++){
+        block(key, i, nonce, buf + i * BLOCK_SIZE);
+    }
+
+    // fast key erasure: the start of the batch replaces the key
+    std::fill(key, key + 8, 0);
+    rekey(buf);
+    wipe(buf, KEY_SIZE);
+    used = KEY_SIZE;
+}
+
+ChaCha20::ChaCha20()
+    : key(),
+      buf(),
+      used(sizeof(buf)),
+      generated(0),
+      reseeding(true),
+      forks_seen(fork_count())
+{
+    reseed();
+}
+
+ChaCha20::ChaCha20(const std::string & seed)
+    : key(),
+      buf(),
+      used(sizeof(buf)),
+      generated(0),
+      reseeding(false),
+      forks_seen(fork_count())
+{
+    if (seed.size() != KEY_SIZE){
+        throw std::runtime_error("Error: ChaCha20 seed must be " + std::to_string(KEY_SIZE) + " octets.");
+    }
+
+    rekey(reinterpret_cast <const uint8_t *> (seed.data()));
+}
+
+ChaCha20::~ChaCha20(){
+    wipe(key, sizeof(key));
+    wipe(buf, sizeof(buf));
+}
+
+void ChaCha20::reseed(){
+    uint8_t seed[KEY_SIZE];
+    system_random(seed, KEY_SIZE);
+    rekey(seed);
+    wipe(seed, KEY_SIZE);
+
+    // anything left over was made with the old key
+    wipe(buf, sizeof(buf));
+    used = sizeof(buf);
+    generated = 0;
+    forks_seen = fork_count();
+}
+
+void ChaCha20::generate(uint8_t * out, std::size_t len){
+    // a forked child would otherwise repeat its parent's output
+    if (reseeding && (fork_count() != forks_seen)){
+        reseed();
+    }
+
+    while (len){
+        if (used == sizeof(buf)){
+            refill();
+        }
+
+        const std::size_t n = std::min(len, sizeof(buf) - used);
+        std::memcpy(out, buf + used, n);
+        wipe(buf + used, n);
+        used += n;
+        generated += n;
+        out += n;
+        len -= n;
+    }
+}
+
+}
+}
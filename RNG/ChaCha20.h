@@ -0,0 +1,89 @@
+/*
+ChaCha20.h
+ChaCha20 based deterministic random bit generator, seeded by the operating system
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __CHACHA20__
+#define __CHACHA20__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Generator.h"
+
+namespace OpenPGP {
+    namespace RNG {
+        // Keystream blocks are generated BLOCKS at a time into a pool that
+        // small requests are served from. The first KEY_SIZE octets of
+        // every batch become the next key, and octets are erased from the
+        // pool as they are handed out, so earlier output cannot be
+        // recovered from the state.
+        class ChaCha20 : public Generator{
+            public:
+                static const std::size_t KEY_SIZE = 32;             // octets
+                static const std::size_t BLOCK_SIZE = 64;           // octets
+                static const std::size_t BLOCKS = 64;               // blocks generated at a time
+                static const std::size_t RESEED_INTERVAL = 1 << 20; // octets of output between reseeds
+
+                // ChaCha20 block function from RFC 7539 sec 2.3
+                static void block(const uint32_t key[8], const uint32_t counter, const uint32_t nonce[3], uint8_t out[BLOCK_SIZE]);
+
+                // fill out with len octets from the operating system
+                // throws if none are available
+                static void system_random(uint8_t * out, const std::size_t len);
+
+            private:
+                uint32_t key[8];
+                uint8_t buf[BLOCK_SIZE * BLOCKS];
+                std::size_t used;                                   // octets of buf already handed out
+                std::size_t generated;                              // octets since the last reseed
+                bool reseeding;                                     // false when constructed from a fixed seed
+                unsigned long forks_seen;                           // forks counted when last seeded; a fork reseeds
+
+                void rekey(const uint8_t * seed);                   // xor KEY_SIZE octets into the key
+                void refill();
+
+            public:
+                // seeded from the operating system and reseeded periodically
+                ChaCha20();
+
+                // seeded with KEY_SIZE octets and never reseeded; the output
+                // only depends on the seed
+                ChaCha20(const std::string & seed);
+
+                ChaCha20(const ChaCha20 & copy) = delete;
+                ~ChaCha20();
+
+                // mix fresh operating system randomness into the key
+                void reseed();
+
+                using Generator::generate;
+                void generate(uint8_t * out, std::size_t len);
+
+                ChaCha20 & operator=(const ChaCha20 & copy) = delete;
+        };
+    }
+}
+
+#endif
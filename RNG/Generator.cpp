@@ -0,0 +1,17 @@
+#include "Generator.h"
+
+namespace OpenPGP {
+namespace RNG {
+
+Generator::~Generator(){}
+
+std::string Generator::generate(const std::size_t len){
+    std::string out(len, 0);
+    if (len){
+        generate(reinterpret_cast <uint8_t *> (&out[0]), len);
+    }
+    return out;
+}
+
+}
+}
@@ -0,0 +1,49 @@
+/*
+Generator.h
+Interface of random octet generators
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __GENERATOR__
+#define __GENERATOR__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace OpenPGP {
+    namespace RNG {
+        // A generator is not locked; give each thread its own
+        class Generator{
+            public:
+                typedef std::shared_ptr <Generator> Ptr;
+
+                virtual ~Generator();
+
+                virtual void generate(uint8_t * out, std::size_t len) = 0;
+                std::string generate(const std::size_t len);
+        };
+    }
+}
+
+#endif
@@ -27,5 +27,8 @@ THE SOFTWARE.
 #define __RNG__
 
 #include "BBS.h"
+#include "ChaCha20.h"
+#include "Generator.h"
+#include "Random.h"
 
 #endif
@@ -0,0 +1,65 @@
+#include "Random.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace OpenPGP {
+namespace RNG {
+
+static std::atomic <uint8_t> source(Source::CHACHA20);
+
+// generator of the innermost Scope on this thread
+static thread_local Generator * current = nullptr;
+
+void set_source(const uint8_t src){
+    if ((src != Source::CHACHA20) && (src != Source::BBS)){
+        throw std::runtime_error("Error: Unknown random number source: " + std::to_string(src));
+    }
+
+    source = src;
+}
+
+uint8_t get_source(){
+    return source;
+}
+
+Scope::Scope(Generator * gen)
+    : previous(current)
+{
+    if (gen){
+        current = gen;
+    }
+}
+
+Scope::~Scope(){
+    current = previous;
+}
+
+void fill(uint8_t * out, const std::size_t len){
+    if (current){
+        current -> generate(out, len);
+        return;
+    }
+
+    if (source == Source::BBS){
+        BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
+        const std::string bits = unbinify(BBS().rand(len << 3));
+        std::memcpy(out, bits.data(), len);
+        return;
+    }
+
+    // each thread has its own generator, so no locking is needed
+    static thread_local ChaCha20 drbg;
+    drbg.generate(out, len);
+}
+
+std::string bytes(const std::size_t len){
+    std::string out(len, 0);
+    if (len){
+        fill(reinterpret_cast <uint8_t *> (&out[0]), len);
+    }
+    return out;
+}
+
+}
+}
@@ -0,0 +1,69 @@
+/*
+Random.h
+Random octets for the rest of the library
+
+Copyright (c) 2013 - 2017 Jason Lee @ calccrypto at gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef __RANDOM__
+#define __RANDOM__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "BBS.h"
+#include "ChaCha20.h"
+#include "Generator.h"
+
+namespace OpenPGP {
+    namespace RNG {
+        // where random octets come from
+        namespace Source {
+            const uint8_t CHACHA20 = 0;     // one ChaCha20 generator per thread (default)
+            const uint8_t BBS      = 1;     // Blum Blum Shub; repeatable when seeded with fixed values
+        }
+
+        void set_source(const uint8_t source);
+        uint8_t get_source();
+
+        // While a Scope exists, random octets drawn on the thread that
+        // made it come from its generator instead of the source above.
+        // Scopes nest, and a null generator changes nothing.
+        class Scope{
+            private:
+                Generator * previous;
+
+            public:
+                Scope(Generator * gen);
+                Scope(const Scope & copy) = delete;
+                ~Scope();
+
+                Scope & operator=(const Scope & copy) = delete;
+        };
+
+        // len random octets
+        void fill(uint8_t * out, const std::size_t len);
+        std::string bytes(const std::size_t len);
+    }
+}
+
+#endif
@@ -1 +1,4 @@
-RNG_OBJECTS=BBS.o
+RNG_OBJECTS=BBS.o       \
+            ChaCha20.o  \
+            Generator.o \
+            Random.o
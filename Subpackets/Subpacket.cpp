@@ -4,16 +4,33 @@ namespace OpenPGP {
 namespace Subpacket {
 
 std::string Sub::write_SUBPACKET(const std::string & data) const{
-    if (data.size() < 192){
-        return std::string(1, data.size()) + data;
+    ByteWriter out(length_size(data.size()) + data.size());
+    write_length(data.size(), out);
+    out.put(data);
+    return out.release();
+}
+
+std::size_t Sub::length_size(const std::size_t length){
+    if (length < 192){
+        return 1;
+    }
+    else if (length < 8384){
+        return 2;
+    }
+    return 5;
+}
+
+void Sub::write_length(const std::size_t length, ByteWriter & out){
+    if (length < 192){
+        out.put8(length);
     }
-    else if ((192 <= data.size()) && (data.size() < 8383)){
-        return unhexlify(makehex(((((data.size() >> 8) + 192) << 8) + (data.size() & 0xff) - 192), 4)) + data;
+    else if (length < 8384){
+        out.put16((((length >> 8) + 192) << 8) + (length & 0xff) - 192);
     }
     else{
-        return "\xff" + unhexlify(makehex(data.size(), 8)) + data;
+        out.put8(0xff);
+        out.put32(length);
     }
-    return ""; // should never reach here; mainly just to remove compiler warnings
 }
 
 std::string Sub::show_title() const{
@@ -44,8 +61,27 @@ Sub & Sub::operator=(const Sub & copy){
 
 Sub::~Sub(){}
 
+std::string Sub::raw() const{
+    ByteWriter out(serialized_size());
+    write_raw(out);
+    return out.release();
+}
+
 std::string Sub::write() const{
-    return write_SUBPACKET(std::string(1, type | (critical?0x80:0x00)) + raw());
+    ByteWriter out(write_size());
+    write(out);
+    return out.release();
+}
+
+void Sub::write(ByteWriter & out) const{
+    write_length(serialized_size() + 1, out);
+    out.put8(type | (critical?0x80:0x00));
+    write_raw(out);
+}
+
+std::size_t Sub::write_size() const{
+    const std::size_t length = serialized_size() + 1;
+    return length_size(length) + length;
 }
 
 uint8_t Sub::get_type() const{
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <stdexcept>
 #include <string>
 
+#include "../common/ByteWriter.h"
 #include "../common/includes.h"
 
 namespace OpenPGP {
@@ -99,6 +100,10 @@ namespace OpenPGP {
 
                 std::string write_SUBPACKET(const std::string & data) const;
 
+                // subpacket length header for a subpacket (type octet + data) of the given length
+                static std::size_t length_size(const std::size_t length);
+                static void write_length(const std::size_t length, ByteWriter & out);
+
                 // returns first line of show functions (no tab or newline)
                 virtual std::string show_title() const;
 
@@ -112,8 +117,12 @@ namespace OpenPGP {
                 virtual ~Sub();
                 virtual void read(const std::string & data) = 0;
                 virtual std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const = 0;
-                virtual std::string raw()   const = 0; // returns raw subpacket data, with no header
+                virtual std::size_t serialized_size() const = 0; // number of octets raw() will produce, computed without serializing
+                virtual void write_raw(ByteWriter & out) const = 0; // appends the subpacket data to out
+                std::string raw()           const; // returns raw subpacket data, with no header
                 std::string write()         const;
+                void write(ByteWriter & out) const;
+                std::size_t write_size()    const; // number of octets write() will produce
 
                 bool get_critical()         const;
                 uint8_t get_type()          const;
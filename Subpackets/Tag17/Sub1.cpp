@@ -50,8 +50,17 @@ std::string Sub1::show(const std::size_t indents, const std::size_t indent_size)
     return out + " '" + filename + "'.";
 }
 
-std::string Sub1::raw() const{
-    return "\x10" + zero + "\x01\x01" + std::string(12, 0) + image;
+void Sub1::write_raw(ByteWriter & out) const{
+    out.put8(0x10);
+    out.put(zero);
+    out.put8(0x01);
+    out.put8(0x01);
+    out.put(std::string(12, 0));
+    out.put(image);
+}
+
+std::size_t Sub1::serialized_size() const{
+    return 16 + image.size();
 }
 
 uint8_t Sub1::get_encoding() const{
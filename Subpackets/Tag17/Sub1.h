@@ -99,7 +99,8 @@ namespace OpenPGP {
                     Sub1(const std::string & data);
                     void read(const std::string & data);
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                    std::string raw() const;
+                    void write_raw(ByteWriter & out) const;
+                    std::size_t serialized_size() const;
 
                     uint8_t get_encoding() const;
                     std::string get_image() const;
@@ -27,8 +27,12 @@ std::string Sub10::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + stuff;
 }
 
-std::string Sub10::raw() const{
-    return stuff;
+void Sub10::write_raw(ByteWriter & out) const{
+    out.put(stuff);
+}
+
+std::size_t Sub10::serialized_size() const{
+    return stuff.size();
 }
 
 std::string Sub10::get_stuff() const{
@@ -33,8 +33,12 @@ std::string Sub11::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub11::raw() const{
-    return psa;
+void Sub11::write_raw(ByteWriter & out) const{
+    out.put(psa);
+}
+
+std::size_t Sub11::serialized_size() const{
+    return psa.size();
 }
 
 std::string Sub11::get_psa() const{
@@ -54,7 +54,8 @@ namespace OpenPGP {
                     Sub11(const std::string & data);
                     void read(const std::string & data);
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                    std::string raw() const;
+                    void write_raw(ByteWriter & out) const;
+                    std::size_t serialized_size() const;
 
                     std::string get_psa() const;  // string containing Symmetric Key Algorithm values (ex: "\x07\x08\x09")
 
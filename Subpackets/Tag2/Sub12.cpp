@@ -36,8 +36,14 @@ std::string Sub12::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Fingerprint: " + fingerprint;
 }
 
-std::string Sub12::raw() const{
-    return std::string(1, _class) + std::string(1, pka) + fingerprint;
+void Sub12::write_raw(ByteWriter & out) const{
+    out.put8(_class);
+    out.put8(pka);
+    out.put(fingerprint);
+}
+
+std::size_t Sub12::serialized_size() const{
+    return 2 + fingerprint.size();
 }
 
 uint8_t Sub12::get_class() const{
@@ -26,8 +26,12 @@ std::string Sub16::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Key ID: " + hexlify(keyid);
 }
 
-std::string Sub16::raw() const{
-    return keyid;
+void Sub16::write_raw(ByteWriter & out) const{
+    out.put(keyid);
+}
+
+std::size_t Sub16::serialized_size() const{
+    return keyid.size();
 }
 
 std::string Sub16::get_keyid() const{
@@ -26,8 +26,12 @@ std::string Sub2::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Creation Time: " + show_time(time);
 }
 
-std::string Sub2::raw() const{
-    return unhexlify(makehex(static_cast <uint32_t> (time), 8));
+void Sub2::write_raw(ByteWriter & out) const{
+    out.put32(time);
+}
+
+std::size_t Sub2::serialized_size() const{
+    return 4;
 }
 
 uint32_t Sub2::get_time() const{
@@ -43,8 +43,16 @@ std::string Sub20::show(const std::size_t indents, const std::size_t indent_size
                  indent + tab + "Value: " + n;
 }
 
-std::string Sub20::raw() const{
-    return flags + unhexlify(makehex(m.size(), 4)) + unhexlify(makehex(n.size(), 4)) + m + n;
+void Sub20::write_raw(ByteWriter & out) const{
+    out.put(flags);
+    out.put16(m.size());
+    out.put16(n.size());
+    out.put(m);
+    out.put(n);
+}
+
+std::size_t Sub20::serialized_size() const{
+    return flags.size() + 2 + 2 + m.size() + n.size();
 }
 
 std::string Sub20::get_flags() const{
@@ -33,8 +33,12 @@ std::string Sub21::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub21::raw() const{
-    return pha;
+void Sub21::write_raw(ByteWriter & out) const{
+    out.put(pha);
+}
+
+std::size_t Sub21::serialized_size() const{
+    return pha.size();
 }
 
 std::string Sub21::get_pha() const{
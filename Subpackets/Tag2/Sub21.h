@@ -52,7 +52,8 @@ namespace OpenPGP {
                     Sub21(const std::string & data);
                     void read(const std::string & data);
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                    std::string raw() const;
+                    void write_raw(ByteWriter & out) const;
+                    std::size_t serialized_size() const;
 
                     std::string get_pha() const;  // returns string of preferred hash algorithms (ex: "\x01\x02\x03")
 
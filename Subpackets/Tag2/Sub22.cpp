@@ -33,8 +33,12 @@ std::string Sub22::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub22::raw() const{
-    return pca;
+void Sub22::write_raw(ByteWriter & out) const{
+    out.put(pca);
+}
+
+std::size_t Sub22::serialized_size() const{
+    return pca.size();
 }
 
 std::string Sub22::get_pca() const{
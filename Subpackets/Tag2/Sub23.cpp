@@ -37,8 +37,12 @@ std::string Sub23::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub23::raw() const{
-    return flags;
+void Sub23::write_raw(ByteWriter & out) const{
+    out.put(flags);
+}
+
+std::size_t Sub23::serialized_size() const{
+    return flags.size();
 }
 
 std::string Sub23::get_flags() const{
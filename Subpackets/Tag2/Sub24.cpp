@@ -27,8 +27,12 @@ std::string Sub24::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "URI - " + pks;
 }
 
-std::string Sub24::raw() const{
-    return pks;
+void Sub24::write_raw(ByteWriter & out) const{
+    out.put(pks);
+}
+
+std::size_t Sub24::serialized_size() const{
+    return pks.size();
 }
 
 std::string Sub24::get_pks() const{
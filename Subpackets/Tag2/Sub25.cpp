@@ -28,8 +28,12 @@ std::string Sub25::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Primary: " + + (primary?"True":"False");
 }
 
-std::string Sub25::raw() const{
-    return (primary?"\x01":zero);
+void Sub25::write_raw(ByteWriter & out) const{
+    out.put8(primary?1:0);
+}
+
+std::size_t Sub25::serialized_size() const{
+    return 1;
 }
 
 bool Sub25::get_primary() const{
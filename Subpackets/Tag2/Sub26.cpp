@@ -27,8 +27,12 @@ std::string Sub26::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Policy - " + uri;
 }
 
-std::string Sub26::raw() const{
-    return uri;
+void Sub26::write_raw(ByteWriter & out) const{
+    out.put(uri);
+}
+
+std::size_t Sub26::serialized_size() const{
+    return uri.size();
 }
 
 std::string Sub26::get_uri() const{
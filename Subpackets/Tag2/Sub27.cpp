@@ -37,8 +37,12 @@ std::string Sub27::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub27::raw() const{
-    return flags;
+void Sub27::write_raw(ByteWriter & out) const{
+    out.put(flags);
+}
+
+std::size_t Sub27::serialized_size() const{
+    return flags.size();
 }
 
 std::string Sub27::get_flags() const{
@@ -27,8 +27,12 @@ std::string Sub28::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "ID: " + signer;
 }
 
-std::string Sub28::raw() const{
-    return signer;
+void Sub28::write_raw(ByteWriter & out) const{
+    out.put(signer);
+}
+
+std::size_t Sub28::serialized_size() const{
+    return signer.size();
 }
 
 std::string Sub28::get_signer() const{
@@ -44,8 +44,13 @@ std::string Sub29::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub29::raw() const{
-    return std::string(1, code) + reason;
+void Sub29::write_raw(ByteWriter & out) const{
+    out.put8(code);
+    out.put(reason);
+}
+
+std::size_t Sub29::serialized_size() const{
+    return 1 + reason.size();
 }
 
 uint8_t Sub29::get_code() const{
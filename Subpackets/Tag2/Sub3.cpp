@@ -26,8 +26,12 @@ std::string Sub3::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Signature Expiration Time (Days): " + (dt?show_time(dt):"Never");
 }
 
-std::string Sub3::raw() const{
-    return unhexlify(makehex(dt, 8));
+void Sub3::write_raw(ByteWriter & out) const{
+    out.put32(dt);
+}
+
+std::size_t Sub3::serialized_size() const{
+    return 4;
 }
 
 uint32_t Sub3::get_dt() const{
@@ -37,8 +37,12 @@ std::string Sub30::show(const std::size_t indents, const std::size_t indent_size
     return out;
 }
 
-std::string Sub30::raw() const{
-    return flags;
+void Sub30::write_raw(ByteWriter & out) const{
+    out.put(flags);
+}
+
+std::size_t Sub30::serialized_size() const{
+    return flags.size();
 }
 
 std::string Sub30::get_flags() const{
@@ -36,8 +36,14 @@ std::string Sub31::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Hash: " + hexlify(hash);
 }
 
-std::string Sub31::raw() const{
-    return std::string(1, pka) + std::string(1, hash_alg) + hash;
+void Sub31::write_raw(ByteWriter & out) const{
+    out.put8(pka);
+    out.put8(hash_alg);
+    out.put(hash);
+}
+
+std::size_t Sub31::serialized_size() const{
+    return 2 + hash.size();
 }
 
 uint8_t Sub31::get_pka() const{
@@ -61,7 +61,8 @@ namespace OpenPGP {
                     Sub31(const std::string & data);
                     void read(const std::string & data);
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                    std::string raw() const;
+                    void write_raw(ByteWriter & out) const;
+                    std::size_t serialized_size() const;
 
                     uint8_t get_pka() const;
                     uint8_t get_hash_alg() const;
@@ -34,8 +34,12 @@ std::string Sub32::show(const std::size_t indents, const std::size_t indent_size
            embedded -> show(indents + 1, indent_size);
 }
 
-std::string Sub32::raw() const{
-    return embedded -> raw();
+void Sub32::write_raw(ByteWriter & out) const{
+    embedded -> write_raw(out);
+}
+
+std::size_t Sub32::serialized_size() const{
+    return embedded -> serialized_size();
 }
 
 Packet::Tag2::Tag::Ptr Sub32::get_embedded() const{
@@ -51,7 +55,7 @@ Sub::Ptr Sub32::clone() const{
 }
 
 Sub32 & Sub32::operator=(const Sub32 & copy){
-    operator=(copy);
+    Sub::operator=(copy);
     embedded = std::static_pointer_cast <Packet::Tag2> (copy.embedded -> clone());
     return *this;
 }
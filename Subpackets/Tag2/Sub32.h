@@ -53,7 +53,8 @@ namespace OpenPGP {
                     ~Sub32();
                     void read(const std::string & data);
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                    std::string raw() const;
+                    void write_raw(ByteWriter & out) const;
+                    std::size_t serialized_size() const;
 
                     Packet::Tag2::Tag::Ptr get_embedded() const;
 
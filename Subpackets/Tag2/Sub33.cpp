@@ -33,8 +33,13 @@ std::string Sub33::show(const std::size_t indents, const std::size_t indent_size
            indent + tab + "Fingerprint: " + hexlify(issuer_fingerprint) + " (" + std::to_string(issuer_fingerprint.size()) + " octets)";
 }
 
-std::string Sub33::raw() const{
-    return std::string(1, version) + issuer_fingerprint;
+void Sub33::write_raw(ByteWriter & out) const{
+    out.put8(version);
+    out.put(issuer_fingerprint);
+}
+
+std::size_t Sub33::serialized_size() const{
+    return 1 + issuer_fingerprint.size();
 }
 
 uint8_t Sub33::get_version() const{
@@ -28,8 +28,12 @@ std::string Sub4::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Exportable: " + (exportable?"True":"False");
 }
 
-std::string Sub4::raw() const{
-    return (exportable?"\x01":zero);
+void Sub4::write_raw(ByteWriter & out) const{
+    out.put8(exportable?1:0);
+}
+
+std::size_t Sub4::serialized_size() const{
+    return 1;
 }
 
 bool Sub4::get_exportable() const{
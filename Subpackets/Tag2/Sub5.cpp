@@ -31,8 +31,13 @@ std::string Sub5::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Trust Amount: " + std::to_string(amount);
 }
 
-std::string Sub5::raw() const{
-    return std::string(1, level) + std::string(1, amount);
+void Sub5::write_raw(ByteWriter & out) const{
+    out.put8(level);
+    out.put8(amount);
+}
+
+std::size_t Sub5::serialized_size() const{
+    return 2;
 }
 
 uint8_t Sub5::get_level() const{
@@ -27,8 +27,13 @@ std::string Sub6::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Regular Expression: " + regex;
 }
 
-std::string Sub6::raw() const{
-    return regex + zero; // might not need '+ zero'
+void Sub6::write_raw(ByteWriter & out) const{
+    out.put(regex);
+    out.put(zero); // might not need the zero
+}
+
+std::size_t Sub6::serialized_size() const{
+    return regex.size() + 1;
 }
 
 std::string Sub6::get_regex() const{
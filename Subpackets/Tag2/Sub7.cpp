@@ -28,8 +28,12 @@ std::string Sub7::show(const std::size_t indents, const std::size_t indent_size)
            indent + tab + "Revocable: " + (revocable?"True":"False");
 }
 
-std::string Sub7::raw() const{
-    return (revocable?"\x01":zero);
+void Sub7::write_raw(ByteWriter & out) const{
+    out.put8(revocable?1:0);
+}
+
+std::size_t Sub7::serialized_size() const{
+    return 1;
 }
 
 bool Sub7::get_revocable() const{
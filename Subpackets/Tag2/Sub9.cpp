@@ -52,8 +52,12 @@ std::string Sub9::show(const std::size_t indents, const std::size_t indent_size)
     return out;
 }
 
-std::string Sub9::raw() const{
-    return unhexlify(makehex(dt, 8));
+void Sub9::write_raw(ByteWriter & out) const{
+    out.put32(dt);
+}
+
+std::size_t Sub9::serialized_size() const{
+    return 4;
 }
 
 uint32_t Sub9::get_dt() const{
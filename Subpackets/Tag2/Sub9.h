@@ -53,7 +53,8 @@ namespace OpenPGP {
                     void read(const std::string & data);
                     std::string show(const uint32_t create_time, const std::size_t indents = 0, const std::size_t indent_size = 4) const;
                     std::string show(const std::size_t indents = 0, const std::size_t indent_size = 4) const;
-                    std::string raw() const;
+                    void write_raw(ByteWriter & out) const;
+                    std::size_t serialized_size() const;
 
                     uint32_t get_dt() const;
 
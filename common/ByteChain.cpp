@@ -0,0 +1,132 @@
+#include "ByteChain.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+ByteChain::ByteChain()
+    : pieces(),
+      len(0)
+{}
+
+ByteChain::ByteChain(const ByteSlice & data)
+    : ByteChain()
+{
+    append(data);
+}
+
+ByteChain::ByteChain(const std::string & data)
+    : ByteChain(ByteSlice(data))
+{}
+
+void ByteChain::append(const ByteSlice & data){
+    if (!data.empty()){
+        pieces.push_back(data);
+        len += data.size();
+    }
+}
+
+void ByteChain::append(const ByteChain & data){
+    for(ByteSlice const & piece : data.pieces){
+        append(piece);
+    }
+}
+
+std::size_t ByteChain::size() const{
+    return len;
+}
+
+bool ByteChain::empty() const{
+    return !len;
+}
+
+const std::vector <ByteSlice> & ByteChain::get_pieces() const{
+    return pieces;
+}
+
+ByteChain ByteChain::substr(std::size_t pos, std::size_t n) const{
+    if (pos > len){
+        throw std::out_of_range("Error: ByteChain position out of range.");
+    }
+
+    if (n > (len - pos)){
+        n = len - pos;
+    }
+
+    ByteChain out;
+    for(ByteSlice const & piece : pieces){
+        if (!n){
+            break;
+        }
+
+        if (pos >= piece.size()){
+            pos -= piece.size();
+            continue;
+        }
+
+        const ByteSlice part = piece.substr(pos, n);
+        out.append(part);
+        n -= part.size();
+        pos = 0;
+    }
+
+    return out;
+}
+
+const ByteSlice & ByteChain::flatten() const{
+    if (pieces.size() > 1){
+        std::string joined;
+        joined.reserve(len);
+        for(ByteSlice const & piece : pieces){
+            joined.append(piece.data(), piece.size());
+        }
+
+        pieces.assign(1, ByteSlice(std::move(joined)));
+    }
+    else if (pieces.empty()){
+        static const ByteSlice EMPTY;
+        return EMPTY;
+    }
+
+    return pieces.front();
+}
+
+std::string ByteChain::str() const{
+    std::string out;
+    out.reserve(len);
+    for(ByteSlice const & piece : pieces){
+        out.append(piece.data(), piece.size());
+    }
+    return out;
+}
+
+bool ByteChain::operator==(const ByteChain & rhs) const{
+    if (len != rhs.len){
+        return false;
+    }
+
+    // compare the pieces pairwise without joining either chain
+    std::size_t i = 0, j = 0, a = 0, b = 0;
+    while ((i < pieces.size()) && (j < rhs.pieces.size())){
+        const std::size_t n = std::min(pieces[i].size() - a, rhs.pieces[j].size() - b);
+        if (pieces[i].substr(a, n) != rhs.pieces[j].substr(b, n)){
+            return false;
+        }
+
+        a += n;
+        b += n;
+        if (a == pieces[i].size()){
+            i++;
+            a = 0;
+        }
+        if (b == rhs.pieces[j].size()){
+            j++;
+            b = 0;
+        }
+    }
+
+    return true;
+}
+
+bool ByteChain::operator!=(const ByteChain & rhs) const{
+    return !(*this == rhs);
+}
@@ -0,0 +1,51 @@
+/*
+Sequence of ByteSlices read as one octet string.
+
+Packets that were sent with partial body lengths arrive as
+several chunks. Chaining the chunks lets a packet hold its
+body without joining it; the chunks are only copied into
+one buffer when something asks for contiguous data, and
+that buffer is kept for later requests.
+*/
+
+#ifndef __BYTE_CHAIN__
+#define __BYTE_CHAIN__
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ByteSlice.h"
+
+class ByteChain{
+    private:
+        mutable std::vector <ByteSlice> pieces;    // joined in place by flatten()
+        std::size_t len;
+
+    public:
+        ByteChain();
+        ByteChain(const ByteSlice & data);
+        ByteChain(const std::string & data);
+
+        // add data to the end of the chain; no data is copied
+        void append(const ByteSlice & data);
+        void append(const ByteChain & data);
+
+        std::size_t size() const;
+        bool empty() const;
+        const std::vector <ByteSlice> & get_pieces() const;
+
+        // part of the chain; no data is copied
+        ByteChain substr(std::size_t pos, std::size_t n = std::string::npos) const;
+
+        // contiguous view of the whole chain; joins the pieces on first use only
+        const ByteSlice & flatten() const;
+
+        // copy the data out
+        std::string str() const;
+
+        bool operator==(const ByteChain & rhs) const;
+        bool operator!=(const ByteChain & rhs) const;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "ByteSlice.h"
+
+#include <cstring>
+#include <stdexcept>
+
+ByteSlice::ByteSlice()
+    : base(),
+      len(0)
+{}
+
+ByteSlice::ByteSlice(const std::string & data)
+    : ByteSlice(std::string(data))
+{}
+
+ByteSlice::ByteSlice(std::string && data)
+    : base(),
+      len(data.size())
+{
+    const std::shared_ptr <const std::string> buffer = std::make_shared <const std::string> (std::move(data));
+    base = std::shared_ptr <const char> (buffer, buffer -> data());
+}
+
+ByteSlice::ByteSlice(const std::shared_ptr <const char> & data, const std::size_t length)
+    : base(data),
+      len(length)
+{}
+
+ByteSlice ByteSlice::view(const char * data, const std::size_t length){
+    return ByteSlice(std::shared_ptr <const char> (std::shared_ptr <const char> (), data), length);
+}
+
+const char * ByteSlice::data() const{
+    return base.get();
+}
+
+std::size_t ByteSlice::size() const{
+    return len;
+}
+
+bool ByteSlice::empty() const{
+    return !len;
+}
+
+char ByteSlice::operator[](const std::size_t i) const{
+    return base.get()[i];
+}
+
+ByteSlice ByteSlice::substr(const std::size_t pos, std::size_t n) const{
+    if (pos > len){
+        throw std::out_of_range("Error: ByteSlice position out of range.");
+    }
+
+    if (n > (len - pos)){
+        n = len - pos;
+    }
+
+    return ByteSlice(std::shared_ptr <const char> (base, base.get() + pos), n);
+}
+
+std::string ByteSlice::str() const{
+    if (!len){
+        return std::string();
+    }
+    return std::string(base.get(), len);
+}
+
+bool ByteSlice::operator==(const ByteSlice & rhs) const{
+    return (len == rhs.len) && (!len || (base == rhs.base) || !std::memcmp(base.get(), rhs.base.get(), len));
+}
+
+bool ByteSlice::operator!=(const ByteSlice & rhs) const{
+    return !(*this == rhs);
+}
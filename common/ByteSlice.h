@@ -0,0 +1,49 @@
+/*
+Immutable view into a reference counted octet buffer.
+
+Copying or taking a substring of a ByteSlice only copies
+a pointer and a length. The backing buffer stays alive
+for as long as any slice into it exists, so packets can
+keep pieces of the data they were parsed from instead of
+copying them out.
+*/
+
+#ifndef __BYTE_SLICE__
+#define __BYTE_SLICE__
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+class ByteSlice{
+    private:
+        std::shared_ptr <const char> base;  // points at the first octet of the slice, but owns the whole buffer
+        std::size_t len;
+
+    public:
+        ByteSlice();
+        ByteSlice(const std::string & data);   // copies data into a new buffer
+        ByteSlice(std::string && data);        // takes over data without copying
+        ByteSlice(const std::shared_ptr <const char> & data, const std::size_t length);
+
+        // slice of memory owned by someone else; it must not outlive data
+        static ByteSlice view(const char * data, const std::size_t length);
+
+        const char * data() const;
+        std::size_t size() const;
+        bool empty() const;
+
+        // unchecked access
+        char operator[](const std::size_t i) const;
+
+        // view of part of this slice; no data is copied
+        ByteSlice substr(const std::size_t pos, std::size_t n = std::string::npos) const;
+
+        // copy the data out
+        std::string str() const;
+
+        bool operator==(const ByteSlice & rhs) const;
+        bool operator!=(const ByteSlice & rhs) const;
+};
+
+#endif
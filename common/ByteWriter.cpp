@@ -0,0 +1,83 @@
+#include "ByteWriter.h"
+
+ByteWriter::ByteWriter(const std::size_t expected)
+    : out()
+{
+    out.reserve(expected);
+}
+
+void ByteWriter::reserve(const std::size_t n){
+    out.reserve(n);
+}
+
+ByteWriter & ByteWriter::put8(const uint8_t value){
+    out.push_back(static_cast <char> (value));
+    return *this;
+}
+
+ByteWriter & ByteWriter::put16(const uint16_t value){
+    const char buf[2] = {static_cast <char> (value >> 8),
+                         static_cast <char> (value)};
+    out.append(buf, 2);
+    return *this;
+}
+
+ByteWriter & ByteWriter::put32(const uint32_t value){
+    const char buf[4] = {static_cast <char> (value >> 24),
+                         static_cast <char> (value >> 16),
+                         static_cast <char> (value >> 8),
+                         static_cast <char> (value)};
+    out.append(buf, 4);
+    return *this;
+}
+
+void ByteWriter::patch16(const std::size_t pos, const uint16_t value){
+    out[pos]     = static_cast <char> (value >> 8);
+    out[pos + 1] = static_cast <char> (value);
+}
+
+char * ByteWriter::at(const std::size_t pos){
+    return &out[pos];
+}
+
+ByteWriter & ByteWriter::put(const char * data, const std::size_t len){
+    out.append(data, len);
+    return *this;
+}
+
+ByteWriter & ByteWriter::put(const std::string & data){
+    out.append(data);
+    return *this;
+}
+
+ByteWriter & ByteWriter::put(const ByteSlice & data){
+    out.append(data.data(), data.size());
+    return *this;
+}
+
+ByteWriter & ByteWriter::put(const ByteChain & data){
+    for(ByteSlice const & piece : data.get_pieces()){
+        put(piece);
+    }
+    return *this;
+}
+
+char * ByteWriter::grow(const std::size_t n){
+    const std::size_t pos = out.size();
+    out.resize(pos + n);
+    return &out[pos];
+}
+
+std::size_t ByteWriter::size() const{
+    return out.size();
+}
+
+const std::string & ByteWriter::str() const{
+    return out;
+}
+
+std::string ByteWriter::release(){
+    std::string tmp;
+    tmp.swap(out);
+    return tmp;
+}
@@ -0,0 +1,58 @@
+/*
+Append-only octet buffer used to serialize packets.
+
+The expected final size is given up front so that the
+output is allocated once, and multi-octet integers are
+written in big-endian (network) order, as used by RFC 4880.
+*/
+
+#ifndef __BYTE_WRITER__
+#define __BYTE_WRITER__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ByteChain.h"
+#include "ByteSlice.h"
+
+class ByteWriter{
+    private:
+        std::string out;
+
+    public:
+        ByteWriter(const std::size_t expected = 0);
+
+        // make sure at least n octets can be held without reallocating
+        void reserve(const std::size_t n);
+
+        // big-endian integers
+        ByteWriter & put8 (const uint8_t  value);
+        ByteWriter & put16(const uint16_t value);
+        ByteWriter & put32(const uint32_t value);
+
+        // overwrite 2 octets that were already written (for lengths that are only known afterwards)
+        void patch16(const std::size_t pos, const uint16_t value);
+
+        // octets that were already written, starting at pos, so they can be
+        // rearranged in place; the pointer is only valid until the next write
+        char * at(const std::size_t pos);
+
+        // raw octets
+        ByteWriter & put(const char * data, const std::size_t len);
+        ByteWriter & put(const std::string & data);
+        ByteWriter & put(const ByteSlice & data);
+        ByteWriter & put(const ByteChain & data);
+
+        // append n zero octets and return where they start, so they can be
+        // filled in place; the pointer is only valid until the next write
+        char * grow(const std::size_t n);
+
+        std::size_t size() const;
+        const std::string & str() const;
+
+        // move the serialized data out of the writer
+        std::string release();
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// read everything from a descriptor that cannot be mapped
+static bool read_all(const int fd, std::string & out){
+    char buf[65536];
+    while (true){
+        const ssize_t got = ::read(fd, buf, sizeof(buf));
+        if (got < 0){
+            if (errno == EINTR){
+                continue;
+            }
+            return false;
+        }
+
+        if (!got){
+            return true;
+        }
+
+        out.append(buf, got);
+    }
+}
+
+MappedFile::MappedFile(const std::string & filename, const Access access, const bool keep_cached)
+    : contents(),
+      opened(false)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0){
+        return;
+    }
+
+    struct stat st;
+    if ((fstat(fd, &st) < 0) || !S_ISREG(st.st_mode) || !st.st_size){
+        std::string data;
+        opened = read_all(fd, data);
+        contents = ByteSlice(std::move(data));
+        ::close(fd);
+        return;
+    }
+
+    const std::size_t length = st.st_size;
+    void * map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED){
+        std::string data;
+        opened = read_all(fd, data);
+        contents = ByteSlice(std::move(data));
+        ::close(fd);
+        return;
+    }
+
+    switch (access){
+        case SEQUENTIAL:
+            madvise(map, length, MADV_SEQUENTIAL);
+            break;
+        case RANDOM:
+            madvise(map, length, MADV_RANDOM);
+            break;
+        default:
+            break;
+    }
+
+    // the descriptor is only needed to drop the file from the page cache
+    int cache_fd = -1;
+    if (keep_cached){
+        ::close(fd);
+    }
+    else{
+        cache_fd = fd;
+    }
+
+    contents = ByteSlice(std::shared_ptr <const char> (static_cast <const char *> (map),
+                                                       [length, cache_fd](const char * p){
+                                                           if (cache_fd >= 0){
+                                                               madvise(const_cast <char *> (p), length, MADV_DONTNEED);
+                                                               posix_fadvise(cache_fd, 0, 0, POSIX_FADV_DONTNEED);
+                                                               ::close(cache_fd);
+                                                           }
+                                                           munmap(const_cast <char *> (p), length);
+                                                       }),
+                         length);
+    opened = true;
+}
+
+bool MappedFile::is_open() const{
+    return opened;
+}
+
+MappedFile::operator bool() const{
+    return opened;
+}
+
+const ByteSlice & MappedFile::data() const{
+    return contents;
+}
+
+std::size_t MappedFile::size() const{
+    return contents.size();
+}
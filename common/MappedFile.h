@@ -0,0 +1,46 @@
+/*
+Read-only memory mapping of a file.
+
+The contents are available as a ByteSlice backed by the
+mapping itself, so large inputs can be hashed, signed or
+encrypted without first being read into a string. The
+mapping stays valid for as long as any slice into it
+exists, even after the MappedFile is gone.
+
+Inputs that cannot be mapped (pipes, terminals, empty
+files) are read into memory instead.
+*/
+
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <string>
+
+#include "ByteSlice.h"
+
+class MappedFile{
+    public:
+        // expected access pattern, passed on to madvise
+        enum Access{
+            NORMAL,
+            SEQUENTIAL,     // read ahead aggressively and drop pages behind the reader
+            RANDOM,
+        };
+
+    private:
+        ByteSlice contents;
+        bool opened;
+
+    public:
+        // keep_cached = false asks the kernel to drop the file from the
+        // page cache once the last slice into the mapping is released
+        MappedFile(const std::string & filename, const Access access = SEQUENTIAL, const bool keep_cached = true);
+
+        bool is_open() const;
+        explicit operator bool() const;
+
+        const ByteSlice & data() const;
+        std::size_t size() const;
+};
+
+#endif
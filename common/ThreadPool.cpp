@@ -0,0 +1,75 @@
+#include "ThreadPool.h"
+
+void ThreadPool::work(){
+    std::unique_lock <std::mutex> lock(mutex);
+    while (true){
+        job_ready.wait(lock, [this](){ return stopping || !jobs.empty(); });
+        if (jobs.empty()){
+            return;
+        }
+
+        std::function <void()> job = std::move(jobs.front());
+        jobs.pop_front();
+        running++;
+
+        lock.unlock();
+        job();
+        lock.lock();
+
+        running--;
+        if (jobs.empty() && !running){
+            idle.notify_all();
+        }
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : workers(),
+      jobs(),
+      mutex(),
+      job_ready(),
+      idle(),
+      running(0),
+      stopping(false)
+{
+    if (!threads){
+        threads = std::thread::hardware_concurrency();
+    }
+
+    if (!threads){
+        threads = 1;
+    }
+
+    for(std::size_t i = 0; i < threads; i++){
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        stopping = true;
+    }
+    job_ready.notify_all();
+
+    for(std::thread & worker : workers){
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const{
+    return workers.size();
+}
+
+void ThreadPool::submit(std::function <void()> job){
+    {
+        std::lock_guard <std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    job_ready.notify_one();
+}
+
+void ThreadPool::wait(){
+    std::unique_lock <std::mutex> lock(mutex);
+    idle.wait(lock, [this](){ return jobs.empty() && !running; });
+}
@@ -0,0 +1,48 @@
+/*
+Fixed set of worker threads running queued jobs.
+
+Jobs are run in the order they were submitted, by whichever
+worker is free. Jobs must not throw; wrap anything that can
+throw and record the failure instead.
+*/
+
+#ifndef __THREAD_POOL__
+#define __THREAD_POOL__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool{
+    private:
+        std::vector <std::thread> workers;
+        std::deque <std::function <void()> > jobs;
+        std::mutex mutex;
+        std::condition_variable job_ready;
+        std::condition_variable idle;
+        std::size_t running;
+        bool stopping;
+
+        void work();
+
+    public:
+        // 0 uses one thread per hardware thread
+        explicit ThreadPool(std::size_t threads = 0);
+        ThreadPool(const ThreadPool & copy) = delete;
+        ~ThreadPool();                                  // finishes the queued jobs first
+
+        std::size_t size() const;
+
+        void submit(std::function <void()> job);
+
+        // block until every submitted job has finished
+        void wait();
+
+        ThreadPool & operator=(const ThreadPool & copy) = delete;
+};
+
+#endif
@@ -1 +1 @@
-COMMON_OBJECTS=includes.o
\ No newline at end of file
+COMMON_OBJECTS=ByteChain.o ByteSlice.o ByteWriter.o MappedFile.o ThreadPool.o includes.o
@@ -125,18 +125,37 @@ Message pka(const SecretKey & pri,
     std::string symkey;
     if ((tag1 -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
         (tag1 -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)){
-        symkey = mpitoraw(PKA::RSA::decrypt(tag1 -> get_mpi()[0], sec -> decrypt_secret_keys(passphrase), sec -> get_mpi()));
+        const PKA::Values pri = sec -> decrypt_secret_keys(passphrase);
+        const PKA::ModExpContext::Ptr context = sec -> get_secret_modexp(pri);
+        if (context){
+            symkey = mpitoraw(PKA::RSA::decrypt(tag1 -> get_mpi()[0], context, sec -> get_mpi()));
+        }
+        else{
+            symkey = mpitoraw(PKA::RSA::decrypt(tag1 -> get_mpi()[0], pri, sec -> get_mpi()));
+        }
     }
     else if (tag1 -> get_pka() == PKA::ID::ELGAMAL){
         symkey = PKA::ElGamal::decrypt(tag1 -> get_mpi(), sec -> decrypt_secret_keys(passphrase), sec -> get_mpi());
     }
 
-    // get symmetric algorithm, session key, 2 octet checksum wrapped in EME_PKCS1_ENCODE
-    symkey = zero + symkey;
+    #ifdef GPG_COMPATIBLE
+    if (tag1 -> get_pka() == PKA::ID::ECDH){
+        // RFC 6637 sec 8: the session key block is wrapped, not PKCS#1 encoded
+        if (!(symkey = PKA::ECDH::decrypt(tag1 -> get_mpi(), tag1 -> get_wrapped(), sec -> decrypt_secret_keys(passphrase), {sec -> get_curve(), sec -> get_kdf_hash(), sec -> get_kdf_alg(), sec -> get_fingerprint()})).size()){
+            // "Error: ECDH decryption failure.\n";
+            return Message();
+        }
+    }
+    else
+    #endif
+    {
+        // get symmetric algorithm, session key, 2 octet checksum wrapped in EME_PKCS1_ENCODE
+        symkey = zero + symkey;
 
-    if (!(symkey = EME_PKCS1v1_5_DECODE(symkey)).size()){            // remove EME_PKCS1 encoding
-        // "Error: EME_PKCS1v1_5_DECODE failure.\n";
-        return Message();
+        if (!(symkey = EME_PKCS1v1_5_DECODE(symkey)).size()){        // remove EME_PKCS1 encoding
+            // "Error: EME_PKCS1v1_5_DECODE failure.\n";
+            return Message();
+        }
     }
 
     const uint8_t sym = symkey[0];                                          // get symmetric algorithm
@@ -3,26 +3,66 @@
 namespace OpenPGP {
 namespace Encrypt {
 
+// appends data to chain without copying it
+static void append(ByteChain & chain, std::string && data){
+    if (data.size()){
+        chain.append(ByteSlice(std::move(data)));
+    }
+}
+
+// calls f with consecutive pieces of data of at most PARTIAL_CHUNK octets
+static void for_each_chunk(const ByteChain & data, const std::function <void(const char *, const std::size_t)> & f){
+    for(ByteSlice const & piece : data.get_pieces()){
+        for(std::size_t pos = 0; pos < piece.size(); pos += Packet::PARTIAL_CHUNK){
+            f(piece.data() + pos, std::min(Packet::PARTIAL_CHUNK, piece.size() - pos));
+        }
+    }
+}
+
+// appends a Literal Data Packet to out; the literal data itself is shared, not copied
+static void append_literal(const Packet::Tag11 & tag11, ByteChain & out){
+    const std::string filename = tag11.get_filename();
+    ByteWriter header(1 + 5 + 6 + filename.size());
+    header.put8(0xc0 | Packet::LITERAL_DATA);
+    Packet::write_body_length(tag11.serialized_size(), header);
+    header.put8(tag11.get_format());
+    header.put8(filename.size());
+    header.put(filename);
+    header.put32(tag11.get_time());
+    append(out, header.release());
+    out.append(tag11.get_literal_slice());
+}
+
 Packet::Tag::Ptr data(const Args & args,
                  const std::string & session_key){
+    const RNG::Scope scope(args.rng.get());
 
     if (!args.valid()){
         // "Error: Bad argument.\n";
         return nullptr;
     }
 
-    std::string to_encrypt;
+    // plaintext packets; the literal data is args.data itself
+    ByteChain to_encrypt;
 
     // if message is to be signed
     if (args.signer){
+        // the signed packets are compressed together below
         const Sign::Args signargs(*(args.signer), args.passphrase, 4, args.hash);
-        Message signed_message = Sign::binary(signargs, args.filename, args.data, args.comp);
+        Message signed_message = Sign::binary(signargs, args.filename, args.data, Compression::ID::UNCOMPRESSED);
         if (!signed_message.meaningful()){
             // "Error: Signing failure.\n";
             return nullptr;
         }
 
-        to_encrypt = signed_message.raw();
+        for(Packet::Tag::Ptr const & p : signed_message.get_packets()){
+            if (p -> get_tag() == Packet::LITERAL_DATA){
+                append_literal(*std::static_pointer_cast <Packet::Tag11> (p), to_encrypt);
+            }
+            else{
+                append(to_encrypt, p -> write(Packet::Tag::Format::NEW));
+            }
+        }
     }
     else{
         // put data in Literal Data Packet
@@ -31,49 +71,156 @@ Packet::Tag::Ptr data(const Args & args,
         tag11.set_filename(args.filename);
         tag11.set_time(0);
         tag11.set_literal(args.data);
+        append_literal(tag11, to_encrypt);
+    }
 
-        to_encrypt = tag11.write(Packet::Tag::Format::NEW);
-
-        if (args.comp){
-            // Compressed Data Packet (Tag 8)
-            Packet::Tag8 tag8;
-            tag8.set_comp(args.comp);
-            tag8.set_data(to_encrypt); // put source data into compressed packet
-            to_encrypt = tag8.write(Packet::Tag::Format::NEW);
-        }
+    if (args.comp){
+        // Compressed Data Packet (Tag 8)
+        Compression::Compressor compressor(args.comp);
+        ByteChain compressed;
+        for_each_chunk(to_encrypt, [&](const char * chunk, const std::size_t length){
+            append(compressed, compressor.update(chunk, length));
+        });
+        append(compressed, compressor.finish());
+
+        ByteWriter header(1 + 5 + 1);
+        header.put8(0xc0 | Packet::COMPRESSED_DATA);
+        Packet::write_body_length(1 + compressed.size(), header);
+        header.put8(args.comp);
+
+        to_encrypt = ByteChain();
+        append(to_encrypt, header.release());
+        to_encrypt.append(compressed);
     }
 
     // generate prefix
     const std::size_t BS = Sym::BLOCK_LENGTH.at(args.sym);
-    std::string prefix = unbinify(RNG::BBS().rand(BS));
+    std::string prefix = RNG::bytes(BS >> 3);
     prefix += prefix.substr(prefix.size() - 2, 2);
 
-    Packet::Tag::Ptr encrypted = nullptr;
+    const uint8_t packet = args.mdc?Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA:Packet::SYMMETRICALLY_ENCRYPTED_DATA;
+    OpenPGP_CFB_Encryptor cfb(Sym::setup(args.sym, session_key), packet, prefix);
+    SHA1 mdc(prefix);
+
+    // the ciphertext of each chunk is kept as it is produced
+    ByteChain encrypted;
+    for_each_chunk(to_encrypt, [&](const char * chunk, const std::size_t length){
+        if (args.mdc){
+            mdc.update(chunk, length);
+        }
+        append(encrypted, cfb.update(chunk, length));
+    });
 
     if (!args.mdc){
         // Symmetrically Encrypted Data Packet (Tag 9)
-        Packet::Tag9 tag9;
-        tag9.set_encrypted_data(use_OpenPGP_CFB_encrypt(args.sym, Packet::SYMMETRICALLY_ENCRYPTED_DATA, to_encrypt, session_key, prefix));
-        encrypted = std::make_shared <Packet::Tag9> (tag9);
+        Packet::Tag9::Ptr tag9 = std::make_shared <Packet::Tag9> ();
+        tag9 -> set_encrypted_data(encrypted);
+        return tag9;
+    }
+
+    // Modification Detection Code Packet (Tag 19)
+    mdc.update("\xd3\x14");
+    append(encrypted, cfb.update("\xd3\x14" + mdc.digest()));
+
+    // Sym. Encrypted Integrity Protected Data Packet (Tag 18)
+    // encrypt(compressed(literal_data_packet(plain text)) + MDC SHA1(20 octets))
+    Packet::Tag18::Ptr tag18 = std::make_shared <Packet::Tag18> ();
+    tag18 -> set_protected_data(encrypted);
+    return tag18;
+}
+
+bool stream(const Args & args,
+            const std::string & session_key,
+            std::istream & in,
+            std::ostream & out,
+            const std::size_t chunk){
+    const RNG::Scope scope(args.rng.get());
+
+    if (!args.valid() || args.signer){
+        // "Error: Bad argument.\n";
+        return false;
+    }
+
+    // generate prefix
+    const std::size_t BS = Sym::BLOCK_LENGTH.at(args.sym);
+    std::string prefix = RNG::bytes(BS >> 3);
+    prefix += prefix.substr(prefix.size() - 2, 2);
+
+    const uint8_t packet = args.mdc?Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA:Packet::SYMMETRICALLY_ENCRYPTED_DATA;
+    OpenPGP_CFB_Encryptor cfb(Sym::setup(args.sym, session_key), packet, prefix);
+    SHA1 mdc(prefix);
+
+    // Sym. Encrypted Integrity Protected Data Packet (Tag 18) or Symmetrically Encrypted Data Packet (Tag 9)
+    PartialWriter encrypted(out, packet, chunk);
+    if (args.mdc){
+        encrypted.put(1);                                   // version
     }
-    else{
-        // Modification Detection Code Packet (Tag 19)
-        Packet::Tag19 tag19;
-        tag19.set_hash(Hash::use(Hash::ID::SHA1, prefix + to_encrypt + "\xd3\x14"));
 
-        // Sym. Encrypted Integrity Protected Data Packet (Tag 18)
-        // encrypt(compressed(literal_data_packet(plain text)) + MDC SHA1(20 octets))
-        Packet::Tag18 tag18;
-        tag18.set_protected_data(use_OpenPGP_CFB_encrypt(args.sym, Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA, to_encrypt + tag19.write(), session_key, prefix));
-        encrypted = std::make_shared <Packet::Tag18> (tag18);
+    // Compressed Data Packet (Tag 8)
+    std::stringstream compressed;
+    PartialWriter tag8(compressed, Packet::COMPRESSED_DATA, chunk);
+    Compression::Compressor compressor(args.comp);
+    if (args.comp){
+        tag8.put(args.comp);
     }
 
-    return encrypted;
+    // Literal Data Packet (Tag 11)
+    std::stringstream literal;
+    PartialWriter tag11(literal, Packet::LITERAL_DATA, chunk);
+    ByteWriter header(6 + args.filename.size());
+    header.put8('b');
+    header.put8(args.filename.size());
+    header.put(args.filename);
+    header.put32(0);
+    tag11.write(header.str().data(), header.size());
+
+    // move whatever the plaintext packets have produced into the encrypted data packet
+    auto flush = [&](const bool last){
+        std::string data;
+        if (args.comp){
+            const std::string lit = literal.str();
+            literal.str("");
+            tag8 << compressor.update(lit);
+            if (last){
+                tag8 << compressor.finish();
+                tag8.close();
+            }
+            data = compressed.str();
+            compressed.str("");
+        }
+        else{
+            data = literal.str();
+            literal.str("");
+        }
+
+        if (args.mdc){
+            mdc.update(data);
+        }
+        encrypted << cfb.update(data);
+    };
+
+    std::vector <char> buf(chunk);
+    while (in){
+        in.read(buf.data(), buf.size());
+        tag11.write(buf.data(), in.gcount());
+        flush(false);
+    }
+    tag11.close();
+    flush(true);
+
+    if (args.mdc){
+        // Modification Detection Code Packet (Tag 19)
+        mdc.update("\xd3\x14");
+        encrypted << cfb.update("\xd3\x14" + mdc.digest());
+    }
+
+    encrypted.close();
+    return static_cast <bool> (out);
 }
 
 Message pka(const Args & args,
             const Key & pgpkey){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
+    const RNG::Scope scope(args.rng.get());
 
     if (!args.valid()){
         // "Error: Bad argument.\n";
@@ -123,7 +270,7 @@ Message pka(const Args & args,
 
     // generate session key
     const std::size_t key_len = Sym::KEY_LENGTH.at(args.sym);
-    const std::string session_key = unbinify(RNG::BBS().rand(key_len));
+    const std::string session_key = RNG::bytes(key_len >> 3);
 
     // get checksum of session key
     uint16_t sum = 0;
@@ -131,17 +278,34 @@ Message pka(const Args & args,
         sum += static_cast <unsigned char> (c);
     }
 
-    std::string nibbles = mpitohex(mpi[0]);        // get hex representation of modulus
-    nibbles += std::string(nibbles.size() & 1, 0); // get even number of nibbles
-    MPI m = hextompi(hexlify(EME_PKCS1v1_5_ENCODE(std::string(1, args.sym) + session_key + unhexlify(makehex(sum, 4)), nibbles.size() >> 1)));
+    const std::string block = std::string(1, args.sym) + session_key + unhexlify(makehex(sum, 4));
 
-    // encrypt m
-    if ((key -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
-        (key -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)){
-        tag1 -> set_mpi({PKA::RSA::encrypt(m, mpi)});
+    #ifdef GPG_COMPATIBLE
+    if (key -> get_pka() == PKA::ID::ECDH){
+        // RFC 6637 sec 8: the block is wrapped instead of PKCS#1 encoded
+        std::string wrapped;
+        tag1 -> set_mpi(PKA::ECDH::encrypt(block, mpi, {key -> get_curve(), key -> get_kdf_hash(), key -> get_kdf_alg(), key -> get_fingerprint()}, wrapped));
+        if (!tag1 -> get_mpi().size()){
+            // "Error: ECDH encryption failed.\n";
+            return Message();
+        }
+        tag1 -> set_wrapped(wrapped);
     }
-    else if (key -> get_pka() == PKA::ID::ELGAMAL){
-        tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi));
+    else
+    #endif
+    {
+        std::string nibbles = mpitohex(mpi[0]);        // get hex representation of modulus
+        nibbles += std::string(nibbles.size() & 1, 0); // get even number of nibbles
+        MPI m = rawtompi(EME_PKCS1v1_5_ENCODE(block, nibbles.size() >> 1));
+
+        // encrypt m
+        if ((key -> get_pka() == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
+            (key -> get_pka() == PKA::ID::RSA_ENCRYPT_ONLY)){
+            tag1 -> set_mpi({PKA::RSA::encrypt(m, mpi)});
+        }
+        else if (key -> get_pka() == PKA::ID::ELGAMAL){
+            tag1 -> set_mpi(PKA::ElGamal::encrypt(m, mpi, key -> get_modexp()));
+        }
     }
 
     // encrypt data and put it into a packet
@@ -161,20 +325,44 @@ Message pka(const Args & args,
 
 Message sym(const Args & args,
             const std::string & passphrase,
-            const uint8_t key_hash){
-    RNG::BBS(static_cast <MPI> (static_cast <unsigned int> (now()))); // seed just in case not seeded
+            const uint8_t key_hash,
+            const uint8_t key_count){
+    // String to Key specifier for decrypting session key
+    S2K::S2K3::Ptr s2k = std::make_shared <S2K::S2K3> ();
+    s2k -> set_hash(key_hash);
+    s2k -> set_count(key_count);
+
+    return sym(args, passphrase, s2k);
+}
+
+Message sym(const Args & args,
+            const std::string & passphrase,
+            const S2K::S2K::Ptr & key_s2k){
+    const RNG::Scope scope(args.rng.get());
 
     if (!args.valid()){
         // "Error: Bad argument.\n";
         return Message();
     }
 
-    // String to Key specifier for decrypting session key
-    S2K::S2K3::Ptr s2k = std::make_shared <S2K::S2K3> ();
-    s2k -> set_type(S2K::ID::ITERATED_AND_SALTED_S2K);
-    s2k -> set_hash(key_hash);
-    s2k -> set_salt(unbinify(RNG::BBS().rand(64)));
-    s2k -> set_count(96);
+    if (!key_s2k){
+        // "Error: No S2K provided.\n";
+        return Message();
+    }
+
+    // every message gets a salt of its own
+    S2K::S2K::Ptr s2k = key_s2k -> clone();
+    if (s2k -> get_type() == S2K::ID::ARGON2){
+        std::static_pointer_cast <S2K::S2K4> (s2k) -> set_salt(RNG::bytes(S2K::S2K4::SALT_SIZE));
+    }
+    else if ((s2k -> get_type() == S2K::ID::SALTED_S2K) ||
+             (s2k -> get_type() == S2K::ID::ITERATED_AND_SALTED_S2K)){
+        std::static_pointer_cast <S2K::S2K1> (s2k) -> set_salt(RNG::bytes(8));
+    }
+    else{
+        // "Error: S2K must have a salt value.\n";
+        return Message();
+    }
 
     // generate Symmetric-Key Encrypted Session Key Packets (Tag 3)
     Packet::Tag3::Ptr tag3 = std::make_shared <Packet::Tag3> ();
@@ -26,8 +26,14 @@ THE SOFTWARE.
 #ifndef __ENCRYPT__
 #define __ENCRYPT__
 
+#include <algorithm>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "Compress/Compress.h"
 #include "Encryptions/Encryptions.h"
@@ -37,6 +43,8 @@ THE SOFTWARE.
 #include "Misc/PKCS1.h"
 #include "Misc/cfb.h"
 #include "PKA/PKAs.h"
+#include "PartialWriter.h"
+#include "RNG/RNGs.h"
 #include "revoke.h"
 #include "sign.h"
 
@@ -44,22 +52,24 @@ namespace OpenPGP {
     namespace Encrypt {
         struct Args{
             std::string filename;
-            std::string data;
+            ByteSlice data;                 // may be a slice of a MappedFile; it is read in place and never copied
             uint8_t sym;                    // symmetric key algorithm used to encrypt data
             uint8_t comp;                   // compression algorithm for encrypted data
             bool mdc;
             SecretKey::Ptr signer;          // for signing data
             std::string passphrase;         // only used when signer is present
             uint8_t hash;                   // hash used to sign data
+            RNG::Generator::Ptr rng;        // source of random octets; the calling thread's generator if null
 
             Args(const std::string & fname = "",
-                        const std::string & dat = "",
+                        const ByteSlice & dat = ByteSlice(),
                         const uint8_t sym_alg = Sym::ID::AES256,
                         const uint8_t comp_alg = Compression::ID::ZLIB,
                         const bool mod_detect = true,
                         const SecretKey::Ptr & signing_key = nullptr,
                         const std::string & pass = "",
-                        const uint8_t hash_alg = Hash::ID::SHA1)
+                        const uint8_t hash_alg = Hash::ID::SHA1,
+                        const RNG::Generator::Ptr & gen = nullptr)
                 : filename(fname),
                   data(dat),
                   sym(sym_alg),
@@ -67,7 +77,8 @@ namespace OpenPGP {
                   mdc(mod_detect),
                   signer(signing_key),
                   passphrase(pass),
-                  hash(hash_alg)
+                  hash(hash_alg),
+                  rng(gen)
             {}
 
             bool valid() const{
@@ -91,17 +102,34 @@ namespace OpenPGP {
         };
 
         // encrypt data once session key has been generated
+        // args.data is compressed and encrypted chunk by chunk where it lies
         Packet::Tag::Ptr data(const Args & args,
                                const std::string & session_key);
 
+        // encrypt everything read from in and write the encrypted data packet to out as it is produced
+        // packets are written with partial body lengths of chunk octets, so the length of in does not
+        // need to be known; args.data is not used and signing is not supported (returns false)
+        bool stream(const Args & args,
+                    const std::string & session_key,
+                    std::istream & in,
+                    std::ostream & out,
+                    const std::size_t chunk = Packet::PARTIAL_CHUNK);
+
         // encrypt with public key
         Message pka(const Args & args,
                     const Key & pub);
 
-        // encrypt with passphrase
+        // encrypt with passphrase; see S2K::S2K3::calibrate for choosing key_count
+        Message sym(const Args & args,
+                    const std::string & passphrase,
+                    const uint8_t key_hash,
+                    const uint8_t key_count = S2K::S2K3::DEFAULT_COUNT);
+
+        // encrypt with passphrase, deriving the key with a copy of key_s2k
+        // that is given a new salt, e.g. an Argon2 S2K::S2K4
         Message sym(const Args & args,
                     const std::string & passphrase,
-                    const uint8_t key_hash);
+                    const S2K::S2K::Ptr & key_s2k);
     }
 }
 #endif
@@ -63,7 +63,7 @@ const Module decrypt_pka(
             return -1;
         }
 
-        std::ifstream msg(args.at("file"), std::ios::binary);
+        const MappedFile msg(args.at("file"));
         if (!msg){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -86,7 +86,7 @@ const Module decrypt_pka(
         }
 
         OpenPGP::SecretKey pri(key);
-        OpenPGP::Message message(msg);
+        OpenPGP::Message message(msg.data());
 
         const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, args.at("passphrase"), message);
 
@@ -56,7 +56,7 @@ const Module decrypt_sym(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream msg(args.at("file"), std::ios::binary);
+        const MappedFile msg(args.at("file"));
         if (!msg){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -78,7 +78,7 @@ const Module decrypt_sym(
             }
         }
 
-        const OpenPGP::Message message(msg);
+        const OpenPGP::Message message(msg.data());
         const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(message, args.at("passphrase"));
 
         if (!decrypted.meaningful()){
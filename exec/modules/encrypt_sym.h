@@ -62,7 +62,7 @@ const Module encrypt_sym(
        const std::map <std::string, bool>        & flags,
        std::ostream                              & out,
        std::ostream                              & err) -> int {
-        std::ifstream file(args.at("file"), std::ios::binary);
+        const MappedFile file(args.at("file"));
         if (!file){
             err << "Error: File \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -105,7 +105,7 @@ const Module encrypt_sym(
         }
 
         const OpenPGP::Encrypt::Args encryptargs(args.at("file"),
-                                                 std::string(std::istreambuf_iterator <char> (file), {}),
+                                                 file.data(),
                                                  OpenPGP::Sym::NUMBER.at(args.at("--sym")),
                                                  OpenPGP::Compression::NUMBER.at(args.at("-c")),
                                                  flags.at("--mdc"),
@@ -63,7 +63,7 @@ const Module sign_cleartext_signature(
             return -1;
         }
 
-        std::ifstream file(args.at("file"), std::ios::binary);
+        const MappedFile file(args.at("file"));
         if (!file){
             err << "IOError: File \"" << args.at("file") << "\" not opened." << std::endl;
             return -1;
@@ -79,7 +79,7 @@ const Module sign_cleartext_signature(
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        const OpenPGP::CleartextSignature signature = OpenPGP::Sign::cleartext_signature(signargs, std::string(std::istreambuf_iterator<char>(file), {}));
+        const OpenPGP::CleartextSignature signature = OpenPGP::Sign::cleartext_signature(signargs, file.data());
 
         if (!signature.meaningful()){
             err << "Error: Generated bad cleartext signature." << std::endl;
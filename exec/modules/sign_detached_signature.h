@@ -63,7 +63,7 @@ const Module sign_detached_signature(
             return -1;
         }
 
-        std::ifstream file(args.at("file"), std::ios::binary);
+        const MappedFile file(args.at("file"));
         if (!file){
             err << "IOError: file \"" + args.at("file") + "\" could not be opened." << std::endl;
             return -1;
@@ -79,7 +79,7 @@ const Module sign_detached_signature(
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        const OpenPGP::DetachedSignature signature = OpenPGP::Sign::detached_signature(signargs, std::string(std::istreambuf_iterator <char> (file), {}));
+        const OpenPGP::DetachedSignature signature = OpenPGP::Sign::detached_signature(signargs, file.data());
 
         if (!signature.meaningful()){
             err << "Error: Generated bad detached signature." << std::endl;
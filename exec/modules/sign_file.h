@@ -64,7 +64,7 @@ const Module sign_file(
             return -1;
         }
 
-        std::ifstream file(args.at("file"), std::ios::binary);
+        const MappedFile file(args.at("file"));
         if (!file){
             err << "IOError: file \"" + args.at("file") + "\" could not be opened." << std::endl;
             return -1;
@@ -85,7 +85,7 @@ const Module sign_file(
                                            4,
                                            OpenPGP::Hash::NUMBER.at(args.at("-h")));
 
-        const OpenPGP::Message message = OpenPGP::Sign::binary(signargs, args.at("file"), std::string(std::istreambuf_iterator <char> (file), {}), OpenPGP::Compression::NUMBER.at(args.at("-c")));
+        const OpenPGP::Message message = OpenPGP::Sign::binary(signargs, args.at("file"), file.data(), OpenPGP::Compression::NUMBER.at(args.at("-c")));
 
         if (!message.meaningful()){
             err << "Error: Generated bad file signature." << std::endl;
@@ -63,7 +63,7 @@ const Module verify_detached_signature(
             return -1;
         }
 
-        std::ifstream file(args.at("file"), std::ios::binary);
+        const MappedFile file(args.at("file"));
         if (!file){
             err << "Error: Data file \"" + args.at("file") + "\" not opened." << std::endl;
             return -1;
@@ -78,7 +78,7 @@ const Module verify_detached_signature(
         const OpenPGP::Key signer(key);
         const OpenPGP::DetachedSignature signature(sig);
 
-            const int verified = OpenPGP::Verify::detached_signature(signer, std::string(std::istreambuf_iterator <char> (file), {}), signature);
+            const int verified = OpenPGP::Verify::detached_signature(signer, file.data(), signature);
 
         if (verified == -1){
             err << "Error: Bad PKA value" << std::endl;
@@ -3,8 +3,6 @@
 namespace OpenPGP {
 
 bool fill_key_sigs(SecretKey & private_key, const std::string & passphrase){
-    RNG::BBS(static_cast <MPI> (static_cast <uint32_t> (now()))); // seed just in case not seeded
-
     if (!private_key.meaningful()){
         // "Error: Bad key.\n";
         return false;
@@ -77,9 +75,7 @@ bool fill_key_sigs(SecretKey & private_key, const std::string & passphrase){
     return true;
 }
 
-SecretKey generate_key(KeyGen & config){
-    RNG::BBS(static_cast <MPI> (static_cast <uint32_t> (now()))); // seed just in case not seeded
-
+SecretKey generate_key(KeyGen & config, ThreadPool * pool){
     if (!config.valid()){
         // "Error: Bad key generation configuration.\n";
         return SecretKey();
@@ -96,7 +92,7 @@ SecretKey generate_key(KeyGen & config){
     // generate public key values for primary key
     PKA::Values pub;
     PKA::Values pri;
-    if (!PKA::generate_keypair(config.pka, PKA::generate_params(config.pka, config.bits >> 1), pri, pub)){
+    if (!PKA::generate_keypair(config.pka, PKA::generate_params(config.pka, config.bits >> 1), pri, pub, pool)){
         // "Error: Could not generate primary key pair.\n";
         return SecretKey();
     }
@@ -113,6 +109,14 @@ SecretKey generate_key(KeyGen & config){
     primary -> set_time(time);
     primary -> set_pka(config.pka);
     primary -> set_mpi(pub);
+    #ifdef GPG_COMPATIBLE
+    if (config.pka == PKA::ID::EdDSA){
+        primary -> set_curve(unhexlify(PKA::CURVE_OID::ED_255));
+    }
+    else if (config.pka == PKA::ID::ECDSA){
+        primary -> set_curve(unhexlify((PKA::ECC::curve_of(mpitoraw(pub[0])) == PKA::ECC::ID::P384)?PKA::CURVE_OID::NIST_384:PKA::CURVE_OID::NIST_256));
+    }
+    #endif
     primary -> set_s2k_con(0); // no passphrase up to here
 
     // encrypt secret only if there is a passphrase
@@ -123,8 +127,8 @@ SecretKey generate_key(KeyGen & config){
         // Secret Key Packet S2K
         S2K::S2K3::Ptr s2k3 = std::make_shared <S2K::S2K3> ();
         s2k3 -> set_hash(config.hash);
-        s2k3 -> set_salt(unhexlify(bintohex(RNG::BBS().rand(64))));
-        s2k3 -> set_count(96);
+        s2k3 -> set_salt(RNG::bytes(8));
+        s2k3 -> set_count(config.count);
 
         // calculate the key from the passphrase
         const std::string session_key = s2k3 -> run(config.passphrase, Sym::KEY_LENGTH.at(config.sym) >> 3);
@@ -134,7 +138,7 @@ SecretKey generate_key(KeyGen & config){
 
         // encrypt private key value
         primary -> set_s2k(s2k3);
-        primary -> set_IV(unhexlify(bintohex(RNG::BBS().rand(Sym::BLOCK_LENGTH.at(config.sym)))));
+        primary -> set_IV(RNG::bytes(Sym::BLOCK_LENGTH.at(config.sym) >> 3));
         secret = use_normal_CFB_encrypt(config.sym, secret, session_key, primary -> get_IV());
     }
     else{
@@ -193,7 +197,7 @@ SecretKey generate_key(KeyGen & config){
     for(KeyGen::SubkeyGen const & skey : config.subkeys){
         PKA::Values subkey_pub;
         PKA::Values subkey_pri;
-        if (!PKA::generate_keypair(skey.pka, PKA::generate_params(skey.pka, skey.bits >> 1), subkey_pri, subkey_pub)){
+        if (!PKA::generate_keypair(skey.pka, PKA::generate_params(skey.pka, skey.bits >> 1), subkey_pri, subkey_pub, pool)){
             // "Error: Could not generate subkey pair.\n";
             return SecretKey();
         }
@@ -210,6 +214,20 @@ SecretKey generate_key(KeyGen & config){
         subkey -> set_time(time);
         subkey -> set_pka(skey.pka);
         subkey -> set_mpi(subkey_pub);
+        #ifdef GPG_COMPATIBLE
+        if (skey.pka == PKA::ID::EdDSA){
+            subkey -> set_curve(unhexlify(PKA::CURVE_OID::ED_255));
+        }
+        else if (skey.pka == PKA::ID::ECDSA){
+            subkey -> set_curve(unhexlify((PKA::ECC::curve_of(mpitoraw(subkey_pub[0])) == PKA::ECC::ID::P384)?PKA::CURVE_OID::NIST_384:PKA::CURVE_OID::NIST_256));
+        }
+        else if (skey.pka == PKA::ID::ECDH){
+            subkey -> set_curve(unhexlify(PKA::CURVE_OID::CURVE_255));
+            subkey -> set_kdf_size(3);
+            subkey -> set_kdf_hash(Hash::ID::SHA256);
+            subkey -> set_kdf_alg(Sym::ID::AES128);
+        }
+        #endif
         subkey -> set_s2k_con(0); // no passphrase up to here
 
         // encrypt secret only if there is a passphrase
@@ -220,8 +238,8 @@ SecretKey generate_key(KeyGen & config){
             // Secret Subkey S2K
             S2K::S2K3::Ptr s2k3 = std::make_shared <S2K::S2K3> ();
             s2k3 -> set_hash(skey.hash);
-            s2k3 -> set_salt(unhexlify(bintohex(RNG::BBS().rand(64)))); // new salt value
-            s2k3 -> set_count(96);
+            s2k3 -> set_salt(RNG::bytes(8)); // new salt value
+            s2k3 -> set_count(skey.count);
 
             // calculate the key from the passphrase
             std::string session_key = s2k3 -> run(config.passphrase, Sym::KEY_LENGTH.at(skey.sym) >> 3);
@@ -231,8 +249,8 @@ SecretKey generate_key(KeyGen & config){
 
             // encrypt private key value
             subkey -> set_s2k(s2k3);
-            subkey -> set_IV(unhexlify(bintohex(RNG::BBS().rand(Sym::BLOCK_LENGTH.at(skey.sym)))));
-            secret = use_normal_CFB_encrypt(skey.sym, secret + Hash::use(Hash::ID::SHA1, secret), session_key, subkey -> get_IV());
+            subkey -> set_IV(RNG::bytes(Sym::BLOCK_LENGTH.at(skey.sym) >> 3));
+            secret = use_normal_CFB_encrypt(skey.sym, secret, session_key, subkey -> get_IV());
         }
         else{
             // add checksum to secret
@@ -286,4 +304,44 @@ SecretKey generate_key(KeyGen & config){
     return private_key;
 }
 
+std::vector <SecretKey> generate_keys(const KeyGen & config, const std::size_t count, ThreadPool & pool){
+    // generate_key waits on the pool it is given, so the jobs get none
+    // jobs must not throw, so the first exception is passed on once every job is done
+    std::vector <SecretKey::Ptr> generated(count);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    for(std::size_t i = 0; i < count; i++){
+        pool.submit([&, i](){
+            try {
+                KeyGen copy = config;
+                SecretKey::Ptr key = std::make_shared <SecretKey> (generate_key(copy));
+                if (key -> meaningful()){
+                    generated[i] = key;
+                }
+            }
+            catch (...) {
+                std::lock_guard <std::mutex> lock(error_mutex);
+                if (!error){
+                    error = std::current_exception();
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    if (error){
+        std::rethrow_exception(error);
+    }
+
+    // leave out the keys that failed
+    std::vector <SecretKey> keys;
+    for(SecretKey::Ptr const & key : generated){
+        if (key){
+            keys.push_back(*key);
+        }
+    }
+
+    return keys;
+}
+
 }
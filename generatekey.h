@@ -26,6 +26,8 @@ THE SOFTWARE.
 #ifndef __GENERATE_KEY__
 #define __GENERATE_KEY__
 
+#include <exception>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -54,6 +56,7 @@ namespace OpenPGP {
         std::size_t bits        = 2048;
         uint8_t     sym         = Sym::ID::AES256;          // symmetric key algorithm used by S2K
         uint8_t     hash        = Hash::ID::SHA256;         // hash algorithm used by S2K
+        uint8_t     count       = S2K::S2K3::DEFAULT_COUNT; // coded count used by S2K; see S2K::S2K3::calibrate
 
         // User ID (s)
         struct UserID{
@@ -73,6 +76,7 @@ namespace OpenPGP {
             std::size_t bits    = 2048;
             uint8_t     sym     = Sym::ID::AES256;          // symmetric key algorithm used by S2K
             uint8_t     hash    = Hash::ID::SHA256;         // hash algorithm used by S2K
+            uint8_t     count   = S2K::S2K3::DEFAULT_COUNT; // coded count used by S2K
             uint8_t     sig     = Hash::ID::SHA256;         // hash algorithm used to sign
             uint32_t    expire  = 0;
         };
@@ -222,7 +226,13 @@ namespace OpenPGP {
     // key generation using config defined above
     // returns a private key
     // public key can be extracted from the private key
-    SecretKey generate_key(KeyGen & config);
+    // the prime searches run on pool, if one is given
+    SecretKey generate_key(KeyGen & config, ThreadPool * pool = nullptr);
+
+    // generate count keys from the same configuration, one per job on pool
+    // each key is generated on a single thread; keys that failed are left out,
+    // and the first exception thrown by a job is rethrown after all of them finish
+    std::vector <SecretKey> generate_keys(const KeyGen & config, const std::size_t count, ThreadPool & pool);
 
 }
 
@@ -1,4 +1,6 @@
-OPENPGP_OBJECTS=decrypt.o                   \
+OPENPGP_OBJECTS=ArmorReader.o               \
+                ArmorWriter.o               \
+                decrypt.o                   \
                 encrypt.o                   \
                 generatekey.o               \
                 CleartextSignature.o        \
@@ -6,6 +8,8 @@ OPENPGP_OBJECTS=decrypt.o                   \
                 DetachedSignature.o         \
                 Key.o                       \
                 Message.o                   \
+                PacketReader.o              \
+                PartialWriter.o             \
                 RevocationCertificate.o     \
                 revoke.o                    \
                 sign.o                      \
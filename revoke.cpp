@@ -78,7 +78,7 @@ Packet::Tag2::Ptr sig(const Packet::Tag5::Ptr & signer, const std::string & pass
     }
 
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = Sign::with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(passphrase), signer -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = Sign::with_pka(digest, signer, passphrase, sig -> get_hash());
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -89,6 +89,8 @@ Packet::Tag2::Ptr sig(const Packet::Tag5::Ptr & signer, const std::string & pass
 }
 
 Packet::Tag2::Ptr key_sig(const Args & args){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad arguments.\n";
         return nullptr;
@@ -121,6 +123,8 @@ Packet::Tag2::Ptr key_sig(const Args & args){
 }
 
 Packet::Tag2::Ptr subkey_sig(const Args & args, const std::string & keyid){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad arguments.\n";
         return nullptr;
@@ -184,7 +188,7 @@ Packet::Tag2::Ptr uid_sig(const Packet::Tag5::Ptr & signer, const std::string &
     // set signature data
     std::string digest = to_sign_30(signer, user, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = Sign::with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(passphrase), signer -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = Sign::with_pka(digest, signer, passphrase, sig -> get_hash());
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -195,6 +199,8 @@ Packet::Tag2::Ptr uid_sig(const Packet::Tag5::Ptr & signer, const std::string &
 }
 
 Packet::Tag2::Ptr uid_sig(const Args & args, const std::string & ID){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad arguments.\n";
         return nullptr;
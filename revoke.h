@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "Key.h"
 #include "Misc/PKCS1.h"
 #include "Misc/mpi.h"
+#include "RNG/RNGs.h"
 #include "RevocationCertificate.h"
 #include "sign.h"
 #include "verify.h"
@@ -52,6 +53,7 @@ namespace OpenPGP {
             std::string reason;
             uint8_t version;            // 3 or 4
             uint8_t hash;
+            RNG::Generator::Ptr rng;    // source of random octets; the calling thread's generator if null
 
             Args(const SecretKey & sign,
                     const std::string & pass,
@@ -59,14 +61,16 @@ namespace OpenPGP {
                     const uint8_t rev_code = Subpacket::Tag2::Revoke::NO_REASON_SPECIFIED,
                     const std::string & rev_reason = "",
                     const uint8_t ver = 4,
-                    const uint8_t ha = Hash::ID::SHA1)
+                    const uint8_t ha = Hash::ID::SHA1,
+                    const RNG::Generator::Ptr & gen = nullptr)
                 : signer(sign),
                   passphrase(pass),
                   target(tar),
                   code(rev_code),
                   reason(rev_reason),
                   version(ver),
-                  hash(ha)
+                  hash(ha),
+                  rng(gen)
             {}
 
             bool valid() const{
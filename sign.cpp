@@ -3,21 +3,38 @@
 namespace OpenPGP {
 namespace Sign {
 
-PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash){
+PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash, const PKA::ModExpContext::Ptr & context){
     if ((pka == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
         (pka == PKA::ID::RSA_ENCRYPT_ONLY)){
         // RFC 4880 sec 5.2.2
         // If RSA, hash value is encoded using EMSA-PKCS1-v1_5
-        return {PKA::RSA::sign(EMSA_PKCS1_v1_5(hash, digest, bitsize(pub[0]) >> 3), pri, pub)};
+        const std::string encoded = EMSA_PKCS1_v1_5(hash, digest, bitsize(pub[0]) >> 3);
+        if (PKA::usable(context, pub[0], {}) && context -> has_crt()){
+            return {PKA::RSA::sign(rawtompi(encoded), context, pub)};
+        }
+        return {PKA::RSA::sign(encoded, pri, pub)};
     }
     else if (pka == PKA::ID::DSA){
-        return PKA::DSA::sign(digest, pri, pub);
+        return PKA::DSA::sign(digest, pri, pub, context);
+    }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDSA){
+        return PKA::ECDSA::sign(digest, pri, pub, hash);
+    }
+    else if (pka == PKA::ID::EdDSA){
+        return PKA::EdDSA::sign(digest, pri, pub);
     }
+    #endif
 
     // "Error: Undefined or incorrect PKA number: " + std::to_string(pka) + "\n";
     return {};
 }
 
+PKA::Values with_pka(const std::string & digest, const Packet::Tag5::Ptr & signer, const std::string & passphrase, const uint8_t hash){
+    const PKA::Values pri = signer -> decrypt_secret_keys(passphrase);
+    return with_pka(digest, signer -> get_pka(), pri, signer -> get_mpi(), hash, signer -> get_secret_modexp(pri));
+}
+
 Packet::Tag2::Ptr create_sig_packet(const uint8_t version, const uint8_t type, const uint8_t pka, const uint8_t hash, const std::string & keyid){
     // Set up signature packet
     Packet::Tag2::Ptr tag2 = std::make_shared <Packet::Tag2> ();
@@ -40,6 +57,12 @@ Packet::Tag2::Ptr create_sig_packet(const uint8_t version, const uint8_t type, c
 }
 
 DetachedSignature detached_signature(const Args & args, const std::string & data){
+    return detached_signature(args, ByteSlice::view(data.data(), data.size()));
+}
+
+DetachedSignature detached_signature(const Args & args, const ByteSlice & data){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad argument.\n";
         return DetachedSignature();
@@ -64,9 +87,9 @@ DetachedSignature detached_signature(const Args & args, const std::string & data
 
     // create Signature Packet
     Packet::Tag2::Ptr sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_BINARY_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
-    const std::string digest = to_sign_00(binary_to_canonical(data), sig);
+    const std::string digest = to_sign_00(binary_to_canonical(ByteChain(data)), sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return DetachedSignature();
@@ -82,6 +105,12 @@ DetachedSignature detached_signature(const Args & args, const std::string & data
 
 // 0x00: Signature of a binary document.
 Message binary(const Args & args, const std::string & filename, const std::string & data, const uint8_t compress){
+    return binary(args, filename, ByteSlice(data), compress);
+}
+
+Message binary(const Args & args, const std::string & filename, const ByteSlice & data, const uint8_t compress){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad argument.\n";
         return DetachedSignature();
@@ -111,9 +140,9 @@ Message binary(const Args & args, const std::string & filename, const std::strin
 
     // sign data
     Packet::Tag2::Ptr sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_BINARY_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
-    const std::string digest = to_sign_00(binary_to_canonical(tag11 -> get_literal()), sig);
+    const std::string digest = to_sign_00(binary_to_canonical(ByteChain(tag11 -> get_literal_slice())), sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return Message();
@@ -138,6 +167,12 @@ Message binary(const Args & args, const std::string & filename, const std::strin
 
 // 0x01: Signature of a canonical text document.
 CleartextSignature cleartext_signature(const Args & args, const std::string & text){
+    return cleartext_signature(args, ByteSlice::view(text.data(), text.size()));
+}
+
+CleartextSignature cleartext_signature(const Args & args, const ByteSlice & text){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad argument.\n";
         return CleartextSignature();
@@ -154,7 +189,7 @@ CleartextSignature cleartext_signature(const Args & args, const std::string & te
     Packet::Tag2::Ptr sig = create_sig_packet(args.version, Signature_Type::SIGNATURE_OF_A_CANONICAL_TEXT_DOCUMENT, signer -> get_pka(), args.hash, signer -> get_keyid());
     const std::string digest = to_sign_01(CleartextSignature::data_to_text(text), sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return CleartextSignature();
@@ -169,7 +204,7 @@ CleartextSignature cleartext_signature(const Args & args, const std::string & te
     // put signature under cleartext
     CleartextSignature message;
     message.set_hash_armor_header({std::make_pair("Hash", Hash::NAME.at(args.hash))});
-    message.set_message(text);
+    message.set_message(text.str());
     message.set_sig(signature);
 
     return message;
@@ -214,7 +249,7 @@ Packet::Tag2::Ptr primary_key(const Packet::Tag5::Ptr signer_signing_key, const
 
     const std::string digest = to_sign_cert(sig -> get_type(), signee_primary_key, signee_id, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer_signing_key -> get_pka(), signer_signing_key -> decrypt_secret_keys(passphrase), signer_signing_key -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = with_pka(digest, signer_signing_key, passphrase, sig -> get_hash());
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -225,6 +260,8 @@ Packet::Tag2::Ptr primary_key(const Packet::Tag5::Ptr signer_signing_key, const
 }
 
 PublicKey primary_key(const Args & args, const PublicKey & signee, const std::string & user, const uint8_t cert){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad arguments.\n";
         return PublicKey();
@@ -357,7 +394,7 @@ Packet::Tag2::Ptr subkey_binding(const Packet::Tag5::Ptr & primary, const std::s
 
     const std::string digest = to_sign_18(primary, sub, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, primary -> get_pka(), primary -> decrypt_secret_keys(passphrase), primary -> get_mpi(), sig -> get_hash());
+    PKA::Values vals = with_pka(digest, primary, passphrase, sig -> get_hash());
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -369,6 +406,8 @@ Packet::Tag2::Ptr subkey_binding(const Packet::Tag5::Ptr & primary, const std::s
 
 // 0x19: Primary Key Binding Signature
 Packet::Tag2::Ptr primary_key_binding(const Args & args, const PublicKey & signee){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad arguments.\n";
         return nullptr;
@@ -419,7 +458,7 @@ Packet::Tag2::Ptr primary_key_binding(const Args & args, const PublicKey & signe
 
     const std::string digest = to_sign_18(signee_primary, signer_subkey, sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer_subkey -> get_pka(), signer_subkey -> decrypt_secret_keys(args.passphrase), signer_subkey -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer_subkey, args.passphrase, args.hash);
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return nullptr;
@@ -430,6 +469,8 @@ Packet::Tag2::Ptr primary_key_binding(const Args & args, const PublicKey & signe
 }
 
 DetachedSignature timestamp(const Args & args, const uint32_t time){
+    const RNG::Scope scope(args.rng.get());
+
     if (!args.valid()){
         // "Error: Bad arguments.\n";
         return DetachedSignature();
@@ -453,7 +494,7 @@ DetachedSignature timestamp(const Args & args, const uint32_t time){
 
     const std::string digest = to_sign_40(sig);
     sig -> set_left16(digest.substr(0, 2));
-    PKA::Values vals = with_pka(digest, signer -> get_pka(), signer -> decrypt_secret_keys(args.passphrase), signer -> get_mpi(), args.hash);
+    PKA::Values vals = with_pka(digest, signer, args.passphrase, args.hash);
     if (!vals.size()){
         // "Error: PKA Signing failed.\n";
         return DetachedSignature();
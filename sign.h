@@ -42,6 +42,7 @@ THE SOFTWARE.
 #include "Misc/sigcalc.h"
 #include "PKA/PKAs.h"
 #include "Packets/packets.h"
+#include "RNG/RNGs.h"
 #include "common/includes.h"
 #include "decrypt.h"
 #include "revoke.h"
@@ -50,7 +51,10 @@ THE SOFTWARE.
 namespace OpenPGP {
     namespace Sign {
         // internal functions
-        PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash);
+        PKA::Values with_pka(const std::string & digest, const uint8_t pka, const PKA::Values & pri, const PKA::Values & pub, const uint8_t hash, const PKA::ModExpContext::Ptr & context = nullptr);
+
+        // decrypts the secret keys of signer and signs with its cached secret context
+        PKA::Values with_pka(const std::string & digest, const Packet::Tag5::Ptr & signer, const std::string & passphrase, const uint8_t hash);
 
         // Generates a new signature packet without PKA values
         Packet::Tag2::Ptr create_sig_packet(const uint8_t version, const uint8_t type, const uint8_t pka, const uint8_t hash, const std::string & keyid);
@@ -62,15 +66,18 @@ namespace OpenPGP {
             std::string passphrase;                     // passphrase for a key on the private key
             uint8_t version;                            // 3 or 4
             uint8_t hash;                               // hash algorithm to use for signing
+            RNG::Generator::Ptr rng;                    // source of random octets; the calling thread's generator if null
 
             Args(const SecretKey & key,
                      const std::string & pass,
                      const uint8_t ver = 4,
-                     const uint8_t ha = Hash::ID::SHA1)
+                     const uint8_t ha = Hash::ID::SHA1,
+                     const RNG::Generator::Ptr & gen = nullptr)
                 : pri(key),
                   passphrase(pass),
                   version(ver),
-                  hash(ha)
+                  hash(ha),
+                  rng(gen)
                 {}
 
             bool valid() const{
@@ -94,14 +101,18 @@ namespace OpenPGP {
         };
 
         // detached signatures (not a standalone signature)
+        // data is hashed in place, so it can be a slice of a MappedFile
         DetachedSignature detached_signature(const Args & args, const std::string & data);
+        DetachedSignature detached_signature(const Args & args, const ByteSlice & data);
 
         // 0x00: Signature of a binary document.
         // signed file is embedded into output
         Message binary(const Args & args, const std::string & filename, const std::string & data, const uint8_t compress);
+        Message binary(const Args & args, const std::string & filename, const ByteSlice & data, const uint8_t compress);   // the literal data packet shares data
 
         // 0x01: Signature of a canonical text document.
         CleartextSignature cleartext_signature(const Args & args, const std::string & text);
+        CleartextSignature cleartext_signature(const Args & args, const ByteSlice & text);     // text is only copied into the result
 
         // 0x02: Standalone signature.
 
@@ -0,0 +1,473 @@
+// OpenPGP benchmarks
+//
+// Timing printouts only; correctness is checked by the unit tests.
+//
+//     make benchmark && ./benchmark [name ...]
+//
+// With no arguments, every benchmark is run.
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PGP.h"
+#include "Misc/CRC-24.h"
+#include "Misc/radix64.h"
+#include "Misc/s2k.h"
+#include "PKA/EdDSA.h"
+#include "PKA/PKAs.h"
+#include "Packets/Tag6.h"
+#include "RNG/RNGs.h"
+#include "sign.h"
+#include "verify.h"
+
+#include "testcases/PKA/testvectors/dsa/dsasiggen.h"
+#include "testcases/testvectors/msg.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// milliseconds between two points in time
+static double ms(const Clock::time_point & start, const Clock::time_point & end){
+    return std::chrono::duration <double, std::milli> (end - start).count();
+}
+
+// microseconds between two points in time
+static double us(const Clock::time_point & start, const Clock::time_point & end){
+    return std::chrono::duration <double, std::micro> (end - start).count();
+}
+
+// bitwise CRC-24 from RFC 4880 sec 6.1
+static uint32_t crc24_reference(const std::string & data){
+    uint32_t crc = OpenPGP::CRC24_INIT;
+    for(unsigned char const c : data){
+        crc ^= static_cast <uint32_t> (c) << 16;
+        for(uint8_t i = 0; i < 8; i++){
+            crc <<= 1;
+            if (crc & 0x1000000){
+                crc ^= 0x1864CFB;
+            }
+        }
+    }
+    return crc & 0xFFFFFF;
+}
+
+static void argon2(){
+    OpenPGP::S2K::S2K4 s2k;
+    s2k.set_salt(std::string(16, 0));
+    s2k.set_passes(1);
+    s2k.set_memory(16);
+
+    for(const uint8_t lanes : {1, 2, 4, 8}){
+        s2k.set_parallelism(lanes);
+        const Clock::time_point start = Clock::now();
+        s2k.run("passphrase", 32);
+        std::cout << "Argon2id 64 MiB, 1 pass, " << (unsigned int) lanes << " lanes: " << ms(start, Clock::now()) << " ms" << std::endl;
+    }
+}
+
+static void crc24(){
+    const std::string data(1 << 24, '\xa5');
+
+    const Clock::time_point t0 = Clock::now();
+    crc24_reference(data);
+    const Clock::time_point t1 = Clock::now();
+    OpenPGP::crc24(data);
+    const Clock::time_point t2 = Clock::now();
+
+    uint32_t crc = OpenPGP::CRC24_INIT;
+    for(std::size_t i = 0; i < data.size(); i += 48){
+        crc = OpenPGP::crc24_update(crc, data.data() + i, std::min((std::size_t) 48, data.size() - i));
+    }
+    const Clock::time_point t3 = Clock::now();
+
+    std::cout << "16 MiB: bitwise " << ms(t0, t1) << " ms, "
+              << "crc24 " << ms(t1, t2) << " ms, "
+              << "48 octets at a time " << ms(t2, t3) << " ms" << std::endl;
+}
+
+static void ecdsa(){
+    const unsigned int rounds = 50;
+    const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, MESSAGE);
+
+    auto time = [&](const std::string & name, const std::function <OpenPGP::PKA::Values()> & sign, const std::function <bool(const OpenPGP::PKA::Values &)> & verify){
+        OpenPGP::PKA::Values sig;
+        const Clock::time_point t0 = Clock::now();
+        for(unsigned int i = 0; i < rounds; i++){
+            sig = sign();
+        }
+        const Clock::time_point t1 = Clock::now();
+        for(unsigned int i = 0; i < rounds; i++){
+            verify(sig);
+        }
+        const Clock::time_point t2 = Clock::now();
+
+        std::cout << name << ": " << us(t0, t1) / rounds << " us sign, " << us(t1, t2) / rounds << " us verify" << std::endl;
+    };
+
+    for(const uint8_t curve : {OpenPGP::PKA::ECC::ID::P256, OpenPGP::PKA::ECC::ID::P384}){
+        OpenPGP::PKA::Values pub;
+        const OpenPGP::PKA::Values pri = OpenPGP::PKA::ECDSA::keygen(pub, curve);
+        time((curve == OpenPGP::PKA::ECC::ID::P256)?"ECDSA P-256":"ECDSA P-384",
+             [&](){ return OpenPGP::PKA::ECDSA::sign(digest, pri, pub, OpenPGP::Hash::ID::SHA256); },
+             [&](const OpenPGP::PKA::Values & sig){ return OpenPGP::PKA::ECDSA::verify(digest, sig, pub); });
+    }
+
+    OpenPGP::PKA::Values rsa_pri, rsa_pub;
+    OpenPGP::PKA::generate_keypair(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN, OpenPGP::PKA::generate_params(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN, 1536), rsa_pri, rsa_pub);
+    time("RSA 3072   ",
+         [&](){ return OpenPGP::PKA::Values({OpenPGP::PKA::RSA::sign(digest, rsa_pri, rsa_pub)}); },
+         [&](const OpenPGP::PKA::Values & sig){ return OpenPGP::PKA::RSA::verify(digest, sig, rsa_pub); });
+
+    const OpenPGP::PKA::Values dsa_pri = {OpenPGP::hextompi(DSA_SIGGEN_X[0])};
+    const OpenPGP::PKA::Values dsa_pub = {OpenPGP::hextompi(DSA_SIGGEN_P), OpenPGP::hextompi(DSA_SIGGEN_Q), OpenPGP::hextompi(DSA_SIGGEN_G), OpenPGP::hextompi(DSA_SIGGEN_Y[0])};
+    time("DSA 1024   ",
+         [&](){ return OpenPGP::PKA::DSA::sign(digest, dsa_pri, dsa_pub); },
+         [&](const OpenPGP::PKA::Values & sig){ return OpenPGP::PKA::DSA::verify(digest, sig, dsa_pub); });
+}
+
+static void ed25519(){
+    const std::size_t count = 64;
+
+    std::vector <OpenPGP::PKA::Ed25519::Signed> batch;
+    for(std::size_t i = 0; i < count; i++){
+        const std::string seed = std::string(31, 0) + std::string(1, static_cast <char> (i));
+        const std::string pub = OpenPGP::PKA::Ed25519::public_key(seed);
+        const std::string msg = std::to_string(i);
+        batch.push_back({msg, OpenPGP::PKA::Ed25519::sign(msg, seed, pub), pub});
+    }
+
+    const Clock::time_point t0 = Clock::now();
+    for(OpenPGP::PKA::Ed25519::Signed const & s : batch){
+        OpenPGP::PKA::Ed25519::verify(s.message, s.signature, s.pub);
+    }
+    const Clock::time_point t1 = Clock::now();
+    OpenPGP::PKA::Ed25519::verify(batch);
+    const Clock::time_point t2 = Clock::now();
+
+    std::cout << count << " Ed25519 signatures: " << us(t0, t1) << " us one by one, " << us(t1, t2) << " us batch" << std::endl;
+}
+
+static void keyring(){
+    const unsigned int keys = 500;
+
+    // public keys with 4096 bit values; parsing does not care that they are not real RSA keys
+    const OpenPGP::MPI n = OpenPGP::random(512) << 3584;
+    std::string raw;
+    for(unsigned int i = 0; i < keys; i++){
+        OpenPGP::Packet::Tag6 key;
+        key.set_version(4);
+        key.set_time(i);
+        key.set_pka(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN);
+        key.set_mpi({n | (OpenPGP::MPI(1) << 4095) | (2 * i + 1), 65537});
+        raw += key.write(OpenPGP::Packet::Tag::Format::NEW);
+    }
+
+    const Clock::time_point t0 = Clock::now();
+    const OpenPGP::PGP parsed(raw);
+    const Clock::time_point t1 = Clock::now();
+    parsed.raw(OpenPGP::Packet::Tag::Format::NEW);
+    const Clock::time_point t2 = Clock::now();
+    std::string keyids;
+    for(OpenPGP::Packet::Tag::Ptr const & p : parsed.get_packets()){
+        keyids += std::static_pointer_cast <OpenPGP::Packet::Key> (p) -> get_keyid();
+    }
+    const Clock::time_point t3 = Clock::now();
+
+    std::cout << keys << " keys, " << raw.size() << " octets: "
+              << us(t0, t1) << " us parse, "
+              << us(t1, t2) << " us write, "
+              << us(t2, t3) << " us key IDs" << std::endl;
+}
+
+static void modexp(){
+    const OpenPGP::MPI p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    const OpenPGP::MPI q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    const OpenPGP::MPI g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    const unsigned int rounds = 2000;
+
+    std::vector <OpenPGP::MPI> exps;
+    for(std::string const & k : DSA_SIGGEN_K){
+        exps.push_back(OpenPGP::hextompi(k));
+    }
+
+    const OpenPGP::PKA::FixedBase table(g, p, OpenPGP::bitsize(q));
+
+    auto time = [&](const std::function <OpenPGP::MPI(const OpenPGP::MPI &)> & f){
+        const Clock::time_point start = Clock::now();
+        for(unsigned int i = 0; i < rounds; i++){
+            f(exps[i % exps.size()]);
+        }
+        return us(start, Clock::now()) / rounds;
+    };
+
+    const double plain = time([&](const OpenPGP::MPI & e){ return OpenPGP::powm(g, e, p); });
+    const double fixed = time([&](const OpenPGP::MPI & e){ return table.powm(e); });
+    std::cout << OpenPGP::bitsize(p) << " bit modulus, " << OpenPGP::bitsize(q) << " bit exponent: " << plain << " us powm, " << fixed << " us fixed base (" << (plain / fixed) << "x)" << std::endl;
+}
+
+static void prime(){
+    const unsigned int rounds = 5;
+    ThreadPool pool;
+
+    for(const uint8_t pka : {OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN, OpenPGP::PKA::ID::DSA, OpenPGP::PKA::ID::ELGAMAL}){
+        const OpenPGP::PKA::Params params = OpenPGP::PKA::generate_params(pka, 1024);
+
+        double serial = 0, pooled = 0;
+        for(unsigned int i = 0; i < rounds; i++){
+            OpenPGP::PKA::Values pri, pub;
+
+            const Clock::time_point t0 = Clock::now();
+            OpenPGP::PKA::generate_keypair(pka, params, pri, pub);
+            const Clock::time_point t1 = Clock::now();
+            OpenPGP::PKA::generate_keypair(pka, params, pri, pub, &pool);
+            const Clock::time_point t2 = Clock::now();
+
+            serial += ms(t0, t1);
+            pooled += ms(t1, t2);
+        }
+
+        std::cout << OpenPGP::PKA::NAME.at(pka) << " 2048: "
+                  << serial / rounds << " ms serial, "
+                  << pooled / rounds << " ms on " << pool.size() << " threads" << std::endl;
+    }
+}
+
+static void radix64(){
+    const std::string data(1 << 22, '\xa5');
+
+    const Clock::time_point t0 = Clock::now();
+    const std::string encoded = OpenPGP::ascii2radix64(data);
+    const Clock::time_point t1 = Clock::now();
+    OpenPGP::radix642ascii(encoded);
+    const Clock::time_point t2 = Clock::now();
+
+    std::string lines;
+    for(std::size_t i = 0; i < encoded.size(); i += OpenPGP::MAX_LINE_LENGTH){
+        lines += encoded.substr(i, OpenPGP::MAX_LINE_LENGTH) + "\n";
+    }
+    const Clock::time_point t3 = Clock::now();
+    OpenPGP::radix642ascii(lines);
+    const Clock::time_point t4 = Clock::now();
+
+    std::cout << "4 MiB: encode " << ms(t0, t1) << " ms, "
+              << "decode " << ms(t1, t2) << " ms, "
+              << "decode with line breaks " << ms(t3, t4) << " ms" << std::endl;
+}
+
+static void rng(){
+    const unsigned int rounds = 100;
+    for(const uint8_t source : {OpenPGP::RNG::Source::BBS, OpenPGP::RNG::Source::CHACHA20}){
+        OpenPGP::RNG::set_source(source);
+        const Clock::time_point start = Clock::now();
+        for(unsigned int i = 0; i < rounds; i++){
+            OpenPGP::RNG::bytes(32);
+        }
+        std::cout << ((source == OpenPGP::RNG::Source::BBS)?"BBS     ":"ChaCha20") << ": "
+                  << us(start, Clock::now()) / rounds << " us per 32 octets" << std::endl;
+    }
+    OpenPGP::RNG::set_source(OpenPGP::RNG::Source::CHACHA20);
+}
+
+static void rsa_batch_verify(){
+    const uint8_t pka = OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN;
+    const unsigned int keys = 4;
+    const unsigned int count = 4000;
+
+    std::vector <OpenPGP::Packet::Key::Ptr> signers;
+    std::vector <OpenPGP::PKA::Values> secrets;
+    for(unsigned int i = 0; i < keys; i++){
+        OpenPGP::PKA::Values pri, pub;
+        OpenPGP::PKA::generate_keypair(pka, OpenPGP::PKA::generate_params(pka, 1024), pri, pub);
+        OpenPGP::Packet::Key::Ptr signer = std::make_shared <OpenPGP::Packet::Tag6> ();
+        signer -> set_pka(pka);
+        signer -> set_mpi(pub);
+        signers.push_back(signer);
+        secrets.push_back(pri);
+    }
+
+    std::vector <OpenPGP::Verify::Batch> batch;
+    for(unsigned int i = 0; i < count; i++){
+        const OpenPGP::Packet::Key::Ptr & signer = signers[i % keys];
+        const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, MESSAGE + std::to_string(i));
+
+        OpenPGP::Packet::Tag2::Ptr sig = std::make_shared <OpenPGP::Packet::Tag2> ();
+        sig -> set_pka(pka);
+        sig -> set_hash(OpenPGP::Hash::ID::SHA256);
+        sig -> set_mpi(OpenPGP::Sign::with_pka(digest, pka, secrets[i % keys], signer -> get_mpi(), OpenPGP::Hash::ID::SHA256));
+
+        batch.push_back({digest, signer, sig});
+    }
+
+    auto time = [&](const std::size_t threads){
+        const Clock::time_point start = Clock::now();
+        OpenPGP::Verify::with_pka(batch, threads);
+        return batch.size() / (ms(start, Clock::now()) / 1000);
+    };
+
+    const double one = time(1);
+    const double all = time(0);
+    std::cout << "2048 bit RSA verify: " << one << "/s on 1 thread, " << all << "/s on " << std::thread::hardware_concurrency() << " threads" << std::endl;
+}
+
+static void rsa_crt(){
+    const unsigned int rounds = 100;
+
+    // keygen takes the size of p and q, so these are 2048 and 4096 bit keys
+    for(const uint32_t bits : {1024, 2048}){
+        // keys in use almost always have e = 65537, which keeps the check cheap
+        OpenPGP::PKA::Values key = OpenPGP::PKA::RSA::keygen(bits);
+        while (OpenPGP::mpigcd((key[3] - 1) * (key[4] - 1), 65537) != 1){
+            key = OpenPGP::PKA::RSA::keygen(bits);
+        }
+        const OpenPGP::PKA::Values pub = {key[0], 65537};
+        const OpenPGP::PKA::Values pri = {OpenPGP::invert(65537, (key[3] - 1) * (key[4] - 1)), key[3], key[4], key[5]};
+
+        const OpenPGP::MPI message = OpenPGP::rawtompi(MESSAGE) % pub[0];
+
+        auto time = [&](const OpenPGP::PKA::Values & values, const bool check){
+            const Clock::time_point start = Clock::now();
+            for(unsigned int i = 0; i < rounds; i++){
+                OpenPGP::PKA::RSA::sign(message, values, pub, check);
+            }
+            return ms(start, Clock::now()) / rounds;
+        };
+
+        const double full = time({pri[0]}, false);
+        const double crt = time(pri, false);
+        const double checked = time(pri, true);
+        std::cout << OpenPGP::bitsize(pub[0]) << " bit RSA sign: " << full << " ms full, " << crt << " ms CRT (" << (full / crt) << "x), "
+                  << checked << " ms CRT with check" << std::endl;
+    }
+}
+
+static void serialize(){
+    const unsigned int keys = 10000;
+    const unsigned int rounds = 5;
+
+    // secret keyring of the usual shape: an encrypted key, a user ID and a
+    // self-signature carrying the common subpackets; only the sizes matter
+    const OpenPGP::MPI n = OpenPGP::random(2048) | (OpenPGP::MPI(1) << 2047);
+    const OpenPGP::MPI sig = OpenPGP::random(2040);
+    OpenPGP::PGP::Packets packets;
+    for(unsigned int i = 0; i < keys; i++){
+        OpenPGP::S2K::S2K3::Ptr s2k = std::make_shared <OpenPGP::S2K::S2K3> ();
+        s2k -> set_hash(OpenPGP::Hash::ID::SHA256);
+        s2k -> set_salt(std::string(8, 's'));
+        s2k -> set_count(96);
+
+        OpenPGP::Packet::Tag5::Ptr key = std::make_shared <OpenPGP::Packet::Tag5> ();
+        key -> set_version(4);
+        key -> set_time(i);
+        key -> set_pka(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN);
+        key -> set_mpi({n | (2 * i + 1), 65537});
+        key -> set_s2k_con(254);
+        key -> set_sym(OpenPGP::Sym::ID::AES256);
+        key -> set_s2k(s2k);
+        key -> set_IV(std::string(16, 'i'));
+        key -> set_secret(std::string(680, 'x'));
+
+        OpenPGP::Packet::Tag13::Ptr uid = std::make_shared <OpenPGP::Packet::Tag13> ();
+        uid -> set_contents("user " + std::to_string(i), "", "user" + std::to_string(i) + "@example.com");
+
+        OpenPGP::Subpacket::Tag2::Sub2::Ptr created = std::make_shared <OpenPGP::Subpacket::Tag2::Sub2> ();
+        created -> set_time(i);
+        OpenPGP::Subpacket::Tag2::Sub9::Ptr expires = std::make_shared <OpenPGP::Subpacket::Tag2::Sub9> ();
+        expires -> set_dt(86400);
+        OpenPGP::Subpacket::Tag2::Sub11::Ptr psa = std::make_shared <OpenPGP::Subpacket::Tag2::Sub11> ();
+        psa -> set_psa("\x09\x08\x07");
+        OpenPGP::Subpacket::Tag2::Sub21::Ptr pha = std::make_shared <OpenPGP::Subpacket::Tag2::Sub21> ();
+        pha -> set_pha("\x08\x0a\x02");
+        OpenPGP::Subpacket::Tag2::Sub22::Ptr pca = std::make_shared <OpenPGP::Subpacket::Tag2::Sub22> ();
+        pca -> set_pca("\x02\x01");
+        OpenPGP::Subpacket::Tag2::Sub27::Ptr flags = std::make_shared <OpenPGP::Subpacket::Tag2::Sub27> ();
+        flags -> set_flags("\x03");
+        OpenPGP::Subpacket::Tag2::Sub20::Ptr notation = std::make_shared <OpenPGP::Subpacket::Tag2::Sub20> ();
+        notation -> set_flags(std::string("\x80\x00\x00\x00", 4));
+        notation -> set_m("note@example.com");
+        notation -> set_n("value");
+        OpenPGP::Subpacket::Tag2::Sub16::Ptr keyid = std::make_shared <OpenPGP::Subpacket::Tag2::Sub16> ();
+        keyid -> set_keyid(std::string(8, 'k'));
+
+        OpenPGP::Packet::Tag2::Ptr self = std::make_shared <OpenPGP::Packet::Tag2> ();
+        self -> set_version(4);
+        self -> set_type(OpenPGP::Signature_Type::POSITIVE_CERTIFICATION_OF_A_USER_ID_AND_PUBLIC_KEY_PACKET);
+        self -> set_pka(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN);
+        self -> set_hash(OpenPGP::Hash::ID::SHA256);
+        self -> set_hashed_subpackets({created, expires, psa, pha, pca, flags, notation});
+        self -> set_unhashed_subpackets({keyid});
+        self -> set_left16("ab");
+        self -> set_mpi({sig});
+
+        packets.push_back(key);
+        packets.push_back(uid);
+        packets.push_back(self);
+    }
+
+    OpenPGP::PGP ring;
+    ring.set_packets(packets);
+
+    std::size_t octets = 0;
+    const Clock::time_point start = Clock::now();
+    for(unsigned int i = 0; i < rounds; i++){
+        octets = ring.raw(OpenPGP::Packet::Tag::Format::NEW).size();
+    }
+    std::cout << keys << " secret keys with self-signatures, " << octets << " octets: " << (ms(start, Clock::now()) / rounds) << " ms write" << std::endl;
+}
+
+static void s2k(){
+    OpenPGP::S2K::S2K3 s2k;
+    s2k.set_salt(unhexlify("0123456789abcdef"));
+    s2k.set_hash(OpenPGP::Hash::ID::SHA1);
+
+    for(uint8_t const count : {96, 160, 224}){
+        s2k.set_count(count);
+        const Clock::time_point start = Clock::now();
+        s2k.run("passphrase", 32);
+        std::cout << "S2K3 SHA1 count " << (int) count << ": " << ms(start, Clock::now()) << " ms" << std::endl;
+    }
+}
+
+static const std::map <std::string, std::function <void()> > BENCHMARKS = {
+    std::make_pair("argon2",            argon2),
+    std::make_pair("crc24",             crc24),
+    std::make_pair("ecdsa",             ecdsa),
+    std::make_pair("ed25519",           ed25519),
+    std::make_pair("keyring",           keyring),
+    std::make_pair("modexp",            modexp),
+    std::make_pair("prime",             prime),
+    std::make_pair("radix64",           radix64),
+    std::make_pair("rng",               rng),
+    std::make_pair("rsa_batch_verify",  rsa_batch_verify),
+    std::make_pair("rsa_crt",           rsa_crt),
+    std::make_pair("s2k",               s2k),
+    std::make_pair("serialize",         serialize),
+};
+
+int main(int argc, char * argv[]){
+    std::vector <std::string> names;
+    for(int i = 1; i < argc; i++){
+        names.push_back(argv[i]);
+    }
+    if (!names.size()){
+        for(std::pair <const std::string, std::function <void()> > const & b : BENCHMARKS){
+            names.push_back(b.first);
+        }
+    }
+
+    for(std::string const & name : names){
+        std::map <std::string, std::function <void()> >::const_iterator it = BENCHMARKS.find(name);
+        if (it == BENCHMARKS.end()){
+            std::cerr << "Error: Unknown benchmark: " << name << std::endl;
+            return 1;
+        }
+
+        std::cout << "[" << name << "]" << std::endl;
+        it -> second();
+    }
+
+    return 0;
+}
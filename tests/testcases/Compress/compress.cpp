@@ -22,3 +22,15 @@ TEST(Compress, bzip2) {
     EXPECT_EQ(decompressed, MESSAGE);
 }
 
+
+TEST(Compress, compressor) {
+    for(uint8_t const alg : {OpenPGP::Compression::ID::UNCOMPRESSED, OpenPGP::Compression::ID::ZIP, OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::ID::BZIP2}){
+        OpenPGP::Compression::Compressor compressor(alg);
+        std::string compressed;
+        for(std::string::size_type i = 0; i < MESSAGE.size(); i += 100){
+            compressed += compressor.update(MESSAGE.substr(i, 100));
+        }
+        compressed += compressor.finish();
+        EXPECT_EQ(OpenPGP::Compression::decompress(alg, compressed), MESSAGE);
+    }
+}
@@ -13,3 +13,18 @@ TEST(SHA1, short_msg) {
         EXPECT_EQ(sha1.hexdigest(), SHA1_SHORT_MSG_HEXDIGEST[i]);
     }
 }
+
+TEST(SHA1, pieces) {
+
+    std::string data;
+    for ( unsigned int i = 0; i < 1000; ++i ) {
+        data += static_cast <char> (i * 7);
+    }
+
+    // octets fed in uneven pieces, straddling block boundaries
+    auto sha1 = SHA1();
+    for ( std::size_t i = 0, len = 1; i < data.size(); i += len, len = len * 3 + 1 ) {
+        sha1.update(data.data() + i, std::min(len, data.size() - i));
+    }
+    EXPECT_EQ(sha1.hexdigest(), SHA1(data).hexdigest());
+}
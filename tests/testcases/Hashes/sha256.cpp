@@ -14,3 +14,18 @@ TEST(SHA256, short_msg) {
     }
 }
 
+
+TEST(SHA256, pieces) {
+
+    std::string data;
+    for ( unsigned int i = 0; i < 1000; ++i ) {
+        data += static_cast <char> (i * 7);
+    }
+
+    // octets fed in uneven pieces, straddling block boundaries
+    auto sha256 = SHA256();
+    for ( std::size_t i = 0, len = 1; i < data.size(); i += len, len = len * 3 + 1 ) {
+        sha256.update(data.data() + i, std::min(len, data.size() - i));
+    }
+    EXPECT_EQ(sha256.hexdigest(), SHA256(data).hexdigest());
+}
@@ -15,3 +15,18 @@ TEST(SHA512, short_msg) {
 }
 
 
+
+TEST(SHA512, pieces) {
+
+    std::string data;
+    for ( unsigned int i = 0; i < 1000; ++i ) {
+        data += static_cast <char> (i * 7);
+    }
+
+    // octets fed in uneven pieces, straddling block boundaries
+    auto sha512 = SHA512();
+    for ( std::size_t i = 0, len = 1; i < data.size(); i += len, len = len * 3 + 1 ) {
+        sha512.update(data.data() + i, std::min(len, data.size() - i));
+    }
+    EXPECT_EQ(sha512.hexdigest(), SHA512(data).hexdigest());
+}
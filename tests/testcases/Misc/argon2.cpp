@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "Misc/argon2.h"
+#include "Misc/s2k.h"
+
+TEST(Argon2, blake2b) {
+    // RFC 7693 appendix A
+    EXPECT_EQ(hexlify(OpenPGP::Argon2::blake2b("abc")), "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+    EXPECT_EQ(hexlify(OpenPGP::Argon2::blake2b("")), "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419d25e1031afee585313896444934eb04b903a685b1448b755d56f701afe9be2ce");
+
+    // input that ends on a block boundary
+    EXPECT_NE(OpenPGP::Argon2::blake2b(std::string(128, 0)), OpenPGP::Argon2::blake2b(std::string(129, 0)));
+    EXPECT_EQ(OpenPGP::Argon2::blake2b("abc", 32).size(), (std::size_t) 32);
+    EXPECT_THROW(OpenPGP::Argon2::blake2b("abc", 65), std::runtime_error);
+}
+
+TEST(Argon2, argon2id) {
+    // RFC 9106 sec 5.3
+    EXPECT_EQ(hexlify(OpenPGP::Argon2::argon2id(std::string(32, 1), std::string(16, 2), 3, 32, 4, 32, std::string(8, 3), std::string(12, 4))),
+              "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+
+    // one lane is filled without any threads
+    const std::string salt(16, 's');
+    EXPECT_EQ(OpenPGP::Argon2::argon2id("password", salt, 2, 64, 1, 16), OpenPGP::Argon2::argon2id("password", salt, 2, 64, 1, 16));
+    EXPECT_NE(OpenPGP::Argon2::argon2id("password", salt, 2, 64, 1, 16), OpenPGP::Argon2::argon2id("password", salt, 2, 64, 2, 16));
+
+    EXPECT_THROW(OpenPGP::Argon2::argon2id("password", salt, 0, 64, 1, 16), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Argon2::argon2id("password", salt, 1, 31, 4, 16), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Argon2::argon2id("password", "short", 1, 64, 1, 16), std::runtime_error);
+
+    // lanes can share a pool
+    ThreadPool pool(2);
+    EXPECT_EQ(OpenPGP::Argon2::argon2id("password", salt, 2, 64, 4, 16, "", "", &pool), OpenPGP::Argon2::argon2id("password", salt, 2, 64, 4, 16));
+}
+
+TEST(Argon2, limits) {
+    EXPECT_EQ(OpenPGP::Argon2::get_max_memory(), OpenPGP::Argon2::DEFAULT_MAX_MEMORY);
+    EXPECT_EQ(OpenPGP::Argon2::get_max_lanes(), OpenPGP::Argon2::DEFAULT_MAX_LANES);
+
+    // parameters from a packet that are too large are refused before allocating
+    OpenPGP::S2K::S2K4 s2k;
+    s2k.set_salt(std::string(16, 2));
+    s2k.set_passes(1);
+    s2k.set_parallelism(1);
+    s2k.set_memory(31);
+    EXPECT_THROW(s2k.run("passphrase", 32), std::runtime_error);
+    s2k.set_memory(8);
+    s2k.set_parallelism(255);
+    EXPECT_THROW(s2k.run("passphrase", 32), std::runtime_error);
+
+    OpenPGP::Argon2::set_limits(128, 2);
+    const std::string salt(16, 's');
+    EXPECT_EQ(OpenPGP::Argon2::argon2id("password", salt, 1, 128, 2, 16).size(), (std::size_t) 16);
+    EXPECT_THROW(OpenPGP::Argon2::argon2id("password", salt, 1, 256, 2, 16), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Argon2::argon2id("password", salt, 1, 128, 4, 16), std::runtime_error);
+    OpenPGP::Argon2::set_limits(OpenPGP::Argon2::DEFAULT_MAX_MEMORY, OpenPGP::Argon2::DEFAULT_MAX_LANES);
+}
+
+TEST(Argon2, s2k) {
+    OpenPGP::S2K::S2K4 s2k;
+    s2k.set_salt(std::string(16, 2));
+    s2k.set_passes(3);
+    s2k.set_parallelism(4);
+    s2k.set_memory(5);
+    EXPECT_EQ(s2k.get_type(), OpenPGP::S2K::ID::ARGON2);
+
+    const std::string raw = s2k.write();
+    EXPECT_EQ(raw, "\x04" + std::string(16, 2) + "\x03\x04\x05");
+
+    OpenPGP::S2K::S2K4 copy;
+    std::string::size_type pos = 0;
+    copy.read(raw, pos);
+    EXPECT_EQ(pos, raw.size());
+    EXPECT_EQ(copy.write(), raw);
+
+    const std::string key = s2k.run("passphrase", 32);
+    EXPECT_EQ(key, OpenPGP::Argon2::argon2id("passphrase", std::string(16, 2), 3, 32, 4, 32));
+    EXPECT_EQ(copy.run("passphrase", 32), key);
+
+    // 4 lanes need at least 2^5 KiB
+    s2k.set_memory(4);
+    EXPECT_THROW(s2k.run("passphrase", 32), std::runtime_error);
+    s2k.set_memory(32);
+    EXPECT_THROW(s2k.run("passphrase", 32), std::runtime_error);
+    EXPECT_THROW(s2k.set_salt(std::string(8, 2)), std::runtime_error);
+}
@@ -0,0 +1,55 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Misc/CRC-24.h"
+
+// the bit at a time implementation from RFC 4880 sec 6.1
+static uint32_t reference(const std::string & str){
+    uint32_t crc = OpenPGP::CRC24_INIT;
+    for(unsigned char const c : str){
+        crc ^= static_cast <uint32_t> (c) << 16;
+        for(uint8_t i = 0; i < 8; i++){
+            crc <<= 1;
+            if (crc & 0x1000000){
+                crc ^= 0x1864CFB;
+            }
+        }
+    }
+    return crc & 0xFFFFFF;
+}
+
+TEST(CRC24, known){
+    EXPECT_EQ(OpenPGP::crc24(""), OpenPGP::CRC24_INIT);
+    EXPECT_EQ(OpenPGP::crc24("123456789"), (uint32_t) 0x21CF02);
+}
+
+TEST(CRC24, reference){
+    std::mt19937 gen(24);
+    std::uniform_int_distribution <int> octet(0, 255);
+
+    // lengths around the 8 octet slices and the 16 octet folds
+    for(std::size_t len = 0; len < 300; len++){
+        std::string data(len, 0);
+        for(char & c : data){
+            c = octet(gen);
+        }
+        ASSERT_EQ(OpenPGP::crc24(data), reference(data)) << len;
+    }
+
+    std::string data(100000, 0);
+    for(char & c : data){
+        c = octet(gen);
+    }
+    const uint32_t expected = reference(data);
+    EXPECT_EQ(OpenPGP::crc24(data), expected);
+
+    // the checksum does not depend on how the input is split
+    for(const std::size_t step : {(std::size_t) 1, (std::size_t) 7, (std::size_t) 63, (std::size_t) 64, (std::size_t) 1000, (std::size_t) 4099}){
+        uint32_t crc = OpenPGP::CRC24_INIT;
+        for(std::size_t i = 0; i < data.size(); i += step){
+            crc = OpenPGP::crc24_update(crc, data.data() + i, std::min(step, data.size() - i));
+        }
+        EXPECT_EQ(crc, expected) << step;
+    }
+}
@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include "Misc/keywrap.h"
+
+// RFC 3394 sec 4
+TEST(KeyWrap, testvectors) {
+    const std::string kek128 = unhexlify("000102030405060708090A0B0C0D0E0F");
+    const std::string kek256 = unhexlify("000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F");
+    const std::string data128 = unhexlify("00112233445566778899AABBCCDDEEFF");
+    const std::string data256 = unhexlify("00112233445566778899AABBCCDDEEFF000102030405060708090A0B0C0D0E0F");
+
+    const std::string wrapped_4_1 = unhexlify("1FA68B0A8112B447AEF34BD8FB5A7B829D3E862371D2CFE5");
+    const std::string wrapped_4_6 = unhexlify("28C9F404C4B810F4CBCCB35CFB87F8263F5786E2D80ED326CBC7F0E71A99F43BFB988B9B7A02DD21");
+
+    EXPECT_EQ(OpenPGP::use_key_wrap(OpenPGP::Sym::ID::AES128, data128, kek128), wrapped_4_1);
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES128, wrapped_4_1, kek128), data128);
+    EXPECT_EQ(OpenPGP::use_key_wrap(OpenPGP::Sym::ID::AES256, data256, kek256), wrapped_4_6);
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES256, wrapped_4_6, kek256), data256);
+
+    std::string bad = wrapped_4_1;
+    bad[10] ^= 1;
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES128, bad, kek128), "");
+    EXPECT_EQ(OpenPGP::use_key_unwrap(OpenPGP::Sym::ID::AES128, wrapped_4_1.substr(1), kek128), "");
+
+    EXPECT_THROW(OpenPGP::use_key_wrap(OpenPGP::Sym::ID::AES128, data128.substr(1), kek128), std::runtime_error);
+    EXPECT_THROW(OpenPGP::use_key_wrap(OpenPGP::Sym::ID::CAST5, data128, kek128), std::runtime_error);
+}
@@ -45,3 +45,120 @@ TEST(MPI, rshift){
         EXPECT_EQ(d-b, 0);
     }
 }
+
+TEST(MPI, powm_public){
+    const OpenPGP::MPI m = OpenPGP::random(512) | 1;
+    for (int i = 0; i < COUNT; ++i){
+        const OpenPGP::MPI a = OpenPGP::random(512), x = OpenPGP::random(160 + i);
+        const OpenPGP::MPI b = OpenPGP::random(512), y = OpenPGP::random(161);
+        EXPECT_EQ(OpenPGP::powm_public(a, x, m), OpenPGP::powm(a, x, m));
+        EXPECT_EQ(OpenPGP::powm2_public(a, x, b, y, m), (OpenPGP::powm(a, x, m) * OpenPGP::powm(b, y, m)) % m);
+    }
+    EXPECT_EQ(OpenPGP::powm2_public(5, 0, 7, 0, m), 1);
+}
+
+TEST(MPI, raw){
+    EXPECT_EQ(OpenPGP::mpitoraw(0), std::string(1, 0));
+    EXPECT_EQ(OpenPGP::mpitoraw(0x0102), "\x01\x02");
+    EXPECT_EQ(OpenPGP::rawtompi(""), 0);
+    EXPECT_EQ(OpenPGP::rawtompi(std::string("\x00\x00\x01\x02", 4)), 0x0102);
+
+    EXPECT_EQ(OpenPGP::bitsize(0), (std::size_t) 1);
+    EXPECT_EQ(OpenPGP::bitsize(1), (std::size_t) 1);
+    EXPECT_EQ(OpenPGP::bitsize(0x100), (std::size_t) 9);
+    EXPECT_EQ(OpenPGP::rawsize(0x100), (std::size_t) 2);
+
+    const OpenPGP::MPI r = OpenPGP::random(512);
+    for (int i = 0; i < COUNT; ++i){
+        const OpenPGP::MPI a = (r << (3584 - i)) + i;
+        const std::string raw = OpenPGP::mpitoraw(a);
+        EXPECT_EQ(raw, unhexlify(OpenPGP::mpitohex(a)));
+        EXPECT_EQ(OpenPGP::rawtompi(raw), a);
+        EXPECT_EQ(OpenPGP::bitsize(a), OpenPGP::mpitobin(a).size());
+    }
+}
+
+TEST(MPI, read_write){
+    // RFC 4880 sec 3.2 examples
+    EXPECT_EQ(OpenPGP::write_MPI(1), std::string("\x00\x01\x01", 3));
+    EXPECT_EQ(OpenPGP::write_MPI(511), std::string("\x00\x09\x01\xff", 4));
+
+    std::string data;
+    std::vector <OpenPGP::MPI> values = {0, 1, 511};
+    for (int i = 0; i < COUNT; ++i){
+        values.push_back((OpenPGP::MPI(0xa5) << (2048 + i)) - i);
+    }
+    for(OpenPGP::MPI const & a : values){
+        const std::string mpi = OpenPGP::write_MPI(a);
+        EXPECT_EQ(mpi.size(), OpenPGP::MPI_size(a));
+        data += mpi;
+    }
+
+    std::string::size_type pos = 0;
+    for(OpenPGP::MPI const & a : values){
+        EXPECT_EQ(OpenPGP::read_MPI(data, pos), a);
+    }
+    EXPECT_EQ(pos, data.size());
+
+    // the largest length does not wrap around
+    pos = 0;
+    EXPECT_EQ(OpenPGP::read_MPI(std::string("\xff\xff", 2) + std::string(8192, '\x01'), pos), OpenPGP::rawtompi(std::string(8192, '\x01')));
+    EXPECT_EQ(pos, (std::string::size_type) 8194);
+
+    // truncated lengths and values are rejected
+    pos = 0;
+    EXPECT_THROW(OpenPGP::read_MPI(std::string("\x01", 1), pos), std::out_of_range);
+    pos = 0;
+    EXPECT_THROW(OpenPGP::read_MPI(std::string("\x00\x11\x01\x02", 4), pos), std::out_of_range);
+    pos = data.size();
+    EXPECT_THROW(OpenPGP::read_MPI(data, pos), std::out_of_range);
+}
+
+TEST(MPI, slices){
+    const std::vector <OpenPGP::MPI> values = {0, 1, 511, OpenPGP::MPI(0xa5) << 2048};
+    std::string data = "header";
+    for(OpenPGP::MPI const & a : values){
+        data += OpenPGP::write_MPI(a);
+    }
+    data += "trailer";
+
+    std::string::size_type pos = 6;
+    OpenPGP::MPISlices slices;
+    slices.read(data, pos, values.size());
+    EXPECT_EQ(data.substr(pos), "trailer");
+    EXPECT_EQ(slices.size(), values.size());
+
+    // truncated lengths and values are rejected
+    std::string::size_type bad = 6;
+    EXPECT_THROW(OpenPGP::MPISlices().read(data, bad, values.size() + 1), std::out_of_range);
+    bad = 6;
+    EXPECT_THROW(OpenPGP::MPISlices().read(data.substr(0, data.size() - 8), bad, values.size()), std::out_of_range);
+
+    // nothing has to be converted to look at or write the values
+    for(std::size_t i = 0; i < values.size(); i++){
+        EXPECT_EQ(slices.bitsize(i), OpenPGP::bitsize(values[i]));
+        EXPECT_EQ(slices.hex(i), OpenPGP::mpitohex(values[i]));
+    }
+    ByteWriter out;
+    slices.write(out);
+    EXPECT_EQ(out.str(), data.substr(6, data.size() - 6 - 7));
+    EXPECT_EQ(slices.write_size(), out.size());
+
+    EXPECT_EQ(slices.get(), values);
+    EXPECT_EQ(&slices.get(), &slices.get());
+    EXPECT_EQ(slices[3], values[3]);
+
+    // copies share the conversion
+    const OpenPGP::MPISlices copy = slices;
+    EXPECT_EQ(&copy.get(), &slices.get());
+
+    // values that were not read are written normally
+    const OpenPGP::MPISlices set(values);
+    ByteWriter set_out;
+    set.write(set_out);
+    EXPECT_EQ(set_out.str(), out.str());
+    EXPECT_EQ(set.write_size(), out.size());
+    EXPECT_EQ(set.bitsize(2), (std::size_t) 9);
+
+    EXPECT_TRUE(OpenPGP::MPISlices().empty());
+}
@@ -1,2 +1,6 @@
-MISC_TESTCASES_OBJECTS=mpi.o         \
-                       radix64.o
\ No newline at end of file
+MISC_TESTCASES_OBJECTS=argon2.o      \
+                       crc24.o       \
+                       keywrap.o     \
+                       mpi.o         \
+                       radix64.o     \
+                       s2k.o
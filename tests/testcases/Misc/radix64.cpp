@@ -1,3 +1,5 @@
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include "Misc/radix64.h"
@@ -23,3 +25,64 @@ TEST(Radix64, rfc4648_base64_test_vectors){
     EXPECT_EQ(OpenPGP::radix642ascii("Zm9vYmFy"), "foobar");
 
 }
+
+// one sextet at a time, as described in RFC 4880 sec 6.3
+static std::string encode_slowly(const std::string & data, const char char62, const char char63){
+    const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789" + std::string(1, char62) + std::string(1, char63);
+    std::string out;
+    for(std::size_t i = 0; i < data.size(); i += 3){
+        uint32_t group = 0;
+        for(std::size_t j = 0; j < 3; j++){
+            group = (group << 8) | (((i + j) < data.size())?static_cast <uint8_t> (data[i + j]):0);
+        }
+        for(std::size_t j = 0; j < 4; j++){
+            out += ((i + j) <= data.size())?alphabet[(group >> (18 - 6 * j)) & 63]:'=';
+        }
+    }
+    return out;
+}
+
+TEST(Radix64, round_trip){
+    std::mt19937 gen(64);
+    for(std::size_t len = 0; len < 300; len++){
+        std::string data(len, 0);
+        for(char & c : data){
+            c = gen();
+        }
+
+        // the default alphabet and a URL safe one
+        for(const std::pair <char, char> & chars : {std::make_pair('+', '/'), std::make_pair('-', '_')}){
+            const std::string encoded = OpenPGP::ascii2radix64(data, chars.first, chars.second);
+            ASSERT_EQ(encoded, encode_slowly(data, chars.first, chars.second));
+            ASSERT_EQ(OpenPGP::radix642ascii(encoded, chars.first, chars.second), data);
+
+            // white space is skipped
+            std::string lines;
+            for(std::size_t i = 0; i < encoded.size(); i += OpenPGP::MAX_LINE_LENGTH){
+                lines += encoded.substr(i, OpenPGP::MAX_LINE_LENGTH) + ((i & 1)?"\r\n":" \n");
+            }
+            ASSERT_EQ(OpenPGP::radix642ascii(lines, chars.first, chars.second), data);
+        }
+    }
+}
+
+TEST(Radix64, bad_input){
+    const std::string encoded = OpenPGP::ascii2radix64(std::string(200, '\x5a'));
+    for(unsigned int c = 0; c < 256; c++){
+        if (isalnum(c) || (c == '+') || (c == '/') || isspace(c)){
+            continue;
+        }
+
+        // inside and after the parts decoded many characters at a time
+        for(const std::size_t pos : {(std::size_t) 3, (std::size_t) 40, (std::size_t) 100, encoded.size() - 6}){
+            std::string bad = encoded;
+            bad[pos] = c;
+            EXPECT_THROW(OpenPGP::radix642ascii(bad), std::runtime_error);
+        }
+    }
+
+    EXPECT_THROW(OpenPGP::radix642ascii("Zm9"), std::runtime_error);
+    EXPECT_THROW(OpenPGP::radix642ascii("Z==="), std::runtime_error);
+    EXPECT_THROW(OpenPGP::radix642ascii("Zg==Zg=="), std::runtime_error);
+    EXPECT_EQ(OpenPGP::radix642ascii("Zg=\n="), "f");
+}
@@ -0,0 +1,146 @@
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "Misc/s2k.h"
+#include "Misc/s2kcache.h"
+
+// RFC 4880 sec 3.7.1.3, written out the long way
+static std::string iterated(const uint8_t hash, const std::string & salt, const std::string & pass, const std::size_t count, const std::size_t key_len){
+    std::string to_hash = salt + pass;
+    while (to_hash.size() < count){
+        to_hash += salt + pass;
+    }
+    to_hash = to_hash.substr(0, std::max(count, (salt + pass).size()));
+
+    std::string out;
+    for(std::size_t i = 0; out.size() < key_len; i++){
+        out += OpenPGP::Hash::use(hash, std::string(i, 0) + to_hash);
+    }
+    return out.substr(0, key_len);
+}
+
+TEST(S2K, iterated_and_salted) {
+    const std::string salt = unhexlify("0123456789abcdef");
+
+    OpenPGP::S2K::S2K3 s2k;
+    s2k.set_salt(salt);
+
+    // the count field decodes to (16 + low nibble) << (high nibble + 6)
+    const std::vector <std::pair <uint8_t, std::size_t> > counts = {
+        std::make_pair(0x00, 1024),
+        std::make_pair(0x60, 65536),
+        std::make_pair(0x61, 69632),
+    };
+
+    for(uint8_t const hash : {OpenPGP::Hash::ID::SHA1, OpenPGP::Hash::ID::SHA256, OpenPGP::Hash::ID::SHA512}){
+        s2k.set_hash(hash);
+        for(std::pair <uint8_t, std::size_t> const & count : counts){
+            s2k.set_count(count.first);
+
+            // one, two and three output blocks
+            for(unsigned int const key_len : {16, 32, 48}){
+                // passphrases that divide the chunk size evenly and unevenly,
+                // and one that is longer than the count
+                for(std::string const & pass : {std::string(""), std::string("abc"), std::string(56, 'p'), std::string(70000, 'q')}){
+                    EXPECT_EQ(s2k.run(pass, key_len), iterated(hash, salt, pass, count.second, key_len));
+                }
+            }
+        }
+    }
+}
+
+TEST(S2K, write) {
+    OpenPGP::S2K::S2K0 simple;
+    simple.set_hash(OpenPGP::Hash::ID::SHA256);
+    EXPECT_EQ(simple.write(), std::string(1, 0) + std::string(1, OpenPGP::Hash::ID::SHA256));
+
+    OpenPGP::S2K::S2K1 salted;
+    salted.set_hash(OpenPGP::Hash::ID::SHA1);
+    salted.set_salt(unhexlify("0123456789abcdef"));
+    EXPECT_EQ(salted.write(), unhexlify("01020123456789abcdef"));
+
+    OpenPGP::S2K::S2K3 iterated;
+    iterated.set_hash(OpenPGP::Hash::ID::SHA1);
+    iterated.set_salt(unhexlify("0123456789abcdef"));
+    iterated.set_count(0x60);
+    EXPECT_EQ(iterated.write(), unhexlify("03020123456789abcdef60"));
+
+    OpenPGP::S2K::S2K4 argon2;
+    argon2.set_salt(std::string(OpenPGP::S2K::S2K4::SALT_SIZE, 's'));
+    EXPECT_EQ(argon2.write().size(), 4 + OpenPGP::S2K::S2K4::SALT_SIZE);
+
+    for(OpenPGP::S2K::S2K const * s2k : std::vector <OpenPGP::S2K::S2K const *> ({&simple, &salted, &iterated, &argon2})){
+        EXPECT_EQ(s2k -> serialized_size(), s2k -> write().size());
+
+        // reading the written specifier back gives the same octets
+        const std::string written = s2k -> write();
+        OpenPGP::S2K::S2K::Ptr copy = s2k -> clone();
+        std::string::size_type pos = 0;
+        copy -> read(written, pos);
+        EXPECT_EQ(pos, written.size());
+        EXPECT_EQ(copy -> write(), written);
+    }
+}
+
+TEST(S2K, calibrate) {
+    // short targets are clamped to the default count
+    EXPECT_EQ(OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA256, std::chrono::milliseconds(0)), (uint8_t) OpenPGP::S2K::S2K3::DEFAULT_COUNT);
+
+    const std::chrono::milliseconds target(100);
+    const uint8_t count = OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA256, target);
+    EXPECT_EQ(OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA256, target), count);
+    EXPECT_GE(OpenPGP::S2K::S2K3::calibrate(OpenPGP::Hash::ID::SHA256, target * 4), count);
+
+    // loosely, since the machine may be busy
+    OpenPGP::S2K::S2K3 s2k;
+    s2k.set_hash(OpenPGP::Hash::ID::SHA256);
+    s2k.set_salt(std::string(8, 0));
+    s2k.set_count(count);
+    const auto start = std::chrono::steady_clock::now();
+    s2k.run("passphrase", 32);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GT(elapsed, target / 8);
+    EXPECT_LT(elapsed, target * 8);
+}
+
+TEST(S2K, cache) {
+    const std::string fingerprint(20, 'f');
+    const std::string params = "\x09\x03\x02" + std::string(8, 's') + "\x60";
+    const std::string key(32, 'k');
+    std::string out;
+
+    // nothing is kept until the cache is enabled
+    OpenPGP::S2K::Cache::put(fingerprint, params, "pass", key);
+    EXPECT_EQ(OpenPGP::S2K::Cache::get(fingerprint, params, "pass", out), false);
+
+    OpenPGP::S2K::Cache::enable(std::chrono::seconds(60));
+    EXPECT_EQ(OpenPGP::S2K::Cache::enabled(), true);
+    OpenPGP::S2K::Cache::put(fingerprint, params, "pass", key);
+    ASSERT_EQ(OpenPGP::S2K::Cache::get(fingerprint, params, "pass", out), true);
+    EXPECT_EQ(out, key);
+
+    // every part of the lookup has to match
+    EXPECT_EQ(OpenPGP::S2K::Cache::get(std::string(20, 'e'), params, "pass", out), false);
+    EXPECT_EQ(OpenPGP::S2K::Cache::get(fingerprint, params + "x", "pass", out), false);
+    EXPECT_EQ(OpenPGP::S2K::Cache::get(fingerprint, params, "Pass", out), false);
+
+    OpenPGP::S2K::Cache::put(fingerprint, params, "other", key);
+    OpenPGP::S2K::Cache::put(std::string(20, 'e'), params, "pass", key);
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 3);
+    OpenPGP::S2K::Cache::evict(fingerprint);
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 1);
+    OpenPGP::S2K::Cache::clear();
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 0);
+
+    // entries do not outlive their time to live
+    OpenPGP::S2K::Cache::enable(std::chrono::seconds(0));
+    OpenPGP::S2K::Cache::put(fingerprint, params, "pass", key);
+    EXPECT_EQ(OpenPGP::S2K::Cache::get(fingerprint, params, "pass", out), false);
+
+    OpenPGP::S2K::Cache::enable(std::chrono::seconds(60));
+    OpenPGP::S2K::Cache::put(fingerprint, params, "pass", key);
+    OpenPGP::S2K::Cache::disable();
+    EXPECT_EQ(OpenPGP::S2K::Cache::enabled(), false);
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 0);
+}
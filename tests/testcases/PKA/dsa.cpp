@@ -34,3 +34,67 @@ TEST(DSA, dsa_siggen) {
         EXPECT_EQ(OpenPGP::Verify::with_pka(digest, OpenPGP::Hash::ID::SHA1, PKA_DSA, {p, q, g, y}, new_sig), true);
     }
 }
+
+TEST(DSA, fixed_base_context) {
+    auto p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    auto q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    auto g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    auto y = OpenPGP::hextompi(DSA_SIGGEN_Y[0]);
+    auto x = OpenPGP::hextompi(DSA_SIGGEN_X[0]);
+    const OpenPGP::PKA::Values pub = {p, q, g, y};
+
+    const OpenPGP::PKA::ModExpContext::Ptr context = OpenPGP::PKA::modexp_context(PKA_DSA, pub);
+    ASSERT_NE(context, nullptr);
+
+    // enough uses to go through both the plain and the table paths
+    for ( unsigned int i = 0; i < DSA_SIGGEN_MSG.size(); ++i ) {
+        auto digest = SHA1(unhexlify(DSA_SIGGEN_MSG[i])).digest();
+        auto k = OpenPGP::hextompi(DSA_SIGGEN_K[i]);
+        auto sig = OpenPGP::PKA::DSA::sign(digest, {x}, pub, k);
+        EXPECT_EQ(OpenPGP::PKA::DSA::sign(digest, {x}, pub, context, k), sig);
+        EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub, context));
+        EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, pub));
+        EXPECT_FALSE(OpenPGP::PKA::DSA::verify(digest, {sig[0], sig[1] + 1}, pub, context));
+    }
+    EXPECT_TRUE(context -> has_table(0));
+    EXPECT_TRUE(context -> has_table(1));
+
+    // a context for another key is ignored
+    auto digest = SHA1(unhexlify(DSA_SIGGEN_MSG[1])).digest();
+    const OpenPGP::PKA::Values other = {p, q, g, OpenPGP::hextompi(DSA_SIGGEN_Y[1])};
+    auto sig = OpenPGP::PKA::DSA::sign(digest, {OpenPGP::hextompi(DSA_SIGGEN_X[1])}, other, context);
+    EXPECT_TRUE(OpenPGP::PKA::DSA::verify(digest, sig, other, context));
+}
+
+TEST(DSA, batch_verify) {
+    auto p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    auto q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    auto g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    auto y = OpenPGP::hextompi(DSA_SIGGEN_Y[0]);
+    auto x = OpenPGP::hextompi(DSA_SIGGEN_X[0]);
+
+    OpenPGP::Packet::Key::Ptr signer = std::make_shared <OpenPGP::Packet::Tag6> ();
+    signer -> set_pka(PKA_DSA);
+    signer -> set_mpi({p, q, g, y});
+
+    std::vector <OpenPGP::Verify::Batch> batch;
+    for ( unsigned int i = 0; i < DSA_SIGGEN_MSG.size(); ++i ) {
+        auto digest = SHA1(unhexlify(DSA_SIGGEN_MSG[i])).digest();
+        OpenPGP::Packet::Tag2::Ptr sig = std::make_shared <OpenPGP::Packet::Tag2> ();
+        sig -> set_pka(PKA_DSA);
+        sig -> set_hash(OpenPGP::Hash::ID::SHA1);
+        sig -> set_mpi(OpenPGP::Sign::with_pka(digest, PKA_DSA, {x}, signer -> get_mpi(), OpenPGP::Hash::ID::SHA1));
+        batch.push_back({(i % 2)?digest:digest + "!", signer, sig});
+    }
+
+    const std::vector <int> results = OpenPGP::Verify::with_pka(batch, 2);
+    ASSERT_EQ(results.size(), batch.size());
+    for ( unsigned int i = 0; i < batch.size(); ++i ) {
+        EXPECT_EQ(results[i], (i % 2)?1:0);
+    }
+
+    // every signature went through the context of the key, which now has its tables
+    const OpenPGP::PKA::ModExpContext::Ptr context = signer -> get_modexp();
+    EXPECT_TRUE(context -> has_table(0));
+    EXPECT_TRUE(context -> has_table(1));
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "PKA/ECDH.h"
+#include "PKA/PKAs.h"
+
+// RFC 7748 sec 6.1
+static const std::string X25519_ALICE_SECRET = "77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a";
+static const std::string X25519_ALICE_PUBLIC = "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a";
+static const std::string X25519_BOB_SECRET   = "5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb";
+static const std::string X25519_BOB_PUBLIC   = "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f";
+static const std::string X25519_SHARED       = "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742";
+
+// RFC 6979 sec A.2.5 key
+static const std::string P256_SECRET = "c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721";
+static const std::string P256_PUBLIC = "0460fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb67903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299";
+
+// generated with OpenSSL
+static const std::string P256_ECDH_SECRET = "8bf3d02e93f91fe6e720b6bf39451ba90b46527e67be0785cd662d61909ec9e6";
+static const std::string P256_ECDH_PEER   = "04f5bf74f1c396f437ba40a48f5c135e452f4abd1e5094128b801fbb1c7187d411f186f2f611017db562a87c1092b76e0682de7ef28d84fb0dc116b68574025a13";
+static const std::string P256_ECDH_SHARED = "91e502a3c6456bf00378aa6a8345375843221665e1d1b9fd7aa5a79ab7404131";
+
+TEST(X25519, testvectors) {
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::public_key(unhexlify(X25519_ALICE_SECRET))), X25519_ALICE_PUBLIC);
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::public_key(unhexlify(X25519_BOB_SECRET))), X25519_BOB_PUBLIC);
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::shared_secret(unhexlify(X25519_ALICE_SECRET), unhexlify(X25519_BOB_PUBLIC))), X25519_SHARED);
+    EXPECT_EQ(hexlify(OpenPGP::PKA::X25519::shared_secret(unhexlify(X25519_BOB_SECRET), unhexlify(X25519_ALICE_PUBLIC))), X25519_SHARED);
+
+    // the point of order 1 gives an all zero result
+    EXPECT_EQ(OpenPGP::PKA::X25519::shared_secret(unhexlify(X25519_ALICE_SECRET), std::string(32, 0)), "");
+    EXPECT_THROW(OpenPGP::PKA::X25519::public_key("short"), std::runtime_error);
+}
+
+TEST(ECC, p256) {
+    const uint8_t curve = OpenPGP::PKA::ECC::ID::P256;
+    EXPECT_EQ(hexlify(OpenPGP::PKA::ECC::public_key(curve, unhexlify(P256_SECRET))), P256_PUBLIC);
+    EXPECT_EQ(hexlify(OpenPGP::PKA::ECC::shared_secret(curve, unhexlify(P256_ECDH_SECRET), unhexlify(P256_ECDH_PEER))), P256_ECDH_SHARED);
+
+    // 1 * G
+    EXPECT_EQ(hexlify(OpenPGP::PKA::ECC::public_key(curve, std::string(1, 1))),
+              "046b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c2964fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5");
+
+    // scalars out of range
+    EXPECT_EQ(OpenPGP::PKA::ECC::public_key(curve, std::string(32, 0)), "");
+    EXPECT_EQ(OpenPGP::PKA::ECC::public_key(curve, std::string(32, '\xff')), "");
+
+    // points not on the curve
+    std::string bad = unhexlify(P256_ECDH_PEER);
+    bad[64] ^= 1;
+    EXPECT_EQ(OpenPGP::PKA::ECC::shared_secret(curve, unhexlify(P256_ECDH_SECRET), bad), "");
+    EXPECT_EQ(OpenPGP::PKA::ECC::shared_secret(curve, unhexlify(P256_ECDH_SECRET), bad.substr(1)), "");
+
+    EXPECT_THROW(OpenPGP::PKA::ECC::size(0), std::runtime_error);
+}
+
+TEST(ECDH, roundtrip) {
+    const std::string session = std::string(1, OpenPGP::Sym::ID::AES256) + std::string(32, 'k') + "\x0d\x60";
+
+    for(std::string const & oid : {OpenPGP::PKA::CURVE_OID::CURVE_255, OpenPGP::PKA::CURVE_OID::NIST_256}){
+        const std::string curve = unhexlify(oid);
+        ASSERT_TRUE(OpenPGP::PKA::ECDH::supported(curve));
+
+        OpenPGP::PKA::Values pub;
+        const OpenPGP::PKA::Values pri = OpenPGP::PKA::ECDH::keygen(pub, curve);
+        ASSERT_EQ(pri.size(), (std::size_t) 1);
+        ASSERT_EQ(pub.size(), (std::size_t) 1);
+
+        const OpenPGP::PKA::ECDH::KDF kdf = {curve, OpenPGP::Hash::ID::SHA256, OpenPGP::Sym::ID::AES128, std::string(20, 'f')};
+
+        std::string wrapped;
+        const OpenPGP::PKA::Values ephemeral = OpenPGP::PKA::ECDH::encrypt(session, pub, kdf, wrapped);
+        ASSERT_EQ(ephemeral.size(), (std::size_t) 1);
+        EXPECT_EQ(wrapped.size(), (std::size_t) 48);
+        EXPECT_EQ(OpenPGP::PKA::ECDH::decrypt(ephemeral, wrapped, pri, kdf), session);
+
+        // the KDF binds the recipient fingerprint
+        OpenPGP::PKA::ECDH::KDF other = kdf;
+        other.fingerprint[0] = 'g';
+        EXPECT_EQ(OpenPGP::PKA::ECDH::decrypt(ephemeral, wrapped, pri, other), "");
+
+        wrapped[0] ^= 1;
+        EXPECT_EQ(OpenPGP::PKA::ECDH::decrypt(ephemeral, wrapped, pri, kdf), "");
+    }
+
+    EXPECT_FALSE(OpenPGP::PKA::ECDH::supported(unhexlify(OpenPGP::PKA::CURVE_OID::ED_255)));
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "PKA/PKAs.h"
+
+#include "../testvectors/msg.h"
+
+// RFC 6979 sec A.2.5 and A.2.6, message "sample"
+struct ECDSA_Vector {
+    uint8_t curve;
+    uint8_t hash;
+    std::string secret;
+    std::string pub;
+    std::string k;
+    std::string r;
+    std::string s;
+};
+
+static const std::vector <ECDSA_Vector> ECDSA_VECTORS = {
+    {
+        OpenPGP::PKA::ECC::ID::P256, OpenPGP::Hash::ID::SHA256,
+        "c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721",
+        "0460fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb67903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299",
+        "a6e3c57dd01abe90086538398355dd4c3b17aa873382b0f24d6129493d8aad60",
+        "efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716",
+        "f7cb1c942d657c41d436c7a1b6e29f65f3e900dbb9aff4064dc4ab2f843acda8",
+    },
+    {
+        OpenPGP::PKA::ECC::ID::P384, OpenPGP::Hash::ID::SHA384,
+        "6b9d3dad2e1b8c1c05b19875b6659f4de23c3b667bf297ba9aa47740787137d896d5724e4c70a825f872c9ea60d2edf5",
+        "04ec3a4e415b4e19a4568618029f427fa5da9a8bc4ae92e02e06aae5286b300c64def8f0ea9055866064a254515480bc138015d9b72d7d57244ea8ef9ac0c621896708a59367f9dfb9f54ca84b3f1c9db1288b231c3ae0d4fe7344fd2533264720",
+        "94ed910d1a099dad3254e9242ae85abde4ba15168eaf0ca87a555fd56d10fbca2907e3e83ba95368623b8c4686915cf9",
+        "94edbb92a5ecb8aad4736e56c691916b3f88140666ce9fa73d64c4ea95ad133c81a648152e44acf96e36dd1e80fabe46",
+        "99ef4aeb15f178cea1fe40db2603138f130e740a19624526203b6351d0a3a94fa329c145786e679e7b82c71a38628ac8",
+    },
+};
+
+TEST(ECDSA, testvectors) {
+    for(ECDSA_Vector const & v : ECDSA_VECTORS){
+        const std::string secret = unhexlify(v.secret);
+        const std::string pub    = unhexlify(v.pub);
+        const std::string digest = OpenPGP::Hash::use(v.hash, "sample");
+
+        EXPECT_EQ(OpenPGP::PKA::ECC::public_key(v.curve, secret), pub);
+        EXPECT_EQ(OpenPGP::PKA::ECC::curve_of(pub), v.curve);
+        EXPECT_EQ(hexlify(OpenPGP::PKA::ECDSA::nonce(v.curve, v.hash, secret, digest)), v.k);
+        EXPECT_EQ(hexlify(OpenPGP::PKA::ECC::sign(v.curve, digest, secret, unhexlify(v.k))), v.r + v.s);
+
+        const OpenPGP::PKA::Values pri_mpi = {OpenPGP::hextompi(v.secret)};
+        const OpenPGP::PKA::Values pub_mpi = {OpenPGP::hextompi(v.pub)};
+        const OpenPGP::PKA::Values sig = OpenPGP::PKA::ECDSA::sign(digest, pri_mpi, pub_mpi, v.hash);
+        ASSERT_EQ(sig.size(), (std::size_t) 2);
+        EXPECT_EQ(sig[0], OpenPGP::hextompi(v.r));
+        EXPECT_EQ(sig[1], OpenPGP::hextompi(v.s));
+        EXPECT_TRUE(OpenPGP::PKA::ECDSA::verify(digest, sig, pub_mpi));
+
+        // wrong digest, r, s, and key
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(OpenPGP::Hash::use(v.hash, "test"), sig, pub_mpi));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {sig[0] + 1, sig[1]}, pub_mpi));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {sig[0], sig[1] + 1}, pub_mpi));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {sig[1], sig[0]}, pub_mpi));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {sig[0]}, pub_mpi));
+
+        // r and s must be in [1, n - 1]
+        const OpenPGP::MPI n = OpenPGP::rawtompi(OpenPGP::PKA::ECC::order(v.curve));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {0, sig[1]}, pub_mpi));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {sig[0], n}, pub_mpi));
+        EXPECT_FALSE(OpenPGP::PKA::ECDSA::verify(digest, {sig[0] + n, sig[1]}, pub_mpi));
+    }
+}
+
+TEST(ECDSA, keygen) {
+    for(const uint8_t curve : {OpenPGP::PKA::ECC::ID::P256, OpenPGP::PKA::ECC::ID::P384}){
+        OpenPGP::PKA::Values pub;
+        const OpenPGP::PKA::Values pri = OpenPGP::PKA::ECDSA::keygen(pub, curve);
+        ASSERT_EQ(pri.size(), (std::size_t) 1);
+        ASSERT_EQ(pub.size(), (std::size_t) 1);
+
+        const std::string point = OpenPGP::mpitoraw(pub[0]);
+        EXPECT_EQ(OpenPGP::PKA::ECC::curve_of(point), curve);
+        EXPECT_EQ(point.size(), (std::size_t) (OpenPGP::PKA::ECC::size(curve) << 1) + 1);
+
+        for(const uint8_t hash : {OpenPGP::Hash::ID::SHA1, OpenPGP::Hash::ID::SHA256, OpenPGP::Hash::ID::SHA512}){
+            const std::string digest = OpenPGP::Hash::use(hash, MESSAGE);
+            const OpenPGP::PKA::Values sig = OpenPGP::PKA::ECDSA::sign(digest, pri, pub, hash);
+            ASSERT_EQ(sig.size(), (std::size_t) 2);
+            EXPECT_TRUE(OpenPGP::PKA::ECDSA::verify(digest, sig, pub));
+
+            // deterministic nonces
+            EXPECT_EQ(OpenPGP::PKA::ECDSA::sign(digest, pri, pub, hash), sig);
+        }
+    }
+
+    // unknown curve
+    EXPECT_EQ(OpenPGP::PKA::ECDSA::sign("", {1}, {OpenPGP::rawtompi("\x04\x01\x02")}, OpenPGP::Hash::ID::SHA256).size(), (std::size_t) 0);
+
+    #ifdef GPG_COMPATIBLE
+    // generate_params takes half of the key size
+    EXPECT_EQ(OpenPGP::PKA::generate_params(OpenPGP::PKA::ID::ECDSA, 128), OpenPGP::PKA::Params({OpenPGP::PKA::ECC::ID::P256}));
+    EXPECT_EQ(OpenPGP::PKA::generate_params(OpenPGP::PKA::ID::ECDSA, 192), OpenPGP::PKA::Params({OpenPGP::PKA::ECC::ID::P384}));
+    #endif
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "PKA/PKAs.h"
+#include "Packets/Tag5.h"
+#include "sign.h"
+
+#include "../testvectors/msg.h"
+#include "testvectors/dsa/dsasiggen.h"
+
+TEST(ModExp, fixed_base) {
+    const OpenPGP::MPI p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    const OpenPGP::MPI q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    const OpenPGP::MPI g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    const std::size_t bits = OpenPGP::bitsize(q);
+
+    for(unsigned int window = 1; window <= 8; window++){
+        const OpenPGP::PKA::FixedBase table(g, p, bits, window);
+        EXPECT_EQ(table.powm(0), 1);
+        EXPECT_EQ(table.powm(1), g);
+        EXPECT_EQ(table.powm(q - 1), OpenPGP::powm(g, q - 1, p));
+        for(std::string const & k : DSA_SIGGEN_K){
+            const OpenPGP::MPI e = OpenPGP::hextompi(k);
+            EXPECT_EQ(table.powm(e), OpenPGP::powm(g, e, p));
+        }
+    }
+
+    // exponents that do not fit into the table are rejected instead of
+    // being run through a shorter, exponent dependent path
+    const OpenPGP::PKA::FixedBase table(g, p, bits);
+    EXPECT_TRUE(table.fits((OpenPGP::MPI(1) << bits) - 1));
+    EXPECT_FALSE(table.fits(OpenPGP::MPI(1) << bits));
+    EXPECT_THROW(table.powm(p - 2), std::runtime_error);
+    EXPECT_THROW(table.powm(-1), std::runtime_error);
+}
+
+TEST(ModExp, context) {
+    const OpenPGP::MPI p = OpenPGP::hextompi(DSA_SIGGEN_P);
+    const OpenPGP::MPI q = OpenPGP::hextompi(DSA_SIGGEN_Q);
+    const OpenPGP::MPI g = OpenPGP::hextompi(DSA_SIGGEN_G);
+    const OpenPGP::MPI y = OpenPGP::hextompi(DSA_SIGGEN_Y[0]);
+    const OpenPGP::MPI k = OpenPGP::hextompi(DSA_SIGGEN_K[0]);
+
+    OpenPGP::PKA::ModExpContext::Ptr context = OpenPGP::PKA::modexp_context(OpenPGP::PKA::ID::DSA, {p, q, g, y});
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(context -> get_mod(), p);
+    EXPECT_EQ(context -> get_base_count(), (std::size_t) 2);
+    EXPECT_EQ(context -> get_base(0), g);
+    EXPECT_EQ(context -> get_base(1), y);
+
+    // the table is only built after a few uses
+    for(unsigned int i = 0; i <= OpenPGP::PKA::ModExpContext::BUILD_AFTER; i++){
+        EXPECT_FALSE(context -> has_table(0));
+        EXPECT_EQ(context -> powm(0, k + i), OpenPGP::powm(g, k + i, p));
+    }
+    EXPECT_TRUE(context -> has_table(0));
+    EXPECT_FALSE(context -> has_table(1));
+    EXPECT_EQ(context -> powm(0, k), OpenPGP::powm(g, k, p));
+    EXPECT_EQ(context -> powm(1, k, false), OpenPGP::powm(y, k, p));
+    EXPECT_FALSE(context -> has_crt());
+
+    // both bases at once with Shamir's trick until both tables are built
+    const OpenPGP::PKA::ModExpContext::Ptr pair = OpenPGP::PKA::modexp_context(OpenPGP::PKA::ID::DSA, {p, q, g, y});
+    for(unsigned int i = 0; i <= OpenPGP::PKA::ModExpContext::BUILD_AFTER + 1; i++){
+        EXPECT_EQ(pair -> has_table(0) && pair -> has_table(1), i > OpenPGP::PKA::ModExpContext::BUILD_AFTER);
+        EXPECT_EQ(pair -> powm2_public(k + i, k), (OpenPGP::powm(g, k + i, p) * OpenPGP::powm(y, k, p)) % p);
+    }
+
+    EXPECT_TRUE(OpenPGP::PKA::usable(pair, p, {g, y}));
+    EXPECT_FALSE(OpenPGP::PKA::usable(pair, p, {y, g}));
+    EXPECT_FALSE(OpenPGP::PKA::usable(pair, p, {g}));
+    EXPECT_FALSE(OpenPGP::PKA::usable(nullptr, p, {g, y}));
+    EXPECT_THROW(context -> powm_crt(k), std::runtime_error);
+
+    EXPECT_EQ(OpenPGP::PKA::modexp_context(0, {p}), nullptr);
+}
+
+TEST(ModExp, rsa_key) {
+    OpenPGP::PKA::Values pri, pub;
+    ASSERT_EQ(OpenPGP::PKA::generate_keypair(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN, {512}, pri, pub), OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN);
+
+    OpenPGP::Packet::Tag5 key;
+    key.set_version(4);
+    key.set_pka(OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN);
+    key.set_mpi(pub);
+    key.set_s2k_con(0);
+    key.set_secret(key.encrypt_secret_keys("", pri));
+
+    // the public context is built once and shared by copies
+    const OpenPGP::PKA::ModExpContext::Ptr context = key.get_modexp();
+    ASSERT_NE(context, nullptr);
+    EXPECT_EQ(key.get_modexp(), context);
+    EXPECT_EQ(OpenPGP::Packet::Tag5(key).get_modexp(), context);
+
+    const OpenPGP::PKA::ModExpContext::Ptr secret = key.get_secret_modexp("");
+    ASSERT_NE(secret, nullptr);
+    EXPECT_TRUE(secret -> has_crt());
+    EXPECT_FALSE(context -> has_crt());
+
+    const OpenPGP::MPI message = OpenPGP::rawtompi(MESSAGE) % pub[0];
+    const OpenPGP::MPI signature = OpenPGP::PKA::RSA::sign(message, secret, pub, true);
+    EXPECT_EQ(signature, OpenPGP::powm(message, pri[0], pub[0]));
+    EXPECT_TRUE(OpenPGP::PKA::RSA::verify(message, {signature}, pub));
+
+    // the secret context is kept for the same private values
+    EXPECT_EQ(key.get_secret_modexp(""), secret);
+    EXPECT_EQ(key.get_secret_modexp(pri), secret);
+    EXPECT_EQ(key.get_secret_modexp(OpenPGP::PKA::Values({pri[0] + 2, pri[1], pri[2], pri[3]})) -> has_crt(pri), false);
+    EXPECT_EQ(key.get_secret_modexp(OpenPGP::PKA::Values({1, 3, 5, 7})), nullptr);
+
+    // signing through the key goes through its cached secret context
+    const OpenPGP::Packet::Tag5::Ptr signer = std::make_shared <OpenPGP::Packet::Tag5> (key);
+    const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, MESSAGE);
+    const OpenPGP::PKA::Values vals = OpenPGP::Sign::with_pka(digest, signer, "", OpenPGP::Hash::ID::SHA256);
+    EXPECT_EQ(vals, OpenPGP::Sign::with_pka(digest, OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN, pri, pub, OpenPGP::Hash::ID::SHA256));
+    EXPECT_TRUE(signer -> get_secret_modexp(pri) -> has_crt(pri));
+
+    // changing the key drops the context
+    key.set_mpi(pub);
+    EXPECT_NE(key.get_modexp(), context);
+}
+
+TEST(ModExp, elgamal) {
+    OpenPGP::PKA::Values pri, pub;
+    ASSERT_EQ(OpenPGP::PKA::generate_keypair(OpenPGP::PKA::ID::ELGAMAL, {512}, pri, pub), OpenPGP::PKA::ID::ELGAMAL);
+
+    const OpenPGP::PKA::ModExpContext::Ptr context = OpenPGP::PKA::modexp_context(OpenPGP::PKA::ID::ELGAMAL, pub);
+    ASSERT_NE(context, nullptr);
+
+    const std::string message = MESSAGE.substr(0, 32);
+    for(unsigned int i = 0; i < OpenPGP::PKA::ModExpContext::BUILD_AFTER + 2; i++){
+        const OpenPGP::PKA::Values c = OpenPGP::PKA::ElGamal::encrypt(message, pub, context);
+        EXPECT_EQ(OpenPGP::PKA::ElGamal::decrypt(c, pri, pub), message);
+    }
+    EXPECT_TRUE(context -> has_table(0));
+    EXPECT_TRUE(context -> has_table(1));
+}
@@ -1,2 +1,7 @@
-PKA_TESTCASES_OBJECTS=dsa.o \
-                      rsa.o
\ No newline at end of file
+PKA_TESTCASES_OBJECTS=dsa.o     \
+                      ecdh.o    \
+                      ecdsa.o   \
+                      ed25519.o \
+                      modexp.o  \
+                      prime.o   \
+                      rsa.o
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "PKA/PKAs.h"
+
+#include "../testvectors/msg.h"
+
+// odd starting points, some of them far from the next prime
+static const std::vector <OpenPGP::MPI> PRIME_STARTS = {
+    3,
+    7919,
+    16383,
+    OpenPGP::hextompi("f7e75fdc469067ffdc4e847c51f452df"),
+    OpenPGP::hextompi("e0d1b2f3a4c5968778695a4b3c2d1e0f1f2e3d4c5b6a79889786a5b4c3d2e1f1"),
+    OpenPGP::hextompi("c90fdaa22168c234c4c6628b80dc1cd129024e088a67cc74020bbea63b139b22514a08798e3404dd"),
+};
+
+TEST(Prime, next) {
+    ThreadPool pool(4);
+    for(OpenPGP::MPI const & start : PRIME_STARTS){
+        const OpenPGP::MPI expected = OpenPGP::nextprime(start - 1);
+        EXPECT_EQ(OpenPGP::PKA::Prime::next(start), expected);
+        EXPECT_EQ(OpenPGP::PKA::Prime::next(start, 2, &pool), expected);
+    }
+
+    // all of the starting points at once
+    std::vector <OpenPGP::MPI> expected;
+    for(OpenPGP::MPI const & start : PRIME_STARTS){
+        expected.push_back(OpenPGP::nextprime(start - 1));
+    }
+    EXPECT_EQ(OpenPGP::PKA::Prime::next(PRIME_STARTS), expected);
+    EXPECT_EQ(OpenPGP::PKA::Prime::next(PRIME_STARTS, 2, &pool), expected);
+}
+
+TEST(Prime, step) {
+    // p = kq + 1, as used for the DSA and ElGamal groups
+    ThreadPool pool(4);
+    const OpenPGP::MPI q = OpenPGP::nextprime(OpenPGP::hextompi("f7e75fdc469067ffdc4e847c51f452df"));
+    const OpenPGP::MPI start = (OpenPGP::hextompi("c90fdaa22168c234c4c6628b80dc1cd129024e088a67cc74020bbea63b139b22514a08798e3404dd") / (q << 1)) * (q << 1) + 1;
+
+    const OpenPGP::MPI p = OpenPGP::PKA::Prime::next(start, q << 1, &pool);
+    EXPECT_TRUE(OpenPGP::knuth_prime_test(p, 25));
+    EXPECT_EQ(OpenPGP::MPI(p % q), 1);
+    EXPECT_EQ(OpenPGP::PKA::Prime::next(start, q << 1), p);
+
+    // nothing smaller was skipped
+    for(OpenPGP::MPI c = start; c < p; c += q << 1){
+        EXPECT_FALSE(OpenPGP::knuth_prime_test(c, 25));
+    }
+}
+
+TEST(Prime, random) {
+    ThreadPool pool(2);
+    for(const unsigned int bits : {16, 64, 160, 256}){
+        const OpenPGP::MPI p = OpenPGP::PKA::Prime::random(bits, &pool);
+        EXPECT_EQ(OpenPGP::bitsize(p), (std::size_t) bits);
+        EXPECT_TRUE(OpenPGP::knuth_prime_test(p, 25));
+    }
+}
+
+TEST(Prime, generate_keypairs) {
+    const uint8_t pka = OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN;
+    const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, MESSAGE);
+
+    ThreadPool pool(4);
+    std::vector <OpenPGP::PKA::Values> pri, pub;
+    ASSERT_EQ(OpenPGP::PKA::generate_keypairs(pka, OpenPGP::PKA::generate_params(pka, 512), 4, pri, pub, pool), (std::size_t) 4);
+    ASSERT_EQ(pri.size(), (std::size_t) 4);
+    ASSERT_EQ(pub.size(), (std::size_t) 4);
+
+    for(std::size_t i = 0; i < pri.size(); i++){
+        ASSERT_EQ(pri[i].size(), (std::size_t) 4);
+        ASSERT_EQ(pub[i].size(), (std::size_t) 2);
+        EXPECT_EQ(pri[i][1] * pri[i][2], pub[i][0]);
+        EXPECT_TRUE(OpenPGP::PKA::RSA::verify(digest, {OpenPGP::PKA::RSA::sign(digest, pri[i], pub[i])}, pub[i]));
+    }
+
+    // no parameters
+    EXPECT_EQ(OpenPGP::PKA::generate_keypairs(pka, {}, 4, pri, pub, pool), (std::size_t) 0);
+    EXPECT_EQ(pri.size(), (std::size_t) 0);
+    EXPECT_EQ(pub.size(), (std::size_t) 0);
+}
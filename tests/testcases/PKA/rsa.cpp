@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "sign.h"
+#include "verify.h"
 
 #include "../testvectors/msg.h"
 #include "testvectors/rsa/rsasiggen15_186-2.h"
@@ -43,3 +44,76 @@ TEST(RSA, keygen) {
     auto signature = OpenPGP::PKA::RSA::sign(message, pri, pub);
     EXPECT_TRUE(OpenPGP::PKA::RSA::verify(message, {signature}, pub));
 }
+
+TEST(RSA, crt) {
+    OpenPGP::PKA::Values key = OpenPGP::PKA::RSA::keygen(512);
+    OpenPGP::PKA::Values pub = {key[0], key[1]};
+    OpenPGP::PKA::Values pri = {key[2], key[3], key[4], key[5]};
+
+    OpenPGP::MPI message = OpenPGP::rawtompi(MESSAGE) % pub[0];
+
+    // CRT must give the same result as the full exponentiation
+    auto full = OpenPGP::PKA::RSA::sign(message, {pri[0]}, pub);
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(message, pri, pub), full);
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(message, pri, pub, true), full);
+
+    // values that do not belong to the modulus are not used
+    auto bad = pri;
+    bad[1] += 2;
+    EXPECT_EQ(OpenPGP::PKA::RSA::sign(message, bad, pub), full);
+
+    // a faulty u is caught by the check
+    bad = pri;
+    bad[3] += 1;
+    EXPECT_THROW(OpenPGP::PKA::RSA::sign(message, bad, pub, true), std::runtime_error);
+}
+
+// signatures over MESSAGE by count different keys, with every third one broken
+static std::vector <OpenPGP::Verify::Batch> make_batch(const unsigned int keys, const unsigned int count, const unsigned int bits = 512) {
+    std::vector <OpenPGP::Packet::Key::Ptr> signers;
+    std::vector <OpenPGP::PKA::Values> secrets;
+    for(unsigned int i = 0; i < keys; i++){
+        // keys in use almost always have e = 65537
+        OpenPGP::PKA::Values key = OpenPGP::PKA::RSA::keygen(bits);
+        const OpenPGP::MPI tot = (key[3] - 1) * (key[4] - 1);
+        if (OpenPGP::mpigcd(tot, 65537) != 1){
+            i--;
+            continue;
+        }
+        const OpenPGP::PKA::Values pub = {key[0], 65537};
+        const OpenPGP::PKA::Values pri = {OpenPGP::invert(65537, tot), key[3], key[4], key[5]};
+        OpenPGP::Packet::Key::Ptr signer = std::make_shared <OpenPGP::Packet::Tag6> ();
+        signer -> set_pka(PKA_RSA);
+        signer -> set_mpi(pub);
+        signers.push_back(signer);
+        secrets.push_back(pri);
+    }
+
+    std::vector <OpenPGP::Verify::Batch> batch;
+    for(unsigned int i = 0; i < count; i++){
+        const OpenPGP::Packet::Key::Ptr & signer = signers[i % keys];
+        const std::string digest = OpenPGP::Hash::use(OpenPGP::Hash::ID::SHA256, MESSAGE + std::to_string(i));
+
+        OpenPGP::Packet::Tag2::Ptr sig = std::make_shared <OpenPGP::Packet::Tag2> ();
+        sig -> set_pka(PKA_RSA);
+        sig -> set_hash(OpenPGP::Hash::ID::SHA256);
+        sig -> set_mpi(OpenPGP::Sign::with_pka(digest, PKA_RSA, secrets[i % keys], signer -> get_mpi(), OpenPGP::Hash::ID::SHA256));
+
+        batch.push_back({(i % 3 == 2)?digest.substr(1) + "!":digest, signer, sig});
+    }
+
+    return batch;
+}
+
+TEST(RSA, batch_verify) {
+    std::vector <OpenPGP::Verify::Batch> batch = make_batch(3, 30);
+    batch.push_back({"", nullptr, nullptr});
+
+    const std::vector <int> results = OpenPGP::Verify::with_pka(batch, 4);
+    ASSERT_EQ(results.size(), batch.size());
+    for(std::size_t i = 0; i + 1 < batch.size(); i++){
+        EXPECT_EQ(results[i], (i % 3 != 2));
+        EXPECT_EQ(results[i], OpenPGP::Verify::with_pka(batch[i].digest, batch[i].signer, batch[i].signee));
+    }
+    EXPECT_EQ(results.back(), -1);
+}
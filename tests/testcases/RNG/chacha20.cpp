@@ -0,0 +1,149 @@
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "RNG/RNGs.h"
+
+TEST(ChaCha20, block) {
+    // RFC 7539 sec 2.3.2
+    const uint32_t key[8]   = {0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c, 0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c};
+    const uint32_t nonce[3] = {0x09000000, 0x4a000000, 0x00000000};
+    uint8_t out[OpenPGP::RNG::ChaCha20::BLOCK_SIZE];
+    OpenPGP::RNG::ChaCha20::block(key, 1, nonce, out);
+    EXPECT_EQ(hexlify(std::string(reinterpret_cast <char *> (out), sizeof(out))),
+              "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+              "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+
+    // RFC 7539 sec A.1, test vector 1
+    const uint32_t zero[8] = {};
+    OpenPGP::RNG::ChaCha20::block(zero, 0, zero, out);
+    EXPECT_EQ(hexlify(std::string(reinterpret_cast <char *> (out), sizeof(out))),
+              "76b8e0ada0f13d90405d6ae55386bd28bdd219b8a08ded1aa836efcc8b770dc7"
+              "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586");
+}
+
+TEST(ChaCha20, seeded) {
+    const std::string zero(OpenPGP::RNG::ChaCha20::KEY_SIZE, 0);
+
+    // the first KEY_SIZE octets of the keystream become the next key,
+    // so output starts after them
+    OpenPGP::RNG::ChaCha20 drbg(zero);
+    EXPECT_EQ(hexlify(drbg.generate(32)), "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586");
+
+    // the output does not depend on how it is asked for
+    OpenPGP::RNG::ChaCha20 a(zero), b(zero);
+    std::string pieces;
+    for(std::size_t len : {0, 1, 7, 64, 500, 1024, 3000, 5000, 10000}){
+        pieces += a.generate(len);
+    }
+    EXPECT_EQ(pieces, b.generate(pieces.size()));
+
+    // different seeds give different output
+    OpenPGP::RNG::ChaCha20 c(std::string(OpenPGP::RNG::ChaCha20::KEY_SIZE, 1));
+    EXPECT_NE(OpenPGP::RNG::ChaCha20(zero).generate(64), c.generate(64));
+
+    EXPECT_THROW(OpenPGP::RNG::ChaCha20("short seed"), std::runtime_error);
+}
+
+TEST(ChaCha20, system) {
+    OpenPGP::RNG::ChaCha20 a, b;
+    const std::string x = a.generate(64);
+    EXPECT_NE(x, b.generate(64));
+    EXPECT_NE(x, a.generate(64));
+
+    // reseeding keeps producing output
+    a.reseed();
+    EXPECT_EQ(a.generate(OpenPGP::RNG::ChaCha20::RESEED_INTERVAL + 1).size(), OpenPGP::RNG::ChaCha20::RESEED_INTERVAL + 1);
+
+    // a forked child does not repeat what is left in its parent's pool
+    a.generate(16);
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0){
+        const std::string out = a.generate(32);
+        _exit(write(fds[1], out.data(), out.size()) != (ssize_t) out.size());
+    }
+    close(fds[1]);
+    std::string child(32, 0);
+    EXPECT_EQ(read(fds[0], &child[0], child.size()), (ssize_t) child.size());
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    EXPECT_EQ(status, 0);
+    EXPECT_NE(child, a.generate(32));
+}
+
+TEST(RNG, bytes) {
+    ASSERT_EQ(OpenPGP::RNG::get_source(), OpenPGP::RNG::Source::CHACHA20);
+    EXPECT_EQ(OpenPGP::RNG::bytes(0).size(), (std::size_t) 0);
+    EXPECT_EQ(OpenPGP::RNG::bytes(100).size(), (std::size_t) 100);
+
+    // every thread has its own generator
+    std::mutex mutex;
+    std::set <std::string> seen;
+    std::vector <std::thread> threads;
+    for(unsigned int i = 0; i < 8; i++){
+        threads.emplace_back([&](){
+            for(unsigned int j = 0; j < 100; j++){
+                const std::string out = OpenPGP::RNG::bytes(16);
+                std::lock_guard <std::mutex> lock(mutex);
+                seen.insert(out);
+            }
+        });
+    }
+    for(std::thread & t : threads){
+        t.join();
+    }
+    EXPECT_EQ(seen.size(), (std::size_t) 800);
+
+    // random MPIs are at most as long as asked for
+    for(const unsigned int bits : {1, 7, 8, 9, 255, 256}){
+        EXPECT_LE(OpenPGP::bitsize(OpenPGP::random(bits)), (std::size_t) bits);
+    }
+}
+
+TEST(RNG, source) {
+    OpenPGP::RNG::set_source(OpenPGP::RNG::Source::BBS);
+    EXPECT_EQ(OpenPGP::RNG::get_source(), OpenPGP::RNG::Source::BBS);
+    EXPECT_EQ(OpenPGP::RNG::bytes(16).size(), (std::size_t) 16);
+    OpenPGP::RNG::set_source(OpenPGP::RNG::Source::CHACHA20);
+    EXPECT_EQ(OpenPGP::RNG::get_source(), OpenPGP::RNG::Source::CHACHA20);
+
+    EXPECT_THROW(OpenPGP::RNG::set_source(2), std::runtime_error);
+    EXPECT_EQ(OpenPGP::RNG::get_source(), OpenPGP::RNG::Source::CHACHA20);
+}
+
+TEST(RNG, scope) {
+    const std::string seed(OpenPGP::RNG::ChaCha20::KEY_SIZE, 2);
+    const std::string expected = OpenPGP::RNG::ChaCha20(seed).generate(48);
+
+    OpenPGP::RNG::ChaCha20 outer(seed), inner(seed);
+    std::string out;
+    {
+        const OpenPGP::RNG::Scope a(&outer);
+        out += OpenPGP::RNG::bytes(16);
+        {
+            const OpenPGP::RNG::Scope b(&inner);
+            EXPECT_EQ(OpenPGP::RNG::bytes(16), expected.substr(0, 16));
+
+            // a null generator keeps the current one
+            const OpenPGP::RNG::Scope c(nullptr);
+            EXPECT_EQ(OpenPGP::RNG::bytes(16), expected.substr(16, 16));
+        }
+        out += OpenPGP::RNG::bytes(32);
+
+        // other threads are not affected
+        std::string other;
+        std::thread([&](){ other = OpenPGP::RNG::bytes(48); }).join();
+        EXPECT_NE(other, expected);
+    }
+    EXPECT_EQ(out, expected);
+    EXPECT_NE(OpenPGP::RNG::bytes(48), expected);
+}
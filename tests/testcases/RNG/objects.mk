@@ -0,0 +1 @@
+RNG_TESTCASES_OBJECTS=chacha20.o
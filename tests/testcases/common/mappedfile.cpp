@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "ByteChain.h"
+#include "MappedFile.h"
+
+static std::string temp_file(const std::string & contents){
+    char name[] = "/tmp/mappedfileXXXXXX";
+    const int fd = mkstemp(name);
+    close(fd);
+    std::ofstream(name, std::ios::binary) << contents;
+    return name;
+}
+
+TEST(MappedFile, contents){
+    std::string contents;
+    for(unsigned int i = 0; i < 100000; i++){
+        contents += static_cast <char> (i * 7);
+    }
+
+    const std::string name = temp_file(contents);
+    ByteSlice data;
+    {
+        const MappedFile file(name, MappedFile::SEQUENTIAL, false);
+        ASSERT_EQ(file.is_open(), true);
+        EXPECT_EQ(file.size(), contents.size());
+        data = file.data().substr(10);
+    }
+
+    // the mapping outlives the MappedFile
+    EXPECT_EQ(data.str(), contents.substr(10));
+    std::remove(name.c_str());
+}
+
+TEST(MappedFile, empty_and_missing){
+    const std::string name = temp_file("");
+    const MappedFile empty(name);
+    EXPECT_EQ(static_cast <bool> (empty), true);
+    EXPECT_EQ(empty.size(), 0);
+    std::remove(name.c_str());
+
+    const MappedFile missing(name);
+    EXPECT_EQ(static_cast <bool> (missing), false);
+}
+
+TEST(ByteChain, pieces){
+    ByteChain chain(ByteSlice(std::string("abc")));
+    chain.append(ByteSlice(std::string("")));
+    chain.append(ByteSlice(std::string("defg")));
+    EXPECT_EQ(chain.size(), 7);
+    EXPECT_EQ(chain.get_pieces().size(), 2);
+    EXPECT_EQ(chain.substr(2, 3).str(), "cde");
+    EXPECT_EQ(chain.substr(2, 3).get_pieces().size(), 2);
+    EXPECT_EQ(chain, ByteChain(std::string("abcdefg")));
+
+    // joined once, then kept
+    EXPECT_EQ(chain.flatten().str(), "abcdefg");
+    EXPECT_EQ(chain.get_pieces().size(), 1);
+}
@@ -1 +1,2 @@
-COMMON_TESTCASES_OBJECTS=
\ No newline at end of file
+COMMON_TESTCASES_OBJECTS=mappedfile.o \
+                         threadpool.o
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include "ThreadPool.h"
+
+TEST(ThreadPool, runs_every_job){
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::atomic <unsigned int> count(0);
+    for(unsigned int i = 0; i < 1000; i++){
+        pool.submit([&count](){ count++; });
+    }
+    pool.wait();
+    EXPECT_EQ(count, 1000);
+
+    // the pool can be reused after waiting
+    pool.submit([&count](){ count++; });
+    pool.wait();
+    EXPECT_EQ(count, 1001);
+}
+
+TEST(ThreadPool, finishes_jobs_on_destruction){
+    std::atomic <unsigned int> count(0);
+    {
+        ThreadPool pool;
+        EXPECT_GE(pool.size(), 1);
+        for(unsigned int i = 0; i < 100; i++){
+            pool.submit([&count](){ count++; });
+        }
+    }
+    EXPECT_EQ(count, 100);
+}
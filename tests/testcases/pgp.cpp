@@ -1,13 +1,22 @@
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <sstream>
+#include <thread>
+#include <unistd.h>
 
 #include <gtest/gtest.h>
 
 #include "arm_key.h"
+#include "ArmorReader.h"
+#include "ArmorWriter.h"
 #include "decrypt.h"
 #include "encrypt.h"
+#include "PartialWriter.h"
 #include "generatekey.h"
+#include "common/MappedFile.h"
 #include "revoke.h"
 #include "sign.h"
 #include "verify.h"
@@ -113,10 +122,27 @@ TEST(PGP, keygen){
 
     EXPECT_EQ(config.valid(), true);
 
+    // the key and the subkey each get their own S2K count
+    config.passphrase = PASSPHRASE;
+    config.count = 97;
+    config.subkeys[0].count = 98;
+
     // generate private key
     const OpenPGP::SecretKey pri = generate_key(config);
     EXPECT_EQ(pri.meaningful(), true);
 
+    for(OpenPGP::Packet::Tag::Ptr const & p : pri.get_packets()){
+        if (OpenPGP::Packet::is_secret(p -> get_tag())){
+            const OpenPGP::Packet::Tag5::Ptr key = std::dynamic_pointer_cast <OpenPGP::Packet::Tag5> (p);
+            const OpenPGP::S2K::S2K3::Ptr s2k = std::dynamic_pointer_cast <OpenPGP::S2K::S2K3> (key -> get_s2k());
+            ASSERT_NE(s2k, nullptr);
+            EXPECT_EQ(s2k -> get_count(), (p -> get_tag() == OpenPGP::Packet::SECRET_KEY)?97:98);
+
+            // RSA d, p, q, u and nothing after the checksum
+            EXPECT_EQ(key -> decrypt_secret_keys(PASSPHRASE).size(), (std::size_t) 4);
+        }
+    }
+
     // extract public key from private
     const OpenPGP::PublicKey pub = pri.get_public();
     EXPECT_EQ(pub.meaningful(), true);
@@ -125,6 +151,30 @@ TEST(PGP, keygen){
     EXPECT_EQ(pri.fingerprint(), pub.fingerprint());
 }
 
+TEST(PGP, generate_keys){
+
+    OpenPGP::KeyGen config;
+    config.pka = OpenPGP::PKA::ID::RSA_ENCRYPT_OR_SIGN;
+    config.bits = 1024;
+    config.uids.push_back(OpenPGP::KeyGen::UserID());
+    config.uids[0].user = "batch";
+    ASSERT_EQ(config.valid(), true);
+
+    ThreadPool pool(3);
+    const std::vector <OpenPGP::SecretKey> keys = OpenPGP::generate_keys(config, 3, pool);
+    ASSERT_EQ(keys.size(), (std::size_t) 3);
+    for(std::size_t i = 0; i < keys.size(); i++){
+        EXPECT_EQ(keys[i].meaningful(), true);
+        for(std::size_t j = 0; j < i; j++){
+            EXPECT_NE(keys[i].fingerprint(), keys[j].fingerprint());
+        }
+    }
+
+    // bad configurations give no keys
+    config.uids.clear();
+    EXPECT_EQ(OpenPGP::generate_keys(config, 3, pool).size(), (std::size_t) 0);
+}
+
 TEST(PGP, revoke_key){
 
     OpenPGP::SecretKey pri;
@@ -224,6 +274,75 @@ TEST(PGP, encrypt_decrypt_pka_mdc){
     EXPECT_EQ(message, MESSAGE);
 }
 
+#ifdef GPG_COMPATIBLE
+TEST(PGP, encrypt_decrypt_sign_verify_ecc){
+
+    OpenPGP::KeyGen config;
+    config.passphrase = PASSPHRASE;
+    config.pka = OpenPGP::PKA::ID::EdDSA;
+    config.bits = 256;
+    config.uids.push_back(OpenPGP::KeyGen::UserID());
+    config.subkeys.push_back(OpenPGP::KeyGen::SubkeyGen());
+    config.subkeys[0].pka = OpenPGP::PKA::ID::ECDH;
+    config.subkeys[0].bits = 256;
+    ASSERT_EQ(config.valid(), true);
+
+    const OpenPGP::SecretKey pri = generate_key(config);
+    ASSERT_EQ(pri.meaningful(), true);
+
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    const OpenPGP::Message encrypted = OpenPGP::Encrypt::pka(encrypt_args, pri);
+    ASSERT_EQ(encrypted.meaningful(), true);
+
+    const OpenPGP::Packet::Tag1::Ptr tag1 = std::dynamic_pointer_cast <OpenPGP::Packet::Tag1> (encrypted.get_packets()[0]);
+    EXPECT_EQ(tag1 -> get_pka(), OpenPGP::PKA::ID::ECDH);
+    EXPECT_EQ(tag1 -> get_wrapped().size(), (std::size_t) 48);
+
+    // truncated wrapped keys are rejected
+    const std::string body = tag1 -> raw();
+    EXPECT_THROW(OpenPGP::Packet::Tag1(body.substr(0, body.size() - 49)), std::runtime_error);
+    EXPECT_THROW(OpenPGP::Packet::Tag1(body.substr(0, body.size() - 1)), std::runtime_error);
+
+    // survives a round trip through the packet encoding
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::pka(pri, PASSPHRASE, OpenPGP::Message(encrypted.raw()));
+    std::string message = "";
+    for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+        if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+            message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+        }
+    }
+    EXPECT_EQ(message, MESSAGE);
+
+    const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE, 4, OpenPGP::Hash::ID::SHA256);
+    const OpenPGP::DetachedSignature sig = OpenPGP::Sign::detached_signature(sign_args, MESSAGE);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE + "x", sig), false);
+}
+
+TEST(PGP, sign_verify_ecdsa){
+
+    for(const std::size_t bits : {256, 384}){
+        OpenPGP::KeyGen config;
+        config.passphrase = PASSPHRASE;
+        config.pka = OpenPGP::PKA::ID::ECDSA;
+        config.bits = bits;
+        config.uids.push_back(OpenPGP::KeyGen::UserID());
+        ASSERT_EQ(config.valid(), true);
+
+        const OpenPGP::SecretKey pri = generate_key(config);
+        ASSERT_EQ(pri.meaningful(), true);
+
+        const OpenPGP::Packet::Key::Ptr primary = std::dynamic_pointer_cast <OpenPGP::Packet::Key> (pri.get_packets()[0]);
+        EXPECT_EQ(primary -> get_curve(), unhexlify((bits == 256)?OpenPGP::PKA::CURVE_OID::NIST_256:OpenPGP::PKA::CURVE_OID::NIST_384));
+
+        const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE, 4, OpenPGP::Hash::ID::SHA256);
+        const OpenPGP::DetachedSignature sig = OpenPGP::Sign::detached_signature(sign_args, MESSAGE);
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE + "x", sig), false);
+    }
+}
+#endif
+
 TEST(PGP, encrypt_decrypt_pka_no_mdc){
 
     OpenPGP::SecretKey pri;
@@ -279,6 +398,120 @@ TEST(PGP, encrypt_decrypt_symmetric_mdc){
     EXPECT_EQ(message, MESSAGE);
 }
 
+TEST(PGP, encrypt_decrypt_symmetric_rng){
+
+    const std::string seed(OpenPGP::RNG::ChaCha20::KEY_SIZE, 1);
+
+    // the same generator state gives the same salt
+    OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    encrypt_args.rng = std::make_shared <OpenPGP::RNG::ChaCha20> (seed);
+    const OpenPGP::Message a = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
+    encrypt_args.rng = std::make_shared <OpenPGP::RNG::ChaCha20> (seed);
+    const OpenPGP::Message b = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
+    ASSERT_EQ(a.meaningful(), true);
+    ASSERT_EQ(b.meaningful(), true);
+    EXPECT_EQ(a.get_packets()[0] -> raw(), b.get_packets()[0] -> raw());
+
+    encrypt_args.rng = nullptr;
+    const OpenPGP::Message c = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Sym::ID::AES256);
+    EXPECT_NE(a.get_packets()[0] -> raw(), c.get_packets()[0] -> raw());
+
+    // concurrent operations, each with its own generator
+    std::vector <std::thread> threads;
+    std::vector <std::string> messages(4);
+    for(std::size_t i = 0; i < messages.size(); i++){
+        threads.emplace_back([&, i](){
+            OpenPGP::Encrypt::Args args("", MESSAGE);
+            args.rng = std::make_shared <OpenPGP::RNG::ChaCha20> ();
+            const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(OpenPGP::Encrypt::sym(args, PASSPHRASE, OpenPGP::Sym::ID::AES256), PASSPHRASE);
+            for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+                if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+                    messages[i] += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+                }
+            }
+        });
+    }
+    for(std::thread & t : threads){
+        t.join();
+    }
+    for(std::string const & message : messages){
+        EXPECT_EQ(message, MESSAGE);
+    }
+}
+
+TEST(PGP, encrypt_decrypt_symmetric_chunks){
+    // several chunks, the last one partial
+    std::string data(3 * OpenPGP::Packet::PARTIAL_CHUNK + 5, 0);
+    for(std::size_t i = 0; i < data.size(); i++){
+        data[i] = i * 7;
+    }
+
+    for(uint8_t const comp : {OpenPGP::Compression::ID::UNCOMPRESSED, OpenPGP::Compression::ID::ZLIB, OpenPGP::Compression::ID::BZIP2}){
+        for(bool const mdc : {true, false}){
+            const OpenPGP::Encrypt::Args encrypt_args("file", ByteSlice::view(data.data(), data.size()), OpenPGP::Sym::ID::AES256, comp, mdc);
+            const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256);
+            ASSERT_EQ(encrypted.meaningful(), true);
+
+            const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(encrypted, PASSPHRASE);
+            std::string message;
+            for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+                if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+                    message += std::static_pointer_cast <OpenPGP::Packet::Tag11> (p) -> get_literal();
+                }
+            }
+            EXPECT_EQ(message, data);
+        }
+    }
+}
+
+TEST(PGP, encrypt_decrypt_symmetric_argon2){
+
+    OpenPGP::S2K::S2K4::Ptr s2k = std::make_shared <OpenPGP::S2K::S2K4> ();
+    s2k -> set_passes(1);
+    s2k -> set_parallelism(2);
+    s2k -> set_memory(10);
+
+    const OpenPGP::Encrypt::Args encrypt_args("", MESSAGE);
+    const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, s2k);
+    ASSERT_EQ(encrypted.meaningful(), true);
+
+    // written and read back with the Argon2 specifier and a new salt
+    const OpenPGP::Message read(encrypted.write());
+    const OpenPGP::Packet::Tag3::Ptr tag3 = std::dynamic_pointer_cast <OpenPGP::Packet::Tag3> (read.get_packets()[0]);
+    ASSERT_EQ(tag3 -> get_s2k() -> get_type(), OpenPGP::S2K::ID::ARGON2);
+    const OpenPGP::S2K::S2K4::Ptr used = std::static_pointer_cast <OpenPGP::S2K::S2K4> (tag3 -> get_s2k());
+    EXPECT_EQ(used -> get_salt().size(), OpenPGP::S2K::S2K4::SALT_SIZE);
+    EXPECT_EQ(used -> get_memory(), (uint8_t) 10);
+
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(read, PASSPHRASE);
+    std::string message = "";
+    for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+        if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+            message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+        }
+    }
+    EXPECT_EQ(message, MESSAGE);
+
+    // no salt to fill in
+    EXPECT_EQ(OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, std::make_shared <OpenPGP::S2K::S2K0> ()).meaningful(), false);
+
+    // secret keys locked with Argon2
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri), true);
+    const OpenPGP::Packet::Tag5::Ptr key = std::static_pointer_cast <OpenPGP::Packet::Tag5> (pri.get_packets()[0]);
+    const OpenPGP::PKA::Values values = key -> decrypt_secret_keys(PASSPHRASE);
+
+    s2k -> set_salt(std::string(OpenPGP::S2K::S2K4::SALT_SIZE, 1));
+    OpenPGP::Packet::Tag5 locked(*key);
+    locked.set_s2k_con(254);
+    locked.set_s2k(s2k);
+    locked.encrypt_secret_keys(PASSPHRASE, values);
+
+    const OpenPGP::Packet::Tag5 reread(locked.raw());
+    ASSERT_EQ(reread.get_s2k() -> get_type(), OpenPGP::S2K::ID::ARGON2);
+    EXPECT_EQ(reread.decrypt_secret_keys(PASSPHRASE), values);
+}
+
 TEST(PGP, encrypt_decrypt_symmetric_no_mdc){
 
     OpenPGP::Encrypt::Args encrypt_args;
@@ -350,6 +583,25 @@ TEST(PGP, sign_verify_detached){
     EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
 }
 
+TEST(PGP, sign_verify_detached_mapped){
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri), true);
+
+    char name[] = "/tmp/detachedXXXXXX";
+    close(mkstemp(name));
+    std::ofstream(name, std::ios::binary) << MESSAGE;
+
+    const MappedFile file(name);
+    ASSERT_EQ(file.is_open(), true);
+
+    const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE);
+    const OpenPGP::DetachedSignature sig = OpenPGP::Sign::detached_signature(sign_args, file.data());
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
+    EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, file.data(), sig), true);
+    std::remove(name);
+}
+
 TEST(PGP, sign_verify_binary){
 
     OpenPGP::SecretKey pri;
@@ -370,6 +622,48 @@ TEST(PGP, sign_verify_cleartext){
     EXPECT_EQ(OpenPGP::Verify::cleartext_signature(pri, sig), true);
 }
 
+TEST(PGP, sign_verify_s2k_cache){
+
+    OpenPGP::SecretKey pri;
+    ASSERT_EQ(read_pgp <OpenPGP::SecretKey> ("Alicepri", pri), true);
+
+    const OpenPGP::Packet::Tag5::Ptr key = std::static_pointer_cast <OpenPGP::Packet::Tag5> (pri.get_packets()[0]);
+    const std::string fingerprint = key -> get_fingerprint();
+    const std::string params = std::string(1, key -> get_sym()) + key -> get_s2k() -> write();
+
+    OpenPGP::S2K::Cache::enable(std::chrono::seconds(60));
+    const OpenPGP::PKA::Values expected = key -> decrypt_secret_keys(PASSPHRASE);
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 1);
+
+    std::string derived;
+    ASSERT_EQ(OpenPGP::S2K::Cache::get(fingerprint, params, PASSPHRASE, derived), true);
+    EXPECT_EQ(derived, key -> calculate_key(PASSPHRASE));
+    EXPECT_EQ(key -> decrypt_secret_keys(PASSPHRASE), expected);
+
+    // wrong passphrases are not remembered
+    EXPECT_ANY_THROW(key -> decrypt_secret_keys("not the passphrase"));
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 1);
+
+    // the cached key is used instead of running the S2K again
+    OpenPGP::S2K::Cache::put(fingerprint, params, PASSPHRASE, std::string(derived.size(), 0));
+    EXPECT_ANY_THROW(key -> decrypt_secret_keys(PASSPHRASE));
+    OpenPGP::S2K::Cache::evict(fingerprint);
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 0);
+
+    // signing goes through the cache too
+    const OpenPGP::Sign::Args sign_args(pri, PASSPHRASE);
+    for(unsigned int i = 0; i < 2; i++){
+        const OpenPGP::DetachedSignature sig = OpenPGP::Sign::detached_signature(sign_args, MESSAGE);
+        EXPECT_EQ(OpenPGP::Verify::detached_signature(pri, MESSAGE, sig), true);
+    }
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 1);
+
+    OpenPGP::S2K::Cache::disable();
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 0);
+    EXPECT_EQ(key -> decrypt_secret_keys(PASSPHRASE), expected);
+    EXPECT_EQ(OpenPGP::S2K::Cache::size(), (std::size_t) 0);
+}
+
 TEST(PGP, verify_primary_key){
 
     OpenPGP::PublicKey pub;
@@ -630,3 +924,397 @@ TEST(Key, merge){
 
     }
 }
+
+TEST(PGP, serialized_size){
+    const OpenPGP::Key k(arm);
+    ASSERT_EQ(k.meaningful(), true);
+
+    std::size_t total = 0;
+    for(OpenPGP::Packet::Tag::Ptr const & p : k.get_packets()){
+        EXPECT_EQ(p -> serialized_size(), p -> raw().size());
+        for(OpenPGP::Packet::Tag::Format const header : {OpenPGP::Packet::Tag::DEFAULT, OpenPGP::Packet::Tag::OLD, OpenPGP::Packet::Tag::NEW}){
+            EXPECT_EQ(p -> write_size(header), p -> write(header).size());
+        }
+        total += p -> write_size();
+
+        // subpackets are written straight into the signature
+        if (p -> get_tag() == OpenPGP::Packet::SIGNATURE){
+            const OpenPGP::Packet::Tag2::Ptr sig = std::static_pointer_cast <OpenPGP::Packet::Tag2> (p);
+            for(OpenPGP::Subpacket::Tag2::Sub::Ptr const & s : sig -> get_hashed_subpackets()){
+                EXPECT_EQ(s -> serialized_size(), s -> raw().size());
+                EXPECT_EQ(s -> write_size(), s -> write().size());
+            }
+        }
+    }
+
+    // writing and reading back must not change anything
+    const std::string raw = k.raw();
+    EXPECT_EQ(raw.size(), total);
+    EXPECT_EQ(OpenPGP::Key(k.write()).raw(), raw);
+}
+
+TEST(PGP, read_raw_shares_buffer){
+    OpenPGP::Packet::Tag11 literal;
+    literal.set_format(OpenPGP::Packet::Literal::BINARY);
+    literal.set_filename("");
+    literal.set_time(0);
+    literal.set_literal(std::string(70000, 'a'));
+
+    // old format packet with a 4 octet length
+    const ByteSlice buffer(literal.write(OpenPGP::Packet::Tag::OLD));
+    EXPECT_EQ(static_cast <uint8_t> (buffer[0]) & 3, 2);
+
+    OpenPGP::PGP pgp;
+    pgp.read_raw(buffer);
+    ASSERT_EQ(pgp.get_packets().size(), 1);
+
+    const OpenPGP::Packet::Tag11::Ptr tag11 = std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (pgp.get_packets()[0]);
+    EXPECT_EQ(tag11 -> get_literal(), literal.get_literal());
+
+    // the literal data points into the original buffer instead of a copy
+    const ByteSlice & slice = tag11 -> get_literal_slice();
+    EXPECT_GE(slice.data(), buffer.data());
+    EXPECT_LE(slice.data() + slice.size(), buffer.data() + buffer.size());
+}
+
+TEST(PGP, read_slice){
+    const OpenPGP::Encrypt::Args encrypt_args("file", std::string(1000, 'a'));
+    const OpenPGP::Message encrypted = OpenPGP::Encrypt::sym(encrypt_args, PASSPHRASE, OpenPGP::Hash::ID::SHA256);
+    ASSERT_EQ(encrypted.meaningful(), true);
+
+    // armored data is decoded in place
+    const std::string armored = encrypted.write(OpenPGP::PGP::Armored::YES);
+    const OpenPGP::Message from_armor(ByteSlice::view(armored.data(), armored.size()));
+    EXPECT_EQ(from_armor.raw(), encrypted.raw());
+
+    // binary data is read as slices
+    const std::string binary = encrypted.write(OpenPGP::PGP::Armored::NO);
+    const OpenPGP::Message from_binary(ByteSlice::view(binary.data(), binary.size()));
+    EXPECT_EQ(from_binary.raw(), encrypted.raw());
+
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(from_binary, PASSPHRASE);
+    ASSERT_EQ(decrypted.meaningful(), true);
+}
+
+TEST(PacketReader, lengths){
+    OpenPGP::Packet::Tag13 uid;
+    uid.set_contents("PacketReader", "", "packet@reader");
+
+    // literal data body split into 512 + 1 + 3 octet chunks
+    const std::string literal = std::string("b\x00", 2) + std::string(4, '\x00') + std::string(510, 'x');
+    const std::string chunked = "\xcb\xe9" + literal.substr(0, 512) +
+                                "\xe0" + literal.substr(512, 1) +
+                                "\x03" + literal.substr(513, 3);
+
+    std::stringstream stream(uid.write(OpenPGP::Packet::Tag::OLD) +
+                             uid.write(OpenPGP::Packet::Tag::NEW) +
+                             chunked +
+                             "\xaf" + literal);             // old format, indeterminate length
+
+    OpenPGP::PacketReader reader(stream);
+    OpenPGP::PacketReader::Header header;
+
+    ASSERT_EQ(reader.next(header), true);
+    EXPECT_EQ(header.tag, OpenPGP::Packet::USER_ID);
+    EXPECT_EQ(header.format, false);
+    EXPECT_EQ(header.length, uid.get_contents().size());
+
+    // skip this body without reading it
+    ASSERT_EQ(reader.next(header), true);
+    EXPECT_EQ(header.tag, OpenPGP::Packet::USER_ID);
+    EXPECT_EQ(header.format, true);
+    EXPECT_EQ(std::string(std::istreambuf_iterator <char> (reader.body()), {}), uid.get_contents());
+
+    ASSERT_EQ(reader.next(header), true);
+    EXPECT_EQ(header.tag, OpenPGP::Packet::LITERAL_DATA);
+    EXPECT_EQ(header.partial, true);
+    EXPECT_EQ(header.length, 512);
+    EXPECT_EQ(std::string(std::istreambuf_iterator <char> (reader.body()), {}), literal);
+
+    OpenPGP::Packet::Tag::Ptr packet = reader.read_packet();
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet -> get_tag(), OpenPGP::Packet::LITERAL_DATA);
+    EXPECT_EQ(packet -> raw(), literal);
+
+    EXPECT_EQ(reader.next(header), false);
+
+    // definite length bodies larger than a chunk
+    OpenPGP::Packet::Tag11 large;
+    large.set_format(OpenPGP::Packet::Literal::BINARY);
+    large.set_filename("");
+    large.set_time(0);
+    large.set_literal(std::string(3 * OpenPGP::Packet::PARTIAL_CHUNK + 1, 'a'));
+
+    std::stringstream large_stream(large.write(OpenPGP::Packet::Tag::NEW));
+    OpenPGP::PacketReader large_reader(large_stream);
+    packet = large_reader.read_packet();
+    ASSERT_NE(packet, nullptr);
+    EXPECT_EQ(packet -> raw(), large.raw());
+
+    // a header claiming 4 GiB followed by no data
+    std::stringstream claimed("\xcb\xff\xff\xff\xff\xff");
+    OpenPGP::PacketReader claimed_reader(claimed);
+    EXPECT_THROW(claimed_reader.read_packet(), std::runtime_error);
+}
+
+TEST(PGP, partial_body_lengths){
+    // literal data body split into 512 + 1 + 3 octet chunks
+    const std::string literal = std::string("b\x00", 2) + std::string(4, '\x00') + std::string(510, 'x');
+    const std::string chunked = "\xcb\xe9" + literal.substr(0, 512) +
+                                "\xe0" + literal.substr(512, 1) +
+                                "\x03" + literal.substr(513, 3);
+
+    // the chunks are kept as one packet
+    OpenPGP::PGP pgp;
+    pgp.read_raw(ByteSlice(chunked));
+    ASSERT_EQ(pgp.get_packets().size(), 1);
+    const OpenPGP::Packet::Tag11::Ptr tag11 = std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (pgp.get_packets()[0]);
+    ASSERT_NE(tag11, nullptr);
+    EXPECT_EQ(tag11 -> get_partial(), 1);
+    EXPECT_EQ(tag11 -> get_literal(), std::string(510, 'x'));
+    EXPECT_EQ(tag11 -> raw(), literal);
+
+    // bodies larger than a chunk are written with partial body lengths
+    OpenPGP::Packet::Tag11 large;
+    large.set_format(OpenPGP::Packet::Literal::BINARY);
+    large.set_filename("");
+    large.set_time(0);
+    large.set_literal(std::string(3 * OpenPGP::Packet::PARTIAL_CHUNK, 'a'));
+    large.set_partial(1);
+
+    const std::string written = large.write(OpenPGP::Packet::Tag::NEW);
+    EXPECT_EQ(written.size(), large.write_size(OpenPGP::Packet::Tag::NEW));
+    EXPECT_EQ(written.substr(0, 2), "\xcb\xf0");    // 2^16 octet chunks
+
+    OpenPGP::PGP reread;
+    reread.read_raw(written);
+    ASSERT_EQ(reread.get_packets().size(), 1);
+    EXPECT_EQ(reread.get_packets()[0] -> raw(), large.raw());
+}
+
+TEST(PGP, subpacket_lengths){
+    // a subpacket length (type octet + data) of 8383 is the largest that fits in 2 octets
+    OpenPGP::Subpacket::Tag2::Sub26 sub26;
+    sub26.set_uri(std::string(8382, 'u'));
+    const std::string two = sub26.write();
+    EXPECT_EQ(two.size(), sub26.write_size());
+    EXPECT_EQ(two.substr(0, 3), "\xdf\xff\x1a");
+
+    sub26.set_uri(std::string(8383, 'u'));
+    const std::string five = sub26.write();
+    EXPECT_EQ(five.size(), sub26.write_size());
+    EXPECT_EQ(five.substr(0, 6), std::string("\xff\x00\x00\x20\xc0\x1a", 6));
+}
+
+TEST(PartialWriter, chunks){
+    const std::string body(1500, 'p');
+
+    std::stringstream out;
+    OpenPGP::PartialWriter writer(out, OpenPGP::Packet::LITERAL_DATA, 512);
+    writer << body.substr(0, 700);
+    writer << body.substr(700);
+    writer.close();
+
+    // 1500 = 512 + 512 + 476 (two octet length)
+    EXPECT_EQ(out.str(), "\xcb\xe9" + body.substr(0, 512) +
+                         "\xe9" + body.substr(512, 512) +
+                         "\xc1\x1c" + body.substr(1024));
+
+    // short bodies are written as ordinary packets
+    std::stringstream small;
+    OpenPGP::PartialWriter(small, OpenPGP::Packet::LITERAL_DATA) << "abc";
+    EXPECT_EQ(small.str(), "\xcb\x03" "abc");
+
+    std::stringstream bad;
+    EXPECT_THROW(OpenPGP::PartialWriter(bad, OpenPGP::Packet::LITERAL_DATA, 256), std::runtime_error);
+    EXPECT_THROW(OpenPGP::PartialWriter(bad, OpenPGP::Packet::LITERAL_DATA, 1000), std::runtime_error);
+}
+
+TEST(ArmorWriter, lines){
+    for(std::size_t const len : {(std::size_t) 0, (std::size_t) 1, (std::size_t) 2, (std::size_t) 47, (std::size_t) 48, (std::size_t) 49, (std::size_t) 100000}){
+        std::string data(len, 0);
+        for(std::size_t i = 0; i < len; i++){
+            data[i] = i * 7;
+        }
+
+        // same output as encoding everything at once, however it is written
+        const uint32_t crc = OpenPGP::crc24(data);
+        const char checksum[3] = {static_cast <char> (crc >> 16), static_cast <char> (crc >> 8), static_cast <char> (crc)};
+        const std::string encoded = OpenPGP::ascii2radix64(data);
+        std::string expected;
+        for(std::size_t i = 0; i < encoded.size(); i += OpenPGP::MAX_LINE_LENGTH){
+            expected += encoded.substr(i, OpenPGP::MAX_LINE_LENGTH) + "\n";
+        }
+        expected += "=" + OpenPGP::ascii2radix64(checksum, 3) + "\n";
+
+        std::stringstream out;
+        {
+            OpenPGP::ArmorWriter armor(out);
+            for(std::size_t i = 0; i < len; i += 1000){
+                armor << data.substr(i, 1000);
+            }
+        }
+        EXPECT_EQ(out.str(), expected) << len;
+
+        // and it reads back
+        out << "-----END PGP MESSAGE-----\nafter\n";
+        OpenPGP::ArmorReader armor(out);
+        const std::string decoded((std::istreambuf_iterator <char> (armor)), std::istreambuf_iterator <char> ());
+        EXPECT_EQ(decoded, data) << len;
+        EXPECT_EQ(armor.finished(), true);
+        EXPECT_EQ(armor.has_checksum(), true);
+        EXPECT_EQ(armor.checksum_matches(), true);
+
+        std::string line;
+        EXPECT_TRUE(std::getline(out, line));
+        EXPECT_EQ(line, "after");
+    }
+
+    std::stringstream wide;
+    OpenPGP::ArmorWriter(wide, 76) << std::string(57, 'a');
+    EXPECT_EQ(wide.str().find('\n'), (std::size_t) 76);
+
+    std::stringstream bad;
+    EXPECT_THROW(OpenPGP::ArmorWriter(bad, 0), std::runtime_error);
+    EXPECT_THROW(OpenPGP::ArmorWriter(bad, 77), std::runtime_error);
+
+    // line lengths that are not a multiple of 4 can put padding at the start of a line
+    for(std::size_t const line_length : {(std::size_t) 1, (std::size_t) 5, (std::size_t) 7, (std::size_t) 10, (std::size_t) 75}){
+        for(std::string const & data : {std::string("hello"), std::string("hello!"), std::string(100, 'x')}){
+            std::stringstream out;
+            {
+                OpenPGP::ArmorWriter armor(out, line_length);
+                armor << data;
+            }
+            out << "-----END PGP MESSAGE-----\n";
+
+            OpenPGP::ArmorReader armor(out);
+            EXPECT_EQ(std::string((std::istreambuf_iterator <char> (armor)), std::istreambuf_iterator <char> ()), data) << line_length;
+            EXPECT_EQ(armor.checksum_matches(), true) << line_length;
+        }
+    }
+}
+
+TEST(ArmorReader, checksum){
+    // "foobar", with and without line breaks, white space and a checksum
+    const char checksum[3] = {static_cast <char> (OpenPGP::crc24("foobar") >> 16), static_cast <char> (OpenPGP::crc24("foobar") >> 8), static_cast <char> (OpenPGP::crc24("foobar"))};
+    const std::string crc = "=" + OpenPGP::ascii2radix64(checksum, 3) + "\n";
+
+    for(std::string const & body : {std::string("Zm9vYmFy\n"), std::string("Zm9v\r\nYm Fy\r\n")}){
+        std::stringstream good(body + crc + "-----END PGP MESSAGE-----\n");
+        OpenPGP::ArmorReader reader(good);
+        EXPECT_EQ(std::string((std::istreambuf_iterator <char> (reader)), std::istreambuf_iterator <char> ()), "foobar");
+        EXPECT_EQ(reader.checksum_matches(), true);
+    }
+
+    std::stringstream none("Zm9vYmFy\n-----END PGP MESSAGE-----\n");
+    OpenPGP::ArmorReader no_checksum(none);
+    EXPECT_EQ(std::string((std::istreambuf_iterator <char> (no_checksum)), std::istreambuf_iterator <char> ()), "foobar");
+    EXPECT_EQ(no_checksum.has_checksum(), false);
+
+    std::stringstream wrong("Zm9vYmFy\n=AAAA\n-----END PGP MESSAGE-----\n");
+    OpenPGP::ArmorReader wrong_checksum(wrong);
+    EXPECT_EQ(std::string((std::istreambuf_iterator <char> (wrong_checksum)), std::istreambuf_iterator <char> ()), "foobar");
+    EXPECT_EQ(wrong_checksum.has_checksum(), true);
+    EXPECT_EQ(wrong_checksum.checksum_matches(), false);
+
+    // padding only at the end
+    std::stringstream padding("Zm9vYg==\nZm9v\n-----END PGP MESSAGE-----\n");
+    OpenPGP::ArmorReader misplaced(padding);
+    EXPECT_THROW(misplaced.rdbuf() -> sgetc(), std::runtime_error);
+}
+
+TEST(PGP, encrypt_stream_decrypt_symmetric){
+    std::string data;
+    while (data.size() < 5000){
+        data += MESSAGE;
+    }
+
+    for(bool const mdc : {true, false}){
+        OpenPGP::Encrypt::Args encrypt_args;
+        encrypt_args.mdc = mdc;
+        encrypt_args.comp = mdc?OpenPGP::Compression::ID::ZLIB:OpenPGP::Compression::ID::UNCOMPRESSED;
+
+        OpenPGP::S2K::S2K3::Ptr s2k = std::make_shared <OpenPGP::S2K::S2K3> ();
+        s2k -> set_type(OpenPGP::S2K::ID::ITERATED_AND_SALTED_S2K);
+        s2k -> set_hash(OpenPGP::Hash::ID::SHA256);
+        s2k -> set_salt(std::string(8, 's'));
+        s2k -> set_count(96);
+
+        OpenPGP::Packet::Tag3 tag3;
+        tag3.set_version(4);
+        tag3.set_sym(encrypt_args.sym);
+        tag3.set_s2k(s2k);
+        const std::string session_key = tag3.get_session_key(PASSPHRASE);
+
+        std::stringstream in(data);
+        std::stringstream out;
+        out << tag3.write(OpenPGP::Packet::Tag::NEW);
+        ASSERT_EQ(OpenPGP::Encrypt::stream(encrypt_args, session_key.substr(1), in, out, 512), true);
+
+        const OpenPGP::Message encrypted(out.str());
+        ASSERT_EQ(encrypted.get_packets().size(), 2);
+        EXPECT_EQ(encrypted.get_packets()[1] -> get_tag(), mdc?OpenPGP::Packet::SYM_ENCRYPTED_INTEGRITY_PROTECTED_DATA:OpenPGP::Packet::SYMMETRICALLY_ENCRYPTED_DATA);
+        if (!encrypt_args.comp){                                // compressed data fits in one chunk
+            EXPECT_EQ(encrypted.get_packets()[1] -> get_partial(), 1);
+        }
+
+        const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(encrypted, PASSPHRASE);
+        std::string message = "";
+        for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+            if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+                message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+            }
+        }
+        EXPECT_EQ(message, data);
+    }
+}
+
+TEST(PGP, encrypt_stream_armored){
+    std::string data;
+    while (data.size() < 5000){
+        data += MESSAGE;
+    }
+
+    OpenPGP::Encrypt::Args encrypt_args;
+    OpenPGP::S2K::S2K3::Ptr s2k = std::make_shared <OpenPGP::S2K::S2K3> ();
+    s2k -> set_type(OpenPGP::S2K::ID::ITERATED_AND_SALTED_S2K);
+    s2k -> set_hash(OpenPGP::Hash::ID::SHA256);
+    s2k -> set_salt(std::string(8, 's'));
+    s2k -> set_count(96);
+
+    OpenPGP::Packet::Tag3 tag3;
+    tag3.set_version(4);
+    tag3.set_sym(encrypt_args.sym);
+    tag3.set_s2k(s2k);
+    const std::string session_key = tag3.get_session_key(PASSPHRASE);
+
+    // packets are armored as they are written
+    std::stringstream in(data);
+    std::stringstream out;
+    out << "-----BEGIN PGP MESSAGE-----\n\n";
+    OpenPGP::ArmorWriter armor(out);
+    armor << tag3.write(OpenPGP::Packet::Tag::NEW);
+    ASSERT_EQ(OpenPGP::Encrypt::stream(encrypt_args, session_key.substr(1), in, armor, 512), true);
+    armor.close();
+    out << "-----END PGP MESSAGE-----\n";
+
+    const OpenPGP::Message encrypted(out.str());
+    EXPECT_EQ(encrypted.get_armored(), true);
+    ASSERT_EQ(encrypted.get_packets().size(), 2);
+
+    // writing to a stream gives the same text
+    std::stringstream rewritten;
+    encrypted.PGP::write(rewritten);
+    EXPECT_EQ(rewritten.str(), encrypted.PGP::write());
+    EXPECT_EQ(OpenPGP::Message(rewritten.str()).get_packets().size(), 2);
+
+    const OpenPGP::Message decrypted = OpenPGP::Decrypt::sym(encrypted, PASSPHRASE);
+    std::string message = "";
+    for(OpenPGP::Packet::Tag::Ptr const & p : decrypted.get_packets()){
+        if (p -> get_tag() == OpenPGP::Packet::LITERAL_DATA){
+            message += std::dynamic_pointer_cast <OpenPGP::Packet::Tag11> (p) -> out(false);
+        }
+    }
+    EXPECT_EQ(message, data);
+}
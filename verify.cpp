@@ -1,9 +1,13 @@
 #include "verify.h"
 
+#include <algorithm>
+#include <future>
+#include <map>
+
 namespace OpenPGP {
 namespace Verify {
 
-int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee){
+int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee, const PKA::ModExpContext::Ptr & context){
     if ((pka == PKA::ID::RSA_ENCRYPT_OR_SIGN) ||
         (pka == PKA::ID::RSA_SIGN_ONLY)){
         // RFC 4880 sec 5.2.2
@@ -11,18 +15,107 @@ int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka,
         return PKA::RSA::verify(EMSA_PKCS1_v1_5(hash, digest, bitsize(signer[0]) >> 3), signee, signer);
     }
     else if (pka == PKA::ID::DSA){
-        return PKA::DSA::verify(digest, signee, signer);
+        return PKA::DSA::verify(digest, signee, signer, context);
+    }
+    #ifdef GPG_COMPATIBLE
+    else if (pka == PKA::ID::ECDSA){
+        return PKA::ECDSA::verify(digest, signee, signer);
     }
+    else if (pka == PKA::ID::EdDSA){
+        return PKA::EdDSA::verify(digest, signee, signer);
+    }
+    #endif
 
     // "Error: Bad PKA value.\n";
     return -1;
 }
 
 int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee){
-    return with_pka(digest, signee -> get_hash(), signee -> get_pka(), signer -> get_mpi(), signee -> get_mpi());
+    return with_pka(digest, signee -> get_hash(), signee -> get_pka(), signer -> get_mpi(), signee -> get_mpi(), signer -> get_modexp());
+}
+
+std::vector <int> with_pka(const std::vector <Batch> & batch, ThreadPool & pool){
+    std::vector <int> results(batch.size(), -1);
+
+    // the signatures made by each key, in order of first appearance
+    struct Group {
+        const PKA::Values * signer;         // decoded key values, shared by every job of the group
+        PKA::ModExpContext::Ptr context;
+        std::vector <std::size_t> items;
+    };
+
+    std::vector <Group> groups;
+    std::map <const Packet::Key *, std::size_t> group_of;
+    for(std::size_t i = 0; i < batch.size(); i++){
+        const Packet::Key::Ptr & signer = batch[i].signer;
+        std::map <const Packet::Key *, std::size_t>::iterator it = group_of.find(signer.get());
+        if (it == group_of.end()){
+            it = group_of.emplace(signer.get(), groups.size()).first;
+            groups.push_back({nullptr, nullptr, {}});
+
+            // decode the key and fetch its context once here instead of in every job
+            if (signer){
+                try{
+                    groups.back().signer = &signer -> get_mpi();
+                    groups.back().context = signer -> get_modexp();
+                }
+                catch (...){
+                    // "Error: Signing key could not be read.\n";
+                    groups.back().signer = nullptr;
+                }
+            }
+        }
+        groups[it -> second].items.push_back(i);
+    }
+
+    // split large groups so that a batch signed by a single key still uses every thread
+    const std::size_t chunk = std::max <std::size_t> (1, batch.size() / (pool.size() * 4));
+
+    std::vector <std::future <void> > done;
+    for(Group const & group : groups){
+        if (!group.signer){
+            continue;
+        }
+
+        for(std::size_t start = 0; start < group.items.size(); start += chunk){
+            const std::size_t end = std::min(group.items.size(), start + chunk);
+            std::shared_ptr <std::promise <void> > finished = std::make_shared <std::promise <void> > ();
+            done.push_back(finished -> get_future());
+
+            pool.submit([&batch, &results, &group, start, end, finished](){
+                for(std::size_t i = start; i < end; i++){
+                    const Packet::Tag2::Ptr & signee = batch[group.items[i]].signee;
+                    try{
+                        if (signee){
+                            results[group.items[i]] = with_pka(batch[group.items[i]].digest, signee -> get_hash(), signee -> get_pka(), *group.signer, signee -> get_mpi(), group.context);
+                        }
+                    }
+                    catch (...){
+                        // "Error: Signature could not be verified.\n";
+                    }
+                }
+                finished -> set_value();
+            });
+        }
+    }
+
+    for(std::future <void> & f : done){
+        f.wait();
+    }
+
+    return results;
+}
+
+std::vector <int> with_pka(const std::vector <Batch> & batch, const std::size_t threads){
+    ThreadPool pool(threads);
+    return with_pka(batch, pool);
 }
 
 int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig){
+    return detached_signature(key, ByteSlice::view(data.data(), data.size()), sig);
+}
+
+int detached_signature(const Key & key, const ByteSlice & data, const DetachedSignature & sig){
     if (!key.meaningful()){
         // "Error: Bad PGP Key.\n";
         return -1;
@@ -49,7 +142,7 @@ int detached_signature(const Key & key, const std::string & data, const Detached
 
     // calculate the digest of the data (treated as binary)
     // and check the left 16 bits
-    const std::string digest = to_sign_00(binary_to_canonical(data), signature);
+    const std::string digest = to_sign_00(binary_to_canonical(ByteChain(data)), signature);
     if (digest.substr(0, 2) != signature -> get_left16()){
         // "Hash digest and given left 16 bits of hash do not match.\n";
         return false;
@@ -148,14 +241,14 @@ int binary(const Key & key, const Message & message){
             while (SP < packets.size()){
                 if (std::static_pointer_cast <Packet::Tag4> (packets[OPSP]) -> get_keyid() == signing_key -> get_keyid()){
                     // build signed data
-                    std::string binary = "";
+                    ByteChain binary;
                     for(PGP::Packets::size_type i = msg; i < SP; i++){
                         // actually only expects 1 literal data packet
                         if (packets[i] -> get_tag() == Packet::LITERAL_DATA){
-                            binary += binary_to_canonical(std::static_pointer_cast <Packet::Tag11> (packets[i]) -> get_literal());
+                            binary.append(binary_to_canonical(ByteChain(std::static_pointer_cast <Packet::Tag11> (packets[i]) -> get_literal_slice())));
                         }
                         else{
-                            binary += packets[i] -> raw();
+                            binary.append(ByteSlice(packets[i] -> raw()));
                         }
                     }
 
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #define __VERIFY__
 
 #include <string>
+#include <vector>
 
 #include "CleartextSignature.h"
 #include "DetachedSignature.h"
@@ -38,18 +39,35 @@ THE SOFTWARE.
 #include "PKA/PKAs.h"
 #include "Packets/packets.h"
 #include "RevocationCertificate.h"
+#include "common/ThreadPool.h"
 
 namespace OpenPGP {
     namespace Verify {
         // verify pka with variables only
-        int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee);
+        int with_pka(const std::string & digest, const uint8_t hash, const uint8_t pka, const PKA::Values & signer, const PKA::Values & signee, const PKA::ModExpContext::Ptr & context = nullptr);
 
         // verify pka with packets
         int with_pka(const std::string & digest, const Packet::Key::Ptr & signer, const Packet::Tag2::Ptr & signee);
+
+        // one signature of a batch
+        struct Batch {
+            std::string digest;             // hash of the signed data and the signature trailer
+            Packet::Key::Ptr signer;
+            Packet::Tag2::Ptr signee;
+        };
+
+        // verify many signatures at once, spread across a thread pool
+        // signatures are grouped by signing key (the same Key::Ptr); each key is decoded and
+        // its exponentiation context fetched once, then shared by every signature it made
+        // results are in the order of the batch and have the same meaning as the single signature version
+        // waits for its jobs on pool, so it must not be called from a job running on that pool
+        std::vector <int> with_pka(const std::vector <Batch> & batch, ThreadPool & pool);
+        std::vector <int> with_pka(const std::vector <Batch> & batch, const std::size_t threads = 0);
         // /////////////////
 
         // detached signatures (not a standalone signature)
         int detached_signature(const Key & key, const std::string & data, const DetachedSignature & sig);
+        int detached_signature(const Key & key, const ByteSlice & data, const DetachedSignature & sig);   // data is hashed in place
 
         // 0x00: Signature of a binary document.
         int binary(const Key & key, const Message & message);